@@ -0,0 +1,30 @@
+#.rst:
+# FindParquet
+# -----------
+#
+# Find the Apache Parquet C++ library (with its Apache Arrow bindings).
+# It is searched first next to the Arrow installation, if any, then in the
+# default locations.
+#
+# Result Variables
+# ^^^^^^^^^^^^^^^^
+#
+# This module defines the following variables:
+#
+# ::
+#
+#   PARQUET_FOUND        - True if Parquet is found.
+#   PARQUET_INCLUDE_DIR  - Where to find parquet/arrow/reader.h
+#   PARQUET_SHARED_LIB   - The Parquet shared library
+
+find_path(PARQUET_INCLUDE_DIR NAMES parquet/arrow/reader.h
+  HINTS ${ARROW_INCLUDE_DIR} $ENV{PARQUET_HOME}/include $ENV{ARROW_HOME}/include)
+
+find_library(PARQUET_SHARED_LIB NAMES parquet
+  HINTS ${ARROW_LIBS} $ENV{PARQUET_HOME}/lib $ENV{ARROW_HOME}/lib)
+
+mark_as_advanced(PARQUET_INCLUDE_DIR PARQUET_SHARED_LIB)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Parquet
+  REQUIRED_VARS PARQUET_SHARED_LIB PARQUET_INCLUDE_DIR)
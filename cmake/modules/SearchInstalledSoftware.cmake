@@ -932,6 +932,17 @@ if(arrow)
     endif()
   endif()
 
+  #---The Parquet data source is built if the Parquet C++ library is found alongside Arrow
+  if(ARROW_FOUND)
+    find_package(Parquet QUIET)
+    if(PARQUET_FOUND)
+      message(STATUS "Found Apache Parquet: ${PARQUET_SHARED_LIB}")
+    else()
+      message(STATUS "Apache Parquet not found. Set variable PARQUET_HOME to point to your Parquet installation"
+                     " to build the Parquet RDataFrame data source.")
+    endif()
+  endif()
+
 endif()
 
 #---Check for cling and llvm --------------------------------------------------------
@@ -146,6 +146,13 @@
 #pragma link C++ class THnSparseT<TArrayS>+;
 #pragma link C++ class THnSparseT<TArrayC>+;
 #pragma link C++ class THnSparseArrayChunk+;
+#pragma link C++ class THnHash+;
+#pragma link C++ class THnHashT<Double_t>+;
+#pragma link C++ class THnHashT<Float_t>+;
+#pragma link C++ class THnHashT<Long_t>+;
+#pragma link C++ class THnHashT<Int_t>+;
+#pragma link C++ class THnHashT<Short_t>+;
+#pragma link C++ class THnHashT<Char_t>+;
 #pragma link C++ class THStack+;
 #pragma link C++ class TLimit+;
 #pragma link C++ class TLimitDataSource+;
@@ -179,6 +186,13 @@
 #pragma link C++ typedef THnSparseS;
 #pragma link C++ typedef THnSparseC;
 
+#pragma link C++ typedef THnHashD;
+#pragma link C++ typedef THnHashF;
+#pragma link C++ typedef THnHashL;
+#pragma link C++ typedef THnHashI;
+#pragma link C++ typedef THnHashS;
+#pragma link C++ typedef THnHashC;
+
 #pragma link C++ typedef THnD;
 #pragma link C++ typedef THnF;
 #pragma link C++ typedef THnL;
@@ -197,6 +211,13 @@
 #pragma link C++ class THnSparseS;
 #pragma link C++ class THnSparseC;
 
+#pragma link C++ class THnHashD;
+#pragma link C++ class THnHashF;
+#pragma link C++ class THnHashL;
+#pragma link C++ class THnHashI;
+#pragma link C++ class THnHashS;
+#pragma link C++ class THnHashC;
+
 #pragma link C++ class THnD;
 #pragma link C++ class THnF;
 #pragma link C++ class THnL;
@@ -18,6 +18,8 @@
 
 #include "TF1.h"
 
+#include <vector>
+
 namespace ROOT {
 
    namespace Math {
@@ -163,6 +165,9 @@ namespace ROOT {
             return fFunc->EvalPar(x, 0);
          }
 
+         /// evaluate function at n points, with the coordinates given per dimension
+         void DoEvalBatch(unsigned int n, const T *const *x, const double *p, T *f) const;
+
          /// evaluate the partial derivative with respect to the parameter
          T DoParameterDerivative(const T *x, const double *p, unsigned int ipar) const;
 
@@ -207,6 +212,76 @@ namespace ROOT {
          }
       };
 
+      /**
+       * Auxiliar class to compute the exact derivatives with respect to the parameters of a TF1 defined by a formula,
+       * with TFormula::GradientPar. It exists only for double; ParameterGradient returns false when the derivatives
+       * have to be computed numerically.
+       */
+      template <class T>
+      struct FormulaParameterGradient {
+         static bool ParameterGradient(const WrappedMultiTF1Templ<T> *, const T *, const double *, T *)
+         {
+            return false;
+         }
+      };
+
+      template <>
+      struct FormulaParameterGradient<double> {
+         static bool
+         ParameterGradient(const WrappedMultiTF1Templ<double> *wrappedFunc, const double *x, const double *par, double *grad)
+         {
+            const TF1 *func = wrappedFunc->GetFunction();
+            const TFormula *formula = func->GetFormula();
+            // the TF1 must be evaluated by its formula alone (see TF1::EvalPar)
+            if (!formula || func->IsEvalNormalized() || formula->GetNpar() != func->GetNpar() ||
+                formula->GetNdim() != (int)wrappedFunc->NDim())
+               return false;
+            return formula->GradientPar(x, grad, par);
+         }
+      };
+
+      /**
+       * Auxiliar class to evaluate the wrapped TF1 at many points.
+       *
+       * TF1::EvalParBatch exists only for double; the general implementation evaluates the points one by one.
+       */
+      template <class T>
+      struct WrappedTF1BatchEvaluation {
+         static void DoEvalBatch(const WrappedMultiTF1Templ<T> *wrappedFunc, unsigned int n, const T *const *x,
+                                 const double *p, T *f)
+         {
+            TF1 *func = const_cast<TF1 *>(wrappedFunc->GetFunction());
+            const unsigned int ndim = wrappedFunc->NDim();
+            std::vector<T> xi(ndim);
+            for (unsigned int i = 0; i < n; ++i) {
+               for (unsigned int j = 0; j < ndim; ++j)
+                  xi[j] = x[j][i];
+               f[i] = func->EvalPar(xi.data(), p);
+            }
+         }
+      };
+
+      template <>
+      struct WrappedTF1BatchEvaluation<double> {
+         static void DoEvalBatch(const WrappedMultiTF1Templ<double> *wrappedFunc, unsigned int n,
+                                 const double *const *x, const double *p, double *f)
+         {
+            TF1 *func = const_cast<TF1 *>(wrappedFunc->GetFunction());
+            const unsigned int ndim = wrappedFunc->NDim();
+            // the dimension of the TF1 is not the real one for multi-dimensional functions created as TF1
+            if (ndim == (unsigned int)func->GetNdim()) {
+               func->EvalParBatch(n, x, p, f);
+               return;
+            }
+            std::vector<double> xi(ndim);
+            for (unsigned int i = 0; i < n; ++i) {
+               for (unsigned int j = 0; j < ndim; ++j)
+                  xi[j] = x[j][i];
+               f[i] = func->EvalPar(xi.data(), p);
+            }
+         }
+      };
+
       // implementations for WrappedMultiTF1Templ<T>
       template<class T>
       WrappedMultiTF1Templ<T>::WrappedMultiTF1Templ(TF1 &f, unsigned int dim)  :
@@ -276,6 +351,9 @@ namespace ROOT {
          //  so in case of fLinear (or fPolynomial) a non-zero value will be returned for fixed parameters
 
          if (!fLinear) {
+            // exact derivatives of functions defined by a formula
+            if (FormulaParameterGradient<T>::ParameterGradient(this, x, par, grad))
+               return;
             // need to set parameter values
             fFunc->SetParameters(par);
             // no need to call InitArgs (it is called in TF1::GradientPar)
@@ -294,6 +372,9 @@ namespace ROOT {
          // evaluate the derivative of the function with respect to parameter ipar
          // see note above concerning the fixed parameters
          if (!fLinear) {
+            std::vector<T> grad(NPar());
+            if (FormulaParameterGradient<T>::ParameterGradient(this, x, p, grad.data()))
+               return grad[ipar];
             fFunc->SetParameters(p);
             double prec = this->GetDerivPrecision();
             return fFunc->GradientPar(ipar, x, prec);
@@ -312,6 +393,12 @@ namespace ROOT {
             return GeneralLinearFunctionDerivation<T>::DoParameterDerivative(this, x, ipar);
          }
       }
+      template <class T>
+      void WrappedMultiTF1Templ<T>::DoEvalBatch(unsigned int n, const T *const *x, const double *p, T *f) const
+      {
+         WrappedTF1BatchEvaluation<T>::DoEvalBatch(this, n, x, p, f);
+      }
+
       template<class T>
       void WrappedMultiTF1Templ<T>::SetDerivPrecision(double eps)
       {
@@ -0,0 +1,292 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TFORMULADUAL
+#define ROOT_TFORMULADUAL
+
+#include "TMath.h"
+
+namespace ROOT {
+namespace Internal {
+
+// clang-format off
+/**
+\class ROOT::Internal::TFormulaDual
+\ingroup Hist
+\brief A value together with its derivatives with respect to N parameters (forward mode automatic differentiation).
+
+TFormula::GradientPar compiles the expression of the formula a second time, with the parameters of type
+TFormulaDual<N>: the result of the expression holds then the exact derivatives of the formula with respect to its N
+parameters. The mathematical functions which can be differentiated are in the namespace
+ROOT::Internal::TFormulaDualMath, with the names of the TMath functions they replace.
+*/
+// clang-format on
+template <unsigned int N>
+class TFormulaDual {
+public:
+   Double_t fVal;    ///< value
+   Double_t fDer[N]; ///< derivatives with respect to the parameters
+
+   TFormulaDual() : fVal(0)
+   {
+      for (unsigned int i = 0; i < N; ++i)
+         fDer[i] = 0;
+   }
+
+   /// A constant, whose derivatives are 0.
+   explicit TFormulaDual(Double_t val) : fVal(val)
+   {
+      for (unsigned int i = 0; i < N; ++i)
+         fDer[i] = 0;
+   }
+
+   /// The parameter ipar, with value val.
+   static TFormulaDual Parameter(Double_t val, unsigned int ipar)
+   {
+      TFormulaDual d(val);
+      d.fDer[ipar] = 1;
+      return d;
+   }
+
+   /// The dual number val + d * der, used to apply the chain rule.
+   static TFormulaDual Chain(Double_t val, Double_t d, const TFormulaDual &der)
+   {
+      TFormulaDual res(val);
+      for (unsigned int i = 0; i < N; ++i)
+         res.fDer[i] = d * der.fDer[i];
+      return res;
+   }
+
+   void GetGradient(Double_t *grad) const
+   {
+      for (unsigned int i = 0; i < N; ++i)
+         grad[i] = fDer[i];
+   }
+};
+
+template <unsigned int N>
+TFormulaDual<N> operator+(const TFormulaDual<N> &a)
+{
+   return a;
+}
+
+template <unsigned int N>
+TFormulaDual<N> operator-(const TFormulaDual<N> &a)
+{
+   return TFormulaDual<N>::Chain(-a.fVal, -1., a);
+}
+
+template <unsigned int N>
+TFormulaDual<N> operator+(const TFormulaDual<N> &a, const TFormulaDual<N> &b)
+{
+   TFormulaDual<N> res(a.fVal + b.fVal);
+   for (unsigned int i = 0; i < N; ++i)
+      res.fDer[i] = a.fDer[i] + b.fDer[i];
+   return res;
+}
+
+template <unsigned int N>
+TFormulaDual<N> operator+(const TFormulaDual<N> &a, Double_t b)
+{
+   TFormulaDual<N> res(a);
+   res.fVal += b;
+   return res;
+}
+
+template <unsigned int N>
+TFormulaDual<N> operator+(Double_t a, const TFormulaDual<N> &b)
+{
+   return b + a;
+}
+
+template <unsigned int N>
+TFormulaDual<N> operator-(const TFormulaDual<N> &a, const TFormulaDual<N> &b)
+{
+   TFormulaDual<N> res(a.fVal - b.fVal);
+   for (unsigned int i = 0; i < N; ++i)
+      res.fDer[i] = a.fDer[i] - b.fDer[i];
+   return res;
+}
+
+template <unsigned int N>
+TFormulaDual<N> operator-(const TFormulaDual<N> &a, Double_t b)
+{
+   TFormulaDual<N> res(a);
+   res.fVal -= b;
+   return res;
+}
+
+template <unsigned int N>
+TFormulaDual<N> operator-(Double_t a, const TFormulaDual<N> &b)
+{
+   return TFormulaDual<N>::Chain(a - b.fVal, -1., b);
+}
+
+template <unsigned int N>
+TFormulaDual<N> operator*(const TFormulaDual<N> &a, const TFormulaDual<N> &b)
+{
+   TFormulaDual<N> res(a.fVal * b.fVal);
+   for (unsigned int i = 0; i < N; ++i)
+      res.fDer[i] = a.fDer[i] * b.fVal + a.fVal * b.fDer[i];
+   return res;
+}
+
+template <unsigned int N>
+TFormulaDual<N> operator*(const TFormulaDual<N> &a, Double_t b)
+{
+   return TFormulaDual<N>::Chain(a.fVal * b, b, a);
+}
+
+template <unsigned int N>
+TFormulaDual<N> operator*(Double_t a, const TFormulaDual<N> &b)
+{
+   return TFormulaDual<N>::Chain(a * b.fVal, a, b);
+}
+
+template <unsigned int N>
+TFormulaDual<N> operator/(const TFormulaDual<N> &a, const TFormulaDual<N> &b)
+{
+   const Double_t inv = 1. / b.fVal;
+   const Double_t val = a.fVal * inv;
+   TFormulaDual<N> res(val);
+   for (unsigned int i = 0; i < N; ++i)
+      res.fDer[i] = (a.fDer[i] - val * b.fDer[i]) * inv;
+   return res;
+}
+
+template <unsigned int N>
+TFormulaDual<N> operator/(const TFormulaDual<N> &a, Double_t b)
+{
+   return TFormulaDual<N>::Chain(a.fVal / b, 1. / b, a);
+}
+
+template <unsigned int N>
+TFormulaDual<N> operator/(Double_t a, const TFormulaDual<N> &b)
+{
+   const Double_t val = a / b.fVal;
+   return TFormulaDual<N>::Chain(val, -val / b.fVal, b);
+}
+
+// Comparisons use the values only, the derivatives of a branch are those of the branch taken.
+#define ROOT_TFORMULADUAL_COMPARISON(OP)                                                    \
+   template <unsigned int N>                                                              \
+   bool operator OP(const TFormulaDual<N> &a, const TFormulaDual<N> &b)                   \
+   {                                                                                      \
+      return a.fVal OP b.fVal;                                                            \
+   }                                                                                      \
+   template <unsigned int N>                                                              \
+   bool operator OP(const TFormulaDual<N> &a, Double_t b)                                 \
+   {                                                                                      \
+      return a.fVal OP b;                                                                 \
+   }                                                                                      \
+   template <unsigned int N>                                                              \
+   bool operator OP(Double_t a, const TFormulaDual<N> &b)                                 \
+   {                                                                                      \
+      return a OP b.fVal;                                                                 \
+   }
+
+ROOT_TFORMULADUAL_COMPARISON(<)
+ROOT_TFORMULADUAL_COMPARISON(>)
+ROOT_TFORMULADUAL_COMPARISON(<=)
+ROOT_TFORMULADUAL_COMPARISON(>=)
+ROOT_TFORMULADUAL_COMPARISON(==)
+ROOT_TFORMULADUAL_COMPARISON(!=)
+
+#undef ROOT_TFORMULADUAL_COMPARISON
+
+/// The functions of TMath that TFormula can differentiate, for both Double_t and TFormulaDual arguments.
+namespace TFormulaDualMath {
+
+// Functions of one argument, given the derivative DER of FUNC at x with value val
+#define ROOT_TFORMULADUAL_FUNCTION(FUNC, DER)                                                 \
+   inline Double_t FUNC(Double_t x) { return TMath::FUNC(x); }                               \
+   template <unsigned int N>                                                                \
+   TFormulaDual<N> FUNC(const TFormulaDual<N> &a)                                           \
+   {                                                                                        \
+      const Double_t x = a.fVal;                                                            \
+      const Double_t val = TMath::FUNC(x);                                                  \
+      (void)val;                                                                            \
+      return TFormulaDual<N>::Chain(val, DER, a);                                           \
+   }
+
+ROOT_TFORMULADUAL_FUNCTION(Sin, TMath::Cos(x))
+ROOT_TFORMULADUAL_FUNCTION(Cos, -TMath::Sin(x))
+ROOT_TFORMULADUAL_FUNCTION(Tan, 1. + val * val)
+ROOT_TFORMULADUAL_FUNCTION(ASin, 1. / TMath::Sqrt(1. - x * x))
+ROOT_TFORMULADUAL_FUNCTION(ACos, -1. / TMath::Sqrt(1. - x * x))
+ROOT_TFORMULADUAL_FUNCTION(ATan, 1. / (1. + x * x))
+ROOT_TFORMULADUAL_FUNCTION(SinH, TMath::CosH(x))
+ROOT_TFORMULADUAL_FUNCTION(CosH, TMath::SinH(x))
+ROOT_TFORMULADUAL_FUNCTION(TanH, 1. - val * val)
+ROOT_TFORMULADUAL_FUNCTION(Exp, val)
+ROOT_TFORMULADUAL_FUNCTION(Log, 1. / x)
+ROOT_TFORMULADUAL_FUNCTION(Log10, 1. / (x * TMath::Ln10()))
+ROOT_TFORMULADUAL_FUNCTION(Sqrt, 0.5 / val)
+ROOT_TFORMULADUAL_FUNCTION(Abs, (x < 0) ? -1. : 1.)
+
+#undef ROOT_TFORMULADUAL_FUNCTION
+
+inline Double_t Sq(Double_t x)
+{
+   return x * x;
+}
+
+template <unsigned int N>
+TFormulaDual<N> Sq(const TFormulaDual<N> &a)
+{
+   return TFormulaDual<N>::Chain(a.fVal * a.fVal, 2. * a.fVal, a);
+}
+
+inline Double_t Power(Double_t x, Double_t y)
+{
+   return TMath::Power(x, y);
+}
+
+inline Double_t Power(Double_t x, Int_t y)
+{
+   return TMath::Power(x, y);
+}
+
+template <unsigned int N>
+TFormulaDual<N> Power(const TFormulaDual<N> &a, Double_t y)
+{
+   return TFormulaDual<N>::Chain(TMath::Power(a.fVal, y), y * TMath::Power(a.fVal, y - 1), a);
+}
+
+template <unsigned int N>
+TFormulaDual<N> Power(const TFormulaDual<N> &a, Int_t y)
+{
+   return TFormulaDual<N>::Chain(TMath::Power(a.fVal, y), y * TMath::Power(a.fVal, y - 1), a);
+}
+
+template <unsigned int N>
+TFormulaDual<N> Power(Double_t x, const TFormulaDual<N> &b)
+{
+   const Double_t val = TMath::Power(x, b.fVal);
+   return TFormulaDual<N>::Chain(val, val * TMath::Log(x), b);
+}
+
+template <unsigned int N>
+TFormulaDual<N> Power(const TFormulaDual<N> &a, const TFormulaDual<N> &b)
+{
+   // d(a^b) = a^b * (b' log(a) + b a' / a)
+   const Double_t val = TMath::Power(a.fVal, b.fVal);
+   const Double_t da = b.fVal * TMath::Power(a.fVal, b.fVal - 1);
+   const Double_t db = (val != 0) ? val * TMath::Log(a.fVal) : 0.;
+   TFormulaDual<N> res(val);
+   for (unsigned int i = 0; i < N; ++i)
+      res.fDer[i] = da * a.fDer[i] + db * b.fDer[i];
+   return res;
+}
+
+} // namespace TFormulaDualMath
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
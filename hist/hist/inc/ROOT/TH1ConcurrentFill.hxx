@@ -0,0 +1,119 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH1CONCURRENTFILL
+#define ROOT_TH1CONCURRENTFILL
+
+#include "TH1.h"
+
+#include <atomic>
+#include <mutex>
+
+class TAxis;
+
+namespace ROOT {
+
+class TH1ConcurrentFiller;
+
+// clang-format off
+/**
+\class ROOT::TH1ConcurrentFillManager
+\ingroup Hist
+\brief Lets several threads fill the same TH1, TH2 or TH3, without a copy of the histogram per thread.
+
+Each thread fills through its own TH1ConcurrentFiller, obtained with MakeFiller(). The bin contents and the sums of
+squares of weights of the histogram are updated with atomic operations, so that the threads can fill the same bins.
+The statistics of the fills (number of entries, sums of the weights and of their moments) are accumulated by each
+filler, and added to the histogram when the filler is flushed or destroyed.
+~~~{.cpp}
+TH3D h("h", "h", 100, 0., 1., 100, 0., 1., 100, 0., 1.);
+ROOT::TH1ConcurrentFillManager manager(h);
+auto fill = [&manager](const std::vector<Point> &points) {
+   auto filler = manager.MakeFiller();
+   for (const auto &p : points)
+      filler.Fill(p.x, p.y, p.z);
+}; // the statistics of the fills are added to h as filler goes out of scope
+~~~
+Compared to a ROOT::TThreadedObject<TH3D>, memory does not grow with the number of threads and no merge is needed,
+at the cost of an atomic operation per fill, which becomes contended when the threads hit the same bins often.
+
+While fillers are in use, the histogram must not be used otherwise. Its axes cannot be extended: values outside of
+them are accumulated in the underflow and overflow bins. A histogram with a buffer is filled with the buffered values
+upon construction of the manager, which fixes its axes. The sums of squares of weights are updated if the histogram
+stores them: unlike TH1::Fill, the fillers cannot create them at the first weighted fill, so call TH1::Sumw2() before
+creating the manager if weights other than 1 are used. Profiles, TH2Poly and TH1K are not supported.
+**/
+// clang-format on
+class TH1ConcurrentFillManager {
+   friend class TH1ConcurrentFiller;
+
+public:
+   enum class EContentType { kChar, kShort, kInt, kFloat, kDouble };
+
+private:
+   TH1 &fHist;
+   EContentType fContentType;
+   void *fContent = nullptr;    ///< The array of bin contents of the histogram
+   Double_t *fSumw2 = nullptr;  ///< The array of sums of squares of weights, if the histogram stores them
+   Int_t fDimension = 1;
+   const TAxis *fAxes[3] = {nullptr, nullptr, nullptr};
+   Bool_t fStatOverflows = kFALSE;
+   Bool_t fIsNotW = kFALSE;
+   std::atomic<bool> fWarnedSumw2{false}; ///< Whether a weighted fill without sums of squares was reported
+   std::mutex fStatsMutex;
+   Double_t fStats[TH1::kNstat]; ///< The sums of weights of the histogram, updated when fillers are flushed
+   Double_t fEntries = 0.;
+
+   void AddToBin(Int_t bin, Double_t w);
+   void AddStats(const Double_t *stats, Double_t entries);
+
+public:
+   explicit TH1ConcurrentFillManager(TH1 &hist);
+   TH1ConcurrentFillManager(const TH1ConcurrentFillManager &) = delete;
+   TH1ConcurrentFillManager &operator=(const TH1ConcurrentFillManager &) = delete;
+
+   TH1ConcurrentFiller MakeFiller();
+   TH1 &GetHist() const { return fHist; }
+};
+
+/**
+\class ROOT::TH1ConcurrentFiller
+\ingroup Hist
+\brief Fills the histogram of a TH1ConcurrentFillManager, from a single thread.
+
+The Fill methods follow the ones of the histogram: Fill(x, y) is a weighted fill of a TH1 and an unweighted fill of
+a TH2. They return the global bin number, or -1 if the fill does not enter the statistics.
+**/
+class TH1ConcurrentFiller {
+   TH1ConcurrentFillManager *fManager;
+   Double_t fStats[TH1::kNstat] = {};
+   Double_t fEntries = 0.;
+
+   Int_t Fill1D(Double_t x, Double_t w);
+   Int_t Fill2D(Double_t x, Double_t y, Double_t w);
+   Int_t Fill3D(Double_t x, Double_t y, Double_t z, Double_t w);
+
+public:
+   explicit TH1ConcurrentFiller(TH1ConcurrentFillManager &manager) : fManager(&manager) {}
+   TH1ConcurrentFiller(TH1ConcurrentFiller &&other);
+   TH1ConcurrentFiller(const TH1ConcurrentFiller &) = delete;
+   TH1ConcurrentFiller &operator=(const TH1ConcurrentFiller &) = delete;
+   ~TH1ConcurrentFiller() { Flush(); }
+
+   Int_t Fill(Double_t x);
+   Int_t Fill(Double_t x, Double_t y);
+   Int_t Fill(Double_t x, Double_t y, Double_t z);
+   Int_t Fill(Double_t x, Double_t y, Double_t z, Double_t w);
+
+   /// Add the statistics of the fills done so far to the histogram
+   void Flush();
+};
+
+} // namespace ROOT
+
+#endif
@@ -99,6 +99,8 @@ private:
 
    TInterpreter::CallFuncIFacePtr_t::Generic_t fFuncPtr;   //!  function pointer
    void *   fLambdaPtr;                                    //!  pointer to the lambda function
+   TInterpreter::CallFuncIFacePtr_t::Generic_t fGradFuncPtr = nullptr; //! pointer to the function computing the gradient with respect to the parameters
+   Bool_t   fGradGenerated = kFALSE;                       //! flag to control if the generation of the gradient function has been tried
 
    void     InputFormulaIntoCling();
    Bool_t   PrepareEvalMethod();
@@ -115,6 +117,7 @@ private:
    void FillParametrizedFunctions(std::map<std::pair<TString, Int_t>, std::pair<TString, TString>> &functions);
    void FillVecFunctionsShurtCuts();
    void ReInitializeEvalMethod(); 
+   void GenerateGradientPar();
 
 protected:
 
@@ -187,6 +190,8 @@ public:
 #ifdef R__HAS_VECCORE
    ROOT::Double_v EvalParVec(const ROOT::Double_v *x, const Double_t *params = 0) const;
 #endif
+   void           EvalParBatch(Int_t n, const Double_t *const *x, const Double_t *params, Double_t *f) const;
+   Bool_t         GradientPar(const Double_t *x, Double_t *grad, const Double_t *params = 0) const;
    TString        GetExpFormula(Option_t *option="") const;
    const TObject *GetLinearPart(Int_t i) const;
    Int_t          GetNdim() const {return fNdim;}
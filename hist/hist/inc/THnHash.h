@@ -0,0 +1,220 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THnHash
+#define ROOT_THnHash
+
+/*************************************************************************
+
+ THnHash: histogramming multi-dimensional, sparse distributions, with
+ the filled bins stored in contiguous arrays and looked up in an open
+ addressing hash table.
+
+*************************************************************************/
+
+
+#include "THnBase.h"
+
+#include <vector>
+
+class TCollection;
+
+class THnHash: public THnBase {
+ private:
+   std::vector<ULong64_t> fKeys;  // compact coordinates of the filled bins, GetKeyWords() words per bin
+   std::vector<Double_t>  fSumw2; // sum of squared weights of the filled bins, empty if errors are not calculated
+
+   mutable std::vector<Int_t> fKeyLayout;   //! word, bit offset and number of bits of each axis index in the compact coordinates
+   mutable Int_t fKeyWords;                 //! number of 64 bit words of the compact coordinates of a bin
+   mutable std::vector<ULong64_t> fTable;   //! hash table: pairs of (hash of the compact coordinates, bin + 1)
+   mutable Int_t fTableBits;                //! the hash table has 2^fTableBits slots
+   mutable std::vector<ULong64_t> fKeyBuf;  //! compact coordinates of the bin being looked up
+   std::vector<Int_t> fCoordBuf;            //! coordinates of the bin being looked up
+
+   THnHash(const THnHash&); // Not implemented
+   THnHash& operator=(const THnHash&); // Not implemented
+
+   void InitKeyLayout() const;
+   Int_t GetKeyWords() const { if (!fKeyWords) InitKeyLayout(); return fKeyWords; }
+   const ULong64_t* GetKey(Long64_t bin) const { return fKeys.data() + bin * GetKeyWords(); }
+   ULong64_t SetKeyFromCoord(const Int_t* coord) const;
+   void SetCoordFromKey(const ULong64_t* key, Int_t* coord) const;
+   void BuildTable() const;
+   void ReserveTable(Long64_t nbins) const;
+   Long64_t FindBin(const ULong64_t* key, ULong64_t hash) const;
+   Long64_t GetBinIndex(const Int_t* coord, Bool_t allocate);
+   Long64_t AllocateBin(const ULong64_t* key, ULong64_t hash);
+   void AddHashed(const std::vector<const THnHash*>& hists, Double_t c);
+
+ protected:
+
+   THnHash();
+   THnHash(const char* name, const char* title, Int_t dim,
+           const Int_t* nbins, const Double_t* xmin, const Double_t* xmax);
+
+   void InitStorage(Int_t* nbins, Int_t chunkSize);
+   void Reserve(Long64_t nbins);
+
+   virtual Double_t GetAt(Long64_t bin) const = 0;
+   virtual void SetAt(Long64_t bin, Double_t v) = 0;
+   virtual void AddAt(Long64_t bin, Double_t v) = 0;
+   virtual void ResizeContent(Long64_t nbins) = 0;
+   virtual void ReserveContent(Long64_t nbins) = 0;
+
+ public:
+   virtual ~THnHash();
+
+   ROOT::Internal::THnBaseBinIter* CreateIter(Bool_t respectAxisRange) const;
+
+   Long64_t GetNbins() const { return fKeys.size() / GetKeyWords(); }
+
+   Long64_t GetBin(const Int_t* idx) const { return const_cast<THnHash*>(this)->GetBin(idx, kFALSE); }
+   Long64_t GetBin(const Double_t* x) const { return const_cast<THnHash*>(this)->GetBin(x, kFALSE); }
+   Long64_t GetBin(const char* name[]) const { return const_cast<THnHash*>(this)->GetBin(name, kFALSE); }
+   Long64_t GetBin(const Int_t* idx, Bool_t allocate = kTRUE);
+   Long64_t GetBin(const Double_t* x, Bool_t allocate = kTRUE);
+   Long64_t GetBin(const char* name[], Bool_t allocate = kTRUE);
+
+   void FillBin(Long64_t bin, Double_t w) {
+      // Increment the bin content of "bin" by "w".
+      AddAt(bin, w);
+      if (GetCalculateErrors())
+         fSumw2[bin] += w * w;
+      FillBinBase(w);
+   }
+
+   void SetBinContent(const Int_t* idx, Double_t v) {
+      // Forwards to THnBase::SetBinContent().
+      // Non-virtual, CINT-compatible replacement of a using declaration.
+      THnBase::SetBinContent(idx, v);
+   }
+   void SetBinContent(Long64_t bin, Double_t v);
+   void SetBinError2(Long64_t bin, Double_t e2);
+   void AddBinContent(const Int_t* idx, Double_t v = 1.) {
+      // Forwards to THnBase::AddBinContent().
+      // Non-virtual, CINT-compatible replacement of a using declaration.
+      THnBase::AddBinContent(idx, v);
+   }
+   void AddBinContent(Long64_t bin, Double_t v = 1.) { AddAt(bin, v); }
+   void AddBinError2(Long64_t bin, Double_t e2);
+
+   Double_t GetBinContent(const Int_t *idx) const {
+      // Forwards to THnBase::GetBinContent() overload.
+      // Non-virtual, CINT-compatible replacement of a using declaration.
+      return THnBase::GetBinContent(idx);
+   }
+   Double_t GetBinContent(Long64_t bin, Int_t* idx = 0) const;
+   Double_t GetBinError2(Long64_t linidx) const;
+
+   Double_t GetSparseFractionBins() const;
+
+   void Add(const THnBase* h, Double_t c = 1.);
+   void Add(const TH1* hist, Double_t c = 1.) {
+      // Forwards to THnBase::Add().
+      // Non-virtual, CINT-compatible replacement of a using declaration.
+      THnBase::Add(hist, c);
+   }
+   Long64_t Merge(TCollection* list);
+
+   TH1D*      Projection(Int_t xDim, Option_t* option = "") const{
+      // Forwards to THnBase::Projection().
+      // Non-virtual, as a CINT-compatible replacement of a using
+      // declaration.
+      return THnBase::Projection(xDim, option);
+   }
+
+   TH2D*      Projection(Int_t yDim, Int_t xDim,
+                         Option_t* option = "") const {
+      // Forwards to THnBase::Projection().
+      // Non-virtual, as a CINT-compatible replacement of a using
+      // declaration.
+      return THnBase::Projection(yDim, xDim, option);
+   }
+
+   TH3D*      Projection(Int_t xDim, Int_t yDim, Int_t zDim,
+                         Option_t* option = "") const {
+      // Forwards to THnBase::Projection().
+      // Non-virtual, as a CINT-compatible replacement of a using
+      // declaration.
+      return THnBase::Projection(xDim, yDim, zDim, option);
+   }
+
+   THnHash* Projection(Int_t ndim, const Int_t* dim,
+                       Option_t* option = "") const {
+      return (THnHash*) ProjectionND(ndim, dim, option);
+   }
+
+   THnHash* Rebin(Int_t group) const {
+      return (THnHash*) RebinBase(group);
+   }
+   THnHash* Rebin(const Int_t* group) const {
+      return (THnHash*) RebinBase(group);
+   }
+
+   void Reset(Option_t* option = "");
+   void Sumw2();
+
+   ClassDef(THnHash, 1); // Interfaces of hashed sparse n-dimensional histogram
+};
+
+
+
+//______________________________________________________________________________
+/** \class THnHashT
+ Templated implementation of the abstract base THnHash.
+ All functionality and the interfaces to be used are in THnHash!
+
+ The template parameter is the type of the bin content, which THnHashT
+ stores in a contiguous std::vector.
+
+ Typedefs exist for template parematers with ROOT's generic types:
+
+ Templated name     |    Typedef   |    Bin content type
+ -------------------|--------------|--------------------
+ THnHashT<Char_t>   |  THnHashC    |  Char_t
+ THnHashT<Short_t>  |  THnHashS    |  Short_t
+ THnHashT<Int_t>    |  THnHashI    |  Int_t
+ THnHashT<Long_t>   |  THnHashL    |  Long_t
+ THnHashT<Float_t>  |  THnHashF    |  Float_t
+ THnHashT<Double_t> |  THnHashD    |  Double_t
+*/
+
+
+template <typename T>
+class THnHashT: public THnHash {
+ public:
+   THnHashT() {}
+   THnHashT(const char* name, const char* title, Int_t dim,
+            const Int_t* nbins, const Double_t* xmin = 0,
+            const Double_t* xmax = 0):
+      THnHash(name, title, dim, nbins, xmin, xmax) {}
+
+ protected:
+   Double_t GetAt(Long64_t bin) const { return fContent[bin]; }
+   void SetAt(Long64_t bin, Double_t v) { fContent[bin] = (T) v; }
+   void AddAt(Long64_t bin, Double_t v) { fContent[bin] = (T) (fContent[bin] + v); }
+   void ResizeContent(Long64_t nbins) { fContent.resize(nbins); }
+   void ReserveContent(Long64_t nbins) { fContent.reserve(nbins); }
+
+ private:
+   std::vector<T> fContent; // content of the filled bins
+
+   ClassDef(THnHashT, 1); // Hashed sparse n-dimensional histogram with templated content
+};
+
+typedef THnHashT<Double_t> THnHashD;
+typedef THnHashT<Float_t>  THnHashF;
+typedef THnHashT<Long_t>   THnHashL;
+typedef THnHashT<Int_t>    THnHashI;
+typedef THnHashT<Short_t>  THnHashS;
+typedef THnHashT<Char_t>   THnHashC;
+
+
+#endif //  ROOT_THnHash
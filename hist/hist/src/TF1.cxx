@@ -1344,6 +1344,39 @@ Double_t TF1::Eval(Double_t x, Double_t y, Double_t z, Double_t t) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate function at n points with given parameters.
+///
+/// The coordinates are given per dimension: x[j][i] is the coordinate j
+/// of the point i. The n function values are stored in the array f.
+/// If argument params is 0, the internal values of parameters are used.
+///
+/// Functions defined by a formula are evaluated by TFormula::EvalParBatch,
+/// which evaluates the pre-defined functions (e.g. gaus, expo, polN)
+/// without any call to the interpreter. Other functions are evaluated
+/// point by point with EvalPar. Derived classes re-implementing EvalPar
+/// must re-implement this function too.
+
+void TF1::EvalParBatch(Int_t n, const Double_t *const *x, const Double_t *params, Double_t *f)
+{
+   if (fType == EFType::kFormula) {
+      assert(fFormula);
+      fFormula->EvalParBatch(n, x, params, f);
+      if (fNormalized && fNormIntegral != 0) {
+         for (Int_t i = 0; i < n; ++i)
+            f[i] /= fNormIntegral;
+      }
+      return;
+   }
+
+   std::vector<Double_t> xx(fNdim);
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t j = 0; j < fNdim; ++j)
+         xx[j] = x[j][i];
+      f[i] = EvalPar(xx.data(), params);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Evaluate function with given coordinates and parameters.
 ///
@@ -167,6 +167,15 @@ Double_t TF12::EvalPar(const Double_t *x, const Double_t *params)
    return fF2->EvalPar(xx,params);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate this function at the n points x[0][i], see TF12::EvalPar
+
+void TF12::EvalParBatch(Int_t n, const Double_t *const *x, const Double_t *params, Double_t *f)
+{
+   for (Int_t i = 0; i < n; ++i)
+      f[i] = EvalPar(&x[0][i], params);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Save primitive as a C++ statement(s) on output stream out
@@ -24,8 +24,10 @@
 #include "TInterpreter.h"
 #include "TFormula.h"
 #include "TRegexp.h"
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <unordered_map>
 #include <functional>
@@ -691,6 +693,8 @@ void TFormula::Copy(TObject &obj) const
    }
 
    fnew.fFuncPtr = fFuncPtr;
+   fnew.fGradFuncPtr = fGradFuncPtr;
+   fnew.fGradGenerated = fGradGenerated;
 
 }
 
@@ -705,6 +709,8 @@ void TFormula::Clear(Option_t * )
    fNumber = 0;
    fFormula = "";
    fClingName = "";
+   fGradFuncPtr = nullptr;
+   fGradGenerated = kFALSE;
 
 
    if(fMethod) fMethod->Delete();
@@ -2268,6 +2274,8 @@ void TFormula::ProcessFormula(TString &formula)
 
          fClingInput = TString::Format("%s %s(%s){ return %s ; }", argType.Data(), fClingName.Data(),
                                        argumentsPrototype.Data(), inputFormula.c_str());
+         fGradFuncPtr = nullptr;
+         fGradGenerated = kFALSE;
 
 
          // std::cout << "Input Formula " << inputFormula << " \t vec formula  :  " << inputFormulaVecFlag << std::endl;
@@ -3137,6 +3145,235 @@ ROOT::Double_v TFormula::EvalParVec(const ROOT::Double_v *x, const Double_t *par
 }
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula at n points with the given parameters.
+///
+/// The coordinates are given per dimension: x[j][i] is the coordinate j of
+/// the point i. The n values are stored in the array f. If params is 0 the
+/// parameter values of the formula are used.
+///
+/// The pre-defined one-dimensional functions `gaus`, `expo`, `landau` and
+/// `polN`, when they make up the whole formula, are computed directly in a
+/// loop over the points, which the compiler can vectorize. Vectorized formulae
+/// are evaluated a ROOT::Double_v of points at a time, all the others point
+/// by point.
+
+void TFormula::EvalParBatch(Int_t n, const Double_t *const *x, const Double_t *params, Double_t *f) const
+{
+   const Double_t *p = (params) ? params : fClingParameters.data();
+   const Double_t *x0 = (fNdim > 0) ? x[0] : nullptr;
+   // the number is also set when the function is only a part of the expression (e.g. "gaus+1")
+   const Bool_t isPredefined = fNumber != 0 && fNdim == 1 && fReadyToExecute;
+   if (isPredefined && fNumber == 100 && fNpar == 3 && strcmp(GetTitle(), "gaus") == 0) {
+      const Double_t c = p[0];
+      const Double_t mean = p[1];
+      const Double_t sigma = p[2];
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t t = (x0[i] - mean) / sigma;
+         f[i] = c * std::exp(-0.5 * t * t);
+      }
+      return;
+   }
+   if (isPredefined && fNumber == 200 && fNpar == 2 && strcmp(GetTitle(), "expo") == 0) {
+      const Double_t c = p[0];
+      const Double_t slope = p[1];
+      for (Int_t i = 0; i < n; ++i)
+         f[i] = std::exp(c + slope * x0[i]);
+      return;
+   }
+   if (isPredefined && fNumber == 400 && fNpar == 3 && strcmp(GetTitle(), "landau") == 0) {
+      for (Int_t i = 0; i < n; ++i)
+         f[i] = p[0] * TMath::Landau(x0[i], p[1], p[2], false);
+      return;
+   }
+   if (isPredefined && fNumber >= 300 && fNumber < 400 && fNpar == fNumber - 299 &&
+       TString::Format("pol%d", fNumber - 300) == GetTitle()) {
+      // Horner scheme
+      for (Int_t i = 0; i < n; ++i) {
+         Double_t sum = p[fNpar - 1];
+         for (Int_t k = fNpar - 2; k >= 0; --k)
+            sum = sum * x0[i] + p[k];
+         f[i] = sum;
+      }
+      return;
+   }
+
+#ifdef R__HAS_VECCORE
+   if (fVectorized && fNdim > 0) {
+      const Int_t vecSize = vecCore::VectorSize<ROOT::Double_v>();
+      std::vector<ROOT::Double_v> xvec(fNdim);
+      for (Int_t i0 = 0; i0 < n; i0 += vecSize) {
+         const Int_t m = std::min(vecSize, n - i0);
+         // the missing points of the last vector are filled with the first one
+         for (Int_t j = 0; j < fNdim; ++j)
+            for (Int_t k = 0; k < vecSize; ++k)
+               vecCore::Set(xvec[j], k, x[j][i0 + (k < m ? k : 0)]);
+         ROOT::Double_v ans = DoEvalVec(xvec.data(), params);
+         for (Int_t k = 0; k < m; ++k)
+            f[i0 + k] = vecCore::Get(ans, k);
+      }
+      return;
+   }
+#endif
+
+   std::vector<Double_t> xx(fNdim);
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t j = 0; j < fNdim; ++j)
+         xx[j] = x[j][i];
+      f[i] = EvalPar(xx.data(), params);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the TMath functions called in the C++ expression of a formula with
+/// those of ROOT::Internal::TFormulaDualMath, which can be differentiated.
+/// Return false if the expression uses a function or an operator which cannot
+/// be differentiated.
+
+static Bool_t ReplaceWithDualFunctions(TString &expr)
+{
+   static const std::set<TString> dualFunctions = {"Sin",  "Cos",  "Tan",  "ASin", "ACos",  "ATan", "SinH", "CosH",
+                                                   "TanH", "Exp",  "Log",  "Log10", "Sqrt", "Abs",  "Sq",   "Power"};
+   if (expr.Contains("?"))
+      return false;
+
+   TString result;
+   Ssiz_t copied = 0;
+   for (Ssiz_t pos = expr.Index('('); pos != kNPOS; pos = expr.Index('(', pos + 1)) {
+      Ssiz_t begin = pos;
+      while (begin > 0 && (isalnum(expr[begin - 1]) || expr[begin - 1] == '_' || expr[begin - 1] == ':'))
+         --begin;
+      if (begin == pos)
+         continue;
+      TString name = expr(begin, pos - begin);
+      if (!name.BeginsWith("TMath::"))
+         return false;
+      name.Remove(0, 7);
+      if (dualFunctions.count(name)) {
+         result += expr(copied, begin - copied);
+         result += "ROOT::Internal::TFormulaDualMath::";
+         result += name;
+         copied = pos;
+         continue;
+      }
+      // constants as TMath::Pi() are allowed
+      Ssiz_t next = pos + 1;
+      while (next < expr.Length() && isspace(expr[next]))
+         ++next;
+      if (next == expr.Length() || expr[next] != ')')
+         return false;
+   }
+   result += expr(copied, expr.Length() - copied);
+   expr = result;
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate with Cling the function computing the gradient of the formula with
+/// respect to its parameters.
+///
+/// The C++ expression of the formula is compiled a second time with parameters
+/// of type ROOT::Internal::TFormulaDual, which carry the derivatives with respect
+/// to all the parameters through the operations of the expression (forward mode
+/// automatic differentiation). The function is not generated if the expression
+/// calls functions which cannot be differentiated this way.
+/// Must be called with the gROOTMutex locked.
+
+void TFormula::GenerateGradientPar()
+{
+   if (fGradGenerated)
+      return;
+
+   if (fNpar <= 0 || fVectorized || TestBit(kLambda) || !fReadyToExecute) {
+      fGradGenerated = kTRUE;
+      return;
+   }
+
+   // fClingInput is "Double_t name(Double_t *x,Double_t *p){ return expression ; }"
+   const TString begin = "{ return ";
+   const Ssiz_t first = fClingInput.Index(begin);
+   const Ssiz_t last = fClingInput.Last(';');
+   TString expr;
+   if (first != kNPOS && last != kNPOS && last > first)
+      expr = fClingInput(first + begin.Length(), last - first - begin.Length());
+   if (expr.IsNull() || !ReplaceWithDualFunctions(expr)) {
+      fGradGenerated = kTRUE;
+      return;
+   }
+
+   auto hasher = gClingFunctions.hash_function();
+   TString gradName = TString::Format("%sgrad%d__id%zu", gNamePrefix.Data(), fNpar, hasher(expr.Data()));
+   TString gradInput = TString::Format("#include \"ROOT/TFormulaDual.hxx\"\n"
+                                       "#pragma cling optimize(2)\n"
+                                       "void %s(Double_t *x, Double_t *params, Double_t *grad) {\n"
+                                       "   typedef ROOT::Internal::TFormulaDual<%d> Dual_t;\n"
+                                       "   Dual_t p[%d];\n"
+                                       "   for (unsigned int i = 0; i < %d; ++i)\n"
+                                       "      p[i] = Dual_t::Parameter(params[i], i);\n"
+                                       "   const Dual_t result(%s);\n"
+                                       "   result.GetGradient(grad);\n"
+                                       "}\n",
+                                       gradName.Data(), fNpar, fNpar, fNpar, expr.Data());
+
+   std::string key(gradInput.Data());
+   auto funcit = gClingFunctions.find(key);
+   if (funcit != gClingFunctions.end()) {
+      fGradFuncPtr = (TInterpreter::CallFuncIFacePtr_t::Generic_t)funcit->second;
+      fGradGenerated = kTRUE;
+      return;
+   }
+
+   // make sure the interpreter is initialized
+   ROOT::GetROOT();
+   R__ASSERT(gCling);
+   TInterpreter::CallFuncIFacePtr_t::Generic_t gradFuncPtr = nullptr;
+   if (gCling->Declare(gradInput)) {
+      TMethodCall method;
+      method.InitWithPrototype(gradName, "Double_t*,Double_t*,Double_t*");
+      if (method.IsValid() && gCling->CallFunc_IsValid(method.GetCallFunc()))
+         gradFuncPtr = gCling->CallFunc_IFacePtr(method.GetCallFunc()).fGeneric;
+   }
+   if (!gradFuncPtr)
+      Warning("GenerateGradientPar", "Cannot compile the gradient of the formula %s", GetExpFormula().Data());
+   // a failure is also stored, not to try again for each formula with the same expression
+   gClingFunctions.insert(std::make_pair(key, (void *)gradFuncPtr));
+   fGradFuncPtr = gradFuncPtr;
+   fGradGenerated = kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the gradient of the formula with respect to its parameters at the
+/// point x.
+///
+/// The n = GetNpar() derivatives are stored in the array grad. If params is 0
+/// the parameter values of the formula are used.
+/// The derivatives are exact (up to rounding): the function computing them is
+/// generated with Cling the first time it is needed, by automatic
+/// differentiation of the expression of the formula. It supports the arithmetic
+/// operators, the comparisons and the functions sin, cos, tan, asin, acos, atan,
+/// sinh, cosh, tanh, exp, log, log10, sqrt, abs, sq and pow (hence the pre-defined
+/// functions as gaus, expo and polN). For other formulae, and for lambda or
+/// vectorized formulae, the method returns false and grad is not modified.
+
+Bool_t TFormula::GradientPar(const Double_t *x, Double_t *grad, const Double_t *params) const
+{
+   if (!fGradGenerated) {
+      R__LOCKGUARD(gROOTMutex);
+      const_cast<TFormula *>(this)->GenerateGradientPar();
+   }
+   if (!fGradFuncPtr)
+      return kFALSE;
+
+   void *args[3];
+   Double_t *vars = (x) ? const_cast<Double_t *>(x) : const_cast<Double_t *>(fClingVariables.data());
+   Double_t *pars = (params) ? const_cast<Double_t *>(params) : const_cast<Double_t *>(fClingParameters.data());
+   args[0] = &vars;
+   args[1] = &pars;
+   args[2] = &grad;
+   (*fGradFuncPtr)(0, 3, args, nullptr);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Sets first 4  variables (e.g. x, y, z, t) and evaluate formula.
 
@@ -3378,17 +3378,28 @@ void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride
 ////////////////////////////////////////////////////////////////////////////////
 /// Internal method to fill histogram content from a vector
 /// called directly by TH1::BufferEmpty
+///
+/// The bins of the values are computed kNFillBatch at a time with TAxis::FindFixBins,
+/// unless the axis can be extended, in which case they are looked up one at a time
+/// as in TH1::Fill.
 
 void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
    Int_t bin,i;
+   Int_t bins[kNFillBatch];
 
    fEntries += ntimes;
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
+   const Bool_t extend = fXaxis.CanExtend();
+   Int_t ibatch = kNFillBatch;
    ntimes *= stride;
    for (i=0;i<ntimes;i+=stride) {
-      bin =fXaxis.FindBin(x[i]);
+      if (!extend && ibatch == kNFillBatch) {
+         fXaxis.FindFixBins(TMath::Min(Int_t(kNFillBatch), (ntimes-i-1)/stride+1), &x[i], bins, stride);
+         ibatch = 0;
+      }
+      bin = extend ? fXaxis.FindBin(x[i]) : bins[ibatch++];
       if (bin <0) continue;
       if (w) ww = w[i];
       if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
@@ -3747,6 +3758,9 @@ TFitResultPtr TH1::Fit(const char *fname ,Option_t *option ,Option_t *goption, D
 ///          It uses the IMPROVE command of TMinuit (see TMinuit::mnimpr).
 ///          This algorithm attempts to improve the found local minimum by searching for a
 ///          better one.
+///        - "G"  Use the derivatives of the function with respect to its parameters in the minimization.
+///          They are computed exactly for functions defined by a formula which can be differentiated
+///          (see TFormula::GradientPar), numerically otherwise.
 ///        - "R"  Use the Range specified in the function range
 ///        - "N"  Do not store the graphics function, do not draw
 ///        - "0"  Do not plot the result of the fit. By default the fitted function
@@ -5485,6 +5499,10 @@ Bool_t TH1::RecomputeAxisLimits(TAxis& destAxis, const TAxis& anAxis)
 ///   -NOCHECK:  the histogram will not perform a check for duplicate labels in case of axes with labels. The check
 ///              (enabled by default) slows down the merging
 ///
+/// When all histograms have the same axes and implicit multi-threading is enabled (see ROOT::EnableImplicitMT()),
+/// ranges of bins of large histograms are merged in parallel. Each bin of the result is still the sum of the bins
+/// of the histograms in the order of the list, as in the sequential merge.
+///
 /// IMPORTANT remark. The axis x may have different number
 /// of bins and different limits, BUT the largest bin width must be
 /// a multiple of the smallest bin width and the upper limit must also
@@ -0,0 +1,328 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TH1ConcurrentFill.hxx"
+
+#include "TArrayC.h"
+#include "TArrayD.h"
+#include "TArrayF.h"
+#include "TArrayI.h"
+#include "TArrayS.h"
+#include "TAxis.h"
+#include "TError.h"
+#include "TH1K.h"
+#include "TH2Poly.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+#include "TProfile3D.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/// Replace the value at address with update(value), atomically with respect to the other calls for the same address.
+/// The arrays of the histograms are not made of std::atomic: with GCC and clang, the atomic builtins operate on plain
+/// memory; otherwise, the value is accessed through a std::atomic of the same size, which is lock free for the
+/// fundamental types on the supported platforms.
+template <typename T, typename F>
+void AtomicUpdate(T *address, F update)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   T expected;
+   __atomic_load(address, &expected, __ATOMIC_RELAXED);
+   T desired = update(expected);
+   while (!__atomic_compare_exchange(address, &expected, &desired, /*weak=*/true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+      desired = update(expected);
+#else
+   static_assert(sizeof(std::atomic<T>) == sizeof(T), "std::atomic<T> does not have the layout of T");
+   auto atomic = reinterpret_cast<std::atomic<T> *>(address);
+   T expected = atomic->load(std::memory_order_relaxed);
+   while (!atomic->compare_exchange_weak(expected, update(expected), std::memory_order_relaxed))
+      ;
+#endif
+}
+
+void AtomicAdd(Double_t *address, Double_t w)
+{
+   AtomicUpdate(address, [w](Double_t v) { return v + w; });
+}
+
+void AtomicAdd(Float_t *address, Double_t w)
+{
+   AtomicUpdate(address, [w](Float_t v) { return Float_t(v + w); });
+}
+
+/// Add w to the value at address, saturating at +-max as TH1C, TH1S and TH1I::AddBinContent do
+template <typename T, typename Sum_t>
+void AtomicAddSaturated(T *address, Double_t w, Sum_t max)
+{
+   AtomicUpdate(address, [w, max](T v) {
+      const Sum_t newval = v + Sum_t(w);
+      if (newval < -max)
+         return T(-max);
+      if (newval > max)
+         return T(max);
+      return T(newval);
+   });
+}
+
+/// Read the sums of weights of the histogram as they are stored. When an axis range is set, TH1::GetStats returns
+/// the statistics of the bins in range instead: writing them back with PutStats would lose the fills out of range.
+void GetStoredStats(TH1 &hist, Double_t *stats)
+{
+   TAxis *axes[3] = {hist.GetXaxis(), hist.GetYaxis(), hist.GetZaxis()};
+   Bool_t hasRange[3];
+   for (Int_t i = 0; i < 3; ++i) {
+      hasRange[i] = axes[i]->TestBit(TAxis::kAxisRange);
+      axes[i]->ResetBit(TAxis::kAxisRange);
+   }
+   hist.GetStats(stats);
+   for (Int_t i = 0; i < 3; ++i)
+      axes[i]->SetBit(TAxis::kAxisRange, hasRange[i]);
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare the histogram for concurrent fills: throws std::runtime_error if it cannot be filled concurrently.
+
+ROOT::TH1ConcurrentFillManager::TH1ConcurrentFillManager(TH1 &hist) : fHist(hist)
+{
+   const std::string name = hist.GetName();
+   if (hist.InheritsFrom(TProfile::Class()) || hist.InheritsFrom(TProfile2D::Class()) ||
+       hist.InheritsFrom(TProfile3D::Class()) || hist.InheritsFrom(TH2Poly::Class()) ||
+       hist.InheritsFrom(TH1K::Class()))
+      throw std::runtime_error("Histogram " + name + " of class " + hist.ClassName() +
+                               " cannot be filled concurrently.");
+
+   fDimension = hist.GetDimension();
+   fAxes[0] = hist.GetXaxis();
+   fAxes[1] = hist.GetYaxis();
+   fAxes[2] = hist.GetZaxis();
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (fAxes[i]->CanExtend())
+         throw std::runtime_error("The axes of histogram " + name +
+                                  " can be extended: call SetCanExtend(TH1::kNoAxis) to fill it concurrently.");
+   }
+
+   // the fills are done on bins: the buffer must be emptied now, and the axes it may compute must be usable
+   if (hist.GetBuffer()) {
+      hist.BufferEmpty(1);
+      for (Int_t i = 0; i < fDimension; ++i) {
+         if (fAxes[i]->GetXmin() >= fAxes[i]->GetXmax())
+            throw std::runtime_error("The axis limits of histogram " + name +
+                                     " cannot be computed from its buffer, which is empty.");
+      }
+   }
+
+   if (auto array = dynamic_cast<TArrayD *>(&hist)) {
+      fContentType = EContentType::kDouble;
+      fContent = array->GetArray();
+   } else if (auto arrayF = dynamic_cast<TArrayF *>(&hist)) {
+      fContentType = EContentType::kFloat;
+      fContent = arrayF->GetArray();
+   } else if (auto arrayI = dynamic_cast<TArrayI *>(&hist)) {
+      fContentType = EContentType::kInt;
+      fContent = arrayI->GetArray();
+   } else if (auto arrayS = dynamic_cast<TArrayS *>(&hist)) {
+      fContentType = EContentType::kShort;
+      fContent = arrayS->GetArray();
+   } else if (auto arrayC = dynamic_cast<TArrayC *>(&hist)) {
+      fContentType = EContentType::kChar;
+      fContent = arrayC->GetArray();
+   } else {
+      throw std::runtime_error("Histogram " + name + " of class " + hist.ClassName() +
+                               " does not store its bin contents in a TArray and cannot be filled concurrently.");
+   }
+
+   if (hist.GetSumw2N())
+      fSumw2 = hist.GetSumw2()->GetArray();
+   fIsNotW = hist.TestBit(TH1::kIsNotW);
+
+   fStatOverflows = hist.GetStatOverflowsBehaviour();
+   std::fill(fStats, fStats + TH1::kNstat, 0.);
+   GetStoredStats(hist, fStats);
+   fEntries = hist.GetEntries();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a filler, to be used by a single thread.
+
+ROOT::TH1ConcurrentFiller ROOT::TH1ConcurrentFillManager::MakeFiller()
+{
+   return TH1ConcurrentFiller(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add w to the content of the bin, and w*w to its sum of squares of weights.
+
+void ROOT::TH1ConcurrentFillManager::AddToBin(Int_t bin, Double_t w)
+{
+   if (fSumw2)
+      AtomicAdd(fSumw2 + bin, w * w);
+   else if (w != 1. && !fIsNotW && !fWarnedSumw2.exchange(true))
+      ::Warning("TH1ConcurrentFiller::Fill",
+                "Weighted fill of histogram %s, which does not store the sums of squares of weights: call Sumw2() "
+                "before creating the TH1ConcurrentFillManager to get correct bin errors",
+                fHist.GetName());
+   switch (fContentType) {
+   case EContentType::kDouble: AtomicAdd(static_cast<Double_t *>(fContent) + bin, w); break;
+   case EContentType::kFloat: AtomicAdd(static_cast<Float_t *>(fContent) + bin, w); break;
+   case EContentType::kInt: AtomicAddSaturated(static_cast<Int_t *>(fContent) + bin, w, Long64_t(2147483647)); break;
+   case EContentType::kShort: AtomicAddSaturated(static_cast<Short_t *>(fContent) + bin, w, Int_t(32767)); break;
+   case EContentType::kChar: AtomicAddSaturated(static_cast<Char_t *>(fContent) + bin, w, Int_t(127)); break;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the statistics of the fills of a filler to the sums of weights stored in the histogram.
+
+void ROOT::TH1ConcurrentFillManager::AddStats(const Double_t *stats, Double_t entries)
+{
+   std::lock_guard<std::mutex> lock(fStatsMutex);
+   for (Int_t i = 0; i < TH1::kNstat; ++i)
+      fStats[i] += stats[i];
+   fEntries += entries;
+   fHist.PutStats(fStats);
+   fHist.SetEntries(fEntries);
+}
+
+ROOT::TH1ConcurrentFiller::TH1ConcurrentFiller(TH1ConcurrentFiller &&other)
+   : fManager(other.fManager), fEntries(other.fEntries)
+{
+   std::copy(other.fStats, other.fStats + TH1::kNstat, fStats);
+   std::fill(other.fStats, other.fStats + TH1::kNstat, 0.);
+   other.fEntries = 0.;
+}
+
+void ROOT::TH1ConcurrentFiller::Flush()
+{
+   if (fEntries == 0.)
+      return;
+   fManager->AddStats(fStats, fEntries);
+   std::fill(fStats, fStats + TH1::kNstat, 0.);
+   fEntries = 0.;
+}
+
+Int_t ROOT::TH1ConcurrentFiller::Fill1D(Double_t x, Double_t w)
+{
+   const TAxis &xaxis = *fManager->fAxes[0];
+   fEntries++;
+   const Int_t bin = xaxis.FindFixBin(x);
+   fManager->AddToBin(bin, w);
+   if ((bin == 0 || bin > xaxis.GetNbins()) && !fManager->fStatOverflows)
+      return -1;
+   fStats[0] += w;
+   fStats[1] += w * w;
+   fStats[2] += w * x;
+   fStats[3] += w * x * x;
+   return bin;
+}
+
+Int_t ROOT::TH1ConcurrentFiller::Fill2D(Double_t x, Double_t y, Double_t w)
+{
+   const TAxis &xaxis = *fManager->fAxes[0];
+   const TAxis &yaxis = *fManager->fAxes[1];
+   fEntries++;
+   const Int_t binx = xaxis.FindFixBin(x);
+   const Int_t biny = yaxis.FindFixBin(y);
+   const Int_t bin = binx + (xaxis.GetNbins() + 2) * biny;
+   fManager->AddToBin(bin, w);
+   if ((binx == 0 || binx > xaxis.GetNbins() || biny == 0 || biny > yaxis.GetNbins()) &&
+       !fManager->fStatOverflows)
+      return -1;
+   fStats[0] += w;
+   fStats[1] += w * w;
+   fStats[2] += w * x;
+   fStats[3] += w * x * x;
+   fStats[4] += w * y;
+   fStats[5] += w * y * y;
+   fStats[6] += w * x * y;
+   return bin;
+}
+
+Int_t ROOT::TH1ConcurrentFiller::Fill3D(Double_t x, Double_t y, Double_t z, Double_t w)
+{
+   const TAxis &xaxis = *fManager->fAxes[0];
+   const TAxis &yaxis = *fManager->fAxes[1];
+   const TAxis &zaxis = *fManager->fAxes[2];
+   fEntries++;
+   const Int_t binx = xaxis.FindFixBin(x);
+   const Int_t biny = yaxis.FindFixBin(y);
+   const Int_t binz = zaxis.FindFixBin(z);
+   const Int_t bin = binx + (xaxis.GetNbins() + 2) * (biny + (yaxis.GetNbins() + 2) * binz);
+   fManager->AddToBin(bin, w);
+   if ((binx == 0 || binx > xaxis.GetNbins() || biny == 0 || biny > yaxis.GetNbins() || binz == 0 ||
+        binz > zaxis.GetNbins()) &&
+       !fManager->fStatOverflows)
+      return -1;
+   fStats[0] += w;
+   fStats[1] += w * w;
+   fStats[2] += w * x;
+   fStats[3] += w * x * x;
+   fStats[4] += w * y;
+   fStats[5] += w * y * y;
+   fStats[6] += w * x * y;
+   fStats[7] += w * z;
+   fStats[8] += w * z * z;
+   fStats[9] += w * x * z;
+   fStats[10] += w * y * z;
+   return bin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 1D histogram with weight 1.
+
+Int_t ROOT::TH1ConcurrentFiller::Fill(Double_t x)
+{
+   if (fManager->fDimension != 1) {
+      ::Error("TH1ConcurrentFiller::Fill", "Invalid signature - do nothing");
+      return -1;
+   }
+   return Fill1D(x, 1.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 1D histogram at x with weight w, or a 2D histogram at (x, w) with weight 1.
+
+Int_t ROOT::TH1ConcurrentFiller::Fill(Double_t x, Double_t w)
+{
+   if (fManager->fDimension == 1)
+      return Fill1D(x, w);
+   if (fManager->fDimension == 2)
+      return Fill2D(x, w, 1.);
+   ::Error("TH1ConcurrentFiller::Fill", "Invalid signature - do nothing");
+   return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 2D histogram at (x, y) with weight w, or a 3D histogram at (x, y, w) with weight 1.
+
+Int_t ROOT::TH1ConcurrentFiller::Fill(Double_t x, Double_t y, Double_t w)
+{
+   if (fManager->fDimension == 2)
+      return Fill2D(x, y, w);
+   if (fManager->fDimension == 3)
+      return Fill3D(x, y, w, 1.);
+   ::Error("TH1ConcurrentFiller::Fill", "Invalid signature - do nothing");
+   return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3D histogram at (x, y, z) with weight w.
+
+Int_t ROOT::TH1ConcurrentFiller::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
+{
+   if (fManager->fDimension != 3) {
+      ::Error("TH1ConcurrentFiller::Fill", "Invalid signature - do nothing");
+      return -1;
+   }
+   return Fill3D(x, y, z, w);
+}
@@ -8,9 +8,16 @@
 #include "TError.h"
 #include "THashList.h"
 #include "TClass.h"
+#include "TROOT.h"
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 #include <iostream>
 #include <limits>
 #include <utility>
+#include <vector>
 
 #define PRINTRANGE(a, b, bn)                                                                                          \
    Printf(" base: %f %f %d, %s: %f %f %d", a->GetXmin(), a->GetXmax(), a->GetNbins(), bn, b->GetXmin(), b->GetXmax(), \
@@ -751,6 +758,7 @@ Bool_t TH1Merger::SameAxesMerge() {
    fH0->GetStats(totstats);
    Double_t nentries = fH0->GetEntries();
    
+   std::vector<const TH1 *> hists;
    TIter next(&fInputList); 
    while (TH1* hist=(TH1*)next()) {
       // process only if the histogram has limits; otherwise it was processed before
@@ -767,20 +775,45 @@ Bool_t TH1Merger::SameAxesMerge() {
       for (Int_t i=0; i<TH1::kNstat; i++)
          totstats[i] += stats[i];
       nentries += hist->GetEntries();
+      hists.push_back(hist);
+   }
 
-         //Int_t nx = hist->GetXaxis()->GetNbins();
-         // loop on bins of the histogram and do the merge
-      for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
-
-         Double_t cu = hist->RetrieveBinContent(ibin);
-         Double_t e1sq = TMath::Abs(cu);
-         if (fH0->fSumw2.fN) e1sq= hist->GetBinErrorSqUnchecked(ibin);
+   // loop on bins of the histograms and do the merge; the bins of the merged
+   // histogram are summed in the order of the list, whatever the bin ranges
+   const Bool_t haveSumw2 = fH0->fSumw2.fN;
+   auto mergeBins = [&](Int_t firstBin, Int_t lastBin) {
+      for (const TH1 *hist : hists) {
+         for (Int_t ibin = firstBin; ibin < lastBin; ibin++) {
 
-         fH0->AddBinContent(ibin,cu);
-         if (fH0->fSumw2.fN) fH0->fSumw2.fArray[ibin] += e1sq;
+            Double_t cu = hist->RetrieveBinContent(ibin);
+            Double_t e1sq = TMath::Abs(cu);
+            if (haveSumw2) e1sq= hist->GetBinErrorSqUnchecked(ibin);
 
+            fH0->AddBinContent(ibin,cu);
+            if (haveSumw2) fH0->fSumw2.fArray[ibin] += e1sq;
+         }
       }
+   };
+
+   const Int_t ncells = fH0->fNcells;
+   Int_t nranges = 1;
+#ifdef R__USE_IMT
+   // merge ranges of bins in parallel, large enough for the tasks to outweigh their scheduling
+   const Long64_t kMinRangeSize = 1 << 16;
+   if (ROOT::IsImplicitMTEnabled() && hists.size() * Long64_t(ncells) >= 2 * kMinRangeSize)
+      nranges = TMath::Min(Long64_t(4 * ROOT::GetImplicitMTPoolSize()),
+                           TMath::Max(Long64_t(ncells) * Long64_t(hists.size()) / kMinRangeSize, 1LL));
+   nranges = TMath::Min(nranges, ncells);
+   if (nranges > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Int_t irange) {
+         mergeBins(Long64_t(ncells) * irange / nranges, Long64_t(ncells) * (irange + 1) / nranges);
+      }, ROOT::TSeq<Int_t>(nranges));
    }
+#endif
+   if (nranges == 1)
+      mergeBins(0, ncells);
+
    //copy merged stats
    fH0->PutStats(totstats);
    fH0->SetEntries(nentries);
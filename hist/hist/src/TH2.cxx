@@ -551,11 +551,23 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
          return;
    }
 
+   // the bins are computed kNFillBatch at a time, unless the axis can be extended by the fills
+   Int_t binsx[kNFillBatch], binsy[kNFillBatch];
+   const Bool_t extendx = fXaxis.CanExtend();
+   const Bool_t extendy = fYaxis.CanExtend();
+   Int_t ibatch = kNFillBatch;
    Double_t ww = 1;
    for (i=ifirst;i<ntimes;i+=stride) {
+      if (ibatch == kNFillBatch) {
+         const Int_t nbatch = TMath::Min(Int_t(kNFillBatch), (ntimes-i-1)/stride+1);
+         if (!extendx) fXaxis.FindFixBins(nbatch, &x[i], binsx, stride);
+         if (!extendy) fYaxis.FindFixBins(nbatch, &y[i], binsy, stride);
+         ibatch = 0;
+      }
       fEntries++;
-      binx = fXaxis.FindBin(x[i]);
-      biny = fYaxis.FindBin(y[i]);
+      binx = extendx ? fXaxis.FindBin(x[i]) : binsx[ibatch];
+      biny = extendy ? fYaxis.FindBin(y[i]) : binsy[ibatch];
+      ++ibatch;
       if (binx <0 || biny <0) continue;
       bin  = biny*(fXaxis.GetNbins()+2) + binx;
       if (w) ww = w[i];
@@ -382,6 +382,92 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill this histogram with arrays x, y, z and weights w.
+///
+///  - ntimes:  number of entries in arrays x, y, z and w (array size must be ntimes*stride)
+///  - x, y, z: arrays of coordinates to be histogrammed
+///  - w:       array of weights
+///  - stride:  step size through arrays x, y, z and w
+///
+/// If the weight is not equal to 1, the storage of the sum of squares of
+/// weights is automatically triggered and the sum of the squares of weights is incremented
+/// by w[i]^2 in the cell corresponding to x[i],y[i],z[i].
+/// If w is NULL each entry is assumed a weight=1
+///
+/// This is equivalent to calling Fill for each entry, but the bins of the coordinates are
+/// computed many at a time by TAxis::FindFixBins.
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   Int_t binx, biny, binz, bin, i;
+   ntimes *= stride;
+   Int_t ifirst = 0;
+
+   //If a buffer is activated, fill buffer
+   if (fBuffer) {
+      for (i=0;i<ntimes;i+=stride) {
+         if (!fBuffer) break; // buffer can be deleted in BufferFill when is empty
+         if (w) BufferFill(x[i],y[i],z[i],w[i]);
+         else BufferFill(x[i], y[i], z[i], 1.);
+      }
+      // fill the remaining entries if the buffer has been deleted
+      if (i < ntimes && fBuffer==0)
+         ifirst = i;
+      else
+         return;
+   }
+
+   // the bins are computed kNFillBatch at a time, unless the axis can be extended by the fills
+   Int_t binsx[kNFillBatch], binsy[kNFillBatch], binsz[kNFillBatch];
+   const Bool_t extendx = fXaxis.CanExtend();
+   const Bool_t extendy = fYaxis.CanExtend();
+   const Bool_t extendz = fZaxis.CanExtend();
+   Int_t ibatch = kNFillBatch;
+   Double_t ww = 1;
+   for (i=ifirst;i<ntimes;i+=stride) {
+      if (ibatch == kNFillBatch) {
+         const Int_t nbatch = TMath::Min(Int_t(kNFillBatch), (ntimes-i-1)/stride+1);
+         if (!extendx) fXaxis.FindFixBins(nbatch, &x[i], binsx, stride);
+         if (!extendy) fYaxis.FindFixBins(nbatch, &y[i], binsy, stride);
+         if (!extendz) fZaxis.FindFixBins(nbatch, &z[i], binsz, stride);
+         ibatch = 0;
+      }
+      fEntries++;
+      binx = extendx ? fXaxis.FindBin(x[i]) : binsx[ibatch];
+      biny = extendy ? fYaxis.FindBin(y[i]) : binsy[ibatch];
+      binz = extendz ? fZaxis.FindBin(z[i]) : binsz[ibatch];
+      ++ibatch;
+      if (binx <0 || biny <0 || binz<0) continue;
+      bin  =  binx + (fXaxis.GetNbins()+2)*(biny + (fYaxis.GetNbins()+2)*binz);
+      if (w) ww = w[i];
+      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+      if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+      AddBinContent(bin,ww);
+      if (binx == 0 || binx > fXaxis.GetNbins()) {
+         if (!GetStatOverflowsBehaviour()) continue;
+      }
+      if (biny == 0 || biny > fYaxis.GetNbins()) {
+         if (!GetStatOverflowsBehaviour()) continue;
+      }
+      if (binz == 0 || binz > fZaxis.GetNbins()) {
+         if (!GetStatOverflowsBehaviour()) continue;
+      }
+      fTsumw   += ww;
+      fTsumw2  += ww*ww;
+      fTsumwx  += ww*x[i];
+      fTsumwx2 += ww*x[i]*x[i];
+      fTsumwy  += ww*y[i];
+      fTsumwy2 += ww*y[i]*y[i];
+      fTsumwxy += ww*x[i]*y[i];
+      fTsumwz  += ww*z[i];
+      fTsumwz2 += ww*z[i]*z[i];
+      fTsumwxz += ww*x[i]*z[i];
+      fTsumwyz += ww*y[i]*z[i];
+   }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment cell defined by namex,namey,namez by a weight w
 ///
@@ -0,0 +1,767 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "THnHash.h"
+
+#include "RConfigure.h"
+#include "TAxis.h"
+#include "TCollection.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+//______________________________________________________________________________
+//
+// THnHashBinIter iterates over all filled bins of a THnHash.
+//______________________________________________________________________________
+
+   class THnHashBinIter: public ROOT::Internal::THnBaseBinIter {
+   public:
+      THnHashBinIter(Bool_t respectAxisRange, const THnHash* hist):
+         ROOT::Internal::THnBaseBinIter(respectAxisRange), fHist(hist),
+         fIndex(-1) {
+         // Construct a THnHashBinIter
+         fCoord = new Int_t[hist->GetNdimensions()];
+         fCoord[0] = -1;
+      }
+      virtual ~THnHashBinIter() { delete [] fCoord; }
+
+      virtual Int_t GetCoord(Int_t dim) const;
+      virtual Long64_t Next(Int_t* coord = 0);
+
+   private:
+      THnHashBinIter(const THnHashBinIter&); // intentionally unimplemented
+      THnHashBinIter& operator=(const THnHashBinIter&); // intentionally unimplemented
+
+      const THnHash* fHist;
+      Int_t* fCoord; // coord buffer for fIndex; fCoord[0] == -1 if not yet calculated
+      Long64_t fIndex; // current bin index
+   };
+
+   // Smallest hash table, as a power of 2.
+   const Int_t kMinTableBits = 4;
+
+   // Minimal number of bins for which Add() and Merge() run in parallel.
+   const Long64_t kMinParallelBins = 1 << 16;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Finalizer of MurmurHash3: a bijection of the 64 bit integers that spreads
+   /// each input bit over the whole output.
+
+   inline ULong64_t MixBits(ULong64_t h)
+   {
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      h *= 0xc4ceb9fe1a85ec53ULL;
+      h ^= h >> 33;
+      return h;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Hash of the compact coordinates "key" of "nwords" words. For a single word
+   /// keys and hashes are in one to one correspondence.
+
+   inline ULong64_t HashKey(const ULong64_t* key, Int_t nwords)
+   {
+      ULong64_t h = 0;
+      for (Int_t w = 0; w < nwords; ++w)
+         h = MixBits(h ^ key[w]);
+      return h;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Find the slot of the hash table "table" of 2^bits slots holding a bin with
+   /// hash "hash" for which same(bin) is true, or the empty slot where such a
+   /// bin would be inserted. The table is probed linearly, starting at the slot
+   /// given by the top bits of the hash.
+
+   template <class SAME>
+   inline ULong64_t FindSlot(const ULong64_t* table, Int_t bits, ULong64_t hash, SAME same)
+   {
+      const ULong64_t mask = (1ULL << bits) - 1;
+      ULong64_t slot = hash >> (64 - bits);
+      while (table[2 * slot + 1]) {
+         if (table[2 * slot] == hash && same(table[2 * slot + 1] - 1))
+            return slot;
+         slot = (slot + 1) & mask;
+      }
+      return slot;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Insert bin "bin" with hash "hash" into the hash table; the bin must not
+   /// be in the table yet.
+
+   inline void InsertSlot(ULong64_t* table, Int_t bits, ULong64_t hash, Long64_t bin)
+   {
+      const ULong64_t slot = FindSlot(table, bits, hash, [](Long64_t) { return false; });
+      table[2 * slot] = hash;
+      table[2 * slot + 1] = bin + 1;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Number of bits of the hash table needed for "nbins" bins at a load factor
+   /// of at most 1/2.
+
+   inline Int_t GetTableBits(Long64_t nbins)
+   {
+      Int_t bits = kMinTableBits;
+      while ((1LL << bits) < 2 * nbins)
+         ++bits;
+      return bits;
+   }
+
+//______________________________________________________________________________
+//
+// THnHashNewBins collects the bins of a partition of the hash space that
+// Add() or Merge() do not find in the target histogram.
+//______________________________________________________________________________
+
+   class THnHashNewBins {
+   public:
+      THnHashNewBins(): fKeyWords(0), fTableBits(0) {}
+
+      void Add(const ULong64_t* key, Int_t nwords, ULong64_t hash, Double_t v, Double_t e2);
+
+      Long64_t GetNbins() const { return fHashes.size(); }
+      const ULong64_t* GetKey(Long64_t bin) const { return fKeys.data() + bin * fKeyWords; }
+      ULong64_t GetHash(Long64_t bin) const { return fHashes[bin]; }
+      Double_t GetContent(Long64_t bin) const { return fContent[bin]; }
+      Double_t GetError2(Long64_t bin) const { return fSumw2[bin]; }
+
+   private:
+      Int_t fKeyWords;
+      std::vector<ULong64_t> fKeys;
+      std::vector<ULong64_t> fHashes;
+      std::vector<Double_t> fContent;
+      std::vector<Double_t> fSumw2;
+      std::vector<ULong64_t> fTable;
+      Int_t fTableBits;
+   };
+}
+
+Int_t THnHashBinIter::GetCoord(Int_t dim) const
+{
+   if (fCoord[0] == -1) {
+      fHist->GetBinContent(fIndex, fCoord);
+   }
+   return fCoord[dim];
+}
+
+Long64_t THnHashBinIter::Next(Int_t* coord /*= 0*/)
+{
+   // Get next bin index (in range if RespectsAxisRange()).
+   // If coords != 0, set it to the index's axis coordinates
+   // (i.e. coord must point to an array of Int_t[fNdimension]
+   if (!fHist) return -1;
+
+   fCoord[0] = -1;
+   Int_t* useCoordBuf = fCoord;
+   if (coord) {
+      useCoordBuf = coord;
+      coord[0] = -1;
+   }
+
+   do {
+      ++fIndex;
+      if (fIndex >= fHist->GetNbins()) {
+         fHist = 0;
+         return -1;
+      }
+      if (RespectsAxisRange()) {
+         fHist->GetBinContent(fIndex, useCoordBuf);
+      }
+   } while (RespectsAxisRange()
+            && !fHist->IsInRange(useCoordBuf)
+            && (fHaveSkippedBin = kTRUE /* assignment! */));
+
+   if (coord && coord[0] == -1) {
+      if (fCoord[0] == -1) {
+         fHist->GetBinContent(fIndex, coord);
+      } else {
+         memcpy(coord, fCoord, fHist->GetNdimensions() * sizeof(Int_t));
+      }
+   }
+
+   return fIndex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add "v" and "e2" to the content and error of the bin with compact
+/// coordinates "key", allocating it if needed.
+
+void THnHashNewBins::Add(const ULong64_t* key, Int_t nwords, ULong64_t hash, Double_t v, Double_t e2)
+{
+   fKeyWords = nwords;
+   if (fTable.empty() || 2 * (GetNbins() + 1) > (1LL << fTableBits)) {
+      fTableBits = GetTableBits(GetNbins() + 1);
+      fTable.assign(2ULL << fTableBits, 0);
+      for (Long64_t bin = 0; bin < GetNbins(); ++bin)
+         InsertSlot(fTable.data(), fTableBits, fHashes[bin], bin);
+   }
+   const ULong64_t slot = FindSlot(fTable.data(), fTableBits, hash, [&](Long64_t bin) {
+      return nwords == 1 || !memcmp(GetKey(bin), key, nwords * sizeof(ULong64_t));
+   });
+   if (fTable[2 * slot + 1]) {
+      const Long64_t bin = fTable[2 * slot + 1] - 1;
+      fContent[bin] += v;
+      fSumw2[bin] += e2;
+      return;
+   }
+   fTable[2 * slot] = hash;
+   fTable[2 * slot + 1] = GetNbins() + 1;
+   fKeys.insert(fKeys.end(), key, key + nwords);
+   fHashes.push_back(hash);
+   fContent.push_back(v);
+   fSumw2.push_back(e2);
+}
+
+
+/** \class THnHash
+    \ingroup Hist
+
+Multidimensional histogram for sparse distributions, with the filled bins
+stored in contiguous arrays.
+
+THnHash is an alternative to THnSparse with the same interface: only the
+bins with non-zero content take memory. Use it for large histograms that
+are filled, added and merged often; THnSparse remains the better choice
+when many files written with it must be read.
+
+To construct a THnHash object you must use one of its templated, derived
+classes:
+- THnHashD (typedef for THnHashT<Double_t>): bin content held by a Double_t,
+- THnHashF (typedef for THnHashT<Float_t>): bin content held by a Float_t,
+- THnHashL (typedef for THnHashT<Long_t>): bin content held by a Long_t,
+- THnHashI (typedef for THnHashT<Int_t>): bin content held by an Int_t,
+- THnHashS (typedef for THnHashT<Short_t>): bin content held by a Short_t,
+- THnHashC (typedef for THnHashT<Char_t>): bin content held by a Char_t,
+
+They take the same constructor arguments as a THnSparse, except the chunk
+size:
+
+    Int_t bins[2] = {10, 20};
+    Double_t xmin[2] = {0., -5.};
+    Double_t xmax[2] = {10., 5.};
+    THnHashD hh("hh", "hh", 2, bins, xmin, xmax);
+
+## Internal Representation
+The filled bins are numbered in the order in which they are allocated.
+Their content, their sum of squared weights and their compact coordinates
+(each axis index using as few bits as its number of bins requires, packed
+into 64 bit words) are stored in three contiguous arrays indexed by the
+bin number; only those are written to file.
+
+GetBin() finds the bin number of a coordinate in a transient hash table,
+built again when needed after reading: an open addressing table with
+linear probing, holding the hash of the compact coordinates and the bin
+number in each slot, and never more than half full. A lookup hence mostly
+touches a single cache line of the table.
+
+## Adding and Merging
+Add() and Merge() of THnHash objects with the same binning walk the hash
+tables of the added histograms directly. With implicit multi-threading
+enabled (see ROOT::EnableImplicitMT()) and large enough histograms, the
+hash space is split into partitions that are added in parallel, each
+task touching only the bins of its own partition; the bins missing in the
+target histogram are then allocated in partition order. The numbering of
+the filled bins can thus depend on the number of threads, their contents
+do not.
+*/
+
+
+ClassImp(THnHash);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Construct an empty THnHash.
+
+THnHash::THnHash():
+   fKeyWords(0), fTableBits(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Construct a THnHash with "dim" dimensions.
+/// "nbins" holds the number of bins for each dimension;
+/// "xmin" and "xmax" the minimal and maximal value for each dimension.
+/// The arrays "xmin" and "xmax" can be NULL; in that case SetBinEdges()
+/// must be called for each dimension.
+
+THnHash::THnHash(const char* name, const char* title, Int_t dim,
+                 const Int_t* nbins, const Double_t* xmin, const Double_t* xmax):
+   THnBase(name, title, dim, nbins, xmin, xmax),
+   fKeyWords(0), fTableBits(0)
+{
+   InitKeyLayout();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destruct a THnHash
+
+THnHash::~THnHash()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Initialize the storage of a histogram created via Init()
+
+void THnHash::InitStorage(Int_t* /*nbins*/, Int_t /*chunkSize*/)
+{
+   fKeyWords = 0;
+   fTable.clear();
+   InitKeyLayout();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Determine where each axis index is stored in the compact coordinates:
+/// each uses as many bits as needed for its number of bins plus overflow,
+/// and no index straddles two words.
+
+void THnHash::InitKeyLayout() const
+{
+   fKeyLayout.resize(3 * fNdimensions);
+   Int_t word = 0;
+   Int_t shift = 0;
+   for (Int_t d = 0; d < fNdimensions; ++d) {
+      Int_t n = GetAxis(d)->GetNbins() + 1;
+      Int_t nbits = 1;
+      while (n /= 2) ++nbits;
+      if (shift + nbits > 64) {
+         ++word;
+         shift = 0;
+      }
+      fKeyLayout[3 * d] = word;
+      fKeyLayout[3 * d + 1] = shift;
+      fKeyLayout[3 * d + 2] = nbits;
+      shift += nbits;
+   }
+   fKeyWords = word + 1;
+   fKeyBuf.resize(fKeyWords);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set fKeyBuf to the compact coordinates of "coord" and return their hash.
+
+ULong64_t THnHash::SetKeyFromCoord(const Int_t* coord) const
+{
+   const Int_t nwords = GetKeyWords();
+   for (Int_t w = 0; w < nwords; ++w)
+      fKeyBuf[w] = 0;
+   for (Int_t d = 0; d < fNdimensions; ++d)
+      fKeyBuf[fKeyLayout[3 * d]] |= ((ULong64_t) coord[d]) << fKeyLayout[3 * d + 1];
+   return HashKey(fKeyBuf.data(), nwords);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set "coord" to the axis indexes of the compact coordinates "key".
+
+void THnHash::SetCoordFromKey(const ULong64_t* key, Int_t* coord) const
+{
+   for (Int_t d = 0; d < fNdimensions; ++d) {
+      const ULong64_t mask = (1ULL << fKeyLayout[3 * d + 2]) - 1;
+      coord[d] = (Int_t) ((key[fKeyLayout[3 * d]] >> fKeyLayout[3 * d + 1]) & mask);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// We have been streamed, or are about to be filled: set up fTable
+
+void THnHash::BuildTable() const
+{
+   ReserveTable(GetNbins());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make the hash table large enough for "nbins" filled bins.
+
+void THnHash::ReserveTable(Long64_t nbins) const
+{
+   const Int_t bits = GetTableBits(nbins);
+   if (!fTable.empty() && bits <= fTableBits)
+      return;
+
+   std::vector<ULong64_t> table(2ULL << bits, 0);
+   if (fTable.empty()) {
+      const Int_t nwords = GetKeyWords();
+      const Long64_t nfilled = GetNbins();
+      for (Long64_t bin = 0; bin < nfilled; ++bin)
+         InsertSlot(table.data(), bits, HashKey(GetKey(bin), nwords), bin);
+   } else {
+      const ULong64_t nslots = 1ULL << fTableBits;
+      for (ULong64_t slot = 0; slot < nslots; ++slot)
+         if (fTable[2 * slot + 1])
+            InsertSlot(table.data(), bits, fTable[2 * slot], fTable[2 * slot + 1] - 1);
+   }
+   fTable.swap(table);
+   fTableBits = bits;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the bin with compact coordinates "key" of hash "hash",
+/// or -1 if it is not filled.
+
+Long64_t THnHash::FindBin(const ULong64_t* key, ULong64_t hash) const
+{
+   if (fTable.empty())
+      BuildTable();
+   const Int_t nwords = GetKeyWords();
+   const ULong64_t slot = FindSlot(fTable.data(), fTableBits, hash, [&](Long64_t bin) {
+      return nwords == 1 || !memcmp(GetKey(bin), key, nwords * sizeof(ULong64_t));
+   });
+   return (Long64_t) fTable[2 * slot + 1] - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate a bin with compact coordinates "key" of hash "hash", which must
+/// not be filled yet, and return its index.
+
+Long64_t THnHash::AllocateBin(const ULong64_t* key, ULong64_t hash)
+{
+   const Long64_t bin = GetNbins();
+   ReserveTable(bin + 1);
+   fKeys.insert(fKeys.end(), key, key + GetKeyWords());
+   ResizeContent(bin + 1);
+   if (GetCalculateErrors())
+      fSumw2.push_back(0.);
+   InsertSlot(fTable.data(), fTableBits, hash, bin);
+   return bin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the bin with coordinates "coord".
+/// If it doesn't exist then return -1, or allocate a new bin if allocate is set
+
+Long64_t THnHash::GetBinIndex(const Int_t* coord, Bool_t allocate)
+{
+   const ULong64_t hash = SetKeyFromCoord(coord);
+   const Long64_t bin = FindBin(fKeyBuf.data(), hash);
+   if (bin >= 0 || !allocate)
+      return bin;
+   return AllocateBin(fKeyBuf.data(), hash);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Initialize storage for nbins
+
+void THnHash::Reserve(Long64_t nbins)
+{
+   ReserveTable(nbins);
+   fKeys.reserve(nbins * GetKeyWords());
+   ReserveContent(nbins);
+   if (GetCalculateErrors())
+      fSumw2.reserve(nbins);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create an iterator over all filled bins of a THnHash.
+/// Use THnIter instead.
+
+ROOT::Internal::THnBaseBinIter* THnHash::CreateIter(Bool_t respectAxisRange) const
+{
+   return new THnHashBinIter(respectAxisRange, this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the bin index for the n dimensional coordinates coord,
+/// allocate one if it doesn't exist yet and "allocate" is true.
+
+Long64_t THnHash::GetBin(const Int_t* coord, Bool_t allocate /*= kTRUE*/)
+{
+   return GetBinIndex(coord, allocate);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the bin index for the n dimensional tuple x,
+/// allocate one if it doesn't exist yet and "allocate" is true.
+
+Long64_t THnHash::GetBin(const Double_t* x, Bool_t allocate /* = kTRUE */)
+{
+   fCoordBuf.resize(fNdimensions);
+   for (Int_t i = 0; i < fNdimensions; ++i)
+      fCoordBuf[i] = GetAxis(i)->FindBin(x[i]);
+   return GetBinIndex(fCoordBuf.data(), allocate);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the bin index for the n dimensional tuple addressed by "name",
+/// allocate one if it doesn't exist yet and "allocate" is true.
+
+Long64_t THnHash::GetBin(const char* name[], Bool_t allocate /* = kTRUE */)
+{
+   fCoordBuf.resize(fNdimensions);
+   for (Int_t i = 0; i < fNdimensions; ++i)
+      fCoordBuf[i] = GetAxis(i)->FindBin(name[i]);
+   return GetBinIndex(fCoordBuf.data(), allocate);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the content of the filled bin number "bin".
+/// If coord is non-null, it will contain the bin's coordinates for each axis
+/// that correspond to the bin.
+
+Double_t THnHash::GetBinContent(Long64_t bin, Int_t* coord /* = 0 */) const
+{
+   if (bin >= 0 && bin < GetNbins()) {
+      if (coord)
+         SetCoordFromKey(GetKey(bin), coord);
+      return GetAt(bin);
+   }
+   if (coord)
+      memset(coord, -1, sizeof(Int_t) * fNdimensions);
+   return 0.;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get square of the error of bin addressed by linidx as
+/// \f$\sum weight^{2}\f$
+/// If errors are not enabled (via Sumw2() or CalculateErrors())
+/// return contents.
+
+Double_t THnHash::GetBinError2(Long64_t linidx) const
+{
+   if (!GetCalculateErrors())
+      return GetBinContent(linidx);
+
+   if (linidx < 0 || linidx >= GetNbins())
+      return 0.;
+
+   return fSumw2[linidx];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set content of bin with index "bin" to "v"
+
+void THnHash::SetBinContent(Long64_t bin, Double_t v)
+{
+   SetAt(bin, v);
+   ++fEntries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set error of bin with index "bin" to "e", enable errors if needed
+
+void THnHash::SetBinError2(Long64_t bin, Double_t e2)
+{
+   if (!GetCalculateErrors())
+      Sumw2(); // enable error calculation
+   fSumw2[bin] = e2;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add "e" to error of bin with index "bin", enable errors if needed
+
+void THnHash::AddBinError2(Long64_t bin, Double_t e2)
+{
+   if (!GetCalculateErrors())
+      Sumw2(); // enable error calculation
+   fSumw2[bin] += e2;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the amount of filled bins over all bins
+
+Double_t THnHash::GetSparseFractionBins() const
+{
+   Double_t nbinsTotal = 1.;
+   for (Int_t d = 0; d < fNdimensions; ++d)
+      nbinsTotal *= GetAxis(d)->GetNbins() + 2;
+   return GetNbins() / nbinsTotal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add contents of h scaled by c to this histogram:
+/// this = this + c * h
+/// Note that if h has Sumw2 set, Sumw2 is automatically called for this
+/// if not already set.
+/// If h is a THnHash, its filled bins are added without going through
+/// their coordinates, in parallel if implicit multi-threading is enabled.
+
+void THnHash::Add(const THnBase* h, Double_t c)
+{
+   // Check consistency of the input
+   if (!CheckConsistency(h, "Add")) return;
+
+   const THnHash* hh = dynamic_cast<const THnHash*>(h);
+   if (!hh) {
+      AddInternal(h, c, kFALSE);
+      return;
+   }
+   AddHashed(std::vector<const THnHash*>(1, hh), c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge this with a list of THnBase's. All THnBase's provided
+/// in the list must have the same bin layout!
+/// The THnHash's of the list are added together, see Add().
+
+Long64_t THnHash::Merge(TCollection* list)
+{
+   if (!list) return 0;
+   if (list->IsEmpty()) return (Long64_t)GetEntries();
+
+   std::vector<const THnHash*> hashed;
+   TIter iter(list);
+   const TObject* addMeObj = 0;
+   while ((addMeObj = iter())) {
+      const THnBase* addMe = dynamic_cast<const THnBase*>(addMeObj);
+      if (!addMe) {
+         Error("Merge", "Object named %s is not THnBase! Skipping it.",
+               addMeObj->GetName());
+      } else if (CheckConsistency(addMe, "Merge")) {
+         const THnHash* addMeHashed = dynamic_cast<const THnHash*>(addMe);
+         if (addMeHashed)
+            hashed.push_back(addMeHashed);
+         else
+            AddInternal(addMe, 1., kFALSE);
+      }
+   }
+   AddHashed(hashed, 1.);
+   return (Long64_t)GetEntries();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the contents of the THnHash's "hists", with the same binning as this,
+/// scaled by c.
+///
+/// The hash space is split into 2^partBits partitions by the top bits of the
+/// hashes. A partition corresponds to a contiguous region of the hash table of
+/// each histogram, plus the slots following it up to the next empty one, into
+/// which linear probing can have moved its bins. The partitions thus touch
+/// disjoint bins of this histogram and are added in parallel; the bins they
+/// do not find are collected and allocated afterwards.
+
+void THnHash::AddHashed(const std::vector<const THnHash*>& hists, Double_t c)
+{
+   if (hists.empty())
+      return;
+
+   Bool_t haveErrors = GetCalculateErrors();
+   Long64_t sumNbins = GetNbins();
+   Int_t minTableBits = 64;
+   for (const THnHash* h: hists) {
+      haveErrors |= h->GetCalculateErrors();
+      h->BuildTable();
+      sumNbins += h->GetNbins();
+      minTableBits = std::min(minTableBits, h->fTableBits);
+   }
+   // Trigger error calculation if one of hists has it
+   if (haveErrors && !GetCalculateErrors())
+      Sumw2();
+   // Set up the hash table, and avoid rehashing while allocating the new bins
+   Reserve(sumNbins);
+
+   Int_t partBits = 0;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && sumNbins >= kMinParallelBins) {
+      const UInt_t nTasks = 4 * ROOT::GetImplicitMTPoolSize();
+      while ((1U << partBits) < nTasks && partBits < minTableBits)
+         ++partBits;
+   }
+#endif
+   const UInt_t nPartitions = 1U << partBits;
+   std::vector<THnHashNewBins> newBins(nPartitions);
+   const Int_t nwords = GetKeyWords();
+
+   auto addPartition = [&](UInt_t part) {
+      THnHashNewBins& partNewBins = newBins[part];
+      for (const THnHash* h: hists) {
+         const Bool_t sourceErrors = h->GetCalculateErrors();
+         const ULong64_t nslots = 1ULL << h->fTableBits;
+         const ULong64_t regionSize = nslots >> partBits;
+         const ULong64_t regionStart = part * regionSize;
+         for (ULong64_t i = 0; i < nslots; ++i) {
+            const ULong64_t slot = (regionStart + i) & (nslots - 1);
+            const ULong64_t binp1 = h->fTable[2 * slot + 1];
+            if (!binp1) {
+               if (i >= regionSize) break;
+               continue;
+            }
+            const ULong64_t hash = h->fTable[2 * slot];
+            if (partBits && (hash >> (64 - partBits)) != part)
+               continue;
+
+            const Long64_t hbin = binp1 - 1;
+            const Double_t v = h->GetAt(hbin);
+            Double_t e2 = 0.;
+            if (haveErrors)
+               e2 = (sourceErrors ? h->fSumw2[hbin] : v) * c * c;
+            const ULong64_t* key = h->GetKey(hbin);
+            const Long64_t bin = FindBin(key, hash);
+            if (bin < 0) {
+               partNewBins.Add(key, nwords, hash, c * v, e2);
+            } else {
+               if (haveErrors)
+                  fSumw2[bin] += e2;
+               AddAt(bin, c * v);
+            }
+         }
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (partBits) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(addPartition, ROOT::TSeq<UInt_t>(nPartitions));
+   } else
+#endif
+   {
+      for (UInt_t part = 0; part < nPartitions; ++part)
+         addPartition(part);
+   }
+
+   for (const THnHashNewBins& partNewBins: newBins) {
+      for (Long64_t i = 0; i < partNewBins.GetNbins(); ++i) {
+         const Long64_t bin = AllocateBin(partNewBins.GetKey(i), partNewBins.GetHash(i));
+         if (haveErrors)
+            fSumw2[bin] += partNewBins.GetError2(i);
+         AddAt(bin, partNewBins.GetContent(i));
+      }
+   }
+
+   Double_t nEntries = GetEntries();
+   for (const THnHash* h: hists)
+      nEntries += c * h->GetEntries();
+   SetEntries(nEntries);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable calculation of errors
+
+void THnHash::Sumw2()
+{
+   if (GetCalculateErrors()) return;
+
+   fTsumw2 = 0.;
+   // fill sumw2 array with current content
+   const Long64_t nbins = GetNbins();
+   fSumw2.resize(nbins);
+   for (Long64_t bin = 0; bin < nbins; ++bin)
+      fSumw2[bin] = GetAt(bin);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Clear the histogram
+
+void THnHash::Reset(Option_t *option /*= ""*/)
+{
+   fKeys.clear();
+   fSumw2.clear();
+   ResizeContent(0);
+   fTable.clear();
+   ResetBase(option);
+}
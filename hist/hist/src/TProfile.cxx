@@ -770,14 +770,23 @@ void TProfile::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const D
          return;
    }
 
+   // the bins are computed kNFillBatch at a time, unless the axis can be extended by the fills
+   Int_t bins[kNFillBatch];
+   const Bool_t extend = fXaxis.CanExtend();
+   Int_t ibatch = kNFillBatch;
    for (i=ifirst;i<ntimes;i+=stride) {
+      if (!extend && ibatch == kNFillBatch) {
+         fXaxis.FindFixBins(TMath::Min(Int_t(kNFillBatch), (ntimes-i-1)/stride+1), &x[i], bins, stride);
+         ibatch = 0;
+      }
+      bin = extend ? 0 : bins[ibatch++];
       if (fYmin != fYmax) {
          if (y[i] <fYmin || y[i]> fYmax || TMath::IsNaN(y[i])) continue;
       }
 
       Double_t u = (w) ? w[i] : 1; // (w[i] > 0 ? w[i] : -w[i]);
       fEntries++;
-      bin =fXaxis.FindBin(x[i]);
+      if (extend) bin =fXaxis.FindBin(x[i]);
       AddBinContent(bin, u*y[i]);
       fSumw2.fArray[bin] += u*y[i]*y[i];
       if (!fBinSumw2.fN && u != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();  // must be called before accumulating the entries
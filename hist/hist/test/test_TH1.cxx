@@ -2,6 +2,15 @@
 
 #include "TH1.h"
 #include "TH1F.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TProfile.h"
+#include "TList.h"
+#include "TROOT.h"
+
+#include <limits>
+#include <utility>
+#include <vector>
 
 // StatOverflows TH1
 TEST(TH1, StatOverflows)
@@ -30,3 +39,82 @@ TEST(TH1, StatOverflows)
    EXPECT_EQ(TH1::EStatOverflows::kConsider, h1.GetStatOverflows());
    EXPECT_EQ(TH1::EStatOverflows::kNeutral,  h2.GetStatOverflows());
 }
+
+// FillN computes the bins of the values in batches: it must give the same histogram as Fill
+TEST(TH1, FillNSameAsFill)
+{
+   const Int_t n = 1000;
+   std::vector<Double_t> x(2 * n), y(2 * n), z(2 * n), w(2 * n);
+   for (Int_t i = 0; i < 2 * n; ++i) {
+      x[i] = -1.2 + 2.4 * ((i * 37) % 101) / 100.;
+      y[i] = -1.2 + 2.4 * ((i * 53) % 89) / 88.;
+      z[i] = -1.2 + 2.4 * ((i * 71) % 97) / 96.;
+      w[i] = 0.5 + (i % 3);
+   }
+   x[2] = std::numeric_limits<Double_t>::quiet_NaN();
+   const Double_t edges[] = {-1., -0.9, -0.5, 0., 0.1, 0.7, 1.};
+
+   for (Int_t stride : {1, 2}) {
+      TH1D hFix("hFix", "", 10, -1., 1.), hFixN("hFixN", "", 10, -1., 1.);
+      TH1D hVar("hVar", "", 6, edges), hVarN("hVarN", "", 6, edges);
+      TH2D h2("h2", "", 10, -1., 1., 6, edges), h2N("h2N", "", 10, -1., 1., 6, edges);
+      TH3D h3("h3", "", 4, -1., 1., 5, -1., 1., 6, -1., 1.), h3N("h3N", "", 4, -1., 1., 5, -1., 1., 6, -1., 1.);
+      TProfile p("p", "", 6, edges), pN("pN", "", 6, edges);
+      for (Int_t i = 0; i < n * stride; i += stride) {
+         hFix.Fill(x[i], w[i]);
+         hVar.Fill(x[i], w[i]);
+         h2.Fill(x[i], y[i], w[i]);
+         h3.Fill(x[i], y[i], z[i], w[i]);
+         p.Fill(x[i], y[i], w[i]);
+      }
+      hFixN.FillN(n, x.data(), w.data(), stride);
+      hVarN.FillN(n, x.data(), w.data(), stride);
+      h2N.FillN(n, x.data(), y.data(), w.data(), stride);
+      h3N.FillN(n, x.data(), y.data(), z.data(), w.data(), stride);
+      pN.FillN(n, x.data(), y.data(), w.data(), stride);
+
+      for (auto hh : {std::make_pair<TH1 *, TH1 *>(&hFix, &hFixN), std::make_pair<TH1 *, TH1 *>(&hVar, &hVarN),
+                      std::make_pair<TH1 *, TH1 *>(&h2, &h2N), std::make_pair<TH1 *, TH1 *>(&h3, &h3N),
+                      std::make_pair<TH1 *, TH1 *>(&p, &pN)}) {
+         EXPECT_EQ(hh.first->GetEntries(), hh.second->GetEntries()) << hh.first->GetName();
+         EXPECT_DOUBLE_EQ(hh.first->GetMean(), hh.second->GetMean()) << hh.first->GetName();
+         for (Int_t bin = 0; bin < hh.first->GetNcells(); ++bin) {
+            EXPECT_DOUBLE_EQ(hh.first->GetBinContent(bin), hh.second->GetBinContent(bin)) << hh.first->GetName();
+            EXPECT_DOUBLE_EQ(hh.first->GetBinError(bin), hh.second->GetBinError(bin)) << hh.first->GetName();
+         }
+      }
+   }
+}
+
+#ifdef R__USE_IMT
+// Merging histograms with the same axes in parallel gives the same bins as sequentially
+TEST(TH1, MergeSameAxesParallel)
+{
+   const Int_t nhists = 8;
+   std::vector<TH2F> hists;
+   hists.reserve(nhists);
+   for (Int_t i = 0; i < nhists; ++i) {
+      hists.emplace_back(Form("h%d", i), "", 500, 0., 1., 400, 0., 1.);
+      for (Int_t j = 0; j < 20000; ++j)
+         hists.back().Fill(((j * 7919 + i * 104729) % 10007) / 10007., ((j * 6151 + i) % 8191) / 8191., 0.1 + i);
+   }
+   TList list;
+   for (Int_t i = 1; i < nhists; ++i)
+      list.Add(&hists[i]);
+
+   TH2F hSeq(hists[0]);
+   hSeq.Merge(&list);
+
+   ROOT::EnableImplicitMT(4);
+   TH2F hPar(hists[0]);
+   hPar.Merge(&list);
+   ROOT::DisableImplicitMT();
+
+   EXPECT_EQ(hSeq.GetEntries(), hPar.GetEntries());
+   EXPECT_EQ(hSeq.GetMean(1), hPar.GetMean(1));
+   for (Int_t bin = 0; bin < hSeq.GetNcells(); ++bin) {
+      EXPECT_EQ(hSeq.GetBinContent(bin), hPar.GetBinContent(bin));
+      EXPECT_EQ(hSeq.GetBinError(bin), hPar.GetBinError(bin));
+   }
+}
+#endif
@@ -0,0 +1,159 @@
+#include "gtest/gtest.h"
+
+#include "ROOT/TH1ConcurrentFill.hxx"
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TProfile.h"
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+template <typename F>
+void RunThreads(unsigned nThreads, F &&f)
+{
+   std::vector<std::thread> threads;
+   for (unsigned i = 0; i < nThreads; ++i)
+      threads.emplace_back(f, i);
+   for (auto &t : threads)
+      t.join();
+}
+} // anonymous namespace
+
+TEST(TH1ConcurrentFill, SameAsFill1D)
+{
+   TH1D hSeq("hSeq", "", 20, -1., 1.);
+   TH1D hConc("hConc", "", 20, -1., 1.);
+   const unsigned nThreads = 4, nPerThread = 10000;
+   for (unsigned t = 0; t < nThreads; ++t)
+      for (unsigned i = 0; i < nPerThread; ++i)
+         hSeq.Fill(-1.2 + 2.4 * i / nPerThread, 0.5 + t);
+
+   hConc.Sumw2();
+   ROOT::TH1ConcurrentFillManager manager(hConc);
+   RunThreads(nThreads, [&manager](unsigned t) {
+      auto filler = manager.MakeFiller();
+      for (unsigned i = 0; i < nPerThread; ++i)
+         filler.Fill(-1.2 + 2.4 * i / nPerThread, 0.5 + t);
+   });
+
+   EXPECT_EQ(hSeq.GetEntries(), hConc.GetEntries());
+   EXPECT_DOUBLE_EQ(hSeq.GetSumOfWeights(), hConc.GetSumOfWeights());
+   EXPECT_NEAR(hSeq.GetMean(), hConc.GetMean(), 1e-12);
+   EXPECT_NEAR(hSeq.GetStdDev(), hConc.GetStdDev(), 1e-12);
+   for (Int_t bin = 0; bin <= hSeq.GetNbinsX() + 1; ++bin) {
+      EXPECT_DOUBLE_EQ(hSeq.GetBinContent(bin), hConc.GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(hSeq.GetBinError(bin), hConc.GetBinError(bin));
+   }
+}
+
+TEST(TH1ConcurrentFill, SameAsFill2D3D)
+{
+   TH2F h2Seq("h2Seq", "", 5, 0., 1., 4, 0., 1.);
+   TH2F h2Conc("h2Conc", "", 5, 0., 1., 4, 0., 1.);
+   TH3I h3Seq("h3Seq", "", 3, 0., 1., 3, 0., 1., 3, 0., 1.);
+   TH3I h3Conc("h3Conc", "", 3, 0., 1., 3, 0., 1., 3, 0., 1.);
+   const unsigned nThreads = 4, nPerThread = 1000;
+   for (unsigned t = 0; t < nThreads; ++t) {
+      for (unsigned i = 0; i < nPerThread; ++i) {
+         const double x = double(i % 11) / 10, y = double(i % 7) / 6;
+         h2Seq.Fill(x, y);
+         h3Seq.Fill(x, y, 1. - x);
+      }
+   }
+
+   ROOT::TH1ConcurrentFillManager manager2(h2Conc);
+   ROOT::TH1ConcurrentFillManager manager3(h3Conc);
+   RunThreads(nThreads, [&](unsigned) {
+      auto filler2 = manager2.MakeFiller();
+      auto filler3 = manager3.MakeFiller();
+      for (unsigned i = 0; i < nPerThread; ++i) {
+         const double x = double(i % 11) / 10, y = double(i % 7) / 6;
+         filler2.Fill(x, y);
+         filler3.Fill(x, y, 1. - x);
+      }
+   });
+
+   EXPECT_EQ(h2Seq.GetEntries(), h2Conc.GetEntries());
+   EXPECT_NEAR(h2Seq.GetCorrelationFactor(), h2Conc.GetCorrelationFactor(), 1e-12);
+   for (Int_t bin = 0; bin < h2Seq.GetNcells(); ++bin)
+      EXPECT_EQ(h2Seq.GetBinContent(bin), h2Conc.GetBinContent(bin));
+   EXPECT_EQ(h3Seq.GetEntries(), h3Conc.GetEntries());
+   EXPECT_NEAR(h3Seq.GetMean(3), h3Conc.GetMean(3), 1e-12);
+   for (Int_t bin = 0; bin < h3Seq.GetNcells(); ++bin)
+      EXPECT_EQ(h3Seq.GetBinContent(bin), h3Conc.GetBinContent(bin));
+}
+
+TEST(TH1ConcurrentFill, AxisRange)
+{
+   TH1D hSeq("hSeq", "", 10, 0., 1.);
+   TH1D hConc("hConc", "", 10, 0., 1.);
+   for (auto h : {&hSeq, &hConc}) {
+      for (int i = 0; i < 100; ++i)
+         h->Fill(0.005 + 0.01 * i);
+   }
+   hConc.GetXaxis()->SetRange(3, 5);
+   for (int i = 0; i < 400; ++i)
+      hSeq.Fill(0.0025 + 0.0025 * i);
+
+   {
+      ROOT::TH1ConcurrentFillManager manager(hConc);
+      RunThreads(4, [&manager](unsigned t) {
+         auto filler = manager.MakeFiller();
+         for (int i = 0; i < 100; ++i)
+            filler.Fill(0.0025 + 0.0025 * (100 * t + i));
+      });
+   }
+
+   // the statistics in range are computed from the bins, the stored ones include the fills out of range
+   EXPECT_EQ(hSeq.GetEntries(), hConc.GetEntries());
+   hSeq.GetXaxis()->SetRange(3, 5);
+   EXPECT_DOUBLE_EQ(hSeq.GetMean(), hConc.GetMean());
+   hSeq.GetXaxis()->SetRange();
+   hConc.GetXaxis()->SetRange();
+   EXPECT_NEAR(hSeq.GetMean(), hConc.GetMean(), 1e-12);
+   EXPECT_NEAR(hSeq.GetStdDev(), hConc.GetStdDev(), 1e-12);
+}
+
+TEST(TH1ConcurrentFill, Sumw2)
+{
+   TH1D h("h", "", 10, 0., 1.);
+   {
+      ROOT::TH1ConcurrentFillManager manager(h);
+      auto filler = manager.MakeFiller();
+      filler.Fill(0.5);
+   }
+   EXPECT_EQ(0, h.GetSumw2N());
+
+   h.Sumw2();
+   {
+      ROOT::TH1ConcurrentFillManager manager(h);
+      auto filler = manager.MakeFiller();
+      filler.Fill(0.5, 3.);
+   }
+   EXPECT_DOUBLE_EQ(10., h.GetSumw2()->At(h.FindFixBin(0.5)));
+}
+
+TEST(TH1ConcurrentFill, Saturation)
+{
+   TH1C h("h", "", 1, 0., 1.);
+   ROOT::TH1ConcurrentFillManager manager(h);
+   RunThreads(4, [&manager](unsigned) {
+      auto filler = manager.MakeFiller();
+      for (int i = 0; i < 100; ++i)
+         filler.Fill(0.5);
+   });
+   EXPECT_EQ(127., h.GetBinContent(1));
+   EXPECT_EQ(400., h.GetEntries());
+}
+
+TEST(TH1ConcurrentFill, Unsupported)
+{
+   TProfile p("p", "", 10, 0., 1.);
+   EXPECT_THROW(ROOT::TH1ConcurrentFillManager{p}, std::runtime_error);
+   TH1D h("h", "", 10, 0., 1.);
+   h.SetCanExtend(TH1::kAllAxes);
+   EXPECT_THROW(ROOT::TH1ConcurrentFillManager{h}, std::runtime_error);
+}
@@ -0,0 +1,161 @@
+#include "gtest/gtest.h"
+
+#include "THnHash.h"
+#include "THnSparse.h"
+#include "TList.h"
+#include "TMemFile.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include <memory>
+
+namespace {
+const Int_t kNdim = 4;
+const Int_t kBins[kNdim] = {10, 1000, 3, 100000};
+const Double_t kXmin[kNdim] = {0., -10., 0., 0.};
+const Double_t kXmax[kNdim] = {1., 10., 3., 1.};
+
+void FillRandom(THnBase &h, UInt_t seed, Int_t n)
+{
+   TRandom3 rnd(seed);
+   Double_t x[kNdim];
+   for (Int_t i = 0; i < n; ++i) {
+      x[0] = rnd.Uniform(-0.1, 1.1);
+      x[1] = rnd.Gaus(0., 4.);
+      x[2] = rnd.Integer(3);
+      x[3] = rnd.Uniform();
+      h.Fill(x, rnd.Uniform(0.5, 2.));
+   }
+}
+
+// Compare each filled bin of "h" with the bin of "ref" with the same coordinates
+void ExpectSameBins(const THnBase &ref, const THnBase &h)
+{
+   EXPECT_EQ(ref.GetNbins(), h.GetNbins());
+   EXPECT_DOUBLE_EQ(ref.GetEntries(), h.GetEntries());
+   Int_t coord[kNdim];
+   for (Long64_t bin = 0; bin < h.GetNbins(); ++bin) {
+      const Double_t v = h.GetBinContent(bin, coord);
+      const Long64_t refBin = ref.GetBin(coord);
+      ASSERT_LE(0, refBin);
+      EXPECT_NEAR(ref.GetBinContent(refBin), v, 1e-9);
+      EXPECT_NEAR(ref.GetBinError2(refBin), h.GetBinError2(bin), 1e-9);
+   }
+}
+} // anonymous namespace
+
+TEST(THnHash, SameAsTHnSparse)
+{
+   THnSparseD hs("hs", "", kNdim, kBins, kXmin, kXmax);
+   THnHashD hh("hh", "", kNdim, kBins, kXmin, kXmax);
+   hs.Sumw2();
+   hh.Sumw2();
+   FillRandom(hs, 1, 20000);
+   FillRandom(hh, 1, 20000);
+   ExpectSameBins(hs, hh);
+
+   Int_t coord[kNdim] = {11, 0, 1, 100001};
+   EXPECT_EQ(-1, hh.GetBin(coord, kFALSE));
+   const Long64_t bin = hh.GetBin(coord);
+   EXPECT_EQ(hh.GetNbins() - 1, bin);
+   EXPECT_EQ(bin, hh.GetBin(coord, kFALSE));
+
+   hh.Reset();
+   EXPECT_EQ(0, hh.GetNbins());
+   EXPECT_EQ(-1, hh.GetBin(coord, kFALSE));
+}
+
+TEST(THnHash, AddAndMerge)
+{
+   THnSparseD hsRef("hsRef", "", kNdim, kBins, kXmin, kXmax);
+   THnHashF hh("hh", "", kNdim, kBins, kXmin, kXmax);
+   THnHashD hh1("hh1", "", kNdim, kBins, kXmin, kXmax);
+   THnHashD hh2("hh2", "", kNdim, kBins, kXmin, kXmax);
+   THnSparseD hs3("hs3", "", kNdim, kBins, kXmin, kXmax);
+   hh2.Sumw2();
+   FillRandom(hh, 10, 5000);
+   FillRandom(hh1, 11, 5000);
+   FillRandom(hh2, 12, 5000);
+   FillRandom(hs3, 13, 5000);
+   FillRandom(hsRef, 10, 5000);
+
+   hh.Add(&hh1, 2.);
+   THnSparseD hs1("hs1", "", kNdim, kBins, kXmin, kXmax);
+   FillRandom(hs1, 11, 5000);
+   hsRef.Add(&hs1, 2.);
+   THnSparseD hs2("hs2", "", kNdim, kBins, kXmin, kXmax);
+   hs2.Sumw2();
+   FillRandom(hs2, 12, 5000);
+
+   TList list;
+   list.Add(&hh2);
+   list.Add(&hs3);
+   hh.Merge(&list);
+   list.Clear();
+   list.Add(&hs2);
+   list.Add(&hs3);
+   hsRef.Merge(&list);
+
+   // hh has Float_t content
+   EXPECT_EQ(hsRef.GetNbins(), hh.GetNbins());
+   EXPECT_DOUBLE_EQ(hsRef.GetEntries(), hh.GetEntries());
+   Int_t coord[kNdim];
+   for (Long64_t bin = 0; bin < hh.GetNbins(); ++bin) {
+      const Double_t v = hh.GetBinContent(bin, coord);
+      const Long64_t refBin = hsRef.GetBin(coord);
+      ASSERT_LE(0, refBin);
+      EXPECT_NEAR(hsRef.GetBinContent(refBin), v, 1e-5 * v);
+      EXPECT_NEAR(hsRef.GetBinError2(refBin), hh.GetBinError2(bin), 1e-5 * hh.GetBinError2(bin));
+   }
+}
+
+#ifdef R__USE_IMT
+// With more than 65536 bins in total, Add() and Merge() add the bins by partitions of the hash space in parallel
+TEST(THnHash, AddAndMergeParallel)
+{
+   THnHashD hh1("hh1", "", kNdim, kBins, kXmin, kXmax);
+   THnHashD hh2("hh2", "", kNdim, kBins, kXmin, kXmax);
+   hh1.Sumw2();
+   // the bins of hh1 are the ones of the targets, the ones of hh2 are mostly new
+   FillRandom(hh1, 30, 40000);
+   FillRandom(hh2, 31, 40000);
+   TList list;
+   list.Add(&hh1);
+   list.Add(&hh2);
+
+   THnHashD hSeq("hSeq", "", kNdim, kBins, kXmin, kXmax);
+   FillRandom(hSeq, 30, 40000);
+   hSeq.Add(&hh1, 2.);
+   hSeq.Merge(&list);
+
+   ROOT::EnableImplicitMT(4);
+   THnHashD hPar("hPar", "", kNdim, kBins, kXmin, kXmax);
+   FillRandom(hPar, 30, 40000);
+   ASSERT_LE(1 << 16, hPar.GetNbins() + hh1.GetNbins());
+   hPar.Add(&hh1, 2.);
+   hPar.Merge(&list);
+   ROOT::DisableImplicitMT();
+
+   EXPECT_TRUE(hPar.GetCalculateErrors());
+   ExpectSameBins(hSeq, hPar);
+}
+#endif
+
+TEST(THnHash, Streaming)
+{
+   THnHashI hh("hh", "", kNdim, kBins, kXmin, kXmax);
+   FillRandom(hh, 20, 10000);
+
+   TMemFile file("test_THnHash.root", "RECREATE");
+   file.WriteObject(&hh, "hh");
+   THnHashI *readPtr = nullptr;
+   file.GetObject("hh", readPtr);
+   ASSERT_TRUE(readPtr != nullptr);
+   std::unique_ptr<THnHashI> read(readPtr);
+   ExpectSameBins(hh, *read);
+
+   // The hash table is rebuilt when the read histogram is filled further
+   FillRandom(hh, 21, 1000);
+   FillRandom(*read, 21, 1000);
+   ExpectSameBins(hh, *read);
+}
@@ -4,7 +4,9 @@
 
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <iostream>
+#include <vector>
 
 using namespace std;
 
@@ -172,6 +174,65 @@ void test_convVoigt()
    voigtHelper(1, 1);
 }
 
+// Test that the evaluation of many points gives the same values as EvalPar,
+// for the pre-defined functions and for other formulae
+void test_evalParBatch()
+{
+   const int n = 100;
+   std::vector<double> x(n);
+   for (int i = 0; i < n; ++i)
+      x[i] = -5. + 0.1 * i;
+   const double *xcols[1] = {x.data()};
+   std::vector<double> f(n);
+
+   const double params[4] = {2., 0.5, 1.5, -0.1};
+   const char *formulas[] = {"gaus", "expo", "landau", "pol3", "gausn", "gaus+1", "[0]*x+[1]*sin(x)"};
+   for (auto formula : formulas) {
+      TF1 f1("f1", formula, -5, 5);
+      f1.EvalParBatch(n, xcols, params, f.data());
+      for (int i = 0; i < n; ++i)
+         EXPECT_NEAR(f1.EvalPar(&x[i], params), f[i], 1.E-12 * (1. + std::abs(f[i]))) << formula << " x = " << x[i];
+
+      // use the stored parameters
+      f1.SetParameters(params);
+      f1.EvalParBatch(n, xcols, nullptr, f.data());
+      for (int i = 0; i < n; ++i)
+         EXPECT_NEAR(f1.EvalPar(&x[i]), f[i], 1.E-12 * (1. + std::abs(f[i]))) << formula << " x = " << x[i];
+   }
+
+   TF1 fFunc("fFunc", func, -5, 5, 1);
+   fFunc.EvalParBatch(n, xcols, params, f.data());
+   for (int i = 0; i < n; ++i)
+      EXPECT_EQ(x[i] + params[0], f[i]);
+}
+
+// Test the exact gradient of formulae with respect to the parameters against the numerical one
+void test_gradientPar()
+{
+   const double params[4] = {2., 0.5, 1.5, -0.1};
+   const char *formulas[] = {"gaus", "expo", "pol3", "[0]*exp(-0.5*((x-[1])/[2])^2)+[3]*sqrt(x*x+1)",
+                             "[0]*sin([1]*x)+pow([2],2)*log(abs(x)+[3]+2)"};
+   for (auto formula : formulas) {
+      TF1 f1("f1", formula, -5, 5);
+      f1.SetParameters(params);
+      const int npar = f1.GetNpar();
+      std::vector<double> grad(npar);
+      std::vector<double> numGrad(npar);
+      for (double x = -4.5; x < 5; x += 1.) {
+         ASSERT_TRUE(f1.GetFormula()->GradientPar(&x, grad.data(), params)) << formula;
+         f1.GradientPar(&x, numGrad.data(), 1.E-4);
+         for (int i = 0; i < npar; ++i)
+            EXPECT_NEAR(numGrad[i], grad[i], 1.E-6 * (1. + std::abs(grad[i]))) << formula << " x = " << x;
+      }
+   }
+
+   // landau is not differentiated
+   TF1 f2("f2", "landau", -5, 5);
+   std::vector<double> grad(3);
+   double x = 1.;
+   EXPECT_FALSE(f2.GetFormula()->GradientPar(&x, grad.data(), params));
+}
+
 TEST(TF1, NsumCoeffNames)
 {
    test_nsumCoeffNames();
@@ -219,3 +280,13 @@ TEST(TF1, Constructors)
    for (auto tf1 : vtf1)
       EXPECT_EQ(tf1(&x, &p), 2);
 }
+
+TEST(TF1, EvalParBatch)
+{
+   test_evalParBatch();
+}
+
+TEST(TF1, GradientPar)
+{
+   test_gradientPar();
+}
@@ -40,6 +40,7 @@ to be merged, like the standalone hadd program.
 #include "TROOT.h"
 #include "TMemFile.h"
 #include "TVirtualMutex.h"
+#include "TVirtualRWMutex.h"
 
 #ifdef WIN32
 // For _getmaxstdio
@@ -57,6 +58,33 @@ TClassRef R__TTree_Class("TTree");
 
 static const Int_t kCpProgress = BIT(14);
 static const Int_t kCintFileNumber = 100;
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the functions of a histogram before another histogram is read into it:
+/// TH1::Streamer clears the list of functions without deleting them. This library
+/// does not depend on libHist, so the list is found through the dictionary of TH1.
+/// As in ~TH1, a function can be in the list several times and may already have
+/// been deleted if it is shared with other histograms.
+
+static void R__DeleteHistoFunctions(TObject *hist)
+{
+   static const Long_t offset = R__TH1_Class->GetDataMemberOffset("fFunctions");
+   void *th1 = R__TH1_Class->DynamicCast(TObject::Class(), hist, kFALSE);
+   TList *functions = th1 && offset ? *(TList **)((char *)th1 + offset) : 0;
+   if (!functions)
+      return;
+
+   R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   TObject *obj = 0;
+   while ((obj = functions->First())) {
+      while (functions->Remove(obj)) { }
+      if (!obj->TestBit(TObject::kNotDeleted)) {
+         break;
+      }
+      delete obj;
+   }
+   functions->Clear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the maximum number of allowed opened files minus some wiggle room
 /// for CINT or at least of the standard library (stdio).
@@ -547,6 +575,11 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
 
                TList inputs;
                Bool_t oneGo = fHistoOneGo && cl->InheritsFrom(R__TH1_Class);
+               // When merging histograms one file at a time, read each of them into the
+               // histogram of the previous file rather than constructing a new one, which
+               // reuses the memory of its bins
+               Bool_t recycle = !oneGo && cl->InheritsFrom(R__TH1_Class);
+               TObject *recycled = 0;
 
                // Loop over all source files and merge same-name object
                TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
@@ -563,7 +596,17 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                         ndir->cd();
                         TKey *key2 = (TKey*)ndir->GetListOfKeys()->FindObject(key->GetName());
                         if (key2) {
-                           TObject *hobj = key2->ReadObj();
+                           TObject *hobj = 0;
+                           if (recycled && !strcmp(key2->GetClassName(), recycled->ClassName())) {
+                              R__DeleteHistoFunctions(recycled);
+                              if (key2->Read(recycled))
+                                 hobj = recycled;
+                           }
+                           if (!hobj) {
+                              delete recycled;
+                              recycled = 0;
+                              hobj = key2->ReadObj();
+                           }
                            if (!hobj) {
                               Info("MergeRecursive", "could not read object for key {%s, %s}; skipping file %s",
                                    key->GetName(), key->GetTitle(), nextsource->GetName());
@@ -584,12 +627,18 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                                  Error("MergeRecursive", "calling Merge() on '%s' with the corresponding object in '%s'",
                                        obj->GetName(), nextsource->GetName());
                               }
-                              inputs.Delete();
+                              if (recycle) {
+                                 recycled = hobj;
+                                 inputs.Clear();
+                              } else {
+                                 inputs.Delete();
+                              }
                            }
                         }
                      }
                      nextsource = (TFile*)sourcelist->After( nextsource );
                   } while (nextsource);
+                  delete recycled;
                   // Merge the list, if still to be done
                   if (oneGo || info.fIsFirst) {
                      ROOT::MergeFunc_t func = cl->GetMerge();
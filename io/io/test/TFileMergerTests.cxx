@@ -1,10 +1,15 @@
 #include "TFileMerger.h"
 
+#include "TF1.h"
+#include "TH1.h"
+#include "TList.h"
 #include "TMemFile.h"
 #include "TTree.h"
 
 #include "gtest/gtest.h"
 
+#include <memory>
+
 namespace {
 using testing::internal::GetCapturedStderr;
 using testing::internal::CaptureStderr;
@@ -63,6 +68,18 @@ static void CheckTree(TMemFile &file, const char *name, double expectedValue)
    t->ResetBranchAddresses();
 }
 
+static void CreateAHistogram(TMemFile &file, double value)
+{
+   TH1D h("h", "A histogram", 10, 0., 10.);
+   h.SetDirectory(nullptr);
+   h.Fill(value);
+   // The same function can be in the list several times, with different drawing options
+   auto f = new TF1("f", "gaus", 0., 10.);
+   h.GetListOfFunctions()->Add(f);
+   h.GetListOfFunctions()->Add(f, "same");
+   file.WriteObject(&h, "h");
+}
+
 TEST(TFileMerger, CreateWithTFilePointer)
 {
    TMemFile a("a.root", "RECREATE");
@@ -96,3 +113,33 @@ TEST(TFileMerger, CreateWithUnwritableTFilePointer)
    output->SetWritable(false);
    EXPECT_ROOT_ERROR(merger.OutputFile(std::move(output)), "Error in .* output file output.root is not writable\n");
 }
+
+TEST(TFileMerger, MergeHistogramsWithFunctionsOneByOne)
+{
+   TMemFile a("a.root", "RECREATE");
+   CreateAHistogram(a, 1.5);
+   TMemFile b("b.root", "RECREATE");
+   CreateAHistogram(b, 2.5);
+   TMemFile c("c.root", "RECREATE");
+   CreateAHistogram(c, 3.5);
+
+   // The histograms of b and c are read into the same object, which must not keep the functions of the previous file
+   TFileMerger merger(kFALSE, /*histoOneGo=*/kFALSE);
+   auto output = std::unique_ptr<TMemFile>(new TMemFile("output.root", "CREATE"));
+   ASSERT_TRUE(merger.OutputFile(std::move(output)));
+   merger.AddFile(&a, false);
+   merger.AddFile(&b, false);
+   merger.AddFile(&c, false);
+   ASSERT_TRUE(merger.PartialMerge());
+
+   auto &result = *static_cast<TMemFile *>(merger.GetOutputFile());
+   TH1D *hPtr = nullptr;
+   result.GetObject("h", hPtr);
+   ASSERT_TRUE(hPtr != nullptr);
+   std::unique_ptr<TH1D> h(hPtr);
+   EXPECT_EQ(3., h->GetEntries());
+   for (Int_t bin = 2; bin <= 4; ++bin)
+      EXPECT_EQ(1., h->GetBinContent(bin));
+   EXPECT_EQ(2, h->GetListOfFunctions()->GetSize());
+   EXPECT_EQ(h->GetListOfFunctions()->First(), h->GetListOfFunctions()->Last());
+}
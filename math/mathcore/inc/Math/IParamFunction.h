@@ -21,6 +21,7 @@
 
 
 #include <cassert>
+#include <vector>
 
 /**
    @defgroup ParamFunc Parameteric Function Evaluation Interfaces.
@@ -127,6 +128,17 @@ namespace ROOT {
             return DoEval(x);
          }
 
+         /**
+         Evaluate function at n points for given parameters p and store the values in f.
+         The coordinates are given per dimension as in the fit data classes: x[j][i] is the
+         coordinate j of the point i.
+         Use the virtual function DoEvalBatch, which by default calls DoEvalPar for each point
+         */
+         void EvalBatch(unsigned int n, const T *const *x, const double *p, T *f) const
+         {
+            DoEvalBatch(n, x, p, f);
+         }
+
       private:
          /**
             Implementation of the evaluation function using the x values and the parameters.
@@ -134,6 +146,21 @@ namespace ROOT {
          */
          virtual T DoEvalPar(const T *x, const double *p) const = 0;
 
+         /**
+            Implementation of the evaluation at many points. Derived classes can re-implement it
+            when the points can be evaluated more efficiently together
+         */
+         virtual void DoEvalBatch(unsigned int n, const T *const *x, const double *p, T *f) const
+         {
+            const unsigned int ndim = this->NDim();
+            std::vector<T> xi(ndim);
+            for (unsigned int i = 0; i < n; ++i) {
+               for (unsigned int j = 0; j < ndim; ++j)
+                  xi[j] = x[j][i];
+               f[i] = DoEvalPar(xi.data(), p);
+            }
+         }
+
          /**
             Implement the ROOT::Math::IBaseFunctionMultiDim interface DoEval(x) using the cached parameter values
          */
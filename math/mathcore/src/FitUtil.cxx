@@ -49,6 +49,9 @@ namespace ROOT {
 
       namespace FitUtil {
 
+         // number of points evaluated together with IModelFunction::EvalBatch
+         const unsigned int kBatchSize = 256;
+
          // derivative with respect of the parameter to be integrated
          template<class GradFunc = IGradModelFunction>
          struct ParamDerivFunc {
@@ -270,15 +273,66 @@ namespace ROOT {
 
    (const_cast<IModelFunction &>(func)).SetParameters(p);
 
-   auto mapFunction = [&](const unsigned i){
+   // chi2 contribution of the point i given the function value fval
+   auto residual = [&](const unsigned i, double fval) {
 
       double chi2{};
-      double fval{};
 
-      const auto x1 = data.GetCoordComponent(i, 0);
       const auto y = data.Value(i);
       auto invError = data.InvError(i);
 
+      // expected errors
+      if (useExpErrors) {
+         double invWeight  = 1.0; 
+         if (isWeighted) {
+            // we need first to check if a weight factor needs to be applied
+            // weight = sumw2/sumw = error**2/content
+            //invWeight = y * invError * invError;
+            // we use always the global weight and not the observed one in the bin
+            // for empty bins use global weight (if it is weighted data.SumError2() is not zero)
+            invWeight = data.SumOfContent()/ data.SumOfError2();
+            //if (invError > 0) invWeight = y * invError * invError;
+         }
+         
+         //  if (invError == 0) invWeight = (data.SumOfError2() > 0) ? data.SumOfContent()/ data.SumOfError2() : 1.0;
+         // compute expected error  as f(x) / weight
+         double invError2 = (fval > 0) ? invWeight / fval : 0.0;
+         invError = std::sqrt(invError2);
+         //std::cout << "using Pearson chi2 " << x[0] << "  " << 1./invError2 << "  " << fval << std::endl;
+      }
+
+//#define DEBUG
+#ifdef DEBUG
+      std::cout << *data.GetCoordComponent(i, 0) << "  " << y << "  " << 1./invError << " params : ";
+      for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
+         std::cout << p[ipar] << "\t";
+      std::cout << "\tfval = " << fval << " ref " << wrefVolume << std::endl;
+#endif
+//#undef DEBUG
+
+      if (invError > 0) {
+
+         double tmp = ( y -fval )* invError;
+         double resval = tmp * tmp;
+
+
+         // avoid inifinity or nan in chi2 values due to wrong function values
+         if ( resval < maxResValue )
+            chi2 += resval;
+         else {
+            //nRejected++;
+            chi2 += maxResValue;
+         }
+      }
+      return chi2;
+   };
+
+   auto mapFunction = [&](const unsigned i){
+
+      double fval{};
+
+      const auto x1 = data.GetCoordComponent(i, 0);
+
       //invError = (invError!= 0.0) ? 1.0/invError :1;
 
       const double * x = nullptr;
@@ -322,51 +376,27 @@ namespace ROOT {
       // normalize result if requested according to bin volume
       if (useBinVolume) fval *= binVolume;
 
-      // expected errors
-      if (useExpErrors) {
-         double invWeight  = 1.0; 
-         if (isWeighted) {
-            // we need first to check if a weight factor needs to be applied
-            // weight = sumw2/sumw = error**2/content
-            //invWeight = y * invError * invError;
-            // we use always the global weight and not the observed one in the bin
-            // for empty bins use global weight (if it is weighted data.SumError2() is not zero)
-            invWeight = data.SumOfContent()/ data.SumOfError2();
-            //if (invError > 0) invWeight = y * invError * invError;
-         }
-         
-         //  if (invError == 0) invWeight = (data.SumOfError2() > 0) ? data.SumOfContent()/ data.SumOfError2() : 1.0;
-         // compute expected error  as f(x) / weight
-         double invError2 = (fval > 0) ? invWeight / fval : 0.0;
-         invError = std::sqrt(invError2);
-         //std::cout << "using Pearson chi2 " << x[0] << "  " << 1./invError2 << "  " << fval << std::endl;
-      }
-
-//#define DEBUG
-#ifdef DEBUG
-      std::cout << x[0] << "  " << y << "  " << 1./invError << " params : ";
-      for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
-         std::cout << p[ipar] << "\t";
-      std::cout << "\tfval = " << fval << " bin volume " << binVolume << " ref " << wrefVolume << std::endl;
-#endif
-//#undef DEBUG
-
-      if (invError > 0) {
-
-         double tmp = ( y -fval )* invError;
-         double resval = tmp * tmp;
+      return residual(i, fval);
+  };
 
+   // when the function is needed only at the bin centers, the points are evaluated in batches
+   // using the coordinates as they are stored in the data (one array per dimension)
+   const bool useBatches = !useBinIntegral && !useBinVolume;
+   const unsigned int nBatches = (n + kBatchSize - 1) / kBatchSize;
+   auto batchFunction = [&](const unsigned ibatch) {
+      const unsigned int first = ibatch * kBatchSize;
+      const unsigned int nb = std::min(kBatchSize, n - first);
+      std::vector<const double *> x(data.NDim());
+      for (unsigned int j = 0; j < data.NDim(); ++j)
+         x[j] = data.GetCoordComponent(first, j);
+      double fval[kBatchSize];
+      func.EvalBatch(nb, x.data(), p, fval);
 
-         // avoid inifinity or nan in chi2 values due to wrong function values
-         if ( resval < maxResValue )
-            chi2 += resval;
-         else {
-            //nRejected++;
-            chi2 += maxResValue;
-         }
-      }
+      double chi2{};
+      for (unsigned int k = 0; k < nb; ++k)
+         chi2 += residual(first + k, fval[k]);
       return chi2;
-  };
+   };
 
 #ifdef R__USE_IMT
   auto redFunction = [](const std::vector<double> & objs){
@@ -385,14 +415,23 @@ namespace ROOT {
 
   double res{};
   if(executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial){
-    for (unsigned int i=0; i<n; ++i) {
-      res += mapFunction(i);
+    if (useBatches) {
+      for (unsigned int ibatch = 0; ibatch < nBatches; ++ibatch)
+        res += batchFunction(ibatch);
+    } else {
+      for (unsigned int i=0; i<n; ++i) {
+        res += mapFunction(i);
+      }
     }
 #ifdef R__USE_IMT
   } else if(executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
     ROOT::TThreadExecutor pool;
     auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
-    res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
+    if (useBatches)
+      res = pool.MapReduce(batchFunction, ROOT::TSeq<unsigned>(0, nBatches), redFunction,
+                           std::min(chunks, nBatches));
+    else
+      res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
 #endif
 //   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
     // ROOT::TProcessExecutor pool;
@@ -956,30 +995,10 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
 
          // needed to compue effective global weight in case of extended likelihood
 
-         auto mapFunction = [&](const unsigned i) {
+         // log-likelihood contribution of the point i given the function value fval
+         auto logLikelihood = [&](const unsigned i, double fval) {
             double W = 0;
             double W2 = 0;
-            double fval = 0;
-
-            if (data.NDim() > 1) {
-               std::vector<double> x(data.NDim());
-               for (unsigned int j = 0; j < data.NDim(); ++j)
-                  x[j] = *data.GetCoordComponent(i, j);
-#ifdef USE_PARAMCACHE
-               fval = func(x.data());
-#else
-               fval = func(x.data(), p);
-#endif
-
-               // one -dim case
-            } else {
-               const auto x = data.GetCoordComponent(i, 0);
-#ifdef USE_PARAMCACHE
-               fval = func(x);
-#else
-               fval = func(x, p);
-#endif
-            }
 
             if (normalizeFunc)
                fval = fval * (1 / norm);
@@ -1007,6 +1026,24 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
             return LikelihoodAux<double>(logval, W, W2);
          };
 
+         // the function is evaluated in batches of points, using the coordinates as they are stored
+         // in the data (one array per dimension)
+         const unsigned int nBatches = (n + kBatchSize - 1) / kBatchSize;
+         auto batchFunction = [&](const unsigned ibatch) {
+            const unsigned int first = ibatch * kBatchSize;
+            const unsigned int nb = std::min(kBatchSize, n - first);
+            std::vector<const double *> x(data.NDim());
+            for (unsigned int j = 0; j < data.NDim(); ++j)
+               x[j] = data.GetCoordComponent(first, j);
+            double fval[kBatchSize];
+            func.EvalBatch(nb, x.data(), p, fval);
+
+            auto l0 = LikelihoodAux<double>(0.0, 0.0, 0.0);
+            for (unsigned int k = 0; k < nb; ++k)
+               l0 = l0 + logLikelihood(first + k, fval[k]);
+            return l0;
+         };
+
 #ifdef R__USE_IMT
   // auto redFunction = [](const std::vector<LikelihoodAux<double>> & objs){
   //          return std::accumulate(objs.begin(), objs.end(), LikelihoodAux<double>(0.0,0.0,0.0),
@@ -1037,8 +1074,8 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
   double sumW{};
   double sumW2{};
   if(executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial){
-    for (unsigned int i=0; i<n; ++i) {
-      auto resArray = mapFunction(i);
+    for (unsigned int ibatch = 0; ibatch < nBatches; ++ibatch) {
+      auto resArray = batchFunction(ibatch);
       logl+=resArray.logvalue;
       sumW+=resArray.weight;
       sumW2+=resArray.weight2;
@@ -1047,7 +1084,8 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
   } else if(executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
     ROOT::TThreadExecutor pool;
     auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
-    auto resArray = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
+    auto resArray = pool.MapReduce(batchFunction, ROOT::TSeq<unsigned>(0, nBatches), redFunction,
+                                   std::min(chunks, nBatches));
     logl=resArray.logvalue;
     sumW=resArray.weight;
     sumW2=resArray.weight2;
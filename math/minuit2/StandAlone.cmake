@@ -81,6 +81,14 @@ if(minuit2_mpi)
 endif()
 
 # Add the libraries
+if(minuit2_blas)
+    if(CMAKE_PROJECT_NAME STREQUAL PROJECT_NAME)
+        message(STATUS "Building Minuit2 with BLAS support")
+    endif()
+    target_compile_definitions(Minuit2Common INTERFACE MN_USE_BLAS)
+    target_link_libraries(Minuit2Common INTERFACE BLAS::BLAS)
+endif()
+
 add_subdirectory(src)
 
 # Exporting targets to allow find_package(Minuit2) to work properly
@@ -269,6 +269,10 @@ public:
       fSize = prod.Obj().B().Obj().size();
       fData = (double*)StackAllocatorHolder::Get().Allocate(sizeof(double)*fSize);
       Mndspmv("U", fSize, double(prod.f()*prod.Obj().A().f()*prod.Obj().B().f()), prod.Obj().A().Obj().Data(), prod.Obj().B().Obj().Data(), 1, 0., fData, 1);
+    } else if(prod.Obj().B().Obj().Data() != fData) {
+      // the result is written directly, a temporary copy is needed only for v = M*v
+      assert(fSize == prod.Obj().B().Obj().size());
+      Mndspmv("U", fSize, double(prod.f()*prod.Obj().A().f()*prod.Obj().B().f()), prod.Obj().A().Obj().Data(), prod.Obj().B().Obj().Data(), 1, 0., fData, 1);
     } else {
       LAVector tmp(prod.Obj().B());
       assert(fSize == tmp.size());
@@ -53,6 +53,9 @@ inline ABObj<sym, VectorOuterProduct<ABObj<vec, LAVector, T>, T>, T> operator-(c
 
 void Outer_prod(LASymMatrix&, const LAVector&, double f = 1.);
 
+// add f*(v1*v2^T + v2*v1^T) to the symmetric matrix
+void Outer_prod(LASymMatrix&, const LAVector& v1, const LAVector& v2, double f = 1.);
+
   }  // namespace Minuit2
 
 }  // namespace ROOT
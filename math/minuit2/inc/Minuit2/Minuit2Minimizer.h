@@ -51,6 +51,10 @@ namespace ROOT {
    Using a string  (used by the plugin manager) or via an enumeration
    an one can set all the possible minimization algorithms (Migrad, Simplex, Combined, Scan and Fumili).
 
+   With the extra option "ParallelDerivatives" (integer, default 0) of the "Minuit2" default options,
+   the numerical gradient and the Hessian are computed in parallel over the parameters when ROOT
+   implicit multi-threading is enabled. The minimized function must then be thread-safe.
+
    @ingroup Minuit
 */
 class Minuit2Minimizer : public ROOT::Math::Minimizer {
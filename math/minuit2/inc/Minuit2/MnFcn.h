@@ -14,6 +14,7 @@
 #include "Minuit2/MnMatrix.h"
 
 #include <vector>
+#include <atomic>
 
 namespace ROOT {
 
@@ -56,7 +57,8 @@ private:
 
 protected:
 
-  mutable int fNumCall;
+  // atomic since the FCN can be called concurrently when the derivatives are computed in parallel
+  mutable std::atomic<int> fNumCall;
 };
 
   }  // namespace Minuit2
@@ -49,6 +49,8 @@ public:
 
    int StorageLevel() const { return fStoreLevel; }
 
+   bool ParallelDerivatives() const { return fParallelDerivatives; }
+
    bool IsLow() const {return fStrategy == 0;}
    bool IsMedium() const {return fStrategy == 1;}
    bool IsHigh() const {return fStrategy >= 2;}
@@ -69,6 +71,11 @@ public:
    // set storage level of iteration quantities
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
+
+   // compute the numerical gradient and the Hessian in parallel over the parameters,
+   // using the ROOT implicit multi-threading pool when it is enabled (default is false).
+   // The FCN is then called concurrently from several threads and must be thread-safe
+   void SetParallelDerivatives(bool on = true) { fParallelDerivatives = on; }
 private:
 
    unsigned int fStrategy;
@@ -81,6 +88,7 @@ private:
    double fHessTlrG2;
    unsigned int fHessGradNCyc;
    int fStoreLevel;
+   bool fParallelDerivatives;
 };
 
   }  // namespace Minuit2
@@ -47,6 +47,12 @@ class StackError {};
     of heap memory which is then used like a stack, otherwise via standard
     malloc/free. Note that defining _MN_NO_THREAD_SAVE_ makes the code thread-
     unsave. The gain in performance is mainly for cost-cheap FCN functions.
+    In the malloc/free case, the blocks which are freed are kept in a cache
+    of each thread and given back by the next allocations of the same size,
+    since the vectors and matrices of a minimization have a few sizes only.
+    ReleaseCache frees the blocks cached by the calling thread: it is called at
+    the end of a minimization, and by the worker threads computing derivatives
+    in parallel at the end of each of their tasks.
  */
 
 class StackAllocator {
@@ -94,8 +100,7 @@ public:
 #endif
 
 #else
-      void* result = malloc(nBytes);
-      if (!result) throw std::bad_alloc();
+      void* result = AllocateBlock(nBytes);
 #endif
 
       return result;
@@ -124,7 +129,7 @@ public:
       CheckConsistency();
 #endif
 #else
-      free(p);
+      FreeBlock(p);
 #endif
       // std::cout << "Block at " << delBlock
       //   << " deallocated, fStackOffset = " << fStackOffset << std::endl;
@@ -202,8 +207,13 @@ public:
      return true;
   }
 
+  static void ReleaseCache();
+
 private:
 
+  static void* AllocateBlock(size_t nBytes);
+  static void FreeBlock(void* p);
+
   unsigned char* fStack;
 //   unsigned char fStack[default_size];
   int            fStackOffset;
@@ -11,6 +11,7 @@
 #include "Minuit2/MinimumState.h"
 #include "Minuit2/LaSum.h"
 #include "Minuit2/LaProd.h"
+#include "Minuit2/LaOuterProduct.h"
 
 //#define DEBUG
 
@@ -72,11 +73,16 @@ MinimumError DavidonErrorUpdator::Update(const MinimumState& s0,
 
    MnAlgebraicVector vg = v0*dg;
 
-   MnAlgebraicSymMatrix vUpd = Outer_product(dx)/delgam - Outer_product(vg)/gvg;
+   // the outer products are added in place to the update matrix, without temporary matrices
+   MnAlgebraicSymMatrix vUpd(v0.Nrow());
+   Outer_prod(vUpd, dx, 1./delgam);
+   Outer_prod(vUpd, vg, -1./gvg);
 
    if(delgam > gvg) {
-      // use rank 1 formula
-      vUpd += gvg*Outer_product(MnAlgebraicVector(dx/delgam - vg/gvg));
+      // use rank 1 formula, dx is not needed anymore and holds dx/delgam - vg/gvg
+      dx *= 1./delgam;
+      dx += (-1./gvg)*vg;
+      Outer_prod(vUpd, dx, gvg);
    }
 
    double sum_upd = sum_of_elements(vUpd);
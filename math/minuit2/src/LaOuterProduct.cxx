@@ -17,6 +17,7 @@ namespace ROOT {
 
 
 int mndspr(const char*, unsigned int, double, const double*, int, double*);
+int mndspr2(const char*, unsigned int, double, const double*, int, const double*, int, double*);
 
 LASymMatrix::LASymMatrix(const ABObj<sym, VectorOuterProduct<ABObj<vec, LAVector, double>, double>, double>& out) : fSize(0), fNRow(0), fData(0) {
    // constructor from expression based on outer product of symmetric matrices
@@ -52,6 +53,12 @@ void Outer_prod(LASymMatrix& A, const LAVector& v, double f) {
    mndspr("U", v.size(), f, v.Data(), 1, A.Data());
 }
 
+void Outer_prod(LASymMatrix& A, const LAVector& v1, const LAVector& v2, double f) {
+   // function performing the symmetric rank 2 update using mndspr2 (DSPR2) routine from BLAS
+   assert(v1.size() == v2.size());
+   mndspr2("U", v1.size(), f, v1.Data(), 1, v2.Data(), 1, A.Data());
+}
+
    }  // namespace Minuit2
 
 }  // namespace ROOT
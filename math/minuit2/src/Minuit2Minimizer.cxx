@@ -467,6 +467,11 @@ bool Minuit2Minimizer::Minimize() {
       bool ret = minuit2Opt->GetValue("StorageLevel",storageLevel);
       if (ret) SetStorageLevel(storageLevel);
 
+      // compute the numerical derivatives in parallel over the parameters (needs a thread-safe FCN)
+      int parallelDerivatives = 0;
+      minuit2Opt->GetValue("ParallelDerivatives",parallelDerivatives);
+      strategy.SetParallelDerivatives(parallelDerivatives != 0);
+
       if (printLevel > 0) {
          std::cout << "Minuit2Minimizer::Minuit  - Changing default options" << std::endl;
          minuit2Opt->Print();
@@ -1048,7 +1053,13 @@ bool Minuit2Minimizer::Hesse( ) {
    // set the precision if needed
    if (Precision() > 0) fState.SetPrecision(Precision());
 
-   ROOT::Minuit2::MnHesse hesse( strategy );
+   ROOT::Minuit2::MnStrategy mnStrategy(strategy);
+   ROOT::Math::IOptions * minuit2Opt = ROOT::Math::MinimizerOptions::FindDefault("Minuit2");
+   int parallelDerivatives = 0;
+   if (minuit2Opt && minuit2Opt->GetValue("ParallelDerivatives",parallelDerivatives))
+      mnStrategy.SetParallelDerivatives(parallelDerivatives != 0);
+
+   ROOT::Minuit2::MnHesse hesse( mnStrategy );
 
 
    // case when function minimum exists
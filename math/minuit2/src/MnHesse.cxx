@@ -30,6 +30,22 @@
 
 #include "Minuit2/MPIProcess.h"
 
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h"
+#endif
+// as in Numerical2PGradientCalculator, the derivatives can be computed in parallel
+// over the parameters with the ROOT implicit multi-threading pool
+#if defined(R__USE_IMT) && !defined(_OPENMP) && !defined(MPIPROC)
+#define MINUIT2_PARALLEL_DERIVATIVES
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#include <thread>
+#endif
+
+#include <algorithm>
+#include <vector>
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -130,7 +146,9 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
 #endif
 
 
-   for(unsigned int i = 0; i < n; i++) {
+   // compute the second derivative with respect to the internal parameter i, varying x(i) only;
+   // return false if it is found to be zero
+   auto diagonal = [&](unsigned int i, MnAlgebraicVector &x) {
 
       double xtf = x(i);
       double dmin = 8.*prec.Eps2()*(fabs(xtf) + prec.Eps2());
@@ -180,12 +198,7 @@ L26:
          }
 #endif
 
-         for(unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
-            vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
-
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+         return false;
 
 L30:
             double g2bfor = g2(i);
@@ -212,22 +225,53 @@ L30:
          d = std::max(d, 0.1*dlast);
       }
       vhmat(i,i) = g2(i);
-      if(mfcn.NumOfCalls()  > maxcalls) {
+      return true;
+   };
+
+   // the diagonal matrix returned when the calculation fails
+   auto failedState = [&]() {
+      for(unsigned int j = 0; j < n; j++) {
+         double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
+         vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
+      }
+
+      return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+   };
 
+   auto callsExhausted = [&]() {
+      if(mfcn.NumOfCalls()  <= maxcalls) return false;
 #ifdef WARNINGMSG
-         //std::cout<<"maxcalls " << maxcalls << " " << mfcn.NumOfCalls() << "  " <<   st.NFcn() << std::endl;
-         MN_INFO_MSG("MnHesse: maximum number of allowed function calls exhausted.");
-         MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
+      //std::cout<<"maxcalls " << maxcalls << " " << mfcn.NumOfCalls() << "  " <<   st.NFcn() << std::endl;
+      MN_INFO_MSG("MnHesse: maximum number of allowed function calls exhausted.");
+      MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
 #endif
-
-         for(unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
-            vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
+      return true;
+   };
+
+#ifdef MINUIT2_PARALLEL_DERIVATIVES
+   const bool parallel = fStrategy.ParallelDerivatives() && n > 1 && ROOT::IsImplicitMTEnabled();
+   const auto caller = std::this_thread::get_id();
+   if (parallel) {
+      // each task varies its own copy of the parameters; the number of calls is checked at the end
+      std::vector<char> ok(n);
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](unsigned int i) {
+         {
+            MnAlgebraicVector xi = x;
+            ok[i] = diagonal(i, xi);
          }
+         // the blocks cached by a worker thread would be kept until the thread ends
+         if (std::this_thread::get_id() != caller) StackAllocator::ReleaseCache();
+      }, ROOT::TSeq<unsigned int>(n));
 
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+      if (std::find(ok.begin(), ok.end(), 0) != ok.end() || callsExhausted()) return failedState();
+   }
+   else
+#endif
+   {
+      for(unsigned int i = 0; i < n; i++) {
+         if (!diagonal(i, x) || callsExhausted()) return failedState();
       }
-
    }
 
 #ifdef DEBUG
@@ -245,7 +289,27 @@ L30:
 
    //off-diagonal Elements
    // initial starting values
-   if (n > 0) { 
+#ifdef MINUIT2_PARALLEL_DERIVATIVES
+   if (parallel) {
+      // one task per row of the matrix
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](unsigned int i) {
+         {
+            MnAlgebraicVector xi = x;
+            xi(i) += dirin(i);
+            for (unsigned int j = i+1; j < n; j++) {
+               xi(j) += dirin(j);
+               double fs1 = mfcn(xi);
+               vhmat(i,j) = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+               xi(j) -= dirin(j);
+            }
+         }
+         if (std::this_thread::get_id() != caller) StackAllocator::ReleaseCache();
+      }, ROOT::TSeq<unsigned int>(n-1));
+   }
+   else
+#endif
+   if (n > 0) {
       MPIProcess mpiprocOffDiagonal(n*(n-1)/2,0);
       unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
       unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
@@ -25,6 +25,7 @@
 #include "Minuit2/MnHesse.h"
 #include "Minuit2/MnLineSearch.h"
 #include "Minuit2/MnParabolaPoint.h"
+#include "Minuit2/StackAllocator.h"
 
 #if defined(DEBUG) || defined(WARNINGMSG)
 #include "Minuit2/MnPrint.h"
@@ -163,7 +164,12 @@ FunctionMinimum ModularFunctionMinimizer::Minimize(const MnFcn& mfcn, const Grad
 
 
 
-   return mb.Minimum(mfcn, gc, seed, strategy, maxfcn, effective_toler);
+   FunctionMinimum min = mb.Minimum(mfcn, gc, seed, strategy, maxfcn, effective_toler);
+
+   // free the memory kept for the temporaries of the iterations
+   StackAllocator::ReleaseCache();
+
+   return min;
 }
 
 
@@ -33,6 +33,22 @@
 
 #include "Minuit2/MPIProcess.h"
 
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h"
+#endif
+// the parallel computation over the parameters uses the ROOT implicit multi-threading pool,
+// when OpenMP and MPI are not used already
+#if defined(R__USE_IMT) && !defined(_OPENMP) && !defined(MPIPROC)
+#define MINUIT2_PARALLEL_DERIVATIVES
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#include <thread>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -100,10 +116,6 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    MnAlgebraicVector g2 = Gradient.G2();
    MnAlgebraicVector gstep = Gradient.Gstep();
 
-#ifndef _OPENMP
-   MPIProcess mpiproc(n,0);
-#endif
-
 #ifdef DEBUG
    std::cout << "Calculating Gradient at x =   " << par.Vec() << std::endl;
    int pr = std::cout.precision(13);
@@ -111,37 +123,14 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    std::cout.precision(pr);
 #endif
 
-#ifndef _OPENMP
-   // for serial execution this can be outside the loop
-   MnAlgebraicVector x = par.Vec();
-
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
-
-   for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
-
-#else
-
- // parallelize this loop using OpenMP
-//#define N_PARALLEL_PAR 5
-#pragma omp parallel
-#pragma omp for
-//#pragma omp for schedule (static, N_PARALLEL_PAR)
-
-   for(int i = 0; i < int(n); i++) {
-
-#endif
+   // compute the derivatives with respect to the internal parameter i, varying x(i) only
+   auto derivative = [&](unsigned int i, MnAlgebraicVector &x) {
 
 #ifdef DEBUG_MP
       int ith = omp_get_thread_num();
       //std::cout << "Thread number " << ith << "  " << i << std::endl;
 #endif
 
-#ifdef _OPENMP
-       // create in loop since each thread will use its own copy
-      MnAlgebraicVector x = par.Vec();
-#endif
-
       double xtf = x(i);
       double epspri = eps2 + fabs(grd(i)*eps2);
       double stepb4 = 0.;
@@ -217,12 +206,61 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
       std::cout << "Parameter " << Trafo().Name(iext) << " Gradient =   " << grd(i) << " g2 = " << g2(i) << " step " << gstep(i) << std::endl;
       std::cout.precision(pr);
 #endif
-   }
+   };
 
 #ifndef _OPENMP
-   mpiproc.SyncVector(grd);
-   mpiproc.SyncVector(g2);
-   mpiproc.SyncVector(gstep);
+
+#ifdef MINUIT2_PARALLEL_DERIVATIVES
+   if (Strategy().ParallelDerivatives() && n > 1 && ROOT::IsImplicitMTEnabled()) {
+      // each task varies its own copy of the parameters
+      const auto caller = std::this_thread::get_id();
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](unsigned int i) {
+         {
+            MnAlgebraicVector x = par.Vec();
+            derivative(i, x);
+         }
+         // the blocks cached by a worker thread would be kept until the thread ends
+         if (std::this_thread::get_id() != caller) StackAllocator::ReleaseCache();
+      }, ROOT::TSeq<unsigned int>(n));
+   }
+   else
+#endif
+   {
+      MPIProcess mpiproc(n,0);
+
+      // for serial execution this can be outside the loop
+      MnAlgebraicVector x = par.Vec();
+
+      unsigned int startElementIndex = mpiproc.StartElementIndex();
+      unsigned int endElementIndex = mpiproc.EndElementIndex();
+
+      for(unsigned int i = startElementIndex; i < endElementIndex; i++)
+         derivative(i, x);
+
+      mpiproc.SyncVector(grd);
+      mpiproc.SyncVector(g2);
+      mpiproc.SyncVector(gstep);
+   }
+
+#else
+
+ // parallelize this loop using OpenMP
+//#define N_PARALLEL_PAR 5
+#pragma omp parallel
+#pragma omp for
+//#pragma omp for schedule (static, N_PARALLEL_PAR)
+
+   for(int i = 0; i < int(n); i++) {
+      {
+         // create in loop since each thread will use its own copy
+         MnAlgebraicVector x = par.Vec();
+         derivative(i, x);
+      }
+      // the blocks cached by a worker thread would be kept until the thread ends
+      if (omp_get_thread_num() != 0) StackAllocator::ReleaseCache();
+   }
+
 #endif
 
 #ifdef DEBUG
@@ -0,0 +1,104 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2018 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/StackAllocator.h"
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+namespace {
+
+// each block starts with its size, the header keeps the alignment given by malloc
+const size_t kHeaderSize = 16;
+
+// maximum number of blocks and of bytes kept by the cache of a thread
+const unsigned int kMaxCachedBlocks = 32;
+const size_t kMaxCachedBytes = 32*1024*1024;
+
+// set when the cache of the thread is destroyed, the blocks freed afterwards
+// (e.g. by the destructors of static objects) are given back to the system
+thread_local bool gCacheDestroyed = false;
+
+struct BlockCache {
+   void* fBlocks[kMaxCachedBlocks];
+   size_t fSizes[kMaxCachedBlocks];
+   unsigned int fNBlocks;
+   size_t fNBytes;
+
+   BlockCache() : fNBlocks(0), fNBytes(0) {}
+
+   ~BlockCache() {
+      Release();
+      gCacheDestroyed = true;
+   }
+
+   void Release() {
+      for (unsigned int i = 0; i < fNBlocks; ++i)
+         free(fBlocks[i]);
+      fNBlocks = 0;
+      fNBytes = 0;
+   }
+};
+
+BlockCache& GetCache() {
+   thread_local BlockCache cache;
+   return cache;
+}
+
+}
+
+void* StackAllocator::AllocateBlock(size_t nBytes) {
+   // allocate a block of nBytes, re-using a cached block of the same size if any
+   if (!gCacheDestroyed) {
+      BlockCache& cache = GetCache();
+      // look first at the blocks freed last
+      for (unsigned int i = cache.fNBlocks; i > 0; --i) {
+         if (cache.fSizes[i-1] == nBytes) {
+            void* block = cache.fBlocks[i-1];
+            cache.fNBytes -= nBytes;
+            --cache.fNBlocks;
+            cache.fBlocks[i-1] = cache.fBlocks[cache.fNBlocks];
+            cache.fSizes[i-1] = cache.fSizes[cache.fNBlocks];
+            return static_cast<unsigned char*>(block) + kHeaderSize;
+         }
+      }
+   }
+
+   void* block = malloc(nBytes + kHeaderSize);
+   if (!block) throw std::bad_alloc();
+   *static_cast<size_t*>(block) = nBytes;
+   return static_cast<unsigned char*>(block) + kHeaderSize;
+}
+
+void StackAllocator::FreeBlock(void* p) {
+   // give back a block allocated by AllocateBlock, keeping it in the cache if there is room left
+   if (!p) return;
+   void* block = static_cast<unsigned char*>(p) - kHeaderSize;
+   size_t nBytes = *static_cast<size_t*>(block);
+   if (!gCacheDestroyed) {
+      BlockCache& cache = GetCache();
+      if (cache.fNBlocks < kMaxCachedBlocks && cache.fNBytes + nBytes <= kMaxCachedBytes) {
+         cache.fBlocks[cache.fNBlocks] = block;
+         cache.fSizes[cache.fNBlocks] = nBytes;
+         ++cache.fNBlocks;
+         cache.fNBytes += nBytes;
+         return;
+      }
+   }
+   free(block);
+}
+
+void StackAllocator::ReleaseCache() {
+   // free the blocks cached by the calling thread
+   if (!gCacheDestroyed) GetCache().Release();
+}
+
+   }  // namespace Minuit2
+
+}  // namespace ROOT
@@ -14,6 +14,10 @@
 
 #include <math.h>
 
+#ifdef MN_USE_BLAS
+extern "C" double dasum_(const int* n, const double* dx, const int* incx);
+#endif
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -36,6 +40,11 @@ double mndasum(unsigned int n, const double* dx, int incx) {
    /*     modified 12/3/93, array(1) declarations changed to array(*) */
 
 
+#ifdef MN_USE_BLAS
+   int nn = n;
+   return dasum_(&nn, dx, &incx);
+#endif
+
    /* Parameter adjustments */
    --dx;
 
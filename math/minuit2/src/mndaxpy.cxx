@@ -12,6 +12,11 @@
       -lf2c -lm   (in that order)
 */
 
+#ifdef MN_USE_BLAS
+extern "C" void daxpy_(const int* n, const double* da, const double* dx, const int* incx, double* dy,
+                       const int* incy);
+#endif
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -32,6 +37,12 @@ int Mndaxpy(unsigned int n, double da, const double* dx, int incx, double* dy,
    /*     modified 12/3/93, array(1) declarations changed to array(*) */
 
 
+#ifdef MN_USE_BLAS
+   int nn = n;
+   daxpy_(&nn, &da, dx, &incx, dy, &incy);
+   return 0;
+#endif
+
    /* Parameter adjustments */
    --dy;
    --dx;
@@ -12,6 +12,10 @@
    -lf2c -lm   (in that order)
 */
 
+#ifdef MN_USE_BLAS
+extern "C" double ddot_(const int* n, const double* dx, const int* incx, const double* dy, const int* incy);
+#endif
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -35,6 +39,11 @@ double mnddot(unsigned int n, const double* dx, int incx, const double* dy,
    /*     modified 12/3/93, array(1) declarations changed to array(*) */
 
 
+#ifdef MN_USE_BLAS
+   int nn = n;
+   return ddot_(&nn, dx, &incx, dy, &incy);
+#endif
+
    /* Parameter adjustments */
    --dy;
    --dx;
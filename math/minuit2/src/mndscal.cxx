@@ -12,6 +12,10 @@
    -lf2c -lm   (in that order)
 */
 
+#ifdef MN_USE_BLAS
+extern "C" void dscal_(const int* n, const double* da, double* dx, const int* incx);
+#endif
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -32,6 +36,12 @@ int Mndscal(unsigned int n, double da, double* dx, int incx) {
    /*     modified 12/3/93, array(1) declarations changed to array(*) */
 
 
+#ifdef MN_USE_BLAS
+   int nn = n;
+   dscal_(&nn, &da, dx, &incx);
+   return 0;
+#endif
+
    /* Parameter adjustments */
    --dx;
 
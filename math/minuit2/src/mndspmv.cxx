@@ -12,6 +12,11 @@
    -lf2c -lm   (in that order)
 */
 
+#ifdef MN_USE_BLAS
+extern "C" void dspmv_(const char* uplo, const int* n, const double* alpha, const double* ap, const double* x,
+                       const int* incx, const double* beta, double* y, const int* incy);
+#endif
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -131,6 +136,12 @@ int Mndspmv(const char* uplo, unsigned int n, double alpha,
 
    /*     Test the input parameters. */
 
+#ifdef MN_USE_BLAS
+   int nn = n;
+   dspmv_(uplo, &nn, &alpha, ap, x, &incx, &beta, y, &incy);
+   return 0;
+#endif
+
    /* Parameter adjustments */
    --y;
    --x;
@@ -12,6 +12,11 @@
    -lf2c -lm   (in that order)
 */
 
+#ifdef MN_USE_BLAS
+extern "C" void dspr_(const char* uplo, const int* n, const double* alpha, const double* x, const int* incx,
+                      double* ap);
+#endif
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -117,6 +122,12 @@ int mndspr(const char* uplo, unsigned int n, double alpha,
 
    /*     Test the input parameters. */
 
+#ifdef MN_USE_BLAS
+   int nn = n;
+   dspr_(uplo, &nn, &alpha, x, &incx, ap);
+   return 0;
+#endif
+
    /* Parameter adjustments */
    --ap;
    --x;
@@ -0,0 +1,91 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2018 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifdef MN_USE_BLAS
+extern "C" void dspr2_(const char* uplo, const int* n, const double* alpha, const double* x, const int* incx,
+                       const double* y, const int* incy, double* ap);
+#endif
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+
+bool mnlsame(const char*, const char*);
+int mnxerbla(const char*, int);
+
+int mndspr2(const char* uplo, unsigned int n, double alpha,
+            const double* x, int incx, const double* y, int incy, double* ap) {
+
+   /*  DSPR2   performs the symmetric rank 2 operation */
+
+   /*     A := alpha*x*y' + alpha*y*x' + A, */
+
+   /*  where alpha is a scalar, x and y are n element vectors and A is an */
+   /*  n by n symmetric matrix, supplied in packed form (see mndspr). */
+
+   int info = 0;
+   if (! mnlsame(uplo, "U") && ! mnlsame(uplo, "L")) {
+      info = 1;
+   }
+   else if (incx == 0) {
+      info = 5;
+   }
+   else if (incy == 0) {
+      info = 7;
+   }
+   if (info != 0) {
+      mnxerbla("DSPR2 ", info);
+      return 0;
+   }
+
+   if (n == 0 || alpha == 0.) {
+      return 0;
+   }
+
+#ifdef MN_USE_BLAS
+   int nn = n;
+   dspr2_(uplo, &nn, &alpha, x, &incx, y, &incy, ap);
+   return 0;
+#else
+
+   // start of the vectors if the increments are negative
+   const int kx = incx > 0 ? 0 : (1 - static_cast<int>(n)) * incx;
+   const int ky = incy > 0 ? 0 : (1 - static_cast<int>(n)) * incy;
+
+   // the elements of AP are accessed sequentially, column by column
+   double* col = ap;
+   const bool upper = mnlsame(uplo, "U");
+   for (unsigned int j = 0; j < n; ++j) {
+      const double xj = x[kx + static_cast<int>(j) * incx];
+      const double yj = y[ky + static_cast<int>(j) * incy];
+      // rows 0..j of column j (upper) or rows j..n-1 (lower)
+      const unsigned int first = upper ? 0 : j;
+      const unsigned int last = upper ? j + 1 : n;
+      if (xj != 0. || yj != 0.) {
+         const double temp1 = alpha * yj;
+         const double temp2 = alpha * xj;
+         if (incx == 1 && incy == 1) {
+            for (unsigned int i = first; i < last; ++i)
+               col[i - first] += x[i] * temp1 + y[i] * temp2;
+         } else {
+            for (unsigned int i = first; i < last; ++i)
+               col[i - first] += x[kx + static_cast<int>(i) * incx] * temp1 + y[ky + static_cast<int>(i) * incy] * temp2;
+         }
+      }
+      col += last - first;
+   }
+
+   return 0;
+#endif
+}
+
+
+   }  // namespace Minuit2
+
+}  // namespace ROOT
@@ -0,0 +1,141 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2018 LCG ROOT Math team,  CERN/EP-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/BFGSErrorUpdator.h"
+#include "Minuit2/FunctionGradient.h"
+#include "Minuit2/MinimumError.h"
+#include "Minuit2/MinimumParameters.h"
+#include "Minuit2/MinimumState.h"
+#include "Minuit2/MnMatrix.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// check the BFGS update of the inverse Hessian, computed with the symmetric rank 2 kernel
+// (mndspr2), against the former computation: the rank 1 update with dx plus the product
+// of the inverse Hessian with the square matrix dg * dx^T, made symmetric.
+
+using namespace ROOT::Minuit2;
+
+// a square matrix stored by rows, as the one of the former computation
+typedef std::vector<std::vector<double> > SquareMatrix;
+
+// deterministic pseudo-random numbers in [-1, 1)
+double Random() {
+   static unsigned long long seed = 12345;
+   seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+   return double(seed >> 11) / double(1ULL << 52) - 1.;
+}
+
+struct Reference {
+   SquareMatrix invHessian;
+   double dcovar;
+};
+
+// the update as it was computed before the rank 2 kernel
+Reference OldUpdate(const SquareMatrix& v0, double dcov0, const std::vector<double>& dx, const std::vector<double>& dg) {
+   const unsigned int n = dx.size();
+   double delgam = 0, gvg = 0;
+   for (unsigned int i = 0; i < n; ++i) {
+      delgam += dx[i] * dg[i];
+      for (unsigned int j = 0; j < n; ++j)
+         gvg += dg[i] * v0[i][j] * dg[j];
+   }
+
+   // a = dg * dx^T, b = v0 * a
+   SquareMatrix b(n, std::vector<double>(n, 0.));
+   for (unsigned int i = 0; i < n; ++i)
+      for (unsigned int j = 0; j < n; ++j)
+         for (unsigned int k = 0; k < n; ++k)
+            b[i][j] += v0[i][k] * dg[k] * dx[j];
+
+   Reference ref;
+   ref.invHessian = v0;
+   double sumUpd = 0, sum = 0;
+   for (unsigned int i = 0; i < n; ++i) {
+      for (unsigned int j = 0; j < n; ++j) {
+         const double upd = (delgam + gvg) * dx[i] * dx[j] / (delgam * delgam) - (b[i][j] + b[j][i]) / delgam;
+         ref.invHessian[i][j] += upd;
+         // the sums of the absolute values run over the upper triangle, as the matrices are packed
+         if (j >= i) {
+            sumUpd += std::fabs(upd);
+            sum += std::fabs(ref.invHessian[i][j]);
+         }
+      }
+   }
+   ref.dcovar = 0.5 * (dcov0 + sumUpd / sum);
+   return ref;
+}
+
+int TestUpdate(unsigned int n) {
+   // a positive definite inverse Hessian
+   SquareMatrix l(n, std::vector<double>(n));
+   for (unsigned int i = 0; i < n; ++i)
+      for (unsigned int j = 0; j < n; ++j)
+         l[i][j] = Random();
+   SquareMatrix v0(n, std::vector<double>(n, 0.));
+   MnAlgebraicSymMatrix invHessian(n);
+   for (unsigned int i = 0; i < n; ++i) {
+      for (unsigned int j = 0; j < n; ++j) {
+         for (unsigned int k = 0; k < n; ++k)
+            v0[i][j] += l[i][k] * l[j][k];
+         if (i == j) v0[i][j] += n;
+      }
+      for (unsigned int j = 0; j <= i; ++j)
+         invHessian(i, j) = v0[i][j];
+   }
+   const double dcov0 = 0.3;
+
+   std::vector<double> dx(n), dg(n);
+   MnAlgebraicVector x0(n), x1(n), g0(n), g1(n), g2(n), gstep(n);
+   for (unsigned int i = 0; i < n; ++i) {
+      x0(i) = Random();
+      g0(i) = Random();
+      dx[i] = 0.1 * Random();
+      // a gradient change along the step, so that dx^T dg > 0 as for a convex function
+      dg[i] = 2. * dx[i] + 0.05 * Random();
+      x1(i) = x0(i) + dx[i];
+      g1(i) = g0(i) + dg[i];
+      gstep(i) = 0.01;
+   }
+
+   MinimumState s0(MinimumParameters(x0, 1.), MinimumError(invHessian, dcov0), FunctionGradient(g0, g2, gstep), 1., 1);
+   MinimumError updated = BFGSErrorUpdator().Update(s0, MinimumParameters(x1, 0.5), FunctionGradient(g1, g2, gstep));
+
+   const Reference ref = OldUpdate(v0, dcov0, dx, dg);
+   const double tol = 1.E-12;
+   int iret = 0;
+   for (unsigned int i = 0; i < n; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+         const double diff = std::fabs(updated.InvHessian()(i, j) - ref.invHessian[i][j]);
+         if (diff > tol * std::max(1., std::fabs(ref.invHessian[i][j]))) {
+            std::cerr << "n = " << n << ": inverse Hessian (" << i << "," << j << ") differs: "
+                      << updated.InvHessian()(i, j) << " " << ref.invHessian[i][j] << std::endl;
+            iret = 1;
+         }
+      }
+   }
+   if (std::fabs(updated.Dcovar() - ref.dcovar) > tol * ref.dcovar) {
+      std::cerr << "n = " << n << ": dcovar differs: " << updated.Dcovar() << " " << ref.dcovar << std::endl;
+      iret = 1;
+   }
+   return iret;
+}
+
+int main() {
+
+   int iret = 0;
+   const unsigned int sizes[] = {1, 2, 5, 8, 33};
+   for (unsigned int n : sizes)
+      iret |= TestUpdate(n);
+
+   if (iret == 0)
+      std::cout << "The BFGS updates agree with the former computation" << std::endl;
+   return iret;
+}
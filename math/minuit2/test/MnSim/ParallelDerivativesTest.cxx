@@ -0,0 +1,131 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2018 LCG ROOT Math team,  CERN/EP-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/FCNBase.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnHesse.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnPrint.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnUserParameters.h"
+#include "Minuit2/MnUserParameterState.h"
+
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h"
+#endif
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// check that the numerical gradient and the Hessian computed in parallel over the
+// parameters (MnStrategy::SetParallelDerivatives) are the ones of the serial computation.
+// In ROOT builds with implicit multi-threading the derivatives are computed by the IMT
+// pool, otherwise the serial loops are used in both cases.
+
+using namespace ROOT::Minuit2;
+
+const unsigned int npar = 8;
+
+// a function without internal state, which can be evaluated from several threads at once
+struct CoupledQuarticFCN : public FCNBase {
+
+   double operator() (const std::vector<double> & p) const {
+      double f = 0;
+      for (unsigned int i = 0; i < p.size(); ++i) {
+         const double d = p[i] - i;
+         f += (1. + 0.1 * i) * d * d + 0.01 * d * d * d * d;
+         if (i + 1 < p.size())
+            f += 0.5 * d * (p[i+1] - i - 1);
+      }
+      return f;
+   }
+   double Up() const { return 1.; }
+};
+
+bool IsClose(double a, double b, double tol) {
+   return std::fabs(a - b) <= tol * std::max(1., std::max(std::fabs(a), std::fabs(b)));
+}
+
+struct FitResult {
+   std::vector<double> values;
+   std::vector<double> gradient;
+   MnUserCovariance covariance;
+   MnUserCovariance hessian; // Hessian at the starting point
+};
+
+FitResult doFit(bool parallel) {
+
+   CoupledQuarticFCN fcn;
+   MnUserParameters upar;
+   for (unsigned int i = 0; i < npar; ++i)
+      upar.Add(std::string("p") + std::to_string(i), -1. + 0.5 * i, 0.1);
+
+   MnStrategy strategy(2);
+   strategy.SetParallelDerivatives(parallel);
+
+   FitResult result;
+   MnHesse hesse(strategy);
+   result.hessian = hesse(fcn, upar).Hessian();
+
+   MnMigrad migrad(fcn, upar, strategy);
+   FunctionMinimum min = migrad();
+   hesse(fcn, min);
+   std::cout << "minimum (parallel derivatives " << parallel << "): " << min << std::endl;
+
+   result.values = min.UserState().Params();
+   for (unsigned int i = 0; i < npar; ++i)
+      result.gradient.push_back(min.State().Gradient().Grad()(i));
+   result.covariance = min.UserState().Covariance();
+   return result;
+}
+
+int main() {
+
+   const FitResult serial = doFit(false);
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   const FitResult parallel = doFit(true);
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+
+   // each parameter is varied from the same point in both cases: the results agree to rounding
+   const double tol = 1.E-10;
+   int iret = 0;
+   for (unsigned int i = 0; i < npar; ++i) {
+      if (!IsClose(serial.values[i], parallel.values[i], tol)) {
+         std::cerr << "Parameter " << i << " differs: " << serial.values[i] << " " << parallel.values[i] << std::endl;
+         iret = 1;
+      }
+      if (!IsClose(serial.gradient[i], parallel.gradient[i], tol)) {
+         std::cerr << "Gradient " << i << " differs: " << serial.gradient[i] << " " << parallel.gradient[i] << std::endl;
+         iret = 1;
+      }
+      for (unsigned int j = 0; j <= i; ++j) {
+         if (!IsClose(serial.hessian(i,j), parallel.hessian(i,j), tol)) {
+            std::cerr << "Hessian (" << i << "," << j << ") differs: " << serial.hessian(i,j) << " "
+                      << parallel.hessian(i,j) << std::endl;
+            iret = 1;
+         }
+         if (!IsClose(serial.covariance(i,j), parallel.covariance(i,j), tol)) {
+            std::cerr << "Covariance (" << i << "," << j << ") differs: " << serial.covariance(i,j) << " "
+                      << parallel.covariance(i,j) << std::endl;
+            iret = 1;
+         }
+      }
+   }
+   if (iret == 0)
+      std::cout << "Parallel derivatives agree with the serial ones" << std::endl;
+   return iret;
+}
@@ -45,6 +45,10 @@ Upon a second allocation, the vector *v* ceases to be a proxy
 v.emplace_back(0.);
 ~~~
 now the vector *v* owns its memory as a regular vector.
+
+The RAdoptAllocator can also be given a buffer of a few elements, provided by the owner of the container, to be used
+instead of heap memory whenever no more elements are requested. This is how RVec keeps small collections inline.
+Such a buffer belongs to the container that provided it: the allocator does not hand it out anymore once moved.
 **/
 
 
@@ -69,16 +73,42 @@ private:
    pointer fInitialAddress = nullptr;
    EAllocType fAllocType = EAllocType::kOwning;
    StdAlloc_t fStdAllocator;
+   pointer fInlineAddress = nullptr; ///< Buffer for up to fInlineSize elements, used instead of heap memory
+   std::size_t fInlineSize = 0;
+   bool fInlineInUse = false;
+
+   void DropInline()
+   {
+      fInlineAddress = nullptr;
+      fInlineSize = 0;
+      fInlineInUse = false;
+   }
 
 public:
    /// This is the constructor which allows the allocator to adopt a certain memory region.
    RAdoptAllocator(pointer p)
       : fInitialAddress(p), fAllocType(EAllocType::kAdoptingNoAllocYet){};
+   /// This constructor lets the allocator serve the allocations of up to inlineSize elements from a buffer owned by
+   /// the container.
+   RAdoptAllocator(pointer inlineAddress, std::size_t inlineSize)
+      : fInlineAddress(inlineAddress), fInlineSize(inlineAddress ? inlineSize : 0){};
    RAdoptAllocator() = default;
    RAdoptAllocator(const RAdoptAllocator &) = default;
-   RAdoptAllocator(RAdoptAllocator &&) = default;
+   /// The inline buffer stays with the container that provided it, which must not move memory allocated in it
+   RAdoptAllocator(RAdoptAllocator &&other)
+      : fInitialAddress(other.fInitialAddress), fAllocType(other.fAllocType),
+        fStdAllocator(std::move(other.fStdAllocator))
+   {
+   }
    RAdoptAllocator &operator=(const RAdoptAllocator &) = default;
-   RAdoptAllocator &operator=(RAdoptAllocator &&) = default;
+   RAdoptAllocator &operator=(RAdoptAllocator &&other)
+   {
+      fInitialAddress = other.fInitialAddress;
+      fAllocType = other.fAllocType;
+      fStdAllocator = std::move(other.fStdAllocator);
+      DropInline();
+      return *this;
+   }
 
    /// Construct a value at a certain memory address
    /// This method is a no op if memory has been adopted.
@@ -107,7 +137,8 @@ public:
 
    /// \brief Allocate some memory
    /// If an address has been adopted, at the first call, that address is returned.
-   /// Subsequent calls will make "decay" the allocator to a regular stl allocator.
+   /// Subsequent calls will make "decay" the allocator to a regular stl allocator, which uses the inline buffer, if
+   /// any, when it is free and large enough.
    pointer allocate(std::size_t n)
    {
       if (n > std::size_t(-1) / sizeof(T))
@@ -117,21 +148,33 @@ public:
          return fInitialAddress;
       }
       fAllocType = EAllocType::kOwning;
+      if (n <= fInlineSize && !fInlineInUse) {
+         fInlineInUse = true;
+         return fInlineAddress;
+      }
       return StdAllocTraits_t::allocate(fStdAllocator, n);
    }
 
-   /// \brief Dellocate some memory if that had not been adopted.
+   /// \brief Dellocate some memory if that had not been adopted nor taken from the inline buffer.
    void deallocate(pointer p, std::size_t n)
    {
+      if (fInlineAddress && p == fInlineAddress) {
+         fInlineInUse = false;
+         return;
+      }
       if (p != fInitialAddress)
          StdAllocTraits_t::deallocate(fStdAllocator, p, n);
    }
 
+   /// Whether the memory handed out by the allocator is, or will be, the adopted one
+   bool IsAdopting() const { return EAllocType::kOwning != fAllocType; }
+
    bool operator==(const RAdoptAllocator<T> &other)
    {
       return fInitialAddress == other.fInitialAddress &&
              fAllocType == other.fAllocType &&
-             fStdAllocator == other.fStdAllocator;
+             fStdAllocator == other.fStdAllocator &&
+             fInlineAddress == other.fInlineAddress;
    }
    bool operator!=(const RAdoptAllocator<T> &other)
    {
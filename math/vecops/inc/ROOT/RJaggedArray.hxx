@@ -0,0 +1,314 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RJAGGEDARRAY
+#define ROOT_RJAGGEDARRAY
+
+#include <ROOT/RVec.hxx>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace ROOT {
+
+namespace Detail {
+namespace VecOps {
+inline bool AreSameOffsets(const ::ROOT::VecOps::RVec<std::size_t> &o0, const ::ROOT::VecOps::RVec<std::size_t> &o1)
+{
+   return o0.data() == o1.data() || (o0.size() == o1.size() && std::equal(o0.begin(), o0.end(), o1.begin()));
+}
+} // End of Detail::VecOps NS
+} // End of Detail NS
+
+namespace VecOps {
+
+// clang-format off
+/**
+\class ROOT::VecOps::RJaggedArray
+\ingroup vecops
+\brief A collection of variable-size collections of values, stored as one flat array of values plus offsets.
+
+The values of entry `i` are the elements of the content with positions in `[offsets[i], offsets[i + 1])`: this is
+the way collections are laid out in the baskets of a TTree branch. RJaggedArrays typically hold the values of a
+column for a whole cluster of entries, e.g. read with ROOT::RDF::ReadJaggedArray or collected with the Take action
+of RDataFrame, so that selections on the objects of each entry are computed as loops over contiguous arrays:
+~~~{.cpp}
+auto pt = ROOT::RDF::ReadJaggedArray<float>(tree, "jet_pt", clusterBegin, clusterEnd);
+auto eta = ROOT::RDF::ReadJaggedArray<float>(tree, "jet_eta", clusterBegin, clusterEnd);
+auto goodPt = pt[pt > 30.f && abs(eta) < 2.4f]; // the selected jets of each entry
+auto nGood = Sizes(goodPt);                     // how many there are in each entry
+auto ht = Sum(goodPt);                          // their scalar sum, for each entry
+~~~
+Element-wise operations and masks are computed on the flat content, and preserve the offsets. Operations between
+two RJaggedArrays require them to have the same offsets.
+
+Indexing a RJaggedArray with an integer returns the values of an entry as a RVec which adopts the memory of the
+content: it is only valid as long as the RJaggedArray is, and must not be resized.
+**/
+// clang-format on
+template <typename T>
+class RJaggedArray {
+public:
+   using Offsets_t = RVec<std::size_t>;
+   using value_type = T;
+   using size_type = std::size_t;
+
+private:
+   RVec<T> fContent;
+   Offsets_t fOffsets{0u}; ///< One more than the number of entries: the first is always 0, the last the content size
+
+public:
+   RJaggedArray() = default;
+
+   /// Build a RJaggedArray out of its flat content and its offsets, which must start from 0, never decrease and end
+   /// with the size of the content
+   RJaggedArray(RVec<T> content, Offsets_t offsets) : fContent(std::move(content)), fOffsets(std::move(offsets))
+   {
+      if (fOffsets.empty() || fOffsets.front() != 0u || fOffsets.back() != fContent.size() ||
+          !std::is_sorted(fOffsets.begin(), fOffsets.end()))
+         throw std::runtime_error("The offsets of a RJaggedArray must start from 0, never decrease, and end with the "
+                                  "size of its content.");
+   }
+
+   /// The number of entries
+   size_type size() const { return fOffsets.size() - 1u; }
+   bool empty() const { return size() == 0u; }
+   /// The values of all entries, one after the other
+   const RVec<T> &GetContent() const { return fContent; }
+   const Offsets_t &GetOffsets() const { return fOffsets; }
+   size_type GetSize(size_type i) const { return fOffsets[i + 1u] - fOffsets[i]; }
+
+   /// The values of entry `i`, viewed in the content
+   const RVec<T> operator[](size_type i) const
+   {
+      return RVec<T>(const_cast<T *>(fContent.data()) + fOffsets[i], GetSize(i));
+   }
+   const RVec<T> at(size_type i) const
+   {
+      if (i >= size())
+         throw std::out_of_range("RJaggedArray entry index out of range.");
+      return (*this)[i];
+   }
+
+   /// Select the values for which the mask, which has the same offsets, is true
+   template <typename V>
+   RJaggedArray<T> operator[](const RJaggedArray<V> &mask) const
+   {
+      if (!::ROOT::Detail::VecOps::AreSameOffsets(mask.GetOffsets(), fOffsets))
+         throw std::runtime_error("Cannot mask a RJaggedArray with one of different offsets.");
+      const auto &conds = mask.GetContent();
+      Offsets_t offsets(fOffsets.size());
+      offsets[0] = 0u;
+      for (size_type i = 0u; i < size(); ++i) {
+         size_type nSelected = 0u;
+         for (auto j = fOffsets[i]; j < fOffsets[i + 1u]; ++j)
+            nSelected += static_cast<bool>(conds[j]);
+         offsets[i + 1u] = offsets[i] + nSelected;
+      }
+      return RJaggedArray<T>(fContent[conds], std::move(offsets));
+   }
+
+   /// Append an entry with the values in [first, last)
+   template <typename InputIt>
+   void emplace_back(InputIt first, InputIt last)
+   {
+      for (; first != last; ++first)
+         fContent.emplace_back(*first);
+      fOffsets.emplace_back(fContent.size());
+   }
+   void push_back(const RVec<T> &entry) { emplace_back(entry.begin(), entry.end()); }
+   /// Append the entries of another RJaggedArray
+   void Append(const RJaggedArray<T> &other)
+   {
+      const auto contentSize = fContent.size();
+      fContent.resize(contentSize + other.fContent.size());
+      std::copy(other.fContent.begin(), other.fContent.end(), fContent.begin() + contentSize);
+      fOffsets.reserve(fOffsets.size() + other.size());
+      for (auto it = std::next(other.fOffsets.begin()); it != other.fOffsets.end(); ++it)
+         fOffsets.emplace_back(contentSize + *it);
+   }
+   void reserve(size_type nEntries, size_type nValues)
+   {
+      fOffsets.reserve(nEntries + 1u);
+      fContent.reserve(nValues);
+   }
+   void clear()
+   {
+      fContent.clear();
+      fOffsets = {0u};
+   }
+};
+
+///@name RJaggedArray Operators
+/// Element-wise operations, computed on the flat content with the operators of RVec.
+///@{
+
+#define TJAGGED_BINARY_OPERATOR(OP)                                                              \
+template <typename T0, typename T1>                                                              \
+auto operator OP(const RJaggedArray<T0> &a, const T1 &y)                                         \
+  -> RJaggedArray<typename decltype(a.GetContent() OP y)::value_type>                            \
+{                                                                                                \
+   return {a.GetContent() OP y, a.GetOffsets()};                                                 \
+}                                                                                                \
+                                                                                                 \
+template <typename T0, typename T1>                                                              \
+auto operator OP(const T0 &x, const RJaggedArray<T1> &a)                                         \
+  -> RJaggedArray<typename decltype(x OP a.GetContent())::value_type>                            \
+{                                                                                                \
+   return {x OP a.GetContent(), a.GetOffsets()};                                                 \
+}                                                                                                \
+                                                                                                 \
+template <typename T0, typename T1>                                                              \
+auto operator OP(const RJaggedArray<T0> &a0, const RJaggedArray<T1> &a1)                         \
+  -> RJaggedArray<typename decltype(a0.GetContent() OP a1.GetContent())::value_type>             \
+{                                                                                                \
+   if (!::ROOT::Detail::VecOps::AreSameOffsets(a0.GetOffsets(), a1.GetOffsets()))                \
+      throw std::runtime_error("Cannot call operator " #OP " on RJaggedArrays of different offsets."); \
+   return {a0.GetContent() OP a1.GetContent(), a0.GetOffsets()};                                 \
+}
+
+TJAGGED_BINARY_OPERATOR(+)
+TJAGGED_BINARY_OPERATOR(-)
+TJAGGED_BINARY_OPERATOR(*)
+TJAGGED_BINARY_OPERATOR(/)
+TJAGGED_BINARY_OPERATOR(<)
+TJAGGED_BINARY_OPERATOR(>)
+TJAGGED_BINARY_OPERATOR(==)
+TJAGGED_BINARY_OPERATOR(!=)
+TJAGGED_BINARY_OPERATOR(<=)
+TJAGGED_BINARY_OPERATOR(>=)
+TJAGGED_BINARY_OPERATOR(&&)
+TJAGGED_BINARY_OPERATOR(||)
+#undef TJAGGED_BINARY_OPERATOR
+
+template <typename T>
+RJaggedArray<T> operator-(const RJaggedArray<T> &a)
+{
+   return {-a.GetContent(), a.GetOffsets()};
+}
+
+template <typename T>
+RJaggedArray<T> operator!(const RJaggedArray<T> &a)
+{
+   return {!a.GetContent(), a.GetOffsets()};
+}
+
+template <typename T>
+auto abs(const RJaggedArray<T> &a) -> RJaggedArray<typename decltype(abs(a.GetContent()))::value_type>
+{
+   return {abs(a.GetContent()), a.GetOffsets()};
+}
+
+///@}
+///@name RJaggedArray Reductions
+/// Functions reducing the values of each entry to one, returned in a RVec with one element per entry.
+///@{
+
+/// Number of values of each entry
+template <typename T>
+RVec<std::size_t> Sizes(const RJaggedArray<T> &a)
+{
+   const auto &offsets = a.GetOffsets();
+   RVec<std::size_t> sizes(a.size());
+   for (std::size_t i = 0u; i < sizes.size(); ++i)
+      sizes[i] = offsets[i + 1u] - offsets[i];
+   return sizes;
+}
+
+/// Sum of the values of each entry
+template <typename T>
+RVec<T> Sum(const RJaggedArray<T> &a)
+{
+   const auto &content = a.GetContent();
+   const auto &offsets = a.GetOffsets();
+   RVec<T> sums(a.size());
+   for (std::size_t i = 0u; i < sums.size(); ++i) {
+      T sum(0);
+      for (auto j = offsets[i]; j < offsets[i + 1u]; ++j)
+         sum += content[j];
+      sums[i] = sum;
+   }
+   return sums;
+}
+
+/// Mean of the values of each entry, 0 for empty entries
+template <typename T>
+RVec<double> Mean(const RJaggedArray<T> &a)
+{
+   const auto sums = Sum(a);
+   RVec<double> means(a.size());
+   for (std::size_t i = 0u; i < means.size(); ++i) {
+      const auto n = a.GetSize(i);
+      means[i] = n == 0u ? 0. : double(sums[i]) / n;
+   }
+   return means;
+}
+
+/// Largest value of each entry, the lowest value of T for empty entries
+template <typename T>
+RVec<T> Max(const RJaggedArray<T> &a)
+{
+   const auto &content = a.GetContent();
+   const auto &offsets = a.GetOffsets();
+   RVec<T> maxs(a.size());
+   for (std::size_t i = 0u; i < maxs.size(); ++i) {
+      auto max = std::numeric_limits<T>::lowest();
+      for (auto j = offsets[i]; j < offsets[i + 1u]; ++j)
+         max = std::max(max, content[j]);
+      maxs[i] = max;
+   }
+   return maxs;
+}
+
+/// Smallest value of each entry, the largest value of T for empty entries
+template <typename T>
+RVec<T> Min(const RJaggedArray<T> &a)
+{
+   const auto &content = a.GetContent();
+   const auto &offsets = a.GetOffsets();
+   RVec<T> mins(a.size());
+   for (std::size_t i = 0u; i < mins.size(); ++i) {
+      auto min = std::numeric_limits<T>::max();
+      for (auto j = offsets[i]; j < offsets[i + 1u]; ++j)
+         min = std::min(min, content[j]);
+      mins[i] = min;
+   }
+   return mins;
+}
+
+/// Whether any value of each entry is true
+template <typename T>
+RVec<int> Any(const RJaggedArray<T> &a)
+{
+   return Sum(a != T(0)) > 0;
+}
+
+/// Whether all the values of each entry are true, which empty entries are
+template <typename T>
+RVec<int> All(const RJaggedArray<T> &a)
+{
+   return Sum(a == T(0)) == 0;
+}
+
+///@}
+
+/// The values of all entries, one after the other
+template <typename T>
+RVec<T> Flatten(const RJaggedArray<T> &a)
+{
+   return a.GetContent();
+}
+
+} // End of VecOps NS
+} // End of ROOT NS
+
+#endif
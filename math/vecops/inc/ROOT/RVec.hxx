@@ -29,6 +29,7 @@
 #include <numeric> // for inner_product
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 #include <utility>
 
@@ -38,6 +39,89 @@
 
 namespace ROOT {
 
+namespace VecOps {
+template <typename T>
+class RVec;
+} // End of VecOps NS
+
+namespace Detail {
+namespace VecOps {
+
+template <typename T>
+bool IsOwning(const ::ROOT::VecOps::RVec<T> &v);
+
+/// The elements of a RVec which are stored within the object, to spare the small ones a heap allocation
+template <typename T, std::size_t N>
+struct RVecInlineStorage {
+   typename std::aligned_storage<N * sizeof(T), alignof(T)>::type fBuffer;
+   T *data() { return reinterpret_cast<T *>(&fBuffer); }
+   const T *data() const { return reinterpret_cast<const T *>(&fBuffer); }
+};
+
+template <typename T>
+struct RVecInlineStorage<T, 0> {
+   T *data() { return nullptr; }
+   const T *data() const { return nullptr; }
+};
+
+/// How many elements a RVec<T> keeps inline: as many as fit in a cache line for arithmetic types, none otherwise
+template <typename T>
+constexpr std::size_t RVecInlineSize()
+{
+   return std::is_arithmetic<T>::value ? 64 / sizeof(T) : 0;
+}
+
+namespace Kernels {
+// Element-wise loops on float and double arrays, named after the std functions and functors they apply. They are
+// compiled in libROOTVecOps for several instruction sets, the one used being selected at run time for the CPU.
+
+#define TVEC_DECLARE_UNARY_KERNEL(T, NAME) void NAME(const T *x, T *res, std::size_t n);
+
+#define TVEC_DECLARE_BINARY_KERNEL(T, R, NAME)             \
+   void NAME(const T *x, const T *y, R *res, std::size_t n); \
+   void NAME(const T *x, T y, R *res, std::size_t n);        \
+   void NAME(T x, const T *y, R *res, std::size_t n);
+
+#define TVEC_DECLARE_KERNELS(T)                   \
+   TVEC_DECLARE_BINARY_KERNEL(T, T, plus)         \
+   TVEC_DECLARE_BINARY_KERNEL(T, T, minus)        \
+   TVEC_DECLARE_BINARY_KERNEL(T, T, multiplies)   \
+   TVEC_DECLARE_BINARY_KERNEL(T, T, divides)      \
+   TVEC_DECLARE_BINARY_KERNEL(T, int, less)       \
+   TVEC_DECLARE_BINARY_KERNEL(T, int, greater)    \
+   TVEC_DECLARE_BINARY_KERNEL(T, int, less_equal) \
+   TVEC_DECLARE_BINARY_KERNEL(T, int, greater_equal) \
+   TVEC_DECLARE_BINARY_KERNEL(T, int, equal_to)   \
+   TVEC_DECLARE_BINARY_KERNEL(T, int, not_equal_to) \
+   TVEC_DECLARE_BINARY_KERNEL(T, T, pow)          \
+   TVEC_DECLARE_BINARY_KERNEL(T, T, atan2)        \
+   TVEC_DECLARE_BINARY_KERNEL(T, T, hypot)        \
+   TVEC_DECLARE_UNARY_KERNEL(T, abs)              \
+   TVEC_DECLARE_UNARY_KERNEL(T, sqrt)             \
+   TVEC_DECLARE_UNARY_KERNEL(T, exp)              \
+   TVEC_DECLARE_UNARY_KERNEL(T, log)              \
+   TVEC_DECLARE_UNARY_KERNEL(T, log10)            \
+   TVEC_DECLARE_UNARY_KERNEL(T, sin)              \
+   TVEC_DECLARE_UNARY_KERNEL(T, cos)              \
+   TVEC_DECLARE_UNARY_KERNEL(T, tan)              \
+   TVEC_DECLARE_UNARY_KERNEL(T, asin)             \
+   TVEC_DECLARE_UNARY_KERNEL(T, acos)             \
+   TVEC_DECLARE_UNARY_KERNEL(T, atan)             \
+   TVEC_DECLARE_UNARY_KERNEL(T, sinh)             \
+   TVEC_DECLARE_UNARY_KERNEL(T, cosh)             \
+   TVEC_DECLARE_UNARY_KERNEL(T, tanh)
+
+TVEC_DECLARE_KERNELS(float)
+TVEC_DECLARE_KERNELS(double)
+#undef TVEC_DECLARE_KERNELS
+#undef TVEC_DECLARE_BINARY_KERNEL
+#undef TVEC_DECLARE_UNARY_KERNEL
+
+} // End of Kernels NS
+
+} // End of Detail::VecOps NS
+} // End of Detail NS
+
 namespace VecOps {
 // clang-format off
 /**
@@ -58,6 +142,7 @@ the manipulation and analysis of the data in the RVec.
 ## Table of Contents
 - [Example](#example)
 - [Owning and adopting memory](#owningandadoptingmemory)
+- [Small RVecs](#smallrvecs)
 - [Usage in combination with RDataFrame](#usagetdataframe)
 
 ## <a name="example"></a>Example
@@ -102,6 +187,11 @@ If any method which implies a re-allocation is called, e.g. *emplace_back* or *r
 memory is released and new one is allocated. The previous content is copied in the new memory and
 preserved.
 
+## <a name="smallrvecs"></a>Small RVecs
+A RVec of arithmetic type stores up to 64 bytes of elements, e.g. eight doubles, within the object itself, and only
+allocates memory on the heap when it grows beyond that. The many small temporaries produced by expressions such as
+`pt[eta > 2]` are therefore cheap to create and destroy. Moving such a RVec copies its elements.
+
 ## <a name="usagetdataframe"></a>Usage in combination with RDataFrame
 RDataFrame leverages internally RVecs. Suppose to have a dataset stored in a
 TTree which holds these columns (here we choose C arrays to represent the
@@ -141,7 +231,8 @@ hpt->Draw();
 template <typename T>
 class RVec {
 public:
-   using Impl_t = typename std::vector<T, ::ROOT::Detail::VecOps::RAdoptAllocator<T>>;
+   using Alloc_t = ::ROOT::Detail::VecOps::RAdoptAllocator<T>;
+   using Impl_t = typename std::vector<T, Alloc_t>;
    using value_type = typename Impl_t::value_type;
    using size_type = typename Impl_t::size_type;
    using difference_type = typename Impl_t::difference_type;
@@ -155,28 +246,76 @@ public:
    using const_reverse_iterator = typename Impl_t::const_reverse_iterator;
 
 private:
+   template <typename U>
+   friend bool ::ROOT::Detail::VecOps::IsOwning(const RVec<U> &v);
+
+   static constexpr std::size_t fgInlineSize = ::ROOT::Detail::VecOps::RVecInlineSize<T>();
+   ::ROOT::Detail::VecOps::RVecInlineStorage<T, fgInlineSize> fInline; //!
    Impl_t fData;
 
+   Alloc_t MakeAllocator() { return Alloc_t(fInline.data(), fgInlineSize); }
+   /// Whether the elements are stored within this object, in which case fData must not be handed to another RVec
+   bool IsInline() const { return fgInlineSize > 0 && fData.data() == fInline.data(); }
+   /// Arithmetic elements are all copied, the output position only advancing past the selected ones: this loop has
+   /// no branch to mispredict
+   template <typename V>
+   void Compress(const RVec<V> &conds, RVec<T> &ret, std::true_type) const
+   {
+      const size_type n = conds.size();
+      ret.resize(n);
+      size_type nSelected = 0;
+      for (size_type i = 0; i < n; ++i) {
+         ret.fData[nSelected] = fData[i];
+         nSelected += static_cast<bool>(conds[i]);
+      }
+      ret.resize(nSelected);
+   }
+   template <typename V>
+   void Compress(const RVec<V> &conds, RVec<T> &ret, std::false_type) const
+   {
+      const size_type n = conds.size();
+      ret.reserve(n);
+      for (size_type i = 0; i < n; ++i)
+         if (conds[i])
+            ret.emplace_back(fData[i]);
+   }
+   template <typename It>
+   void MoveAssign(It first, It last)
+   {
+      if (fData.get_allocator().IsAdopting())
+         Impl_t(first, last).swap(fData); // do not overwrite the adopted memory
+      else
+         fData.assign(first, last);
+   }
+
 public:
    // constructors
-   RVec() {}
+   RVec() : fData(MakeAllocator()) {}
 
-   explicit RVec(size_type count) : fData(count) {}
+   explicit RVec(size_type count) : fData(count, MakeAllocator()) {}
 
-   RVec(size_type count, const T &value) : fData(count, value) {}
+   RVec(size_type count, const T &value) : fData(count, value, MakeAllocator()) {}
 
-   RVec(const RVec<T> &v) : fData(v.fData) {}
+   RVec(const RVec<T> &v) : fData(v.cbegin(), v.cend(), MakeAllocator()) {}
 
-   RVec(RVec<T> &&v) : fData(std::move(v.fData)) {}
+   RVec(RVec<T> &&v) : fData(MakeAllocator())
+   {
+      if (v.IsInline()) {
+         fData.assign(std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()));
+         v.clear();
+      } else {
+         fData.swap(v.fData);
+      }
+   }
 
-   RVec(const std::vector<T> &v) : fData(v.cbegin(), v.cend()) {}
+   RVec(const std::vector<T> &v) : fData(v.cbegin(), v.cend(), MakeAllocator()) {}
 
-   RVec(pointer p, size_type n) : fData(n, T(), ROOT::Detail::VecOps::RAdoptAllocator<T>(p)) {}
+   RVec(pointer p, size_type n) : fData(n, T(), Alloc_t(p)) {}
 
    template <class InputIt>
-   RVec(InputIt first, InputIt last) : fData(first, last) {}
+   RVec(InputIt first, InputIt last) : fData(first, last, MakeAllocator()) {}
 
-   RVec(std::initializer_list<T> init) : fData(init) {}
+   RVec(std::initializer_list<T> init) : fData(init, MakeAllocator()) {}
 
    // assignment
    RVec<T> &operator=(const RVec<T> &v)
@@ -187,7 +326,11 @@ public:
 
    RVec<T> &operator=(RVec<T> &&v)
    {
-      std::swap(fData, v.fData);
+      if (IsInline() || v.IsInline()) {
+         MoveAssign(std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()));
+         v.clear();
+      } else
+         std::swap(fData, v.fData);
       return *this;
    }
 
@@ -221,10 +364,7 @@ public:
          throw std::runtime_error("Cannot index RVec with condition vector of different size");
 
       RVec<T> ret;
-      ret.reserve(n);
-      for (size_type i = 0; i < n; ++i)
-         if (conds[i])
-            ret.emplace_back(fData[i]);
+      Compress(conds, ret, std::is_arithmetic<T>());
       return ret;
    }
 
@@ -253,7 +393,11 @@ public:
    size_type max_size() const noexcept { return fData.size(); }
    void reserve(size_type new_cap) { fData.reserve(new_cap); }
    size_type capacity() const noexcept { return fData.capacity(); }
-   void shrink_to_fit() { fData.shrink_to_fit(); };
+   void shrink_to_fit()
+   {
+      if (!IsInline())
+         RVec<T>(std::make_move_iterator(begin()), std::make_move_iterator(end())).swap(*this);
+   };
    // modifiers
    void clear() noexcept { fData.clear(); }
    iterator erase(iterator pos) { return fData.erase(pos); }
@@ -275,9 +419,36 @@ public:
    void pop_back() { fData.pop_back(); }
    void resize(size_type count) { fData.resize(count); }
    void resize(size_type count, const value_type &value) { fData.resize(count, value); }
-   void swap(RVec<T> &other) { std::swap(fData, other.fData); }
+   void swap(RVec<T> &other)
+   {
+      if (IsInline() || other.IsInline()) {
+         RVec<T> tmp(std::move(other));
+         other = std::move(*this);
+         *this = std::move(tmp);
+      } else {
+         std::swap(fData, other.fData);
+      }
+   }
 };
 
+} // End of VecOps NS
+
+namespace Detail {
+namespace VecOps {
+
+/// Whether a RVec allocated its elements, and can therefore be written to when it is a temporary. An adopting RVec
+/// may not: its elements belong to someone else, e.g. a TTreeReaderArray.
+template <typename T>
+bool IsOwning(const ::ROOT::VecOps::RVec<T> &v)
+{
+   return !v.fData.get_allocator().IsAdopting();
+}
+
+} // End of Detail::VecOps NS
+} // End of Detail NS
+
+namespace VecOps {
+
 ///@name RVec Unary Arithmetic Operators
 ///@{
 
@@ -541,6 +712,167 @@ TVEC_STD_UNARY_FUNCTION(lgamma)
 TVEC_STD_UNARY_FUNCTION(tgamma)
 #undef TVEC_STD_UNARY_FUNCTION
 
+///@}
+///@name RVec Vectorised Operations on float and double
+/// These overloads are picked over the templates above when all the operands have the same floating point type, and
+/// run the loop in a kernel of libROOTVecOps compiled for the instruction set of the CPU.
+/// When an operand is a temporary that owns its elements, the result is written over them and the temporary is
+/// returned: in `sqrt(px * px + py * py)` only the two products allocate a new RVec. A temporary combined with a
+/// scalar of another type is reused only if the overloads above return its type for that scalar, which is not the
+/// case of `RVec<float> * 2.`.
+///@{
+
+#define TVEC_KERNEL_BINARY(T, R, NAME, KERNEL, MSG)                               \
+inline RVec<R> NAME(const RVec<T> &v0, const RVec<T> &v1)                         \
+{                                                                                 \
+   if (v0.size() != v1.size())                                                    \
+      throw std::runtime_error(ERROR_MESSAGE(MSG));                               \
+                                                                                  \
+   RVec<R> ret(v0.size());                                                        \
+   ::ROOT::Detail::VecOps::Kernels::KERNEL(v0.data(), v1.data(), ret.data(), v0.size()); \
+   return ret;                                                                    \
+}                                                                                 \
+                                                                                  \
+inline RVec<R> NAME(const RVec<T> &v, const T &y)                                 \
+{                                                                                 \
+   RVec<R> ret(v.size());                                                         \
+   ::ROOT::Detail::VecOps::Kernels::KERNEL(v.data(), y, ret.data(), v.size());    \
+   return ret;                                                                    \
+}                                                                                 \
+                                                                                  \
+inline RVec<R> NAME(const T &x, const RVec<T> &v)                                 \
+{                                                                                 \
+   RVec<R> ret(v.size());                                                         \
+   ::ROOT::Detail::VecOps::Kernels::KERNEL(x, v.data(), ret.data(), v.size());    \
+   return ret;                                                                    \
+}
+
+// The rvalue overloads are templates, so that they are not viable when an operand must be converted, e.g. from
+// RVec<int> or from a scalar of another type, and do not make such calls of the templates above ambiguous.
+// Element type returned by the overloads above for elements of types A and B. The scalar type is replaced by void
+// if it is not arithmetic, so that an RVec deduced as scalar does not recurse into these overloads.
+template <typename S>
+using ArithmeticOrVoid = typename std::conditional<std::is_arithmetic<S>::value, S, void>::type;
+#define TVEC_OPERATOR_RESULT(OP, A, B) decltype(std::declval<A>() OP std::declval<B>())
+#define TVEC_FUNCTION_RESULT(F, A, B) PromoteTypes<A, B>
+
+#define TVEC_KERNEL_BINARY_REUSE(T, NAME, KERNEL, MSG, RESULT)                    \
+template <typename U0, typename U1,                                               \
+          typename std::enable_if<std::is_same<U0, T>::value && std::is_same<U1, T>::value, int>::type = 0> \
+RVec<T> NAME(RVec<U0> &&v0, const RVec<U1> &v1)                                   \
+{                                                                                 \
+   if (!::ROOT::Detail::VecOps::IsOwning(v0))                                     \
+      return NAME(static_cast<const RVec<T> &>(v0), v1);                          \
+   if (v0.size() != v1.size())                                                    \
+      throw std::runtime_error(ERROR_MESSAGE(MSG));                               \
+                                                                                  \
+   ::ROOT::Detail::VecOps::Kernels::KERNEL(v0.data(), v1.data(), v0.data(), v0.size()); \
+   return std::move(v0);                                                          \
+}                                                                                 \
+                                                                                  \
+template <typename U0, typename U1,                                               \
+          typename std::enable_if<std::is_same<U0, T>::value && std::is_same<U1, T>::value, int>::type = 0> \
+RVec<T> NAME(const RVec<U0> &v0, RVec<U1> &&v1)                                   \
+{                                                                                 \
+   if (!::ROOT::Detail::VecOps::IsOwning(v1))                                     \
+      return NAME(v0, static_cast<const RVec<T> &>(v1));                          \
+   if (v0.size() != v1.size())                                                    \
+      throw std::runtime_error(ERROR_MESSAGE(MSG));                               \
+                                                                                  \
+   ::ROOT::Detail::VecOps::Kernels::KERNEL(v0.data(), v1.data(), v1.data(), v0.size()); \
+   return std::move(v1);                                                          \
+}                                                                                 \
+                                                                                  \
+template <typename U0, typename U1,                                               \
+          typename std::enable_if<std::is_same<U0, T>::value && std::is_same<U1, T>::value, int>::type = 0> \
+RVec<T> NAME(RVec<U0> &&v0, RVec<U1> &&v1)                                        \
+{                                                                                 \
+   if (::ROOT::Detail::VecOps::IsOwning(v0))                                      \
+      return NAME(std::move(v0), static_cast<const RVec<T> &>(v1));               \
+   return NAME(static_cast<const RVec<T> &>(v0), std::move(v1));                  \
+}                                                                                 \
+                                                                                  \
+template <typename S, typename std::enable_if<std::is_arithmetic<S>::value &&                   \
+                                              std::is_same<RESULT(MSG, T, ArithmeticOrVoid<S>), T>::value, int>::type = 0> \
+RVec<T> NAME(RVec<T> &&v, const S &y)                                             \
+{                                                                                 \
+   if (!::ROOT::Detail::VecOps::IsOwning(v))                                      \
+      return NAME(static_cast<const RVec<T> &>(v), y);                            \
+   ::ROOT::Detail::VecOps::Kernels::KERNEL(v.data(), static_cast<T>(y), v.data(), v.size()); \
+   return std::move(v);                                                           \
+}                                                                                 \
+                                                                                  \
+template <typename S, typename std::enable_if<std::is_arithmetic<S>::value &&                   \
+                                              std::is_same<RESULT(MSG, ArithmeticOrVoid<S>, T), T>::value, int>::type = 0> \
+RVec<T> NAME(const S &x, RVec<T> &&v)                                             \
+{                                                                                 \
+   if (!::ROOT::Detail::VecOps::IsOwning(v))                                      \
+      return NAME(x, static_cast<const RVec<T> &>(v));                            \
+   ::ROOT::Detail::VecOps::Kernels::KERNEL(static_cast<T>(x), v.data(), v.data(), v.size()); \
+   return std::move(v);                                                           \
+}
+
+#define TVEC_KERNEL_UNARY(T, NAME)                                                \
+inline RVec<T> NAME(const RVec<T> &v)                                             \
+{                                                                                 \
+   RVec<T> ret(v.size());                                                         \
+   ::ROOT::Detail::VecOps::Kernels::NAME(v.data(), ret.data(), v.size());         \
+   return ret;                                                                    \
+}                                                                                 \
+                                                                                  \
+inline RVec<T> NAME(RVec<T> &&v)                                                  \
+{                                                                                 \
+   if (!::ROOT::Detail::VecOps::IsOwning(v))                                      \
+      return NAME(static_cast<const RVec<T> &>(v));                               \
+   ::ROOT::Detail::VecOps::Kernels::NAME(v.data(), v.data(), v.size());           \
+   return std::move(v);                                                           \
+}
+
+#define TVEC_KERNEL_FUNCTIONS(T)                                  \
+   TVEC_KERNEL_BINARY(T, T, operator+, plus, +)                   \
+   TVEC_KERNEL_BINARY(T, T, operator-, minus, -)                  \
+   TVEC_KERNEL_BINARY(T, T, operator*, multiplies, *)             \
+   TVEC_KERNEL_BINARY(T, T, operator/, divides, /)                \
+   TVEC_KERNEL_BINARY(T, int, operator<, less, <)                 \
+   TVEC_KERNEL_BINARY(T, int, operator>, greater, >)              \
+   TVEC_KERNEL_BINARY(T, int, operator<=, less_equal, <=)         \
+   TVEC_KERNEL_BINARY(T, int, operator>=, greater_equal, >=)      \
+   TVEC_KERNEL_BINARY(T, int, operator==, equal_to, ==)           \
+   TVEC_KERNEL_BINARY(T, int, operator!=, not_equal_to, !=)       \
+   TVEC_KERNEL_BINARY(T, T, pow, pow, pow)                        \
+   TVEC_KERNEL_BINARY(T, T, atan2, atan2, atan2)                  \
+   TVEC_KERNEL_BINARY(T, T, hypot, hypot, hypot)                  \
+   TVEC_KERNEL_BINARY_REUSE(T, operator+, plus, +, TVEC_OPERATOR_RESULT) \
+   TVEC_KERNEL_BINARY_REUSE(T, operator-, minus, -, TVEC_OPERATOR_RESULT) \
+   TVEC_KERNEL_BINARY_REUSE(T, operator*, multiplies, *, TVEC_OPERATOR_RESULT) \
+   TVEC_KERNEL_BINARY_REUSE(T, operator/, divides, /, TVEC_OPERATOR_RESULT) \
+   TVEC_KERNEL_BINARY_REUSE(T, pow, pow, pow, TVEC_FUNCTION_RESULT) \
+   TVEC_KERNEL_BINARY_REUSE(T, atan2, atan2, atan2, TVEC_FUNCTION_RESULT) \
+   TVEC_KERNEL_BINARY_REUSE(T, hypot, hypot, hypot, TVEC_FUNCTION_RESULT) \
+   TVEC_KERNEL_UNARY(T, abs)                                      \
+   TVEC_KERNEL_UNARY(T, sqrt)                                     \
+   TVEC_KERNEL_UNARY(T, exp)                                      \
+   TVEC_KERNEL_UNARY(T, log)                                      \
+   TVEC_KERNEL_UNARY(T, log10)                                    \
+   TVEC_KERNEL_UNARY(T, sin)                                      \
+   TVEC_KERNEL_UNARY(T, cos)                                      \
+   TVEC_KERNEL_UNARY(T, tan)                                      \
+   TVEC_KERNEL_UNARY(T, asin)                                     \
+   TVEC_KERNEL_UNARY(T, acos)                                     \
+   TVEC_KERNEL_UNARY(T, atan)                                     \
+   TVEC_KERNEL_UNARY(T, sinh)                                     \
+   TVEC_KERNEL_UNARY(T, cosh)                                     \
+   TVEC_KERNEL_UNARY(T, tanh)
+
+TVEC_KERNEL_FUNCTIONS(float)
+TVEC_KERNEL_FUNCTIONS(double)
+#undef TVEC_KERNEL_FUNCTIONS
+#undef TVEC_KERNEL_UNARY
+#undef TVEC_KERNEL_BINARY_REUSE
+#undef TVEC_FUNCTION_RESULT
+#undef TVEC_OPERATOR_RESULT
+#undef TVEC_KERNEL_BINARY
+
 ///@}
 ///@name RVec Fast Mathematical Functions with Vdt
 ///@{
@@ -0,0 +1,90 @@
+#include "ROOT/RVec.hxx"
+
+#include <cmath>
+#include <functional>
+
+// This file is compiled without -ffast-math (see CMakeLists.txt), so that the kernels follow IEEE 754: comparisons
+// with NaN are false (true for not_equal_to), and NaN and infinities propagate through the functions.
+
+// Each kernel is compiled for several instruction sets, the dynamic loader resolving it to the best one available
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 6) && defined(__x86_64__) && defined(__linux__)
+#define R__VECOPS_DISPATCH __attribute__((target_clones("avx2", "avx", "default")))
+#else
+#define R__VECOPS_DISPATCH
+#endif
+
+namespace ROOT {
+namespace Detail {
+namespace VecOps {
+namespace Kernels {
+
+#define TVEC_DEFINE_UNARY_KERNEL(T, NAME)                                  \
+   R__VECOPS_DISPATCH void NAME(const T *x, T *res, std::size_t n)         \
+   {                                                                       \
+      for (std::size_t i = 0; i < n; ++i)                                  \
+         res[i] = std::NAME(x[i]);                                         \
+   }
+
+#define TVEC_DEFINE_BINARY_KERNEL(T, R, NAME, F)                           \
+   R__VECOPS_DISPATCH void NAME(const T *x, const T *y, R *res, std::size_t n) \
+   {                                                                       \
+      for (std::size_t i = 0; i < n; ++i)                                  \
+         res[i] = F(x[i], y[i]);                                           \
+   }                                                                       \
+                                                                           \
+   R__VECOPS_DISPATCH void NAME(const T *x, T y, R *res, std::size_t n)    \
+   {                                                                       \
+      for (std::size_t i = 0; i < n; ++i)                                  \
+         res[i] = F(x[i], y);                                              \
+   }                                                                       \
+                                                                           \
+   R__VECOPS_DISPATCH void NAME(T x, const T *y, R *res, std::size_t n)    \
+   {                                                                       \
+      for (std::size_t i = 0; i < n; ++i)                                  \
+         res[i] = F(x, y[i]);                                              \
+   }
+
+#define TVEC_DEFINE_FUNCTOR_KERNEL(T, R, NAME) TVEC_DEFINE_BINARY_KERNEL(T, R, NAME, std::NAME<T>())
+#define TVEC_DEFINE_STD_BINARY_KERNEL(T, NAME) TVEC_DEFINE_BINARY_KERNEL(T, T, NAME, std::NAME)
+
+#define TVEC_DEFINE_KERNELS(T)                         \
+   TVEC_DEFINE_FUNCTOR_KERNEL(T, T, plus)              \
+   TVEC_DEFINE_FUNCTOR_KERNEL(T, T, minus)             \
+   TVEC_DEFINE_FUNCTOR_KERNEL(T, T, multiplies)        \
+   TVEC_DEFINE_FUNCTOR_KERNEL(T, T, divides)           \
+   TVEC_DEFINE_FUNCTOR_KERNEL(T, int, less)            \
+   TVEC_DEFINE_FUNCTOR_KERNEL(T, int, greater)         \
+   TVEC_DEFINE_FUNCTOR_KERNEL(T, int, less_equal)      \
+   TVEC_DEFINE_FUNCTOR_KERNEL(T, int, greater_equal)   \
+   TVEC_DEFINE_FUNCTOR_KERNEL(T, int, equal_to)        \
+   TVEC_DEFINE_FUNCTOR_KERNEL(T, int, not_equal_to)    \
+   TVEC_DEFINE_STD_BINARY_KERNEL(T, pow)               \
+   TVEC_DEFINE_STD_BINARY_KERNEL(T, atan2)             \
+   TVEC_DEFINE_STD_BINARY_KERNEL(T, hypot)             \
+   TVEC_DEFINE_UNARY_KERNEL(T, abs)                    \
+   TVEC_DEFINE_UNARY_KERNEL(T, sqrt)                   \
+   TVEC_DEFINE_UNARY_KERNEL(T, exp)                    \
+   TVEC_DEFINE_UNARY_KERNEL(T, log)                    \
+   TVEC_DEFINE_UNARY_KERNEL(T, log10)                  \
+   TVEC_DEFINE_UNARY_KERNEL(T, sin)                    \
+   TVEC_DEFINE_UNARY_KERNEL(T, cos)                    \
+   TVEC_DEFINE_UNARY_KERNEL(T, tan)                    \
+   TVEC_DEFINE_UNARY_KERNEL(T, asin)                   \
+   TVEC_DEFINE_UNARY_KERNEL(T, acos)                   \
+   TVEC_DEFINE_UNARY_KERNEL(T, atan)                   \
+   TVEC_DEFINE_UNARY_KERNEL(T, sinh)                   \
+   TVEC_DEFINE_UNARY_KERNEL(T, cosh)                   \
+   TVEC_DEFINE_UNARY_KERNEL(T, tanh)
+
+TVEC_DEFINE_KERNELS(float)
+TVEC_DEFINE_KERNELS(double)
+#undef TVEC_DEFINE_KERNELS
+#undef TVEC_DEFINE_STD_BINARY_KERNEL
+#undef TVEC_DEFINE_FUNCTOR_KERNEL
+#undef TVEC_DEFINE_BINARY_KERNEL
+#undef TVEC_DEFINE_UNARY_KERNEL
+
+} // namespace Kernels
+} // namespace VecOps
+} // namespace Detail
+} // namespace ROOT
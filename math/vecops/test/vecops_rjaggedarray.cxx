@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <ROOT/RJaggedArray.hxx>
+
+#include <limits>
+#include <stdexcept>
+
+using namespace ROOT::VecOps;
+
+template <typename T, typename V>
+void CheckEqual(const RVec<T> &a, const RVec<V> &b)
+{
+   ASSERT_EQ(a.size(), b.size());
+   for (auto i = 0u; i < a.size(); ++i)
+      EXPECT_EQ(a[i], b[i]) << "at position " << i;
+}
+
+TEST(RJaggedArray, Construction)
+{
+   RJaggedArray<int> empty;
+   EXPECT_EQ(empty.size(), 0u);
+   EXPECT_TRUE(empty.empty());
+
+   RJaggedArray<int> a({1, 2, 3}, {0u, 2u, 2u, 3u});
+   EXPECT_EQ(a.size(), 3u);
+   CheckEqual(a[0], RVec<int>{1, 2});
+   EXPECT_TRUE(a[1].empty());
+   CheckEqual(a.at(2), RVec<int>{3});
+   EXPECT_THROW(a.at(3), std::out_of_range);
+
+   EXPECT_THROW(RJaggedArray<int>({1, 2}, {}), std::runtime_error);
+   EXPECT_THROW(RJaggedArray<int>({1, 2}, {1u, 2u}), std::runtime_error);
+   EXPECT_THROW(RJaggedArray<int>({1, 2}, {0u, 1u}), std::runtime_error);
+   EXPECT_THROW(RJaggedArray<int>({1, 2}, {0u, 2u, 1u, 2u}), std::runtime_error);
+}
+
+TEST(RJaggedArray, Filling)
+{
+   RJaggedArray<float> a;
+   a.push_back(RVec<float>{1.f});
+   a.push_back(RVec<float>{});
+   RJaggedArray<float> b({2.f, 3.f}, {0u, 2u});
+   a.Append(b);
+   a.Append(RJaggedArray<float>());
+   CheckEqual(a.GetContent(), RVec<float>{1.f, 2.f, 3.f});
+   CheckEqual(a.GetOffsets(), RVec<std::size_t>{0u, 1u, 1u, 3u});
+   a.clear();
+   EXPECT_EQ(a.size(), 0u);
+   EXPECT_TRUE(a.GetContent().empty());
+}
+
+TEST(RJaggedArray, Operations)
+{
+   RJaggedArray<float> pt({10.f, 40.f, 50.f, 20.f}, {0u, 2u, 2u, 4u});
+   RJaggedArray<float> eta({0.f, 3.f, -1.f, 1.f}, {0u, 2u, 2u, 4u});
+
+   CheckEqual((2.f * pt - pt / 2.f).GetContent(), RVec<float>{15.f, 60.f, 75.f, 30.f});
+   CheckEqual((pt + eta).GetOffsets(), pt.GetOffsets());
+   CheckEqual(abs(eta).GetContent(), RVec<float>{0.f, 3.f, 1.f, 1.f});
+   CheckEqual((pt > 15.f && -eta < 0.5f).GetContent(), RVec<int>{0, 1, 0, 1});
+   EXPECT_THROW(pt + RJaggedArray<float>({1.f}, {0u, 1u}), std::runtime_error);
+
+   const auto good = pt[pt > 15.f && abs(eta) < 2.f];
+   CheckEqual(good.GetContent(), RVec<float>{50.f, 20.f});
+   CheckEqual(good.GetOffsets(), RVec<std::size_t>{0u, 0u, 0u, 2u});
+   EXPECT_THROW(pt[RJaggedArray<int>({1}, {0u, 1u})], std::runtime_error);
+
+   CheckEqual(Flatten(good), RVec<float>{50.f, 20.f});
+}
+
+TEST(RJaggedArray, Reductions)
+{
+   RJaggedArray<float> pt({10.f, 40.f, 50.f, 20.f}, {0u, 2u, 2u, 4u});
+   CheckEqual(Sizes(pt), RVec<std::size_t>{2u, 0u, 2u});
+   CheckEqual(Sum(pt), RVec<float>{50.f, 0.f, 70.f});
+   CheckEqual(Mean(pt), RVec<double>{25., 0., 35.});
+   CheckEqual(Max(pt), RVec<float>{40.f, std::numeric_limits<float>::lowest(), 50.f});
+   CheckEqual(Min(pt), RVec<float>{10.f, std::numeric_limits<float>::max(), 20.f});
+   CheckEqual(Any(pt > 45.f), RVec<int>{0, 0, 1});
+   CheckEqual(All(pt > 15.f), RVec<int>{0, 1, 1});
+}
@@ -4,6 +4,8 @@
 #include <TFile.h>
 #include <TTree.h>
 #include <TSystem.h>
+#include <cmath>
+#include <limits>
 #include <vector>
 #include <sstream>
 
@@ -100,6 +102,50 @@ TEST(VecOps, MoveCtor)
    EXPECT_EQ(v2.size(), 3u);
 }
 
+TEST(VecOps, SmallVectors)
+{
+   // eight doubles are kept inline: moving such a RVec copies them, and growing it moves them to the heap
+   ROOT::VecOps::RVec<double> v1{1., 2., 3.};
+   const auto inlineData = v1.data();
+   ROOT::VecOps::RVec<double> v2(std::move(v1));
+   EXPECT_NE(v2.data(), inlineData);
+   CheckEqual(v2, ROOT::VecOps::RVec<double>{1., 2., 3.});
+
+   v1 = v2;
+   EXPECT_EQ(v1.data(), inlineData);
+   for (auto i : ROOT::TSeqI(10))
+      v1.emplace_back(i);
+   EXPECT_NE(v1.data(), inlineData);
+   EXPECT_EQ(v1.size(), 13u);
+   EXPECT_EQ(v1[12], 9.);
+
+   // the heap memory is handed over on move
+   const auto heapData = v1.data();
+   ROOT::VecOps::RVec<double> v3(std::move(v1));
+   EXPECT_EQ(v3.data(), heapData);
+   v2 = std::move(v3);
+   EXPECT_EQ(v2.size(), 13u);
+   EXPECT_EQ(v2[0], 1.);
+}
+
+TEST(VecOps, SwapSmallAndAdopting)
+{
+   std::vector<double> model{4., 5.};
+   ROOT::VecOps::RVec<double> small{1., 2., 3.};
+   ROOT::VecOps::RVec<double> adopting(model.data(), model.size());
+   swap(small, adopting);
+   CheckEqual(small, ROOT::VecOps::RVec<double>{4., 5.});
+   CheckEqual(adopting, ROOT::VecOps::RVec<double>{1., 2., 3.});
+   // the adopted memory is left untouched
+   EXPECT_EQ(model[0], 4.);
+   EXPECT_EQ(model[1], 5.);
+
+   ROOT::VecOps::RVec<double> adopting2(model.data(), model.size());
+   adopting2 = ROOT::VecOps::RVec<double>{6.};
+   CheckEqual(adopting2, ROOT::VecOps::RVec<double>{6.});
+   EXPECT_EQ(model[0], 4.);
+}
+
 TEST(VecOps, Conversion)
 {
    ROOT::VecOps::RVec<float> fvec{1.0f, 2.0f, 3.0f};
@@ -304,6 +350,141 @@ std::string PrintRVec(ROOT::VecOps::RVec<T> v, V w)
    return ss.str();
 }
 
+TEST(VecOps, VectorisedKernels)
+{
+   // sizes covering the tails left by the vector loops
+   for (auto size : {0u, 1u, 3u, 7u, 8u, 17u, 100u}) {
+      ROOT::VecOps::RVec<double> x(size), y(size);
+      for (auto i : ROOT::TSeqU(size)) {
+         x[i] = 0.1 + 0.37 * i;
+         y[i] = 2. - 0.11 * i;
+      }
+      const auto sum = x + y;
+      const auto scaled = 2. * x;
+      const auto less = x < y;
+      const auto greater = x > 1.;
+      const auto root = sqrt(x);
+      const auto angle = atan2(y, x);
+      const auto e = exp(-x);
+      ROOT::VecOps::RVec<float> xf(x);
+      const auto rootf = sqrt(xf);
+      const auto productf = xf * xf;
+      ASSERT_EQ(sum.size(), size);
+      ASSERT_EQ(less.size(), size);
+      for (auto i : ROOT::TSeqU(size)) {
+         EXPECT_DOUBLE_EQ(sum[i], x[i] + y[i]);
+         EXPECT_DOUBLE_EQ(scaled[i], 2. * x[i]);
+         EXPECT_EQ(less[i], x[i] < y[i]);
+         EXPECT_EQ(greater[i], x[i] > 1.);
+         EXPECT_DOUBLE_EQ(root[i], std::sqrt(x[i]));
+         EXPECT_NEAR(angle[i], std::atan2(y[i], x[i]), 1e-12);
+         EXPECT_NEAR(e[i], std::exp(-x[i]), 1e-12);
+         EXPECT_FLOAT_EQ(rootf[i], std::sqrt(xf[i]));
+         EXPECT_FLOAT_EQ(productf[i], xf[i] * xf[i]);
+      }
+   }
+}
+
+TEST(VecOps, VectorisedKernelsNaN)
+{
+   // the kernels are not compiled with fast-math: comparisons with NaN follow IEEE 754
+   const auto nan = std::numeric_limits<double>::quiet_NaN();
+   ROOT::VecOps::RVec<double> x{1., nan, 3., nan, 5., 6., 7., 8., nan};
+   const auto less = x < 4.;
+   const auto equal = x == x;
+   const auto notEqual = x != x;
+   const auto root = sqrt(x);
+   ROOT::VecOps::RVec<float> xf(x);
+   const auto greaterf = xf > 0.f;
+   for (auto i : ROOT::TSeqU(x.size())) {
+      const bool isNaN = std::isnan(x[i]);
+      EXPECT_EQ(less[i], !isNaN && x[i] < 4.);
+      EXPECT_EQ(equal[i], !isNaN);
+      EXPECT_EQ(notEqual[i], isNaN);
+      EXPECT_EQ(greaterf[i], !isNaN);
+      EXPECT_EQ(std::isnan(root[i]), isNaN);
+   }
+}
+
+TEST(VecOps, MaskCompress)
+{
+   ROOT::VecOps::RVec<float> v{1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f};
+   CheckEqual(v[v > 5.f], ROOT::VecOps::RVec<float>{6.f, 7.f, 8.f, 9.f, 10.f, 11.f});
+   CheckEqual(v[v < 0.f], ROOT::VecOps::RVec<float>{});
+   ROOT::VecOps::RVec<short> mask{1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 1};
+   CheckEqual(v[mask], ROOT::VecOps::RVec<float>{1.f, 4.f, 11.f});
+   ROOT::VecOps::RVec<std::string> s{"a", "b", "c"};
+   ROOT::VecOps::RVec<int> smask{0, 1, 1};
+   const auto selected = s[smask];
+   ASSERT_EQ(selected.size(), 2u);
+   EXPECT_EQ(selected[0], "b");
+   EXPECT_EQ(selected[1], "c");
+}
+
+TEST(VecOps, TemporariesReused)
+{
+   // larger than the inline storage, so that the elements live on the heap and can be handed over
+   const std::size_t n = 100;
+   ROOT::VecOps::RVec<double> px(n, 3.), py(n, 4.);
+   auto prod = px * px;
+   const auto prodData = prod.data();
+   auto sum = std::move(prod) + py * py;
+   EXPECT_EQ(sum.data(), prodData);
+   const auto pt = sqrt(std::move(sum));
+   EXPECT_EQ(pt.data(), prodData);
+   CheckEqual(pt, ROOT::VecOps::RVec<double>(n, 5.));
+   CheckEqual(2. * (px - 1.) / 4., ROOT::VecOps::RVec<double>(n, 1.));
+
+   // the elements of an adopting RVec are not its own to overwrite
+   std::vector<float> buffer(n, 2.f);
+   ROOT::VecOps::RVec<float> adopting(buffer.data(), buffer.size());
+   const auto squared = std::move(adopting) * 2.f;
+   CheckEqual(squared, ROOT::VecOps::RVec<float>(n, 4.f));
+   EXPECT_EQ(buffer[0], 2.f);
+}
+
+TEST(VecOps, TemporariesWithOtherScalarTypes)
+{
+   // the result types are those of lvalue operands, and the temporary is reused when it has that type
+   const std::size_t n = 100;
+   RVec<double> px(n, 4.);
+   RVec<float> pf(n, 2.f);
+
+   auto sq = px * px;
+   const auto sqData = sq.data();
+   auto half = std::move(sq) / 2;
+   static_assert(std::is_same<decltype(half), RVec<double>>::value, "");
+   EXPECT_EQ(half.data(), sqData);
+   CheckEqual(half, RVec<double>(n, 8.));
+
+   auto a = sqrt(px) + 1;
+   static_assert(std::is_same<decltype(a), RVec<double>>::value, "");
+   CheckEqual(a, RVec<double>(n, 3.));
+   auto b = 1.f - sqrt(px);
+   static_assert(std::is_same<decltype(b), RVec<double>>::value, "");
+   CheckEqual(b, RVec<double>(n, -1.));
+   auto c = pow(px * 1., 2);
+   static_assert(std::is_same<decltype(c), RVec<double>>::value, "");
+   CheckEqual(c, RVec<double>(n, 16.));
+
+   // float temporaries give double results with double scalars, and float results with int scalars
+   auto d = (pf * pf) * 2.;
+   static_assert(std::is_same<decltype(d), RVec<double>>::value, "");
+   CheckEqual(d, RVec<double>(n, 8.));
+   auto e = pow(pf * pf, 2);
+   static_assert(std::is_same<decltype(e), RVec<double>>::value, "");
+   CheckEqual(e, RVec<double>(n, 16.));
+   auto sum = pf + pf;
+   const auto sumData = sum.data();
+   auto f = 2 * std::move(sum);
+   static_assert(std::is_same<decltype(f), RVec<float>>::value, "");
+   EXPECT_EQ(f.data(), sumData);
+   CheckEqual(f, RVec<float>(n, 8.f));
+   auto g = 8.f / ((pf + pf) - 2);
+   static_assert(std::is_same<decltype(g), RVec<float>>::value, "");
+   CheckEqual(g, RVec<float>(n, 4.f));
+}
+
 TEST(VecOps, PrintOps)
 {
    ROOT::VecOps::RVec<int> ref{1, 2, 3};
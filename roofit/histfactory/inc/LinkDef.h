@@ -25,6 +25,7 @@
 #pragma link C++ class RooStats::HistFactory::HistoToWorkspaceFactoryFast+ ;
 #pragma link C++ class RooStats::HistFactory::RooBarlowBeestonLL+ ;  
 #pragma link C++ class RooStats::HistFactory::HistFactorySimultaneous+ ;  
+#pragma link C++ class RooStats::HistFactory::HistFactoryFastNLL+ ;
 #pragma link C++ class RooStats::HistFactory::HistFactoryNavigation+ ;  
 
 #pragma link C++ class RooStats::HistFactory::ConfigParser+ ;
@@ -0,0 +1,113 @@
+// @(#)root/roostats:$Id$
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef HISTFACTORYFASTNLL
+#define HISTFACTORYFASTNLL
+
+#include "RooAbsReal.h"
+#include "RooSetProxy.h"
+#include "RooArgSet.h"
+#include <map>
+#include <string>
+#include <vector>
+
+class RooAbsData ;
+class RooAbsPdf ;
+class RooRealVar ;
+class RooSimultaneous ;
+
+namespace RooStats{
+  namespace HistFactory{
+
+class HistFactoryFastNLL : public RooAbsReal {
+public:
+
+  HistFactoryFastNLL() ;
+  HistFactoryFastNLL(const char *name, const char *title, RooSimultaneous& simPdf, RooAbsData& data, const RooArgSet* globalObs=0) ;
+  HistFactoryFastNLL(const HistFactoryFastNLL& other, const char* name=0) ;
+  virtual TObject* clone(const char* newname) const { return new HistFactoryFastNLL(*this,newname); }
+  virtual ~HistFactoryFastNLL() ;
+
+  virtual Double_t defaultErrorLevel() const { return 0.5 ; }
+
+  Int_t numChannels() const { return _channels.size() ; }
+  Int_t numBins() const ;
+  // Number of terms which could not be flattened and are evaluated with getVal() in each bin
+  Int_t numGenericTerms() const ;
+
+protected:
+
+  // A PiecewiseInterpolation as arrays over the bins of a channel
+  struct Interpolation {
+    std::vector<double> nominal ; // nominal value in each bin
+    std::vector<double> dHigh ;   // high - nominal, one row of bins for each parameter
+    std::vector<double> dLow ;    // nominal - low, one row of bins for each parameter
+    std::vector<int> params ;     // index of each interpolation parameter in _inputs
+    std::vector<int> codes ;      // interpolation code of each parameter
+    bool positiveDefinite ;
+  } ;
+
+  // A term coef*func of the RooRealSumPdf of a channel, as a product of factors
+  struct Sample {
+    std::vector<double> constant ;            // factors which do not depend on parameters, times the bin volume
+    std::vector<int> scalars ;                // factors which do not depend on the observables (index in _inputs)
+    std::vector<Interpolation> interpolations ;
+    std::vector<std::vector<int> > binParams ; // parameter of each bin of a ParamHistFunc (index in _inputs)
+    std::vector<const RooAbsReal*> generic ;  // other factors, evaluated bin by bin
+  } ;
+
+  struct Channel {
+    std::string name ;
+    std::vector<RooRealVar*> obs ;     // observables of the channel
+    std::vector<double> centers ;      // coordinates of the bin centers, obs.size() values per bin
+    std::vector<double> data ;         // observed events in each bin
+    std::vector<double> logFactorial ; // log(data!)
+    std::vector<Sample> samples ;
+  } ;
+
+  void addChannel(const char* label, RooAbsPdf& channelPdf, const RooAbsData* chanData, const RooArgSet& dataObs) ;
+  void addFactor(Channel& chan, Sample& sample, const RooAbsReal& node, const RooArgSet& obs) ;
+  Bool_t addInterpolation(Channel& chan, Sample& sample, const RooAbsReal& node, const RooArgSet& obs) ;
+  void addConstraint(RooAbsPdf& pdf, const RooArgSet* globalObs) ;
+  int inputIndex(const RooAbsReal& arg) ;
+
+  void loadBin(const Channel& chan, std::size_t bin) const ;
+  void interpolate(const Interpolation& interp, const double* in, double* out, std::size_t nBins) const ;
+  Double_t channelTerm(const Channel& chan, const double* mu) const ;
+  Double_t constraintTerm(const double* in) const ;
+
+  RooSetProxy _params ; // Parameters of the likelihood
+
+  std::vector<Channel> _channels ; //!
+  std::vector<const RooAbsReal*> _inputs ; //! Scalar inputs of the flattened model, read once per evaluation
+  std::map<const RooAbsArg*,int> _inputMap ; //! Index of each input, only used during construction
+
+  // Gaussian and Poisson constraints as arrays of indices in _inputs
+  std::vector<int> _gaussX, _gaussMean, _gaussSigma ; //!
+  std::vector<int> _poisX, _poisMean ; //!
+  std::vector<char> _poisRound, _poisProtect ; //!
+  std::vector<RooAbsPdf*> _otherConstr ; //! Constraints evaluated through getLogVal()
+  RooArgSet _constrNormSet ; //! Normalization set of the other constraints
+
+  mutable std::vector<double> _inputVals ; //!
+  mutable std::vector<double> _yield ;     //!
+  mutable std::vector<double> _sampleYield ; //!
+  mutable std::vector<double> _work ;      //!
+
+  Double_t evaluate() const ;
+
+private:
+
+  ClassDef(RooStats::HistFactory::HistFactoryFastNLL,0) // Flattened binned likelihood of a HistFactory model
+};
+
+  }
+}
+
+#endif
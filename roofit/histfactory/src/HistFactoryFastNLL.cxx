@@ -0,0 +1,667 @@
+// @(#)root/roostats:$Id$
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// \class RooStats::HistFactory::HistFactoryFastNLL
+/// \ingroup HistFactory
+///
+/// Negative log-likelihood of a HistFactory model, as built by
+/// HistoToWorkspaceFactoryFast, which is evaluated on arrays instead of
+/// through the RooFit expression tree.
+///
+/// At construction the RooRealSumPdf of each channel of the RooSimultaneous
+/// is flattened into arrays over the bins of the channel:
+/// - factors which depend on the observables only (RooHistFunc) are
+///   evaluated once and multiplied into a constant yield per bin,
+/// - factors which do not depend on the observables (FlexibleInterpVar, normalization
+///   factors, luminosity, bin width coefficients) are read once per evaluation,
+/// - a PiecewiseInterpolation is stored as its nominal, high and low
+///   variations in each bin, and interpolated for all bins at once,
+/// - a ParamHistFunc is stored as the index of the parameter of each bin.
+///
+/// Any other term is evaluated with getVal() in each bin, which is correct but
+/// slow; numGenericTerms() tells how many such terms the model has.
+/// The likelihood of a channel is the sum of the Poisson terms of its bins.
+/// The Gaussian and Poisson constraint terms, including the Barlow-Beeston
+/// terms of the statistical uncertainties, are computed in loops over arrays
+/// of their parameters, any other constraint with getLogVal().
+///
+/// The value agrees with the likelihood of RooAbsPdf::createNLL() with the
+/// GlobalObservables() argument up to constant terms, and can be minimized with
+/// RooMinimizer. The parameters are proxied by this object, but the flattened
+/// model refers to the nodes of the p.d.f., which must outlive it. The structure
+/// of the model is fixed at construction, the values of the parameters and of
+/// the global observables are read at each evaluation.
+///
+/// ~~~ {.cpp}
+/// RooSimultaneous* simPdf = (RooSimultaneous*) mc->GetPdf() ;
+/// RooStats::HistFactory::HistFactoryFastNLL nll("nll","nll",*simPdf,*data,mc->GetGlobalObservables()) ;
+/// RooMinimizer m(nll) ;
+/// m.migrad() ;
+/// ~~~
+
+#include <algorithm>
+#include <cmath>
+#include <typeinfo>
+
+#include "Riostream.h"
+#include "TList.h"
+#include "TMath.h"
+
+#include "RooFit.h"
+#include "RooAbsBinning.h"
+#include "RooAbsData.h"
+#include "RooArgList.h"
+#include "RooCatType.h"
+#include "RooGaussian.h"
+#include "RooMsgService.h"
+#include "RooPoisson.h"
+#include "RooProduct.h"
+#include "RooRealSumPdf.h"
+#include "RooRealVar.h"
+#include "RooSimultaneous.h"
+
+#include "RooStats/HistFactory/HistFactoryException.h"
+#include "RooStats/HistFactory/HistFactoryFastNLL.h"
+#include "RooStats/HistFactory/HistFactoryModelUtils.h"
+#include "RooStats/HistFactory/ParamHistFunc.h"
+#include "RooStats/HistFactory/PiecewiseInterpolation.h"
+
+using namespace std ;
+
+ClassImp(RooStats::HistFactory::HistFactoryFastNLL);
+
+
+namespace {
+
+  // Return true if any element of list depends on an element of set
+  Bool_t anyDependsOn(const RooArgList& list, const RooArgSet& set)
+  {
+    for (Int_t i=0 ; i<list.getSize() ; i++) {
+      if (list.at(i)->dependsOn(set)) return kTRUE ;
+    }
+    return kFALSE ;
+  }
+
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor, for I/O only
+
+RooStats::HistFactory::HistFactoryFastNLL::HistFactoryFastNLL() :
+  RooAbsReal("HistFactoryFastNLL","HistFactoryFastNLL"),
+  _params("params","Parameters",this)
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Construct the likelihood of the binned data for the HistFactory model simPdf.
+/// The data must hold the index category of simPdf. If globalObs is given, it is
+/// the normalization set of the constraint terms, as in RooAbsPdf::createNLL().
+
+RooStats::HistFactory::HistFactoryFastNLL::HistFactoryFastNLL(const char *name, const char *title,
+                                                              RooSimultaneous& simPdf, RooAbsData& data,
+                                                              const RooArgSet* globalObs) :
+  RooAbsReal(name,title),
+  _params("params","Parameters",this)
+{
+  RooArgSet* params = simPdf.getParameters(data) ;
+  _params.add(*params) ;
+  delete params ;
+
+  // Flatten the channels, with the data of each state of the index category
+  TList* dataByCategory = data.split(simPdf.indexCat()) ;
+  TIterator* iter = simPdf.indexCat().typeIterator() ;
+  RooCatType* type ;
+  while((type=(RooCatType*)iter->Next())) {
+    RooAbsPdf* channelPdf = simPdf.getPdf(type->GetName()) ;
+    if (!channelPdf) continue ;
+    const RooAbsData* chanData = (const RooAbsData*) dataByCategory->FindObject(type->GetName()) ;
+    addChannel(type->GetName(),*channelPdf,chanData,*data.get()) ;
+  }
+  delete iter ;
+  dataByCategory->Delete() ;
+  delete dataByCategory ;
+
+  // The constraint terms are the factors of the channel p.d.f.s which do not depend on the observables
+  RooArgList obsTerms, constraints ;
+  FactorizeHistFactoryPdf(*data.get(),simPdf,obsTerms,constraints) ;
+  _constrNormSet.add(globalObs ? *globalObs : (const RooArgSet&)_params) ;
+  for (Int_t i=0 ; i<constraints.getSize() ; i++) {
+    addConstraint(*(RooAbsPdf*)constraints.at(i),globalObs) ;
+  }
+
+  _inputMap.clear() ;
+  _inputVals.resize(_inputs.size()) ;
+
+  Int_t nGeneric = numGenericTerms() ;
+  coutI(Minimization) << "HistFactoryFastNLL::ctor(" << GetName() << ") flattened " << _channels.size() << " channels with "
+                      << numBins() << " bins, " << _inputs.size() << " inputs and " << _gaussX.size()+_poisX.size()+_otherConstr.size()
+                      << " constraints" << endl ;
+  if (nGeneric>0) {
+    coutW(Minimization) << "HistFactoryFastNLL::ctor(" << GetName() << ") " << nGeneric
+                        << " terms could not be flattened and are evaluated bin by bin" << endl ;
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy constructor. The copy shares the nodes of the p.d.f. with the original.
+
+RooStats::HistFactory::HistFactoryFastNLL::HistFactoryFastNLL(const HistFactoryFastNLL& other, const char* name) :
+  RooAbsReal(other,name),
+  _params("params",this,other._params),
+  _channels(other._channels),
+  _inputs(other._inputs),
+  _gaussX(other._gaussX), _gaussMean(other._gaussMean), _gaussSigma(other._gaussSigma),
+  _poisX(other._poisX), _poisMean(other._poisMean),
+  _poisRound(other._poisRound), _poisProtect(other._poisProtect),
+  _otherConstr(other._otherConstr),
+  _inputVals(other._inputVals),
+  _yield(other._yield), _sampleYield(other._sampleYield), _work(other._work)
+{
+  _constrNormSet.add(other._constrNormSet) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+RooStats::HistFactory::HistFactoryFastNLL::~HistFactoryFastNLL()
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Total number of bins of all channels
+
+Int_t RooStats::HistFactory::HistFactoryFastNLL::numBins() const
+{
+  Int_t n(0) ;
+  for (std::size_t i=0 ; i<_channels.size() ; i++) {
+    n += _channels[i].data.size() ;
+  }
+  return n ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of factors of the samples which are evaluated with getVal() in each bin
+
+Int_t RooStats::HistFactory::HistFactoryFastNLL::numGenericTerms() const
+{
+  Int_t n(0) ;
+  for (std::size_t i=0 ; i<_channels.size() ; i++) {
+    for (std::size_t j=0 ; j<_channels[i].samples.size() ; j++) {
+      n += _channels[i].samples[j].generic.size() ;
+    }
+  }
+  return n ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of arg in the list of scalar inputs, adding it if needed
+
+int RooStats::HistFactory::HistFactoryFastNLL::inputIndex(const RooAbsReal& arg)
+{
+  std::map<const RooAbsArg*,int>::iterator iter = _inputMap.find(&arg) ;
+  if (iter!=_inputMap.end()) return iter->second ;
+  int index = _inputs.size() ;
+  _inputs.push_back(&arg) ;
+  _inputMap[&arg] = index ;
+  return index ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the observables of the channel to the center of the given bin
+
+void RooStats::HistFactory::HistFactoryFastNLL::loadBin(const Channel& chan, std::size_t bin) const
+{
+  const std::size_t nObs = chan.obs.size() ;
+  for (std::size_t k=0 ; k<nObs ; k++) {
+    chan.obs[k]->setVal(chan.centers[bin*nObs+k]) ;
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Flatten the RooRealSumPdf of the channel p.d.f. and fill the observed events
+/// of its bins from chanData (which is null if the channel has no entries)
+
+void RooStats::HistFactory::HistFactoryFastNLL::addChannel(const char* label, RooAbsPdf& channelPdf, const RooAbsData* chanData,
+                                                           const RooArgSet& dataObs)
+{
+  RooRealSumPdf* sumPdf = dynamic_cast<RooRealSumPdf*>(getSumPdfFromChannel(&channelPdf)) ;
+  if (!sumPdf || sumPdf->funcList().getSize()!=sumPdf->coefList().getSize()) {
+    coutE(InputArguments) << "HistFactoryFastNLL::addChannel(" << GetName() << ") ERROR: p.d.f. " << channelPdf.GetName()
+                          << " of channel " << label << " is not a HistFactory channel" << endl ;
+    throw hf_exc() ;
+  }
+
+  _channels.push_back(Channel()) ;
+  Channel& chan = _channels.back() ;
+  chan.name = label ;
+
+  RooArgSet* obs = sumPdf->getObservables(dataObs) ;
+  RooArgSet* obsSnapshot = (RooArgSet*) obs->snapshot() ;
+  std::vector<Int_t> nBinsObs ;
+  std::size_t nBins(1) ;
+  RooFIter obsIter = obs->fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=obsIter.next())) {
+    RooRealVar* var = dynamic_cast<RooRealVar*>(arg) ;
+    if (!var) {
+      coutE(InputArguments) << "HistFactoryFastNLL::addChannel(" << GetName() << ") ERROR: observable " << arg->GetName()
+                            << " of channel " << label << " is not a RooRealVar" << endl ;
+      delete obsSnapshot ;
+      delete obs ;
+      throw hf_exc() ;
+    }
+    chan.obs.push_back(var) ;
+    nBinsObs.push_back(var->getBinning().numBins()) ;
+    nBins *= nBinsObs.back() ;
+  }
+  const std::size_t nObs = chan.obs.size() ;
+
+  // Bins are numbered with the first observable running fastest
+  chan.centers.resize(nBins*nObs) ;
+  std::vector<double> binVolume(nBins,1.) ;
+  for (std::size_t b=0 ; b<nBins ; b++) {
+    std::size_t rest = b ;
+    for (std::size_t k=0 ; k<nObs ; k++) {
+      Int_t ibin = rest % nBinsObs[k] ;
+      rest /= nBinsObs[k] ;
+      const RooAbsBinning& binning = chan.obs[k]->getBinning() ;
+      chan.centers[b*nObs+k] = binning.binCenter(ibin) ;
+      binVolume[b] *= binning.binWidth(ibin) ;
+    }
+  }
+
+  chan.data.assign(nBins,0.) ;
+  if (chanData) {
+    for (Int_t i=0 ; i<chanData->numEntries() ; i++) {
+      const RooArgSet* row = chanData->get(i) ;
+      std::size_t b(0), stride(1) ;
+      for (std::size_t k=0 ; k<nObs ; k++) {
+        b += stride*chan.obs[k]->getBinning().binNumber(row->getRealValue(chan.obs[k]->GetName())) ;
+        stride *= nBinsObs[k] ;
+      }
+      chan.data[b] += chanData->weight() ;
+    }
+  }
+  chan.logFactorial.resize(nBins) ;
+  for (std::size_t b=0 ; b<nBins ; b++) {
+    chan.logFactorial[b] = TMath::LnGamma(chan.data[b]+1) ;
+  }
+
+  for (Int_t i=0 ; i<sumPdf->funcList().getSize() ; i++) {
+    chan.samples.push_back(Sample()) ;
+    Sample& sample = chan.samples.back() ;
+    sample.constant = binVolume ;
+    addFactor(chan,sample,(const RooAbsReal&)*sumPdf->coefList().at(i),*obs) ;
+    addFactor(chan,sample,(const RooAbsReal&)*sumPdf->funcList().at(i),*obs) ;
+  }
+
+  if (_yield.size()<nBins) {
+    _yield.resize(nBins) ;
+    _sampleYield.resize(nBins) ;
+    _work.resize(nBins) ;
+  }
+
+  *obs = *obsSnapshot ;
+  delete obsSnapshot ;
+  delete obs ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add node as a factor of the yield of sample
+
+void RooStats::HistFactory::HistFactoryFastNLL::addFactor(Channel& chan, Sample& sample, const RooAbsReal& node, const RooArgSet& obs)
+{
+  const std::size_t nBins = chan.data.size() ;
+
+  if (!node.dependsOn(obs)) {
+    sample.scalars.push_back(inputIndex(node)) ;
+    return ;
+  }
+
+  if (!node.dependsOn(_params)) {
+    for (std::size_t b=0 ; b<nBins ; b++) {
+      loadBin(chan,b) ;
+      sample.constant[b] *= node.getVal() ;
+    }
+    return ;
+  }
+
+  if (typeid(node)==typeid(RooProduct)) {
+    RooArgList comps = const_cast<RooProduct&>((const RooProduct&)node).components() ;
+    Bool_t allReal(kTRUE) ;
+    for (Int_t i=0 ; i<comps.getSize() ; i++) {
+      if (!dynamic_cast<RooAbsReal*>(comps.at(i))) allReal = kFALSE ;
+    }
+    if (allReal) {
+      for (Int_t i=0 ; i<comps.getSize() ; i++) {
+        addFactor(chan,sample,(const RooAbsReal&)*comps.at(i),obs) ;
+      }
+      return ;
+    }
+  }
+
+  if (addInterpolation(chan,sample,node,obs)) return ;
+
+  const ParamHistFunc* paramHist = dynamic_cast<const ParamHistFunc*>(&node) ;
+  if (paramHist && !anyDependsOn(paramHist->paramList(),obs)) {
+    std::vector<int> binParams(nBins) ;
+    for (std::size_t b=0 ; b<nBins ; b++) {
+      loadBin(chan,b) ;
+      binParams[b] = inputIndex(paramHist->getParameter()) ;
+    }
+    sample.binParams.push_back(binParams) ;
+    return ;
+  }
+
+  sample.generic.push_back(&node) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add node to the interpolations of sample if it is a PiecewiseInterpolation
+/// whose variations depend on the observables only, and whose interpolation
+/// parameters do not depend on them.
+
+Bool_t RooStats::HistFactory::HistFactoryFastNLL::addInterpolation(Channel& chan, Sample& sample, const RooAbsReal& node,
+                                                                   const RooArgSet& obs)
+{
+  const PiecewiseInterpolation* pi = dynamic_cast<const PiecewiseInterpolation*>(&node) ;
+  if (!pi) return kFALSE ;
+
+  const RooArgList& params = pi->paramList() ;
+  const std::vector<int>& codes = pi->interpolationCodes() ;
+  if (Int_t(codes.size())!=params.getSize() || pi->nominalHist().dependsOn(_params) ||
+      anyDependsOn(pi->lowList(),_params) || anyDependsOn(pi->highList(),_params) || anyDependsOn(params,obs)) {
+    return kFALSE ;
+  }
+  for (std::size_t j=0 ; j<codes.size() ; j++) {
+    if (codes[j]<0 || codes[j]>5) return kFALSE ;
+  }
+
+  const std::size_t nBins = chan.data.size() ;
+  const std::size_t nParams = codes.size() ;
+  Interpolation interp ;
+  interp.codes = codes ;
+  interp.positiveDefinite = pi->positiveDefinite() ;
+  interp.nominal.resize(nBins) ;
+  interp.dHigh.resize(nBins*nParams) ;
+  interp.dLow.resize(nBins*nParams) ;
+  for (std::size_t b=0 ; b<nBins ; b++) {
+    loadBin(chan,b) ;
+    const double nominal = pi->nominalHist().getVal() ;
+    interp.nominal[b] = nominal ;
+    for (std::size_t j=0 ; j<nParams ; j++) {
+      interp.dHigh[j*nBins+b] = ((RooAbsReal*)pi->highList().at(j))->getVal() - nominal ;
+      interp.dLow[j*nBins+b] = nominal - ((RooAbsReal*)pi->lowList().at(j))->getVal() ;
+    }
+  }
+  for (std::size_t j=0 ; j<nParams ; j++) {
+    interp.params.push_back(inputIndex((const RooAbsReal&)*params.at(j))) ;
+  }
+
+  sample.interpolations.push_back(interp) ;
+  return kTRUE ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a constraint term. Gaussian and Poisson constraints are computed from
+/// their inputs, other p.d.f.s with getLogVal().
+
+void RooStats::HistFactory::HistFactoryFastNLL::addConstraint(RooAbsPdf& pdf, const RooArgSet* globalObs)
+{
+  if (typeid(pdf)==typeid(RooGaussian)) {
+    const RooGaussian& gauss = (const RooGaussian&) pdf ;
+    if (!globalObs || !gauss.getSigma().dependsOn(*globalObs)) {
+      _gaussX.push_back(inputIndex(gauss.getX())) ;
+      _gaussMean.push_back(inputIndex(gauss.getMean())) ;
+      _gaussSigma.push_back(inputIndex(gauss.getSigma())) ;
+      return ;
+    }
+  }
+
+  if (typeid(pdf)==typeid(RooPoisson)) {
+    const RooPoisson& pois = (const RooPoisson&) pdf ;
+    if (!globalObs || !pois.getMean().dependsOn(*globalObs)) {
+      _poisX.push_back(inputIndex(pois.getX())) ;
+      _poisMean.push_back(inputIndex(pois.getMean())) ;
+      _poisRound.push_back(!pois.getNoRounding()) ;
+      _poisProtect.push_back(pois.getProtectNegativeMean()) ;
+      return ;
+    }
+  }
+
+  _otherConstr.push_back(&pdf) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the PiecewiseInterpolation interp in all bins, as PiecewiseInterpolation::evaluate() does
+
+void RooStats::HistFactory::HistFactoryFastNLL::interpolate(const Interpolation& interp, const double* in, double* out,
+                                                            std::size_t nBins) const
+{
+  const double* nom = interp.nominal.data() ;
+  std::copy(nom,nom+nBins,out) ;
+
+  for (std::size_t j=0 ; j<interp.params.size() ; j++) {
+    const double x = in[interp.params[j]] ;
+    const double* dh = interp.dHigh.data() + j*nBins ;
+    const double* dl = interp.dLow.data() + j*nBins ;
+
+    switch(interp.codes[j]) {
+    case 0: {
+      // piece-wise linear
+      const double* d = x>0 ? dh : dl ;
+      for (std::size_t b=0 ; b<nBins ; b++) out[b] += x*d[b] ;
+      break ;
+    }
+    case 1: {
+      // piece-wise log
+      if (x>=0) {
+        for (std::size_t b=0 ; b<nBins ; b++) out[b] *= pow((nom[b]+dh[b])/nom[b],x) ;
+      } else {
+        for (std::size_t b=0 ; b<nBins ; b++) out[b] *= pow((nom[b]-dl[b])/nom[b],-x) ;
+      }
+      break ;
+    }
+    case 2:
+    case 3: {
+      // parabolic with linear extrapolation
+      if (x>1) {
+        for (std::size_t b=0 ; b<nBins ; b++) out[b] += (1.5*dh[b]-0.5*dl[b])*(x-1) + dh[b] ;
+      } else if (x<-1) {
+        for (std::size_t b=0 ; b<nBins ; b++) out[b] += -(0.5*dh[b]-1.5*dl[b])*(x+1) - dl[b] ;
+      } else {
+        for (std::size_t b=0 ; b<nBins ; b++) out[b] += 0.5*(dh[b]-dl[b])*x*x + 0.5*(dh[b]+dl[b])*x ;
+      }
+      break ;
+    }
+    case 4: {
+      // polynomial with linear extrapolation, the polynomial part does not go below zero
+      if (x>1) {
+        for (std::size_t b=0 ; b<nBins ; b++) out[b] += x*dh[b] ;
+      } else if (x<-1) {
+        for (std::size_t b=0 ; b<nBins ; b++) out[b] += x*dl[b] ;
+      } else {
+        const double x2 = x*x ;
+        const double poly = x2*(15 + x2*(-10 + x2*3)) ;
+        for (std::size_t b=0 ; b<nBins ; b++) {
+          const double val = nom[b] + x*0.5*(dh[b]+dl[b]) + poly*0.0625*(dh[b]-dl[b]) ;
+          out[b] += (val<0 ? 0. : val) - nom[b] ;
+        }
+      }
+      break ;
+    }
+    case 5: {
+      // quartic with linear extrapolation
+      if (x>1 || x<-1) {
+        const double* d = x>0 ? dh : dl ;
+        for (std::size_t b=0 ; b<nBins ; b++) out[b] += x*d[b] ;
+      } else {
+        const double x2 = x*x ;
+        for (std::size_t b=0 ; b<nBins ; b++) {
+          if (nom[b]==0) continue ;
+          const double S = 0.5*(dh[b]+dl[b]) ;
+          const double A = 0.5*(dh[b]-dl[b]) ;
+          const double val = nom[b] + S*x + 1.5*A*x2 - 0.5*A*x2*x2 ;
+          out[b] += (val<0 ? 0. : val) - nom[b] ;
+        }
+      }
+      break ;
+    }
+    }
+  }
+
+  if (interp.positiveDefinite) {
+    for (std::size_t b=0 ; b<nBins ; b++) {
+      if (out[b]<0) out[b] = 0 ;
+    }
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sum of -log(Poisson(n|mu)) over the bins of the channel, with the special
+/// cases of the binned likelihood of RooNLLVar
+
+Double_t RooStats::HistFactory::HistFactoryFastNLL::channelTerm(const Channel& chan, const double* mu) const
+{
+  const std::size_t nBins = chan.data.size() ;
+  const double* n = chan.data.data() ;
+  const double* logFactorial = chan.logFactorial.data() ;
+
+  Double_t result(0), carry(0) ;
+  for (std::size_t b=0 ; b<nBins ; b++) {
+    Double_t term ;
+    if (mu[b]<=0 && n[b]>0) {
+      // Catch error condition: data present where zero events are predicted
+      logEvalError(Form("Observed %f events in bin %d of channel %s with zero event yield",n[b],(int)b,chan.name.c_str())) ;
+      continue ;
+    } else if (n[b]==0) {
+      term = mu[b] ;
+    } else {
+      term = mu[b] - n[b]*log(mu[b]) + logFactorial[b] ;
+    }
+
+    // Kahan summation of result
+    Double_t y = term - carry ;
+    Double_t t = result + y ;
+    carry = (t - result) - y ;
+    result = t ;
+  }
+  return result ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sum of -log of the constraint terms
+
+Double_t RooStats::HistFactory::HistFactoryFastNLL::constraintTerm(const double* in) const
+{
+  Double_t result(0) ;
+
+  const Double_t logSqrt2Pi = 0.5*log(TMath::TwoPi()) ;
+  for (std::size_t i=0 ; i<_gaussX.size() ; i++) {
+    const double sigma = in[_gaussSigma[i]] ;
+    const double z = (in[_gaussX[i]] - in[_gaussMean[i]])/sigma ;
+    result += 0.5*z*z + log(sigma) + logSqrt2Pi ;
+  }
+
+  // The Barlow-Beeston terms of the statistical uncertainties
+  for (std::size_t i=0 ; i<_poisX.size() ; i++) {
+    const double k = _poisRound[i] ? floor(in[_poisX[i]]) : in[_poisX[i]] ;
+    const double mean = in[_poisMean[i]] ;
+    if (_poisProtect[i] && mean<0) {
+      result -= log(1e-3) ;
+    } else if (k==0) {
+      result += mean ;
+    } else if (k<0 || mean<=0) {
+      logEvalError(Form("Poisson constraint with observed %f and mean %f evaluates to zero",k,mean)) ;
+    } else {
+      result += mean - k*log(mean) + TMath::LnGamma(k+1) ;
+    }
+  }
+
+  for (std::size_t i=0 ; i<_otherConstr.size() ; i++) {
+    result -= _otherConstr[i]->getLogVal(&_constrNormSet) ;
+  }
+
+  return result ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the expected events of all bins and return the negative log-likelihood
+
+Double_t RooStats::HistFactory::HistFactoryFastNLL::evaluate() const
+{
+  for (std::size_t i=0 ; i<_inputs.size() ; i++) {
+    _inputVals[i] = _inputs[i]->getVal() ;
+  }
+  const double* in = _inputVals.data() ;
+  double* yield = _yield.data() ;
+  double* sampleYield = _sampleYield.data() ;
+  double* work = _work.data() ;
+
+  Double_t result(0) ;
+  for (std::size_t c=0 ; c<_channels.size() ; c++) {
+    const Channel& chan = _channels[c] ;
+    const std::size_t nBins = chan.data.size() ;
+    std::fill(yield,yield+nBins,0.) ;
+
+    for (std::size_t s=0 ; s<chan.samples.size() ; s++) {
+      const Sample& sample = chan.samples[s] ;
+
+      double scale(1) ;
+      for (std::size_t i=0 ; i<sample.scalars.size() ; i++) scale *= in[sample.scalars[i]] ;
+      const double* constant = sample.constant.data() ;
+      for (std::size_t b=0 ; b<nBins ; b++) sampleYield[b] = scale*constant[b] ;
+
+      for (std::size_t i=0 ; i<sample.interpolations.size() ; i++) {
+        interpolate(sample.interpolations[i],in,work,nBins) ;
+        for (std::size_t b=0 ; b<nBins ; b++) sampleYield[b] *= work[b] ;
+      }
+
+      for (std::size_t i=0 ; i<sample.binParams.size() ; i++) {
+        const int* index = sample.binParams[i].data() ;
+        for (std::size_t b=0 ; b<nBins ; b++) sampleYield[b] *= in[index[b]] ;
+      }
+
+      if (!sample.generic.empty()) {
+        std::vector<double> obsVals(chan.obs.size()) ;
+        for (std::size_t k=0 ; k<chan.obs.size() ; k++) obsVals[k] = chan.obs[k]->getVal() ;
+        for (std::size_t b=0 ; b<nBins ; b++) {
+          loadBin(chan,b) ;
+          for (std::size_t i=0 ; i<sample.generic.size() ; i++) sampleYield[b] *= sample.generic[i]->getVal() ;
+        }
+        for (std::size_t k=0 ; k<chan.obs.size() ; k++) chan.obs[k]->setVal(obsVals[k]) ;
+      }
+
+      for (std::size_t b=0 ; b<nBins ; b++) yield[b] += sampleYield[b] ;
+    }
+
+    result += channelTerm(chan,yield) ;
+  }
+
+  result += constraintTerm(in) ;
+  return result ;
+}
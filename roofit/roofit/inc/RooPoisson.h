@@ -32,9 +32,14 @@ public:
   
   void setNoRounding(bool flag = kTRUE){_noRounding = flag;}
   void protectNegativeMean(bool flag = kTRUE){_protectNegative = flag;}
+  Bool_t getNoRounding() const { return _noRounding ; }
+  Bool_t getProtectNegativeMean() const { return _protectNegative ; }
 
   Double_t getLogVal(const RooArgSet* set=0) const ;
 
+  const RooAbsReal& getX() const { return x.arg() ; }
+  const RooAbsReal& getMean() const { return mean.arg() ; }
+
 protected:
 
   RooRealProxy x ;
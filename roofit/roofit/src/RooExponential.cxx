@@ -57,6 +57,36 @@ Double_t RooExponential::evaluate() const{
   return exp(c*x);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values for a batch of events
+
+RooSpan<double> RooExponential::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  RooSpan<const double> xVals = x.getValBatch(begin,batchSize);
+  RooSpan<const double> cVals = c.getValBatch(begin,batchSize);
+
+  if (xVals.size()==1 && cVals.size()==1) {
+    RooSpan<double> values = makeBatch(1);
+    values[0] = exp(cVals[0]*xVals[0]);
+    return values;
+  }
+
+  RooSpan<double> values = makeBatch(batchSize);
+  if (cVals.size()==1) {
+    const Double_t slope = cVals[0];
+    const double* xv = xVals.data();
+    double* out = values.data();
+    for (std::size_t i=0; i<batchSize; i++) {
+      out[i] = exp(slope*xv[i]);
+    }
+  } else {
+    for (std::size_t i=0; i<batchSize; i++) {
+      values[i] = exp((cVals.size()==1 ? cVals[0] : cVals[i])*(xVals.size()==1 ? xVals[0] : xVals[i]));
+    }
+  }
+  return values;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooExponential::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const
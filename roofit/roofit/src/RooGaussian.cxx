@@ -69,6 +69,43 @@ Double_t RooGaussian::evaluate() const
   return ret ;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values for a batch of events. The usual case of a batch of
+/// observables with a single mean and width is a loop without branches.
+
+RooSpan<double> RooGaussian::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  RooSpan<const double> xVals = x.getValBatch(begin,batchSize) ;
+  RooSpan<const double> meanVals = mean.getValBatch(begin,batchSize) ;
+  RooSpan<const double> sigmaVals = sigma.getValBatch(begin,batchSize) ;
+
+  if (xVals.size()==1 && meanVals.size()==1 && sigmaVals.size()==1) {
+    RooSpan<double> values = makeBatch(1) ;
+    const Double_t arg = xVals[0] - meanVals[0] ;
+    values[0] = exp(-0.5*arg*arg/(sigmaVals[0]*sigmaVals[0])) ;
+    return values ;
+  }
+
+  RooSpan<double> values = makeBatch(batchSize) ;
+  if (meanVals.size()==1 && sigmaVals.size()==1) {
+    const Double_t m = meanVals[0] ;
+    const Double_t sig = sigmaVals[0] ;
+    const double* xv = xVals.data() ;
+    double* out = values.data() ;
+    for (std::size_t i=0 ; i<batchSize ; i++) {
+      const Double_t arg = xv[i] - m ;
+      out[i] = exp(-0.5*arg*arg/(sig*sig)) ;
+    }
+  } else {
+    for (std::size_t i=0 ; i<batchSize ; i++) {
+      const Double_t arg = (xVals.size()==1 ? xVals[0] : xVals[i]) - (meanVals.size()==1 ? meanVals[0] : meanVals[i]) ;
+      const Double_t sig = sigmaVals.size()==1 ? sigmaVals[0] : sigmaVals[i] ;
+      values[i] = exp(-0.5*arg*arg/(sig*sig)) ;
+    }
+  }
+  return values ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// calculate and return the negative log-likelihood of the Poisson
 
@@ -123,6 +123,46 @@ Double_t RooPolynomial::evaluate() const
   return retVal * std::pow(x, lowestOrder) + (lowestOrder ? 1.0 : 0.0);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values for a batch of events. The coefficients are evaluated
+/// once for the whole batch, unless they depend on the observables themselves.
+
+RooSpan<double> RooPolynomial::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  const unsigned sz = _coefList.getSize();
+  const int lowestOrder = _lowestOrder;
+  if (!sz) {
+    RooSpan<double> values = makeBatch(1);
+    values[0] = lowestOrder ? 1. : 0.;
+    return values;
+  }
+
+  RooSpan<const double> xVals = _x.getValBatch(begin, batchSize);
+  if (xVals.size() == 1) return evaluateEventByEvent(begin, batchSize, 0, kFALSE);
+
+  _wksp.clear();
+  _wksp.reserve(sz);
+  {
+    const RooArgSet* nset = _coefList.nset();
+    RooFIter it = _coefList.fwdIterator();
+    RooAbsReal* c;
+    while ((c = (RooAbsReal*) it.next())) {
+      if (c->dependsOnBatchData()) return evaluateEventByEvent(begin, batchSize, 0, kFALSE);
+      _wksp.push_back(c->getVal(nset));
+    }
+  }
+
+  RooSpan<double> values = makeBatch(batchSize);
+  const Double_t offset = lowestOrder ? 1.0 : 0.0;
+  for (std::size_t j = 0; j < batchSize; ++j) {
+    const Double_t x = xVals[j];
+    Double_t retVal = _wksp[sz - 1];
+    for (unsigned i = sz - 1; i--; ) retVal = _wksp[i] + x * retVal;
+    values[j] = retVal * std::pow(x, lowestOrder) + offset;
+  }
+  return values;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooPolynomial::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const
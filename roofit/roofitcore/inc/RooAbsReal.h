@@ -22,6 +22,7 @@
 #include "RooArgSet.h"
 #include "RooArgList.h"
 #include "RooGlobalFunc.h"
+#include "RooSpan.h"
 
 class RooArgList ;
 class RooDataSet ;
@@ -48,6 +49,7 @@ class TH3F;
 
 #include <list>
 #include <string>
+#include <vector>
 #include <iostream>
 
 class RooAbsReal : public RooAbsArg {
@@ -73,6 +75,10 @@ public:
 
   virtual Double_t getValV(const RooArgSet* set=0) const ;
 
+  // Values for a batch of events of the dataset bound to this expression
+  virtual RooSpan<const double> getValBatch(std::size_t begin, std::size_t batchSize, const RooArgSet* normSet=0) const ;
+  Bool_t dependsOnBatchData() const ;
+
   Double_t getPropagatedError(const RooFitResult &fr, const RooArgSet &nset = RooArgSet());
 
   Bool_t operator==(Double_t value) const ;
@@ -372,6 +378,14 @@ protected:
   }
   virtual Double_t evaluate() const = 0 ;
 
+  // Batch evaluation
+  virtual RooSpan<double> evaluateBatch(std::size_t begin, std::size_t batchSize) const ;
+  RooSpan<double> evaluateEventByEvent(std::size_t begin, std::size_t batchSize, const RooArgSet* normSet, Bool_t normalize) const ;
+  RooSpan<double> makeBatch(std::size_t batchSize) const ;
+  void setBatchData(const Double_t* values) { _batchData = values ; _batchDataF = 0 ; }
+  void setBatchData(const Float_t* values) { _batchData = 0 ; _batchDataF = values ; }
+  Bool_t hasBatchData() const { return _batchData || _batchDataF ; }
+
   // Hooks for RooDataSet interface
   friend class RooRealIntegral ;
   friend class RooVectorDataStore ;
@@ -482,6 +496,10 @@ protected:
   mutable RooArgSet* _lastNSet ; //!
   static Bool_t _hideOffset ; // Offset hiding flag
 
+  const Double_t* _batchData ; //! Values of all events of the data column bound to this object, if any
+  const Float_t* _batchDataF ; //! Same for a data column stored in single precision
+  mutable std::vector<double> _batchValues ; //! Values computed for the last batch of events
+
   ClassDef(RooAbsReal,2) // Abstract real-valued variable
 };
 
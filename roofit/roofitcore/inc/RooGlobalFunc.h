@@ -131,6 +131,7 @@ RooCmdArg Import(TTree& tree) ;
 RooCmdArg ImportFromFile(const char* fname, const char* tname) ;
 RooCmdArg StoreError(const RooArgSet& aset) ; 
 RooCmdArg StoreAsymError(const RooArgSet& aset) ; 
+RooCmdArg StoreAsFloat(const RooArgSet& aset) ;
 RooCmdArg OwnLinked() ;
 
 // RooChi2Var::ctor arguments
@@ -194,6 +195,8 @@ RooCmdArg CloneData(Bool_t flag) ;
 RooCmdArg Integrate(Bool_t flag) ;
 RooCmdArg Minimizer(const char* type, const char* alg=0) ;
 RooCmdArg Offset(Bool_t flag=kTRUE) ;
+RooCmdArg BatchMode(Bool_t flag=kTRUE) ;
+RooCmdArg NumThreads(Int_t nThreads, Int_t interleave=0) ;
 
 // RooAbsPdf::paramOn arguments
 RooCmdArg Label(const char* str) ;
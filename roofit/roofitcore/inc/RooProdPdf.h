@@ -54,6 +54,7 @@ public:
   virtual ~RooProdPdf() ;
 
   virtual Double_t getValV(const RooArgSet* set=0) const ;
+  virtual RooSpan<const double> getValBatch(std::size_t begin, std::size_t batchSize, const RooArgSet* normSet=0) const ;
   Double_t evaluate() const ;
   virtual Bool_t checkObservables(const RooArgSet* nset) const ;	
 
@@ -153,6 +154,7 @@ protected:
   RooAbsReal* specializeRatio(RooFormulaVar& input, const char* targetRangeName) const ;
   Double_t calculate(const RooProdPdf::CacheElem& cache, Bool_t verbose=kFALSE) const ;
   Double_t calculate(const RooArgList* partIntList, const RooLinkedList* normSetList) const ;
+  RooSpan<double> evaluateBatch(std::size_t begin, std::size_t batchSize) const ;
 
  
   friend class RooProdGenContext ;
@@ -0,0 +1,50 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ *    File: $Id$
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+#ifndef ROO_SPAN
+#define ROO_SPAN
+
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////////////////////
+/// A view on a contiguous range of values, which does not own them. It is used
+/// to pass the values of a batch of events between the objects of a RooFit
+/// expression tree, see RooAbsReal::getValBatch().
+
+template<class T>
+class RooSpan {
+public:
+  typedef T value_type ;
+  typedef T* iterator ;
+
+  RooSpan() : _data(0), _size(0) {}
+  RooSpan(T* data, std::size_t size) : _data(data), _size(size) {}
+
+  // A span of non-const values can be used where a span of const values is expected
+  template<class U>
+  RooSpan(const RooSpan<U>& other) : _data(other.data()), _size(other.size()) {}
+
+  T* data() const { return _data ; }
+  std::size_t size() const { return _size ; }
+  bool empty() const { return _size==0 ; }
+
+  T& operator[](std::size_t i) const { return _data[i] ; }
+
+  iterator begin() const { return _data ; }
+  iterator end() const { return _data + _size ; }
+
+  // Sub-range of 'count' values starting at 'offset'
+  RooSpan subspan(std::size_t offset, std::size_t count) const { return RooSpan(_data + offset, count) ; }
+
+private:
+  T* _data ;
+  std::size_t _size ;
+};
+
+#endif
@@ -97,6 +97,12 @@ public:
   // Buffer redirection routines used in inside RooAbsOptTestStatistics
   virtual void attachBuffers(const RooArgSet& extObs) ; 
   virtual void resetBuffers() ;
+
+  // Column access for batch evaluations (see RooAbsReal::getValBatch())
+  void attachBatchData(Bool_t attach=kTRUE) ;
+  RooSpan<const double> getWeightBatch(std::size_t first, std::size_t len) const ;
+  RooSpan<const double> getBatch(const RooAbsArg& real, std::size_t first, std::size_t len) const ;
+  RooSpan<const float> getFloatBatch(const RooAbsArg& real, std::size_t first, std::size_t len) const ;
   
   
   // Constant term  optimizer interface
@@ -111,6 +117,10 @@ public:
   const RooVectorDataStore* cache() const { return _cache ; }
 
   void loadValues(const RooAbsDataStore *tds, const RooFormulaVar* select=0, const char* rangeName=0, Int_t nStart=0, Int_t nStop=2000000000) ;
+
+  // Bulk import of columns, without going through a RooTreeDataStore
+  Bool_t loadValues(const TTree *t, const RooFormulaVar* select=0, const char* rangeName=0) ;
+  Bool_t loadColumns(const RooArgList& vars, const std::vector<RooSpan<const double> >& columns, const RooFormulaVar* select=0, const char* rangeName=0) ;
   
   void dump() ;
 
@@ -135,12 +145,12 @@ public:
   class RealVector {
   public:
     RealVector(UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(Double_t))) : 
-      _nativeReal(0), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0) { 
+      _float(kFALSE), _nativeReal(0), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _vecF0(0), _tracker(0), _nset(0) { 
       _vec.reserve(initialCapacity);
     }
 
     RealVector(RooAbsReal* arg, UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(Double_t))) : 
-      _nativeReal(arg), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0) { 
+      _float(kFALSE), _nativeReal(arg), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _vecF0(0), _tracker(0), _nset(0) { 
       _vec.reserve(initialCapacity);
     }
 
@@ -150,8 +160,9 @@ public:
     }
 
     RealVector(const RealVector& other, RooAbsReal* real=0) : 
-      _vec(other._vec), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf), _nset(0)   {
+      _vec(other._vec), _vecF(other._vecF), _float(other._float), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf), _nset(0)   {
       _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
+      _vecF0 = _vecF.size()>0 ? &_vecF.front() : 0 ;
       if (other._tracker) {
 	_tracker = new RooChangeTracker(Form("track_%s",_nativeReal->GetName()),"tracker",other._tracker->parameters()) ;
       } else {
@@ -168,15 +179,11 @@ public:
       _real = other._real;
       _buf = other._buf;
       _nativeBuf = other._nativeBuf;
-      if (other._vec.size() <= _vec.capacity() / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Double_t))) {
-	std::vector<Double_t> tmp;
-	tmp.reserve(std::max(other._vec.size(), VECTOR_BUFFER_SIZE / sizeof(Double_t)));
-	tmp.assign(other._vec.begin(), other._vec.end());
-	_vec.swap(tmp);
-      } else {
-	_vec = other._vec;
-      }
+      _float = other._float;
+      assignVector(_vec,other._vec);
+      assignVector(_vecF,other._vecF);
       _vec0 = _vec.size()>0 ? &_vec.front() : 0;
+      _vecF0 = _vecF.size()>0 ? &_vecF.front() : 0;
       return *this;
     }
     
@@ -212,66 +219,152 @@ public:
     }
 
     void fill() { 
+      if (_float) {
+	_vecF.push_back(Float_t(*_buf)) ;
+	_vecF0 = &_vecF.front() ;
+	return ;
+      }
       _vec.push_back(*_buf) ; 
       _vec0 = &_vec.front() ;
     } ;
 
+    // Append the n values of a column, e.g. in a bulk import
+    void fill(const Double_t* values, std::size_t n) {
+      if (_float) {
+	_vecF.insert(_vecF.end(),values,values+n) ;
+	_vecF0 = _vecF.size()>0 ? &_vecF.front() : 0 ;
+	return ;
+      }
+      _vec.insert(_vec.end(),values,values+n) ;
+      _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
+    }
+
     void write(Int_t i) {
 /*         std::cout << "write(" << this << ") [" << i << "] nativeReal = " << _nativeReal << " = " << _nativeReal->GetName() << " real = " << _real << " buf = " << _buf << " value = " << *_buf << " native getVal() = " << _nativeReal->getVal() << " getVal() = " << _real->getVal() << std::endl ;  */
-      _vec[i] = *_buf ;
+      if (_float) {
+	_vecF[i] = Float_t(*_buf) ;
+      } else {
+	_vec[i] = *_buf ;
+      }
     }
     
     void reset() { 
-      // make sure the vector releases the underlying memory
+      // make sure the vectors release the underlying memory
       std::vector<Double_t> tmp;
       _vec.swap(tmp);
+      std::vector<Float_t> tmpF;
+      _vecF.swap(tmpF);
       _vec0 = 0;
+      _vecF0 = 0;
     }
 
     inline void get(Int_t idx) const { 
-      *_buf = *(_vec0+idx) ; 
+      *_buf = _float ? Double_t(*(_vecF0+idx)) : *(_vec0+idx) ; 
     }
 
     inline void getNative(Int_t idx) const { 
-      *_nativeBuf = *(_vec0+idx) ; 
+      *_nativeBuf = _float ? Double_t(*(_vecF0+idx)) : *(_vec0+idx) ; 
     }
 
-    Int_t size() const { return _vec.size() ; }
+    Int_t size() const { return _float ? _vecF.size() : _vec.size() ; }
 
     void resize(Int_t siz) {
-      if (siz < Int_t(_vec.capacity()) / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Double_t))) {
-	// do an expensive copy, if we save at least a factor 2 in size
-	std::vector<Double_t> tmp;
-	tmp.reserve(std::max(siz, Int_t(VECTOR_BUFFER_SIZE / sizeof(Double_t))));
-	if (!_vec.empty())
-	    tmp.assign(_vec.begin(), std::min(_vec.end(), _vec.begin() + siz));
-	if (Int_t(tmp.size()) != siz) 
-	    tmp.resize(siz);
-	_vec.swap(tmp);
+      if (_float) {
+	resizeVector(_vecF,siz) ;
       } else {
-	_vec.resize(siz);
+	resizeVector(_vec,siz) ;
       }
       _vec0 = _vec.size() > 0 ? &_vec.front() : 0;
+      _vecF0 = _vecF.size() > 0 ? &_vecF.front() : 0;
     }
 
     void reserve(Int_t siz) {
-      _vec.reserve(siz);
+      if (_float) {
+	_vecF.reserve(siz);
+      } else {
+	_vec.reserve(siz);
+      }
+      _vec0 = _vec.size() > 0 ? &_vec.front() : 0;
+      _vecF0 = _vecF.size() > 0 ? &_vecF.front() : 0;
+    }
+
+    // Store the values in single precision, which halves the memory used by
+    // the column. The values already stored are converted.
+    void setFloatStorage(Bool_t flag=kTRUE) {
+      if (flag==_float) return ;
+      if (flag) {
+	_vecF.reserve(_vec.capacity()) ;
+	_vecF.assign(_vec.begin(),_vec.end()) ;
+	std::vector<Double_t> tmp ;
+	_vec.swap(tmp) ;
+      } else {
+	_vec.reserve(_vecF.capacity()) ;
+	_vec.assign(_vecF.begin(),_vecF.end()) ;
+	std::vector<Float_t> tmp ;
+	_vecF.swap(tmp) ;
+      }
+      _float = flag ;
       _vec0 = _vec.size() > 0 ? &_vec.front() : 0;
+      _vecF0 = _vecF.size() > 0 ? &_vecF.front() : 0;
+    }
+
+    Bool_t isFloatStorage() const { return _float ; }
+
+    // Let the object into which the column is loaded read the values of all
+    // events directly in the column (see RooAbsReal::getValBatch())
+    void attachBatchData(Bool_t attach) {
+      if (!_real) return ;
+      if (!attach || size()==0) {
+	_real->setBatchData((const Double_t*)0) ;
+      } else if (_float) {
+	_real->setBatchData(&_vecF.front()) ;
+      } else {
+	_real->setBatchData(&_vec.front()) ;
+      }
     }
 
   protected:
     std::vector<Double_t> _vec ;
+    std::vector<Float_t> _vecF ; // Values of a column stored in single precision
+
+    template<class T> static void resizeVector(std::vector<T>& vec, Int_t siz) {
+      if (siz < Int_t(vec.capacity()) / 2 && vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(T))) {
+	// do an expensive copy, if we save at least a factor 2 in size
+	std::vector<T> tmp;
+	tmp.reserve(std::max(siz, Int_t(VECTOR_BUFFER_SIZE / sizeof(T))));
+	if (!vec.empty())
+	    tmp.assign(vec.begin(), std::min(vec.end(), vec.begin() + siz));
+	if (Int_t(tmp.size()) != siz) 
+	    tmp.resize(siz);
+	vec.swap(tmp);
+      } else {
+	vec.resize(siz);
+      }
+    }
+
+    template<class T> static void assignVector(std::vector<T>& vec, const std::vector<T>& other) {
+      if (other.size() <= vec.capacity() / 2 && vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(T))) {
+	std::vector<T> tmp;
+	tmp.reserve(std::max(other.size(), VECTOR_BUFFER_SIZE / sizeof(T)));
+	tmp.assign(other.begin(), other.end());
+	vec.swap(tmp);
+      } else {
+	vec = other;
+      }
+    }
 
   private:
     friend class RooVectorDataStore ;
+    Bool_t _float ; // Values are stored in _vecF instead of _vec
     RooAbsReal* _nativeReal ;
     RooAbsReal* _real ;
     Double_t* _buf ; //!
     Double_t* _nativeBuf ; //!
     Double_t* _vec0 ; //!
+    Float_t* _vecF0 ; //!
     RooChangeTracker* _tracker ; //
     RooArgSet* _nset ; //! 
-    ClassDef(RealVector,1) // STL-vector-based Data Storage class
+    ClassDef(RealVector,2) // STL-vector-based Data Storage class
   } ;
   
 
@@ -385,6 +478,14 @@ public:
       if (_vecEH) _vecEH->push_back(*_bufEH) ;
     } ;
 
+    // Append the n values of a column, together with the current errors
+    void fill(const Double_t* values, std::size_t n) {
+      RealVector::fill(values,n) ;
+      if (_vecE) _vecE->insert(_vecE->end(),n,*_bufE) ;
+      if (_vecEL) _vecEL->insert(_vecEL->end(),n,*_bufEL) ;
+      if (_vecEH) _vecEH->insert(_vecEH->end(),n,*_bufEH) ;
+    }
+
     void write(Int_t i) {
       RealVector::write(i) ;
       if (_vecE) (*_vecE)[i] = *_bufE ;
@@ -605,7 +706,7 @@ public:
       //if (std::string((*iter)->bufArg()->GetName())==real->GetName()) {
       if ((*iter)->bufArg()->namePtr()==real->namePtr()) {
 	rv = (*iter) ;
-	return rv ;
+	return setStorage(rv,real) ;
       }
     }    
 
@@ -615,7 +716,7 @@ public:
       //if (std::string((*iter2)->bufArg()->GetName())==real->GetName()) {
       if ((*iter2)->bufArg()->namePtr()==real->namePtr()) {
 	// Return full vector as RealVector base class here
-	return (*iter2) ;
+	return setStorage(*iter2,real) ;
       }
     }    
 
@@ -628,7 +729,7 @@ public:
     _firstReal = &_realStoreList.front() ;
 
 
-    return _realStoreList.back() ;
+    return setStorage(_realStoreList.back(),real) ;
   }
 
   Bool_t isFullReal(RooAbsReal* real) {
@@ -676,7 +777,7 @@ public:
     for (; iter!=_realfStoreList.end() ; ++iter) {
       if (std::string((*iter)->bufArg()->GetName())==real->GetName()) {
 	rv = (*iter) ;
-	return rv ;
+	return setStorage(rv,real) ;
       }
     }    
 
@@ -700,7 +801,7 @@ public:
         _firstReal = 0;
 	_nReal-- ;
 
-	return _realfStoreList.back() ;
+	return setStorage(_realfStoreList.back(),real) ;
       }
     }    
 
@@ -712,7 +813,7 @@ public:
     _firstRealF = &_realfStoreList.front() ;
 
 
-    return _realfStoreList.back() ;
+    return setStorage(_realfStoreList.back(),real) ;
   }
 
   virtual Bool_t hasFilledCache() const { return _cache ? kTRUE : kFALSE ; }  
@@ -729,6 +830,18 @@ public:
 
   void setAllBuffersNative() ;
 
+  // Columns of objects with the attribute StoreAsFloat are stored in single precision
+  template<class T> T* setStorage(T* column, const RooAbsReal* real) {
+    if (real->getAttribute("StoreAsFloat")) {
+      column->setFloatStorage() ;
+    }
+    return column ;
+  }
+
+  RealVector* findRealColumn(const RooAbsArg& arg) const ;
+  CatVector* findCatColumn(const RooAbsArg& arg) const ;
+  Int_t appendBlock(const std::vector<const Double_t*>& values, std::size_t nEvt, RooFormulaVar* select, const char* rangeName) ;
+
   Int_t _nReal ;
   Int_t _nRealF ;
   Int_t _nCat ;
@@ -754,6 +867,8 @@ public:
 
   Bool_t _forcedUpdate ; //! Request for forced cache update 
 
+  mutable std::vector<double> _weightBatch ; //! Weights of a batch, if stored in single precision
+
   ClassDef(RooVectorDataStore,2) // STL-vector-based Data Storage class
 };
 
@@ -104,12 +104,15 @@ RooAbsOptTestStatistic:: RooAbsOptTestStatistic()
 /// If interleave is set to true, the interleave partitioning strategy is used where each partition
 /// i takes all bins for which (ibin % ncpu == i) which is more likely to result in an even workload.
 /// If splitCutRange is true, a different rangeName constructed as rangeName_{catName} will be used
-/// as range definition for each index state of a RooSimultaneous
+/// as range definition for each index state of a RooSimultaneous. If nThreads is greater than 1
+/// (and nCPU is 1), the partitions are calculated by threads in this process instead, see
+/// RooAbsTestStatistic.
 
 RooAbsOptTestStatistic::RooAbsOptTestStatistic(const char *name, const char *title, RooAbsReal& real, RooAbsData& indata,
 					       const RooArgSet& projDeps, const char* rangeName, const char* addCoefRangeName,
-					       Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitCutRange, Bool_t /*cloneInputData*/) : 
-  RooAbsTestStatistic(name,title,real,indata,projDeps,rangeName, addCoefRangeName, nCPU, interleave, verbose, splitCutRange),
+					       Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitCutRange, Bool_t /*cloneInputData*/,
+					       Int_t nThreads) : 
+  RooAbsTestStatistic(name,title,real,indata,projDeps,rangeName, addCoefRangeName, nCPU, interleave, verbose, splitCutRange, nThreads),
   _projDeps(0),
   _sealed(kFALSE), 
   _optimized(kFALSE)
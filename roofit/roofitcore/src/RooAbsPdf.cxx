@@ -312,6 +312,66 @@ Double_t RooAbsPdf::getValV(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the values of the p.d.f for a batch of events, normalized over the
+/// observables in normSet (see RooAbsReal::getValBatch()). The normalization
+/// integral is computed once for the batch, unless it depends on observables of
+/// the events, in which case the events are evaluated one at a time.
+/// As in getValV(), negative or Not-a-Number values are forced to zero.
+
+RooSpan<const double> RooAbsPdf::getValBatch(std::size_t begin, std::size_t batchSize, const RooArgSet* normSet) const
+{
+  // Cached p.d.f. values or data column
+  if (hasBatchData()) {
+    return RooAbsReal::getValBatch(begin,batchSize,normSet) ;
+  }
+
+  RooSpan<double> values ;
+  Double_t normVal(1) ;
+  if (!normSet) {
+    RooArgSet* tmp = _normSet ;
+    _normSet = 0 ;
+    values = evaluateBatch(begin,batchSize) ;
+    _normSet = tmp ;
+  } else {
+    if (normSet!=_normSet || _norm==0) {
+      syncNormalization(normSet) ;
+    }
+    if (_norm->dependsOnBatchData()) {
+      // Conditional p.d.f. whose normalization changes from event to event
+      return evaluateEventByEvent(begin,batchSize,normSet,kTRUE) ;
+    }
+    values = evaluateBatch(begin,batchSize) ;
+    normVal = _norm->getVal() ;
+    if (normVal<=0.) {
+      logEvalError("p.d.f normalization integral is zero or negative") ;
+      for (std::size_t i=0 ; i<values.size() ; i++) {
+	values[i] = 0 ;
+      }
+      return values ;
+    }
+  }
+
+  Int_t nError(0) ;
+  for (std::size_t i=0 ; i<values.size() ; i++) {
+    const Double_t val = values[i] ;
+    // also catches Not-a-Number values
+    if (!(val>=0)) {
+      nError++ ;
+      values[i] = 0 ;
+    } else {
+      values[i] = val/normVal ;
+    }
+  }
+  if (nError>0) {
+    logEvalError(Form("p.d.f value is less than zero or Not-a-Number for %d events, forcing value to zero",nError)) ;
+  }
+
+  return values ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Analytical integral with normalization (see RooAbsReal::analyticalIntegralWN() for further information)
 ///
@@ -735,6 +795,10 @@ Double_t RooAbsPdf::extendedTerm(Double_t observed, const RooArgSet* nset) const
 ///                                    Strategy 3 = RooFit::Hybrid --> Follow strategy 0 for all RooSimultaneous components, except those with less than
 ///                                                 30 dataset entries, for which strategy 2 is followed.
 ///
+/// NumThreads(int num, int strat)  -- Parallelize NLL calculation on num threads of the implicit multi-threading pool (see
+///                                    ROOT::EnableImplicitMT()) instead of num processes, with the same strategies as NumCPU.
+///                                    Each thread calculates its partition with its own copy of the p.d.f. and of the data
+///
 /// Optimize(Bool_t flag)           -- Activate constant term optimization (on by default)
 /// SplitRange(Bool_t flag)         -- Use separate fit ranges in a simultaneous fit. Actual range name for each
 ///                                    subsample is assumed to by rangeName_{indexState} where indexState
@@ -749,6 +813,8 @@ Double_t RooAbsPdf::extendedTerm(Double_t observed, const RooArgSet* nset) const
 /// CloneData(Bool flag)           -- Use clone of dataset in NLL (default is true)
 /// Offset(Bool_t)                  -- Offset likelihood by initial value (so that starting value of FCN in minuit is zero). This
 ///                                    can improve numeric stability in simultaneously fits with components with large likelihood values
+/// BatchMode(Bool_t)               -- Evaluate the p.d.f. of an unbinned likelihood for batches of events at once (see RooAbsReal::getValBatch())
+///                                    instead of event by event
 /// 
 /// 
 
@@ -790,6 +856,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   pc.defineInt("ext","Extended",0,2) ;
   pc.defineInt("numcpu","NumCPU",0,1) ;
   pc.defineInt("interleave","NumCPU",1,0) ;
+  pc.defineInt("numthreads","NumThreads",0,1) ;
+  pc.defineInt("mtInterleave","NumThreads",1,0) ;
   pc.defineInt("verbose","Verbose",0,0) ;
   pc.defineInt("optConst","Optimize",0,0) ;
   pc.defineInt("cloneData","CloneData",2,0) ;
@@ -798,10 +866,12 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   pc.defineSet("glObs","GlobalObservables",0,0) ;
   pc.defineInt("constrAll","Constrained",0,0) ;
   pc.defineInt("doOffset","OffsetLikelihood",0,0) ;
+  pc.defineInt("batchMode","BatchMode",0,0) ;
   pc.defineSet("extCons","ExternalConstraints",0,0) ;
   pc.defineMutex("Range","RangeWithName") ;
   pc.defineMutex("Constrain","Constrained") ;
   pc.defineMutex("GlobalObservables","GlobalObservablesTag") ;
+  pc.defineMutex("NumCPU","NumThreads") ;
     
   // Process and check varargs 
   pc.process(cmdList) ;
@@ -816,12 +886,17 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   Int_t ext      = pc.getInt("ext") ;
   Int_t numcpu   = pc.getInt("numcpu") ;
   RooFit::MPSplit interl = (RooFit::MPSplit) pc.getInt("interleave") ;
+  Int_t numthreads = pc.getInt("numthreads") ;
+  if (pc.hasProcessed("NumThreads")) {
+    interl = (RooFit::MPSplit) pc.getInt("mtInterleave") ;
+  }
 
   Int_t splitr   = pc.getInt("splitRange") ;
   Bool_t verbose = pc.getInt("verbose") ;
   Int_t optConst = pc.getInt("optConst") ;
   Int_t cloneData = pc.getInt("cloneData") ;
   Int_t doOffset = pc.getInt("doOffset") ;
+  Bool_t batchMode = pc.getInt("batchMode") ;
   
   // If no explicit cloneData command is specified, cloneData is set to true if optimization is activated
   if (cloneData==2) {
@@ -900,7 +975,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
     // Simple case: default range, or single restricted range
     //cout<<"FK: Data test 1: "<<data.sumEntries()<<endl;
 
-    nll = new RooNLLVar(baseName.c_str(),"-log(likelihood)",*this,data,projDeps,ext,rangeName,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+    nll = new RooNLLVar(baseName.c_str(),"-log(likelihood)",*this,data,projDeps,ext,rangeName,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData,kFALSE,numthreads) ;
+    static_cast<RooNLLVar*>(nll)->batchMode(batchMode) ;
 
   } else {
     // Composite case: multiple ranges
@@ -910,7 +986,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
     strlcpy(buf,rangeName,bufSize) ;
     char* token = strtok(buf,",") ;
     while(token) {
-      RooAbsReal* nllComp = new RooNLLVar(Form("%s_%s",baseName.c_str(),token),"-log(likelihood)",*this,data,projDeps,ext,token,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+      RooNLLVar* nllComp = new RooNLLVar(Form("%s_%s",baseName.c_str(),token),"-log(likelihood)",*this,data,projDeps,ext,token,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData,kFALSE,numthreads) ;
+      nllComp->batchMode(batchMode) ;
       nllList.add(*nllComp) ;
       token = strtok(0,",") ;
     }
@@ -1020,6 +1097,10 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
 ///                                    Strategy 3 = RooFit::Hybrid --> Follow strategy 0 for all RooSimultaneous components, except those with less than
 ///                                                 30 dataset entries, for which strategy 2 is followed.
 ///
+/// NumThreads(int num, int strat)  -- Parallelize NLL calculation on num threads of the implicit multi-threading pool (see
+///                                    ROOT::EnableImplicitMT()) instead of num processes, with the same strategies as NumCPU.
+///                                    Each thread calculates its partition with its own copy of the p.d.f. and of the data
+///
 /// SplitRange(Bool_t flag)         -- Use separate fit ranges in a simultaneous fit. Actual range name for each
 ///                                    subsample is assumed to by rangeName_{indexState} where indexState
 ///                                    is the state of the master index category of the simultaneous fit
@@ -1030,6 +1111,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
 /// ExternalConstraints(const RooArgSet& ) -- Include given external constraints to likelihood
 /// Offset(Bool_t)                  -- Offset likelihood by initial value (so that starting value of FCN in minuit is zero). This
 ///                                    can improve numeric stability in simultaneously fits with components with large likelihood values
+/// BatchMode(Bool_t)               -- Evaluate the p.d.f. of an unbinned likelihood for batches of events at once (see RooAbsReal::getValBatch())
+///                                    instead of event by event
 ///
 /// Options to control flow of fit procedure
 /// ----------------------------------------
@@ -1106,7 +1189,7 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooLinkedList& cmdList)
   RooCmdConfig pc(Form("RooAbsPdf::fitTo(%s)",GetName())) ;
 
   RooLinkedList fitCmdList(cmdList) ;
-  RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,RangeWithName,SumCoefRange,NumCPU,SplitRange,Constrained,Constrain,ExternalConstraints,CloneData,GlobalObservables,GlobalObservablesTag,OffsetLikelihood") ;
+  RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,RangeWithName,SumCoefRange,NumCPU,SplitRange,Constrained,Constrain,ExternalConstraints,CloneData,GlobalObservables,GlobalObservablesTag,OffsetLikelihood,BatchMode,NumThreads") ;
 
   pc.defineString("fitOpt","FitOptions",0,"") ;
   pc.defineInt("optConst","Optimize",0,2) ;
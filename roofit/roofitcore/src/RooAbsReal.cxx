@@ -26,6 +26,11 @@
    Implementation of RooAbsReal may be derived, thus no interface
    is provided to modify the contents.
 
+   The values of an expression for a batch of events of a dataset are
+   computed at once by getValBatch(). Classes implementing evaluateBatch()
+   compute them in loops over the events, the others are evaluated one
+   event at a time.
+
    \ingroup Roofitcore
 */
 
@@ -103,6 +108,7 @@
 #include "TVector.h"
 
 #include <sstream>
+#include <mutex>
 
 using namespace std ;
 
@@ -120,12 +126,15 @@ RooAbsReal::ErrorLoggingMode RooAbsReal::_evalErrorMode = RooAbsReal::PrintError
 Int_t RooAbsReal::_evalErrorCount = 0 ;
 map<const RooAbsArg*,pair<string,list<RooAbsReal::EvalError> > > RooAbsReal::_evalErrorList ;
 
+// Serializes the logging of evaluation errors by objects calculated in different threads
+static std::recursive_mutex _evalErrorMutex ;
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// coverity[UNINIT_CTOR]
 /// Default constructor
 
-RooAbsReal::RooAbsReal() : _specIntegratorConfig(0), _treeVar(kFALSE), _selectComp(kTRUE), _lastNSet(0)
+RooAbsReal::RooAbsReal() : _specIntegratorConfig(0), _treeVar(kFALSE), _selectComp(kTRUE), _lastNSet(0), _batchData(0), _batchDataF(0)
 {
 }
 
@@ -136,7 +145,7 @@ RooAbsReal::RooAbsReal() : _specIntegratorConfig(0), _treeVar(kFALSE), _selectCo
 
 RooAbsReal::RooAbsReal(const char *name, const char *title, const char *unit) :
   RooAbsArg(name,title), _plotMin(0), _plotMax(0), _plotBins(100),
-  _value(0),  _unit(unit), _forceNumInt(kFALSE), _specIntegratorConfig(0), _treeVar(kFALSE), _selectComp(kTRUE), _lastNSet(0)
+  _value(0),  _unit(unit), _forceNumInt(kFALSE), _specIntegratorConfig(0), _treeVar(kFALSE), _selectComp(kTRUE), _lastNSet(0), _batchData(0), _batchDataF(0)
 {
   setValueDirty() ;
   setShapeDirty() ;
@@ -151,7 +160,7 @@ RooAbsReal::RooAbsReal(const char *name, const char *title, const char *unit) :
 RooAbsReal::RooAbsReal(const char *name, const char *title, Double_t inMinVal,
 		       Double_t inMaxVal, const char *unit) :
   RooAbsArg(name,title), _plotMin(inMinVal), _plotMax(inMaxVal), _plotBins(100),
-  _value(0), _unit(unit), _forceNumInt(kFALSE), _specIntegratorConfig(0), _treeVar(kFALSE), _selectComp(kTRUE), _lastNSet(0)
+  _value(0), _unit(unit), _forceNumInt(kFALSE), _specIntegratorConfig(0), _treeVar(kFALSE), _selectComp(kTRUE), _lastNSet(0), _batchData(0), _batchDataF(0)
 {
   setValueDirty() ;
   setShapeDirty() ;
@@ -167,7 +176,7 @@ RooAbsReal::RooAbsReal(const char *name, const char *title, Double_t inMinVal,
 RooAbsReal::RooAbsReal(const RooAbsReal& other, const char* name) :
   RooAbsArg(other,name), _plotMin(other._plotMin), _plotMax(other._plotMax),
   _plotBins(other._plotBins), _value(other._value), _unit(other._unit), _label(other._label),
-  _forceNumInt(other._forceNumInt), _treeVar(other._treeVar), _selectComp(other._selectComp), _lastNSet(0)
+  _forceNumInt(other._forceNumInt), _treeVar(other._treeVar), _selectComp(other._selectComp), _lastNSet(0), _batchData(0), _batchDataF(0)
 {
   if (other._specIntegratorConfig) {
     _specIntegratorConfig = new RooNumIntConfig(*other._specIntegratorConfig) ;
@@ -264,6 +273,124 @@ Double_t RooAbsReal::getValV(const RooArgSet* nset) const
 }
 
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the values of this object for the events [begin, begin+batchSize) of
+/// the dataset whose columns are bound to the expression tree (see
+/// RooVectorDataStore::attachBatchData()). A batch holding a single value means
+/// that the value is the same for all events, e.g. for a parameter.
+///
+/// The returned values stay valid until the next batch evaluation of this object.
+
+RooSpan<const double> RooAbsReal::getValBatch(std::size_t begin, std::size_t batchSize, const RooArgSet* normSet) const
+{
+  // Observables and cached expressions are read from their data column, which
+  // is converted to double precision if it is stored as floats
+  if (_batchData) {
+    return RooSpan<const double>(_batchData+begin,batchSize) ;
+  }
+  if (_batchDataF) {
+    RooSpan<double> values = makeBatch(batchSize) ;
+    const Float_t* column = _batchDataF+begin ;
+    for (std::size_t i=0 ; i<batchSize ; i++) {
+      values[i] = column[i] ;
+    }
+    return values ;
+  }
+
+  if (normSet && normSet!=_lastNSet) {
+    ((RooAbsReal*) this)->setProxyNormSet(normSet) ;
+    _lastNSet = (RooArgSet*) normSet ;
+  }
+
+  return evaluateBatch(begin,batchSize) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the value of this object changes from event to event in
+/// a batch evaluation, i.e. if it depends on the value of an object bound
+/// to a data column.
+
+Bool_t RooAbsReal::dependsOnBatchData() const
+{
+  if (hasBatchData()) return kTRUE ;
+
+  RooArgSet nodes ;
+  treeNodeServerList(&nodes,0,kTRUE,kTRUE,kTRUE) ;
+  RooFIter iter = nodes.fwdIterator() ;
+  RooAbsArg* node ;
+  while((node=iter.next())) {
+    RooAbsReal* real = dynamic_cast<RooAbsReal*>(node) ;
+    if (real && real->hasBatchData()) return kTRUE ;
+  }
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the unnormalized values of this object for a batch of events.
+/// The returned values must be stored in the buffer of this object (makeBatch()).
+/// The default implementation evaluates the events one at a time.
+
+RooSpan<double> RooAbsReal::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  return evaluateEventByEvent(begin,batchSize,0,kFALSE) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of this object for a batch of events one event at a time,
+/// loading the values of each event in the objects bound to data columns. If
+/// 'normalize' is true the values are those of getVal(normSet), otherwise of evaluate().
+/// If the value does not depend on the event, a single value is returned.
+
+RooSpan<double> RooAbsReal::evaluateEventByEvent(std::size_t begin, std::size_t batchSize, const RooArgSet* normSet, Bool_t normalize) const
+{
+  RooArgSet nodes ;
+  treeNodeServerList(&nodes) ;
+  std::vector<RooAbsReal*> boundNodes ;
+  RooFIter iter = nodes.fwdIterator() ;
+  RooAbsArg* node ;
+  while((node=iter.next())) {
+    RooAbsReal* real = dynamic_cast<RooAbsReal*>(node) ;
+    if (real && real->hasBatchData()) boundNodes.push_back(real) ;
+  }
+
+  if (boundNodes.empty()) {
+    RooSpan<double> values = makeBatch(1) ;
+    values[0] = normalize ? getVal(normSet) : evaluate() ;
+    return values ;
+  }
+
+  RooSpan<double> values = makeBatch(batchSize) ;
+  for (std::size_t i=0 ; i<batchSize ; i++) {
+    for (std::vector<RooAbsReal*>::const_iterator it=boundNodes.begin() ; it!=boundNodes.end() ; ++it) {
+      (*it)->_value = (*it)->_batchData ? (*it)->_batchData[begin+i] : (*it)->_batchDataF[begin+i] ;
+      (*it)->setValueDirty() ;
+    }
+    values[i] = normalize ? getVal(normSet) : evaluate() ;
+  }
+  return values ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a buffer for the values of a batch of batchSize events, owned by this object
+
+RooSpan<double> RooAbsReal::makeBatch(std::size_t batchSize) const
+{
+  if (_batchValues.size()<batchSize) {
+    _batchValues.resize(batchSize) ;
+  }
+  return RooSpan<double>(_batchValues.data(),batchSize) ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooAbsReal::numEvalErrorItems()
@@ -3605,6 +3732,8 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
     return ;
   }
 
+  std::lock_guard<std::recursive_mutex> lock(_evalErrorMutex) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
@@ -3660,6 +3789,8 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
     return ;
   }
 
+  std::lock_guard<std::recursive_mutex> lock(_evalErrorMutex) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
@@ -32,6 +32,16 @@ organizes multi-processor parallel calculation of test statistic
 values. For the latter, the test statistic value is calculated in
 partitions in parallel executing processes and a posteriori
 combined in the main thread.
+
+Alternatively, the partitions can be calculated by threads of the
+implicit multi-threading pool (see ROOT::EnableImplicitMT()). Each
+partition is then calculated by a clone of the test statistic with its
+own copy of the function and of the data, sharing only the parameters
+with the other partitions. As no values need to be sent to other
+processes, the parameters need not be synchronized before each
+calculation. The partitions are defined as for the calculation in
+parallel processes, e.g. the components of a RooSimultaneous can be
+distributed among the threads with the RooFit::SimComponents strategy.
 **/
 
 
@@ -52,6 +62,13 @@ combined in the main thread.
 #include "RooProdPdf.h"
 #include "RooRealSumPdf.h"
 #include <string>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
 
 using namespace std;
 
@@ -64,7 +81,7 @@ RooAbsTestStatistic::RooAbsTestStatistic() :
   _func(0), _data(0), _projDeps(0), _splitRange(0), _simCount(0),
   _verbose(kFALSE), _init(kFALSE), _gofOpMode(Slave), _nEvents(0), _setNum(0),
   _numSets(0), _extSet(0), _nGof(0), _gofArray(0), _nCPU(1), _mpfeArray(0),
-  _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
+  _nThreads(1), _mtArray(0), _mtSerialEval(kTRUE), _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
   _offsetCarry(0), _evalCarry(0)
 {
 }
@@ -83,11 +100,13 @@ RooAbsTestStatistic::RooAbsTestStatistic() :
 /// If interleave is set to true, the interleave partitioning strategy is used where each partition
 /// i takes all bins for which (ibin % ncpu == i) which is more likely to result in an even workload.
 /// If splitCutRange is true, a different rangeName constructed as rangeName_{catName} will be used
-/// as range definition for each index state of a RooSimultaneous
+/// as range definition for each index state of a RooSimultaneous. If nThreads is greater than 1 and
+/// nCPU is 1, the nThreads partitions are calculated in this process, by the threads of the implicit
+/// multi-threading pool.
 
 RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, RooAbsReal& real, RooAbsData& data,
 					 const RooArgSet& projDeps, const char* rangeName, const char* addCoefRangeName,
-					 Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitCutRange) :
+					 Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitCutRange, Int_t nThreads) :
   RooAbsReal(name,title),
   _paramSet("paramSet","Set of parameters",this),
   _func(&real),
@@ -102,6 +121,9 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _gofArray(0),
   _nCPU(nCPU),
   _mpfeArray(0),
+  _nThreads(nThreads),
+  _mtArray(0),
+  _mtSerialEval(kTRUE),
   _mpinterl(interleave),
   _doOffset(kFALSE),
   _offset(0),
@@ -121,6 +143,10 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
 
     _gofOpMode = MPMaster ;
 
+  } else if (_nThreads>1) {
+
+    _gofOpMode = MTMaster ;
+
   } else {
 
     // Determine if RooAbsReal is a RooSimultaneous
@@ -161,6 +187,9 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   _gofSplitMode(other._gofSplitMode),
   _nCPU(other._nCPU),
   _mpfeArray(0),
+  _nThreads(other._nThreads),
+  _mtArray(0),
+  _mtSerialEval(kTRUE),
   _mpinterl(other._mpinterl),
   _doOffset(other._doOffset),
   _offset(other._offset),
@@ -178,6 +207,10 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
       
     _gofOpMode = MPMaster ;
 
+  } else if (_nThreads>1) {
+
+    _gofOpMode = MTMaster ;
+
   } else {
 
     // Determine if RooAbsReal is a RooSimultaneous
@@ -216,6 +249,11 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
     delete[] _gofArray ;
   }
 
+  if (MTMaster == _gofOpMode && _init) {
+    for (Int_t i = 0; i < _nThreads; ++i) delete _mtArray[i];
+    delete[] _mtArray ;
+  }
+
   delete _projDeps ;
 
 }
@@ -227,7 +265,8 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
 /// is calculated from on a RooSimultaneous, the test statistic calculation
 /// is performed separately on each simultaneous p.d.f component and associated
 /// data and then combined. If the test statistic calculation is parallelized
-/// partitions are calculated in nCPU processes and a posteriori combined.
+/// partitions are calculated in nCPU processes (or nThreads threads) and a
+/// posteriori combined.
 
 Double_t RooAbsTestStatistic::evaluate() const
 {
@@ -287,6 +326,43 @@ Double_t RooAbsTestStatistic::evaluate() const
     _evalCarry = carry;
     return ret ;
 
+  } else if (MTMaster == _gofOpMode) {
+
+    // Calculate the partitions concurrently. The first calculation after a change of
+    // configuration is done sequentially, as it creates the caches (e.g. the normalization
+    // integrals) of the clones, which involves objects shared by all threads.
+    std::vector<Double_t> values(_nThreads), carries(_nThreads) ;
+    auto calculatePartition = [&](unsigned int i) {
+      values[i] = _mtArray[i]->getValV() ;
+      carries[i] = _mtArray[i]->getCarry() ;
+    } ;
+
+#ifdef R__USE_IMT
+    if (!_mtSerialEval && ROOT::IsImplicitMTEnabled()) {
+      ROOT::TThreadExecutor pool ;
+      pool.Foreach(calculatePartition, ROOT::TSeq<unsigned int>(_nThreads)) ;
+    } else
+#endif
+    {
+      for (Int_t i = 0; i < _nThreads; ++i) calculatePartition(i) ;
+    }
+    _mtSerialEval = kFALSE ;
+
+    // Combine in the order of the partitions, the result does not depend on the scheduling of the threads
+    Double_t sum(0), carry = 0.;
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      Double_t y = values[i];
+      carry += carries[i];
+      y -= carry;
+      const Double_t t = sum + y;
+      carry = (t - sum) - y;
+      sum = t;
+    }
+
+    const Double_t norm = globalNormalization();
+    _evalCarry = carry / norm;
+    return sum / norm ;
+
   } else {
 
     // Evaluate as straight FUNC
@@ -344,6 +420,8 @@ Bool_t RooAbsTestStatistic::initialize()
     initMPMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   } else if (SimMaster == _gofOpMode) {
     initSimMode((RooSimultaneous*)_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
+  } else if (MTMaster == _gofOpMode) {
+    initMTMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   }
   _init = kTRUE;
   return kFALSE;
@@ -371,6 +449,14 @@ Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServe
 // 	cout << "redirecting servers on " << _mpfeArray[i]->GetName() << endl;
       }
     }
+  } else if (MTMaster == _gofOpMode && _mtArray) {
+    // Forward to clones
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      if (_mtArray[i]) {
+	_mtArray[i]->recursiveRedirectServers(newServerList,mustReplaceAll,nameChange);
+      }
+    }
+    _mtSerialEval = kTRUE ;
   }
   return kFALSE;
 }
@@ -396,6 +482,17 @@ void RooAbsTestStatistic::printCompactTreeHook(ostream& os, const char* indent)
     os << indent << "RooAbsTestStatistic end GOF contents" << endl;
   } else if (MPMaster == _gofOpMode) {
     // WVE implement this
+  } else if (MTMaster == _gofOpMode) {
+    // Forward to clones
+    os << indent << "RooAbsTestStatistic begin partition contents" << endl ;
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      if (_mtArray[i]) {
+	TString indent2(indent);
+	indent2 += Form("[%d] ",i);
+	_mtArray[i]->printCompactTreeHook(os,indent2);
+      }
+    }
+    os << indent << "RooAbsTestStatistic end partition contents" << endl;
   }
 }
 
@@ -421,6 +518,11 @@ void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t
     for (Int_t i = 0; i < _nCPU; ++i) {
       _mpfeArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
     }
+  } else if (MTMaster == _gofOpMode) {
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      _mtArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
+    }
+    _mtSerialEval = kTRUE ;
   }
 }
 
@@ -478,6 +580,36 @@ void RooAbsTestStatistic::initMPMode(RooAbsReal* real, RooAbsData* data, const R
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Initialize multi-threaded calculation mode. Create a component test statistic for
+/// each partition, with its own clone of the function and of the data so that the
+/// partitions can be calculated concurrently. Only the parameters are shared.
+
+void RooAbsTestStatistic::initMTMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName)
+{
+  _mtArray = new pRooAbsTestStatistic[_nThreads];
+
+  for (Int_t i = 0; i < _nThreads; ++i) {
+    _mtArray[i] = create(Form("%s_GOF%d",GetName(),i),Form("%s_GOF%d",GetTitle(),i),*real,*data,*projDeps,rangeName,addCoefRangeName,1,_mpinterl,_verbose,_splitRange);
+    _mtArray[i]->recursiveRedirectServers(_paramSet);
+    _mtArray[i]->setMPSet(i,_nThreads);
+  }
+  _mtSerialEval = kTRUE ;
+
+  coutI(Eval) << "RooAbsTestStatistic::initMTMode: created " << _nThreads << " partitions calculated by concurrent threads" << endl;
+#ifdef R__USE_IMT
+  if (!ROOT::IsImplicitMTEnabled()) {
+    coutW(Eval) << "RooAbsTestStatistic::initMTMode(" << GetName() << ") WARNING: implicit multi-threading is not enabled,"
+		<< " the partitions will be calculated sequentially (see ROOT::EnableImplicitMT())" << endl;
+  }
+#else
+  coutW(Eval) << "RooAbsTestStatistic::initMTMode(" << GetName() << ") WARNING: ROOT was built without implicit multi-threading,"
+	      << " the partitions will be calculated sequentially" << endl;
+#endif
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize simultaneous p.d.f processing mode. Strip simultaneous
 /// p.d.f into individual components, split dataset in subset
@@ -653,6 +785,14 @@ Bool_t RooAbsTestStatistic::setData(RooAbsData& indata, Bool_t cloneData)
       }
     }
     break;
+  case MTMaster:
+    // Forward to clones, each with its own copy of the data
+    initialize();
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      _mtArray[i]->setData(indata, kTRUE);
+    }
+    _mtSerialEval = kTRUE;
+    break;
   case MPMaster:
     // Not supported
     coutF(DataHandling) << "RooAbsTestStatistic::setData(" << GetName() << ") FATAL: setData() is not supported in multi-processor mode" << endl;
@@ -694,6 +834,12 @@ void RooAbsTestStatistic::enableOffsetting(Bool_t flag)
       _mpfeArray[i]->enableOffsetting(flag);
     }
     break;
+  case MTMaster:
+    _doOffset = flag;
+    for (Int_t i = 0; i < _nThreads; ++i) {
+      _mtArray[i]->enableOffsetting(flag);
+    }
+    break;
   }
 }
 
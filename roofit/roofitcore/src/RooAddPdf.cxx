@@ -860,6 +860,73 @@ Double_t RooAddPdf::evaluate() const
 }
 
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the values of the sum for a batch of events. The coefficients are
+/// computed once for the batch, unless they depend on the observables of the
+/// events (conditional fractions), in which case the events are evaluated one by one.
+
+RooSpan<double> RooAddPdf::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  const RooArgSet* nset = _normSet ; 
+  if (nset==0 || nset->getSize()==0) {
+    if (_refCoefNorm.getSize()!=0) {
+      nset = &_refCoefNorm ;
+    }
+  }
+
+  CacheElem* cache = getProjCache(nset) ;
+
+  const RooArgList* coefLists[] = { &_coefList, &cache->_suppNormList, &cache->_projList, &cache->_suppProjList,
+				    &cache->_refRangeProjList, &cache->_rangeProjList } ;
+  for (unsigned int l=0 ; l<sizeof(coefLists)/sizeof(coefLists[0]) ; l++) {
+    RooFIter iter = coefLists[l]->fwdIterator() ;
+    RooAbsArg* arg ;
+    while((arg=iter.next())) {
+      if (static_cast<RooAbsReal*>(arg)->dependsOnBatchData()) {
+	return evaluateEventByEvent(begin,batchSize,0,kFALSE) ;
+      }
+    }
+  }
+
+  updateCoefficients(*cache,nset) ;
+
+  RooSpan<double> values = makeBatch(batchSize) ;
+  for (std::size_t j=0 ; j<batchSize ; j++) {
+    values[j] = 0 ;
+  }
+
+  RooAbsPdf* pdf ;
+  Int_t i(0) ;
+  RooFIter pi = _pdfList.fwdIterator() ;
+  while((pdf = (RooAbsPdf*)pi.next())) {
+    if (pdf->isSelectedComp()) {
+      // Accumulate the component before evaluating the next one, which may reuse its buffer
+      RooSpan<const double> pdfVals = pdf->getValBatch(begin,batchSize,nset) ;
+      const Double_t coef = _coefCache[i] ;
+      const Double_t snormVal = cache->_needSupNorm ? ((RooAbsReal*)cache->_suppNormList.at(i))->getVal() : 1. ;
+      if (pdfVals.size()==1) {
+	const Double_t term = pdfVals[0]*coef/snormVal ;
+	for (std::size_t j=0 ; j<batchSize ; j++) {
+	  values[j] += term ;
+	}
+      } else if (cache->_needSupNorm) {
+	for (std::size_t j=0 ; j<batchSize ; j++) {
+	  values[j] += pdfVals[j]*coef/snormVal ;
+	}
+      } else {
+	for (std::size_t j=0 ; j<batchSize ; j++) {
+	  values[j] += pdfVals[j]*coef ;
+	}
+      }
+    }
+    i++ ;
+  }
+
+  return values ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset error counter to given value, limiting the number
 /// of future error messages for this pdf to 'resetValue'
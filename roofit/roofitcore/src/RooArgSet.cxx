@@ -53,6 +53,9 @@
 #include "RooArgList.h"
 #include "RooSentinel.h"
 #include "RooMsgService.h"
+#include "TROOT.h"
+
+#include <mutex>
 
 using namespace std ;
 
@@ -75,6 +78,16 @@ struct POOLDATA
 
 static std::list<POOLDATA> _memPoolList ;
 
+// Serializes the allocations in the memory pool, which can be done by several
+// threads calculating a likelihood. This only happens in IMT tasks, so the
+// mutex is not locked if implicit multi-threading is disabled.
+static std::mutex _memPoolMutex ;
+
+static std::unique_lock<std::mutex> lockMemPool()
+{
+  return ROOT::IsImplicitMTEnabled() ? std::unique_lock<std::mutex>(_memPoolMutex) : std::unique_lock<std::mutex>() ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Clear memoery pool on exit to avoid reported memory leaks
 
@@ -103,6 +116,8 @@ void* RooArgSet::operator new (size_t bytes)
 {
   //cout << " RooArgSet::operator new(" << bytes << ")" << endl ;
 
+  auto lock = lockMemPool() ;
+
   if (!_poolBegin || _poolCur+(sizeof(RooArgSet)) >= _poolEnd) {
 
     if (_poolBegin!=0) {
@@ -179,6 +194,7 @@ void* RooArgSet::operator new (size_t bytes, void* ptr) noexcept
 void RooArgSet::operator delete (void* ptr)
 {
   // Decrease use count in pool that ptr is on
+  auto lock = lockMemPool() ;
   for (std::list<POOLDATA>::iterator poolIter =  _memPoolList.begin() ; poolIter!=_memPoolList.end() ; ++poolIter) {
     if ((char*)ptr > (char*)poolIter->_base && (char*)ptr < (char*)poolIter->_base + POOLSIZE) {
       (*(Int_t*)(poolIter->_base))-- ;
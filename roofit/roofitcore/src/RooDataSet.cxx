@@ -200,7 +200,8 @@ RooDataSet::RooDataSet() : _wgtVar(0)
 ///
 /// Import(TTree*)              -- Import contents of given TTree. Only braches of the TTree that have names
 ///                                corresponding to those of the RooAbsArgs that define the RooDataSet are
-///                                imported. 
+///                                imported. With vector storage, the branches are read directly into the
+///                                columns of the dataset (see RooVectorDataStore::loadValues()).
 /// ImportFromFile(const char* fileName, const char* treeName) -- Import tree with given name from file with given name.
 ///
 /// Import(RooDataSet&)         -- Import contents of given RooDataSet. Only observables that are common with
@@ -234,6 +235,8 @@ RooDataSet::RooDataSet() : _wgtVar(0)
 ///
 /// StoreError(const RooArgSet&)     -- Store symmetric error along with value for given subset of observables
 /// StoreAsymError(const RooArgSet&) -- Store asymmetric error along with value for given subset of observables
+/// StoreAsFloat(const RooArgSet&)   -- Store the values of the given subset of real-valued observables in single
+///                                     precision, which halves the memory they use (vector storage only)
 ///
 
 RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& vars, const RooCmdArg& arg1, const RooCmdArg& arg2, const RooCmdArg& arg3,
@@ -263,6 +266,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
   pc.defineObject("dummy2","LinkDataSliceMany",0) ;
   pc.defineSet("errorSet","StoreError",0) ;
   pc.defineSet("asymErrSet","StoreAsymError",0) ;
+  pc.defineSet("floatSet","StoreAsFloat",0) ;
   pc.defineMutex("ImportTree","ImportData","ImportDataSlice","LinkDataSlice","ImportFromFile") ;
   pc.defineMutex("CutSpec","CutVar") ;
   pc.defineMutex("WeightVarName","WeightVar") ;
@@ -299,6 +303,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
   RooCategory* indexCat = static_cast<RooCategory*>(pc.getObject("indexCat")) ;
   RooArgSet* errorSet = pc.getSet("errorSet") ;
   RooArgSet* asymErrorSet = pc.getSet("asymErrSet") ;
+  RooArgSet* floatSet = pc.getSet("floatSet") ;
   const char* fname = pc.getString("fname") ;
   const char* tname = pc.getString("tname") ;
   Int_t ownLinked = pc.getInt("ownLinked") ;
@@ -429,6 +434,17 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
       delete iter ;
       delete intAsymErrorSet ;
     }
+    if (floatSet) {
+      RooArgSet* intFloatSet = (RooArgSet*) _vars.selectCommon(*floatSet) ;
+      intFloatSet->setAttribAll("StoreAsFloat") ;
+      TIterator* iter = intFloatSet->createIterator() ;
+      RooAbsArg* arg ;
+      while((arg=(RooAbsArg*)iter->Next())) {
+	arg->attachToStore(*_dstore) ;
+      }
+      delete iter ;
+      delete intFloatSet ;
+    }
     
     // Lookup name of weight variable if it was specified by object reference
     if (wgtVar) {
@@ -496,7 +512,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
 	RooFormulaVar cutVarTmp(cutSpec,cutSpec,_vars) ;
 	if (tstore) {
 	  tstore->loadValues(impTree,&cutVarTmp,cutRange);      
-	} else {
+	} else if (!vstore || !vstore->loadValues(impTree,&cutVarTmp,cutRange)) {
 	  RooTreeDataStore tmpstore(name,title,_vars,wgtVarName) ;
 	  tmpstore.loadValues(impTree,&cutVarTmp,cutRange) ;
 	  _dstore->append(tmpstore) ;
@@ -517,7 +533,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
 	RooFormulaVar cutVarTmp(cutSpec,cutSpec,_vars) ;
 	if (tstore) {
 	  tstore->loadValues(t,&cutVarTmp,cutRange);      	
-	} else {
+	} else if (!vstore || !vstore->loadValues(t,&cutVarTmp,cutRange)) {
 	  RooTreeDataStore tmpstore(name,title,_vars,wgtVarName) ;
 	  tmpstore.loadValues(t,&cutVarTmp,cutRange) ;
 	  _dstore->append(tmpstore) ;
@@ -555,7 +571,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
 	// Case 4b --- Import TTree from memory with cutvar
 	if (tstore) {
 	  tstore->loadValues(impTree,cutVar,cutRange);
-	} else {
+	} else if (!vstore || !vstore->loadValues(impTree,cutVar,cutRange)) {
 	  RooTreeDataStore tmpstore(name,title,_vars,wgtVarName) ;
 	  tmpstore.loadValues(impTree,cutVar,cutRange) ;
 	  _dstore->append(tmpstore) ;
@@ -574,7 +590,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
 	}
 	if (tstore) {
 	  tstore->loadValues(t,cutVar,cutRange);      	
-	} else {
+	} else if (!vstore || !vstore->loadValues(t,cutVar,cutRange)) {
 	  RooTreeDataStore tmpstore(name,title,_vars,wgtVarName) ;
 	  tmpstore.loadValues(t,cutVar,cutRange) ;
 	  _dstore->append(tmpstore) ;
@@ -611,7 +627,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
 	// Case 4c --- Import TTree from memort
 	if (tstore) {
 	  tstore->loadValues(impTree,0,cutRange);
-	} else {
+	} else if (!vstore || !vstore->loadValues(impTree,0,cutRange)) {
 	  RooTreeDataStore tmpstore(name,title,_vars,wgtVarName) ;
 	  tmpstore.loadValues(impTree,0,cutRange) ;
 	  _dstore->append(tmpstore) ;
@@ -630,7 +646,7 @@ RooDataSet::RooDataSet(const char* name, const char* title, const RooArgSet& var
 	}
 	if (tstore) {
 	  tstore->loadValues(t,0,cutRange);      	
-	} else {
+	} else if (!vstore || !vstore->loadValues(t,0,cutRange)) {
 	  RooTreeDataStore tmpstore(name,title,_vars,wgtVarName) ;
 	  tmpstore.loadValues(t,0,cutRange) ;
 	  _dstore->append(tmpstore) ;
@@ -762,19 +778,33 @@ RooDataSet::RooDataSet(const char *name, const char *title, TTree *intree,
 		       const RooArgSet& vars, const RooFormulaVar& cutVar, const char* wgtVarName) :
   RooAbsData(name,title,vars)
 {
-  // Create tree version of datastore 
-  RooTreeDataStore* tstore = new RooTreeDataStore(name,title,_vars,*intree,cutVar,wgtVarName) ;
-
-  // Convert to vector datastore if needed
-  if (defaultStorageType==Tree) {
-    _dstore = tstore ;
-  } else if (defaultStorageType==Vector) {
-    RooVectorDataStore* vstore = new RooVectorDataStore(name,title,_vars,wgtVarName) ;
+  // Read the branches directly into a vector datastore if possible
+  RooVectorDataStore* vstore(0) ;
+  if (defaultStorageType==Vector) {
+    vstore = new RooVectorDataStore(name,title,_vars,wgtVarName) ;
+    if (!vstore->loadValues(intree,&cutVar)) {
+      delete vstore ;
+      vstore = 0 ;
+    }
+  }
+
+  if (vstore) {
     _dstore = vstore ;
-    _dstore->append(*tstore) ;
-    delete tstore ;
   } else {
-    _dstore = 0 ;
+    // Create tree version of datastore 
+    RooTreeDataStore* tstore = new RooTreeDataStore(name,title,_vars,*intree,cutVar,wgtVarName) ;
+
+    // Convert to vector datastore if needed
+    if (defaultStorageType==Tree) {
+      _dstore = tstore ;
+    } else if (defaultStorageType==Vector) {
+      vstore = new RooVectorDataStore(name,title,_vars,wgtVarName) ;
+      _dstore = vstore ;
+      _dstore->append(*tstore) ;
+      delete tstore ;
+    } else {
+      _dstore = 0 ;
+    }
   }
   
   appendToDir(this,kTRUE) ;
@@ -804,19 +834,40 @@ RooDataSet::RooDataSet(const char *name, const char *title, TTree *intree,
 		       const RooArgSet& vars, const char *selExpr, const char* wgtVarName) :
   RooAbsData(name,title,vars)
 {
-  // Create tree version of datastore 
-  RooTreeDataStore* tstore = new RooTreeDataStore(name,title,_vars,*intree,selExpr,wgtVarName) ;
-
-  // Convert to vector datastore if needed
-  if (defaultStorageType==Tree) {
-    _dstore = tstore ;
-  } else if (defaultStorageType==Vector) {
-    RooVectorDataStore* vstore = new RooVectorDataStore(name,title,_vars,wgtVarName) ;
+  // Read the branches directly into a vector datastore if possible
+  RooVectorDataStore* vstore(0) ;
+  if (defaultStorageType==Vector) {
+    vstore = new RooVectorDataStore(name,title,_vars,wgtVarName) ;
+    Bool_t loaded ;
+    if (selExpr && *selExpr) {
+      RooFormulaVar select(selExpr,selExpr,_vars) ;
+      loaded = vstore->loadValues(intree,&select) ;
+    } else {
+      loaded = vstore->loadValues(intree) ;
+    }
+    if (!loaded) {
+      delete vstore ;
+      vstore = 0 ;
+    }
+  }
+
+  if (vstore) {
     _dstore = vstore ;
-    _dstore->append(*tstore) ;
-    delete tstore ;
   } else {
-    _dstore = 0 ;
+    // Create tree version of datastore 
+    RooTreeDataStore* tstore = new RooTreeDataStore(name,title,_vars,*intree,selExpr,wgtVarName) ;
+
+    // Convert to vector datastore if needed
+    if (defaultStorageType==Tree) {
+      _dstore = tstore ;
+    } else if (defaultStorageType==Vector) {
+      vstore = new RooVectorDataStore(name,title,_vars,wgtVarName) ;
+      _dstore = vstore ;
+      _dstore->append(*tstore) ;
+      delete tstore ;
+    } else {
+      _dstore = 0 ;
+    }
   }
 
   appendToDir(this,kTRUE) ;
@@ -40,6 +40,7 @@ Use RooAbsCollection derived objects for public use
 #include "TROOT.h"
 
 #include <algorithm>
+#include <mutex>
 
 using namespace std;
 
@@ -256,11 +257,23 @@ namespace RooLinkedListImplDetails {
 
 RooLinkedList::Pool* RooLinkedList::_pool = 0;
 
+// Serializes the access to the element pool, shared by the lists of all
+// threads (e.g. the temporary lists created while likelihoods are calculated
+// by several threads). This only happens in IMT tasks, so the mutex is not
+// locked if implicit multi-threading is disabled.
+static std::mutex _poolMutex ;
+
+static std::unique_lock<std::mutex> lockPool()
+{
+  return ROOT::IsImplicitMTEnabled() ? std::unique_lock<std::mutex>(_poolMutex) : std::unique_lock<std::mutex>() ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 RooLinkedList::RooLinkedList(Int_t htsize) : 
   _hashThresh(htsize), _size(0), _first(0), _last(0), _htableName(0), _htableLink(0), _useNptr(kTRUE)
 {
+  auto lock = lockPool();
   if (!_pool) _pool = new Pool;
   _pool->acquire();
 }
@@ -273,8 +286,11 @@ RooLinkedList::RooLinkedList(const RooLinkedList& other) :
   _name(other._name), 
   _useNptr(other._useNptr)
 {
-  if (!_pool) _pool = new Pool;
-  _pool->acquire();
+  {
+    auto lock = lockPool();
+    if (!_pool) _pool = new Pool;
+    _pool->acquire();
+  }
   if (other._htableName) _htableName = new RooHashTable(other._htableName->size()) ;
   if (other._htableLink) _htableLink = new RooHashTable(other._htableLink->size(),RooHashTable::Pointer) ;
   for (RooLinkedListElem* elem = other._first; elem; elem = elem->_next) {
@@ -287,7 +303,11 @@ RooLinkedList::RooLinkedList(const RooLinkedList& other) :
 
 RooLinkedListElem* RooLinkedList::createElement(TObject* obj, RooLinkedListElem* elem) 
 {
-  RooLinkedListElem* ret = _pool->pop_free_elem();
+  RooLinkedListElem* ret ;
+  {
+    auto lock = lockPool();
+    ret = _pool->pop_free_elem();
+  }
   ret->init(obj, elem);
   return ret ;
 }
@@ -297,6 +317,7 @@ RooLinkedListElem* RooLinkedList::createElement(TObject* obj, RooLinkedListElem*
 void RooLinkedList::deleteElement(RooLinkedListElem* elem) 
 {  
   elem->release() ;
+  auto lock = lockPool();
   _pool->push_free_elem(elem);
   //delete elem ;
 }
@@ -377,6 +398,7 @@ RooLinkedList::~RooLinkedList()
   }
   
   Clear() ;
+  auto lock = lockPool();
   if (_pool->release()) {
     delete _pool;
     _pool = 0;
@@ -43,6 +43,9 @@ In extended mode, a (Nexpect - Nobserved*log(NExpected) term is added
 #include "RooRealSumPdf.h"
 #include "RooRealVar.h"
 #include "RooProdPdf.h"
+#include "RooDataSet.h"
+#include "RooVectorDataStore.h"
+#include "RooAbsCategory.h"
 
 ClassImp(RooNLLVar);
 ;
@@ -63,6 +66,7 @@ RooArgSet RooNLLVar::_emptySet ;
 ///  ConditionalObservables() | Define conditional observables
 ///  Verbose()                | Verbose output of GOF framework classes
 ///  CloneData()              | Clone input dataset for internal use (default is kTRUE)
+///  NumThreads()             | Calculate partitions of the data in threads instead of processes
 
 RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbsData& indata,
 		     const RooCmdArg& arg1, const RooCmdArg& arg2,const RooCmdArg& arg3,
@@ -77,7 +81,8 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
 			 RooFit::BulkPartition,
 			 RooCmdConfig::decodeIntOnTheFly("RooNLLVar::RooNLLVar","Verbose",0,1,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9),
 			 RooCmdConfig::decodeIntOnTheFly("RooNLLVar::RooNLLVar","SplitRange",0,0,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9),
-			 RooCmdConfig::decodeIntOnTheFly("RooNLLVar::RooNLLVar","CloneData",0,1,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9))
+			 RooCmdConfig::decodeIntOnTheFly("RooNLLVar::RooNLLVar","CloneData",0,1,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9),
+			 RooCmdConfig::decodeIntOnTheFly("RooNLLVar::RooNLLVar","NumThreads",0,1,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8,arg9))
 {
   RooCmdConfig pc("RooNLLVar::RooNLLVar") ;
   pc.allowUndefined() ;
@@ -106,11 +111,13 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
 
 RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbsData& indata,
 		     Bool_t extended, const char* rangeName, const char* addCoefRangeName,
-		     Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitRange, Bool_t cloneData, Bool_t binnedL) :
-  RooAbsOptTestStatistic(name,title,pdf,indata,RooArgSet(),rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
+		     Int_t nCPU, RooFit::MPSplit interleave, Bool_t verbose, Bool_t splitRange, Bool_t cloneData, Bool_t binnedL,
+		     Int_t nThreads) :
+  RooAbsOptTestStatistic(name,title,pdf,indata,RooArgSet(),rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData,nThreads),
   _extended(extended),
   _weightSq(kFALSE),
-  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
+  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.),
+  _batchEvaluations(kFALSE)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
   // for a binned likelihood calculation
@@ -151,11 +158,13 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
 
 RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbsData& indata,
 		     const RooArgSet& projDeps, Bool_t extended, const char* rangeName,const char* addCoefRangeName,
-		     Int_t nCPU,RooFit::MPSplit interleave,Bool_t verbose, Bool_t splitRange, Bool_t cloneData, Bool_t binnedL) :
-  RooAbsOptTestStatistic(name,title,pdf,indata,projDeps,rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
+		     Int_t nCPU,RooFit::MPSplit interleave,Bool_t verbose, Bool_t splitRange, Bool_t cloneData, Bool_t binnedL,
+		     Int_t nThreads) :
+  RooAbsOptTestStatistic(name,title,pdf,indata,projDeps,rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData,nThreads),
   _extended(extended),
   _weightSq(kFALSE),
-  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
+  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.),
+  _batchEvaluations(kFALSE)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
   // for a binned likelihood calculation
@@ -196,7 +205,8 @@ RooNLLVar::RooNLLVar(const RooNLLVar& other, const char* name) :
   _weightSq(other._weightSq),
   _first(kTRUE), _offsetSaveW2(other._offsetSaveW2),
   _offsetCarrySaveW2(other._offsetCarrySaveW2),
-  _binw(other._binw) {
+  _binw(other._binw),
+  _batchEvaluations(other._batchEvaluations) {
   _binnedPdf = other._binnedPdf ? (RooRealSumPdf*)_funcClone : 0 ;
 }
 
@@ -230,6 +240,33 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
   } else if ( _gofOpMode==SimMaster) {
     for (Int_t i=0 ; i<_nGof ; i++)
       ((RooNLLVar*)_gofArray[i])->applyWeightSquared(flag);
+  } else if ( _gofOpMode==MTMaster) {
+    initialize();
+    for (Int_t i=0 ; i<_nThreads ; i++)
+      ((RooNLLVar*)_mtArray[i])->applyWeightSquared(flag);
+    setValueDirty();
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the p.d.f. of an unbinned likelihood for batches of events
+/// (RooAbsReal::getValBatch()) instead of event by event. This is done for
+/// datasets stored in a RooVectorDataStore and for a contiguous range of events,
+/// otherwise the events are evaluated one by one. The mode must be set before
+/// the first evaluation for the components of a likelihood calculated in
+/// parallel processes.
+
+void RooNLLVar::batchMode(Bool_t flag)
+{
+  _batchEvaluations = flag ;
+  if (_gofOpMode==SimMaster) {
+    for (Int_t i=0 ; i<_nGof ; i++)
+      ((RooNLLVar*)_gofArray[i])->batchMode(flag);
+  } else if (_gofOpMode==MTMaster && _mtArray) {
+    for (Int_t i=0 ; i<_nThreads ; i++)
+      ((RooNLLVar*)_mtArray[i])->batchMode(flag);
   }
 }
 
@@ -304,6 +341,10 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
     }
 
 
+  } else if (stepSize==1 && canEvaluateBatches()) {
+
+    evaluateBatches(firstEvent,lastEvent,result,carry,sumWeight,sumWeightCarry) ;
+
   } else {
 
     for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
@@ -329,6 +370,9 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
       carry = (t - result) - y;
       result = t;
     }
+  }
+
+  if (!_binnedPdf) {
 
     // include the extended maximum likelihood term, if requested
     if(_extended && _setNum==_extSet) {
@@ -425,4 +469,79 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if batch evaluations are requested and possible: for an unbinned
+/// dataset in a RooVectorDataStore, whose categories are not observables of the p.d.f.
+
+Bool_t RooNLLVar::canEvaluateBatches() const
+{
+  if (!_batchEvaluations || _binnedPdf) return kFALSE ;
+  if (!dynamic_cast<RooDataSet*>(_dataClone) || !dynamic_cast<RooVectorDataStore*>(_dataClone->store())) return kFALSE ;
+
+  RooFIter iter = _funcObsSet->fwdIterator() ;
+  RooAbsArg* obs ;
+  while((obs=iter.next())) {
+    if (dynamic_cast<RooAbsCategory*>(obs)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the likelihood terms of the events [firstEvent,lastEvent) to the Kahan sums
+/// result and sumWeight, evaluating the p.d.f. for batches of events.
+
+void RooNLLVar::evaluateBatches(Int_t firstEvent, Int_t lastEvent, Double_t& result, Double_t& carry,
+                                Double_t& sumWeight, Double_t& sumWeightCarry) const
+{
+  const Int_t batchSize = 1024 ;
+
+  RooAbsPdf* pdfClone = (RooAbsPdf*) _funcClone ;
+  RooVectorDataStore* store = (RooVectorDataStore*) _dataClone->store() ;
+  store->attachBatchData() ;
+
+  for (Int_t begin=firstEvent ; begin<lastEvent ; begin+=batchSize) {
+
+    const std::size_t n = std::min(batchSize,lastEvent-begin) ;
+    RooSpan<const double> probs = pdfClone->getValBatch(begin,n,_normSet) ;
+    RooSpan<const double> weights = store->getWeightBatch(begin,n) ;
+
+    for (std::size_t i=0 ; i<n ; i++) {
+
+      Double_t eventWeight = weights.empty() ? 1. : weights[i] ;
+      if (0. == eventWeight * eventWeight) continue ;
+      if (_weightSq) eventWeight *= eventWeight ;
+
+      // Same checks as RooAbsPdf::getLogVal()
+      const Double_t prob = probs.size()==1 ? probs[0] : probs[i] ;
+      Double_t logProb ;
+      if (prob<0) {
+	pdfClone->logEvalError("getLogVal() top-level p.d.f evaluates to a negative number") ;
+	logProb = 0 ;
+      } else if (prob==0) {
+	pdfClone->logEvalError("getLogVal() top-level p.d.f evaluates to zero") ;
+	logProb = log((double)0) ;
+      } else if (TMath::IsNaN(prob)) {
+	pdfClone->logEvalError("getLogVal() top-level p.d.f evaluates to NaN") ;
+	logProb = log((double)0) ;
+      } else {
+	logProb = log(prob) ;
+      }
+
+      Double_t term = -eventWeight * logProb ;
+
+      Double_t y = eventWeight - sumWeightCarry;
+      Double_t t = sumWeight + y;
+      sumWeightCarry = (t - sumWeight) - y;
+      sumWeight = t;
+
+      y = term - carry;
+      t = result + y;
+      carry = (t - result) - y;
+      result = t;
+    }
+  }
 
+  store->attachBatchData(kFALSE) ;
+}
@@ -473,6 +473,17 @@ Double_t RooProdPdf::getValV(const RooArgSet* set) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Overload getValBatch to track normalization set used
+
+RooSpan<const double> RooProdPdf::getValBatch(std::size_t begin, std::size_t batchSize, const RooArgSet* normSet) const
+{
+  _curNormSet = (RooArgSet*)normSet ;
+  return RooAbsPdf::getValBatch(begin,batchSize,normSet) ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate current value of object
 
@@ -560,6 +571,70 @@ Double_t RooProdPdf::calculate(const RooProdPdf::CacheElem& cache, Bool_t /*verb
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the running product of the terms for a batch of events. As in
+/// calculate(), the product of an event stops at the first term where it
+/// falls below the cut-off value.
+
+RooSpan<double> RooProdPdf::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  Int_t code ;
+  CacheElem* cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+
+  // If cache doesn't have our configuration, recalculate here
+  if (!cache) {
+    RooArgList *plist(0) ;
+    RooLinkedList *nlist(0) ;
+    getPartIntList(_curNormSet,0,plist,nlist,code) ;
+    cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+  }
+
+  // Each term is applied before the next one is evaluated, since it may reuse its buffer
+  RooSpan<double> values = makeBatch(batchSize) ;
+
+  if (cache->_isRearranged) {
+    RooSpan<const double> num = cache->_rearrangedNum->getValBatch(begin,batchSize) ;
+    for (std::size_t j=0 ; j<batchSize ; j++) {
+      values[j] = num.size()==1 ? num[0] : num[j] ;
+    }
+    RooSpan<const double> den = cache->_rearrangedDen->getValBatch(begin,batchSize) ;
+    for (std::size_t j=0 ; j<batchSize ; j++) {
+      values[j] /= den.size()==1 ? den[0] : den[j] ;
+    }
+    return values ;
+  }
+
+  for (std::size_t j=0 ; j<batchSize ; j++) {
+    values[j] = 1.0 ;
+  }
+
+  RooAbsReal* partInt;
+  RooArgSet* normSet;
+  RooFIter plIter = cache->_partList.fwdIterator();
+  RooFIter nlIter = cache->_normList.fwdIterator();
+  Bool_t firstTerm(kTRUE) ;
+  for (partInt = (RooAbsReal*) plIter.next(),
+	 normSet = (RooArgSet*) nlIter.next(); partInt && normSet;
+       partInt = (RooAbsReal*) plIter.next(),
+	 normSet = (RooArgSet*) nlIter.next()) {
+    RooSpan<const double> piVals = partInt->getValBatch(begin,batchSize,normSet->getSize() > 0 ? normSet : 0) ;
+    if (piVals.size()==1) {
+      for (std::size_t j=0 ; j<batchSize ; j++) {
+	if (firstTerm || values[j] > _cutOff) values[j] *= piVals[0] ;
+      }
+    } else {
+      for (std::size_t j=0 ; j<batchSize ; j++) {
+	if (firstTerm || values[j] > _cutOff) values[j] *= piVals[j] ;
+      }
+    }
+    firstTerm = kFALSE ;
+  }
+
+  return values ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Factorize product in irreducible terms for given choice of integration/normalization
 
@@ -197,6 +197,20 @@ Double_t RooRealVar::getValV(const RooArgSet*) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the values of a batch of events: those of the data column bound to
+/// this variable if it is an observable, otherwise its value for all events
+
+RooSpan<const double> RooRealVar::getValBatch(std::size_t begin, std::size_t batchSize, const RooArgSet* normSet) const
+{
+  if (hasBatchData()) {
+    return RooAbsReal::getValBatch(begin,batchSize,normSet) ;
+  }
+  return RooSpan<const double>(&_value,1) ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set value of variable to 'value'. If 'value' is outside
 /// range of object, clip value into range
@@ -39,6 +39,10 @@ use a TTree as internal storage mechanism
 #include "RooNameSet.h"
 #include "RooHistError.h"
 #include "RooTrace.h"
+#include "RooNumber.h"
+#include "RooAbsCategoryLValue.h"
+#include "TLeaf.h"
+#include "TBranch.h"
 
 #include <iomanip>
 using namespace std ;
@@ -832,6 +836,367 @@ void RooVectorDataStore::loadValues(const RooAbsDataStore *ads, const RooFormula
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the leaf of 'branch' if it holds a single number per entry, of a type
+/// that can be converted to double precision (see RooAbsReal::attachToTree()).
+/// For categories, the branch must hold the state index.
+
+static TLeaf* scalarLeaf(TBranch* branch, Bool_t isCat)
+{
+  if (!branch || branch->GetListOfLeaves()->GetEntries()!=1) {
+    return 0 ;
+  }
+
+  TLeaf* leaf = (TLeaf*)branch->GetListOfLeaves()->At(0) ;
+  Int_t count(1) ;
+  if (leaf->GetLeafCounter(count) || count!=1) {
+    return 0 ;
+  }
+
+  TString typeName(leaf->GetTypeName()) ;
+  if (typeName=="Int_t" || typeName=="UChar_t") {
+    return leaf ;
+  }
+  if (!isCat && (typeName=="Double_t" || typeName=="Float_t" || typeName=="UInt_t" || 
+		 typeName=="Char_t" || typeName=="Bool_t")) {
+    return leaf ;
+  }
+  return 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the leaf of tree 't' from which the values of the observable with
+/// branch name 'name' can be imported, or null if there is none
+
+static TLeaf* importLeaf(TTree* t, const TString& name, Bool_t isCat)
+{
+  TLeaf* leaf = scalarLeaf(t->GetBranch(name),isCat) ;
+  if (!leaf && isCat) {
+    // Index branch of a tree written by RooTreeDataStore
+    leaf = scalarLeaf(t->GetBranch(name+"_idx"),isCat) ;
+  }
+  return leaf ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load the values of the entries of tree (or chain) 't' directly into the columns
+/// of this data collection, optionally selecting events using the 'select'
+/// RooFormulaVar and the range 'rangeName'. The branches are read one after the
+/// other for blocks of entries, without the intermediate copy of the tree made by
+/// RooTreeDataStore::loadValues() and without loading each entry in the observables.
+///
+/// Nothing is loaded and false is returned if the tree cannot be read this way,
+/// i.e. if it has friends, if a branch is missing or is not a number, if an observable
+/// is a derived value or if errors are stored with the values. RooTreeDataStore
+/// should be used then.
+
+Bool_t RooVectorDataStore::loadValues(const TTree *t, const RooFormulaVar* select, const char* rangeName) 
+{
+  TTree* tree = const_cast<TTree*>(t) ;
+  if (tree->GetListOfFriends() && tree->GetListOfFriends()->GetSize()>0) {
+    return kFALSE ;
+  }
+  for (vector<RealFullVector*>::const_iterator iter = _realfStoreList.begin() ; iter!=_realfStoreList.end() ; ++iter) {
+    if ((*iter)->_vecE || (*iter)->_vecEL) {
+      return kFALSE ;
+    }
+  }
+
+  // All observables must be real or category lvalues, read from branches of the same name
+  std::vector<TString> names ;
+  std::vector<Bool_t> isCat ;
+  RooFIter iter = _varsww.fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=iter.next())) {
+    if (dynamic_cast<RooAbsRealLValue*>(arg) && findRealColumn(*arg)) {
+      isCat.push_back(kFALSE) ;
+    } else if (dynamic_cast<RooAbsCategoryLValue*>(arg) && findCatColumn(*arg)) {
+      isCat.push_back(kTRUE) ;
+    } else {
+      return kFALSE ;
+    }
+    names.push_back(arg->cleanBranchName()) ;
+  }
+
+  const std::size_t nVar = names.size() ;
+  const std::size_t blockSize = 4096 ;
+  std::vector<TLeaf*> leaves(nVar) ;
+  std::vector<std::vector<Double_t> > block(nVar,std::vector<Double_t>(blockSize)) ;
+  std::vector<const Double_t*> values(nVar) ;
+  for (std::size_t k=0 ; k<nVar ; k++) {
+    values[k] = &block[k].front() ;
+  }
+
+  // Check the branches of the first tree before loading anything
+  const Long64_t nEntries = tree->GetEntries() ;
+  if (nEntries>0 && tree->LoadTree(0)>=0) {
+    for (std::size_t k=0 ; k<nVar ; k++) {
+      if (!importLeaf(tree->GetTree(),names[k],isCat[k])) {
+	return kFALSE ;
+      }
+    }
+  }
+
+  RooFormulaVar* selectClone(0) ;
+  if (select) {
+    selectClone = (RooFormulaVar*) select->cloneTree() ;
+    selectClone->recursiveRedirectServers(_varsww) ;
+    selectClone->setOperMode(RooAbsArg::ADirty,kTRUE) ;
+  }
+
+  if (!select && !rangeName) {
+    reserve(numEntries() + nEntries) ;
+  }
+
+  Int_t numInvalid(0) ;
+  Int_t treeNumber(-1) ;
+  Long64_t entry(0) ;
+  while (entry<nEntries) {
+    Long64_t local = tree->LoadTree(entry) ;
+    if (local<0) break ;
+    TTree* current = tree->GetTree() ;
+
+    // Find the leaves in each new tree of a chain
+    if (tree->GetTreeNumber()!=treeNumber) {
+      treeNumber = tree->GetTreeNumber() ;
+      Bool_t ok(kTRUE) ;
+      for (std::size_t k=0 ; k<nVar ; k++) {
+	leaves[k] = importLeaf(current,names[k],isCat[k]) ;
+	if (!leaves[k]) {
+	  coutE(InputArguments) << "RooVectorDataStore::loadValues(" << GetName() << ") ERROR: tree " << treeNumber 
+				<< " has no branch " << names[k] << " that can be imported, stop reading at entry " << entry << endl ;
+	  ok = kFALSE ;
+	}
+      }
+      if (!ok) break ;
+    }
+
+    const std::size_t nEvt = std::min(Long64_t(blockSize),current->GetEntries()-local) ;
+    for (std::size_t k=0 ; k<nVar ; k++) {
+      TBranch* branch = leaves[k]->GetBranch() ;
+      for (std::size_t i=0 ; i<nEvt ; i++) {
+	branch->GetEntry(local+i) ;
+	block[k][i] = leaves[k]->GetValue() ;
+      }
+    }
+    numInvalid += appendBlock(values,nEvt,selectClone,rangeName) ;
+    entry += nEvt ;
+  }
+
+  if (numInvalid>0) {
+    coutI(Eval) << "RooVectorDataStore::loadValues(" << GetName() << ") Ignored " << numInvalid << " out of range events" << endl ;
+  }
+
+  delete selectClone ;
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load events given column by column, e.g. the values collected by RDataFrame::Take():
+/// columns[k] holds the values of the observable vars[k] (for categories, the state
+/// index) for all events. Every observable of this data collection must be given.
+/// Events are optionally selected using the 'select' RooFormulaVar and the range
+/// 'rangeName'. The values are copied directly from the columns, without loading
+/// each event in the observables. Return false if nothing could be loaded, which
+/// is the case if errors are stored with the values, since the columns have none.
+
+Bool_t RooVectorDataStore::loadColumns(const RooArgList& vars, const std::vector<RooSpan<const double> >& columns, 
+				       const RooFormulaVar* select, const char* rangeName)
+{
+  for (vector<RealFullVector*>::const_iterator iter = _realfStoreList.begin() ; iter!=_realfStoreList.end() ; ++iter) {
+    if ((*iter)->_vecE || (*iter)->_vecEL) {
+      coutE(InputArguments) << "RooVectorDataStore::loadColumns(" << GetName() << ") ERROR: errors are stored with the values of "
+			    << (*iter)->bufArg()->GetName() << ", columns without errors cannot be loaded" << endl ;
+      return kFALSE ;
+    }
+  }
+  if (vars.getSize()!=Int_t(columns.size())) {
+    coutE(InputArguments) << "RooVectorDataStore::loadColumns(" << GetName() << ") ERROR: " << columns.size() 
+			  << " columns given for " << vars.getSize() << " observables" << endl ;
+    return kFALSE ;
+  }
+  const std::size_t nTot = columns.empty() ? 0 : columns.front().size() ;
+
+  // Match the observables of this data collection to the columns
+  std::vector<RooSpan<const double> > matched ;
+  RooFIter iter = _varsww.fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=iter.next())) {
+    Int_t idx = vars.index(arg->GetName()) ;
+    if (idx<0) {
+      coutE(InputArguments) << "RooVectorDataStore::loadColumns(" << GetName() << ") ERROR: no column given for observable " << arg->GetName() << endl ;
+      return kFALSE ;
+    }
+    if (!(dynamic_cast<RooAbsRealLValue*>(arg) && findRealColumn(*arg)) && !(dynamic_cast<RooAbsCategoryLValue*>(arg) && findCatColumn(*arg))) {
+      coutE(InputArguments) << "RooVectorDataStore::loadColumns(" << GetName() << ") ERROR: " << arg->GetName() 
+			    << " is not a real or category observable" << endl ;
+      return kFALSE ;
+    }
+    if (columns[idx].size()!=nTot) {
+      coutE(InputArguments) << "RooVectorDataStore::loadColumns(" << GetName() << ") ERROR: column of " << arg->GetName() 
+			    << " has " << columns[idx].size() << " values instead of " << nTot << endl ;
+      return kFALSE ;
+    }
+    matched.push_back(columns[idx]) ;
+  }
+
+  RooFormulaVar* selectClone(0) ;
+  if (select) {
+    selectClone = (RooFormulaVar*) select->cloneTree() ;
+    selectClone->recursiveRedirectServers(_varsww) ;
+    selectClone->setOperMode(RooAbsArg::ADirty,kTRUE) ;
+  }
+
+  if (!select && !rangeName) {
+    reserve(numEntries() + nTot) ;
+  }
+
+  const std::size_t blockSize = 4096 ;
+  std::vector<const Double_t*> values(matched.size()) ;
+  Int_t numInvalid(0) ;
+  for (std::size_t first=0 ; first<nTot ; first+=blockSize) {
+    for (std::size_t k=0 ; k<matched.size() ; k++) {
+      values[k] = matched[k].data()+first ;
+    }
+    numInvalid += appendBlock(values,std::min(blockSize,nTot-first),selectClone,rangeName) ;
+  }
+
+  if (numInvalid>0) {
+    coutI(Eval) << "RooVectorDataStore::loadColumns(" << GetName() << ") Ignored " << numInvalid << " out of range events" << endl ;
+  }
+
+  delete selectClone ;
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append the events of a block of nEvt events given column by column: values[k]
+/// holds the values of the k-th observable of _varsww. Events with values outside
+/// of the range of an observable or with an undefined category index are rejected,
+/// as well as those outside of range 'rangeName' or failing 'select'. Return the
+/// number of events rejected because of invalid values.
+
+Int_t RooVectorDataStore::appendBlock(const std::vector<const Double_t*>& values, std::size_t nEvt, RooFormulaVar* select, const char* rangeName)
+{
+  const std::size_t nVar = values.size() ;
+  std::vector<char> pass(nEvt,1) ;
+  std::vector<std::vector<const RooCatType*> > types(nVar) ;
+  std::vector<RooAbsArg*> args(nVar) ;
+  std::vector<RealVector*> realColumns(nVar) ;
+  std::vector<CatVector*> catColumns(nVar) ;
+
+  // Check the values one observable at a time
+  RooFIter iter = _varsww.fwdIterator() ;
+  RooAbsArg* arg ;
+  for (std::size_t k=0 ; (arg=iter.next()) ; k++) {
+    args[k] = arg ;
+    realColumns[k] = findRealColumn(*arg) ;
+    catColumns[k] = findCatColumn(*arg) ;
+    const Double_t* v = values[k] ;
+    RooAbsRealLValue* real = dynamic_cast<RooAbsRealLValue*>(arg) ;
+    if (real) {
+      // Same tolerance as RooAbsRealLValue::inRange()
+      const Double_t min = real->getMin() - 1e-6 ;
+      const Double_t max = real->getMax() + 1e-6 ;
+      const Bool_t hasMin = !RooNumber::isInfinite(real->getMin()) ;
+      const Bool_t hasMax = !RooNumber::isInfinite(real->getMax()) ;
+      for (std::size_t i=0 ; i<nEvt ; i++) {
+	if ((hasMin && v[i]<min) || (hasMax && v[i]>max)) pass[i] = 0 ;
+      }
+    } else {
+      RooAbsCategory* cat = static_cast<RooAbsCategory*>(arg) ;
+      types[k].resize(nEvt) ;
+      for (std::size_t i=0 ; i<nEvt ; i++) {
+	types[k][i] = pass[i] ? cat->lookupType(Int_t(v[i])) : 0 ;
+	if (!types[k][i]) pass[i] = 0 ;
+      }
+    }
+  }
+
+  Int_t numInvalid(0) ;
+  for (std::size_t i=0 ; i<nEvt ; i++) {
+    if (!pass[i]) numInvalid++ ;
+  }
+
+  // Selections on whole events need the values loaded in the observables
+  if (select || rangeName) {
+    for (std::size_t i=0 ; i<nEvt ; i++) {
+      if (!pass[i]) continue ;
+      for (std::size_t k=0 ; k<nVar ; k++) {
+	if (types[k].empty()) {
+	  *realColumns[k]->_buf = values[k][i] ;
+	} else {
+	  catColumns[k]->_buf->assignFast(*types[k][i]) ;
+	}
+      }
+      for (std::size_t k=0 ; k<nVar ; k++) {
+	if (rangeName && !args[k]->inRange(rangeName)) {
+	  pass[i] = 0 ;
+	  break ;
+	}
+      }
+      if (pass[i] && select && select->getVal()==0) {
+	pass[i] = 0 ;
+      }
+    }
+  }
+
+  // Append the accepted events to the columns
+  std::vector<Double_t> accepted ;
+  accepted.reserve(nEvt) ;
+  for (std::size_t k=0 ; k<nVar ; k++) {
+    accepted.clear() ;
+    if (types[k].empty()) {
+      for (std::size_t i=0 ; i<nEvt ; i++) {
+	if (pass[i]) accepted.push_back(values[k][i]) ;
+      }
+      RealFullVector* fullColumn = dynamic_cast<RealFullVector*>(realColumns[k]) ;
+      if (fullColumn) {
+	fullColumn->fill(accepted.data(),accepted.size()) ;
+      } else {
+	realColumns[k]->fill(accepted.data(),accepted.size()) ;
+      }
+
+      if (_wgtVar && args[k]->namePtr()==_wgtVar->namePtr()) {
+	// use Kahan's algorithm to sum up weights to avoid loss of precision
+	for (std::size_t i=0 ; i<accepted.size() ; i++) {
+	  Double_t y = accepted[i] - _sumWeightCarry;
+	  Double_t t = _sumWeight + y;
+	  _sumWeightCarry = (t - _sumWeight) - y;
+	  _sumWeight = t;
+	}
+      }
+    } else {
+      CatVector* column = catColumns[k] ;
+      for (std::size_t i=0 ; i<nEvt ; i++) {
+	if (pass[i]) column->_vec.push_back(*types[k][i]) ;
+      }
+      column->_vec0 = column->_vec.empty() ? 0 : &column->_vec.front() ;
+    }
+  }
+
+  std::size_t nAccepted(0) ;
+  for (std::size_t i=0 ; i<nEvt ; i++) {
+    if (pass[i]) nAccepted++ ;
+  }
+  if (!_wgtVar) {
+    _sumWeight += nAccepted ;
+  }
+  _nEntries += nAccepted ;
+
+  return numInvalid ;
+}
+
+
+
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1468,6 +1833,126 @@ void RooVectorDataStore::resetBuffers()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Let the objects into which the real-valued columns are loaded, including the
+/// expressions cached by the constant term optimizer, read the values of all
+/// events directly from the columns in RooAbsReal::getValBatch(). With attach
+/// false, they are evaluated again.
+
+void RooVectorDataStore::attachBatchData(Bool_t attach) 
+{
+  for (vector<RealVector*>::iterator iter = _realStoreList.begin() ; iter!=_realStoreList.end() ; ++iter) {
+    (*iter)->attachBatchData(attach) ;
+  }
+  for (vector<RealFullVector*>::iterator iter = _realfStoreList.begin() ; iter!=_realfStoreList.end() ; ++iter) {
+    (*iter)->attachBatchData(attach) ;
+  }
+  if (_cache) {
+    _cache->attachBatchData(attach) ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the weights of the events [first, first+len). An empty span is
+/// returned for unweighted data, whose weights are all one.
+
+RooSpan<const double> RooVectorDataStore::getWeightBatch(std::size_t first, std::size_t len) const
+{
+  if (_extWgtArray) {
+    return RooSpan<const double>(_extWgtArray+first,len) ;
+  }
+  if (_wgtVar) {
+    RealVector* column = findRealColumn(*_wgtVar) ;
+    if (column && column->_float) {
+      // Weights stored in single precision are converted for each batch
+      if (_weightBatch.size()<len) {
+	_weightBatch.resize(len) ;
+      }
+      for (std::size_t i=0 ; i<len ; i++) {
+	_weightBatch[i] = column->_vecF[first+i] ;
+      }
+      return RooSpan<const double>(_weightBatch.data(),len) ;
+    }
+    if (column) {
+      return RooSpan<const double>(&column->_vec.front()+first,len) ;
+    }
+  }
+  return RooSpan<const double>() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the values of the events [first, first+len) stored in the column of
+/// the real-valued observable 'real'. An empty span is returned if there is no
+/// such column or if it is stored in single precision (see getFloatBatch()).
+
+RooSpan<const double> RooVectorDataStore::getBatch(const RooAbsArg& real, std::size_t first, std::size_t len) const
+{
+  RealVector* column = findRealColumn(real) ;
+  if (!column || column->_float || first+len>column->_vec.size()) {
+    return RooSpan<const double>() ;
+  }
+  return RooSpan<const double>(&column->_vec.front()+first,len) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the values of the events [first, first+len) stored in the column of
+/// the real-valued observable 'real', if it has the attribute StoreAsFloat.
+/// An empty span is returned otherwise.
+
+RooSpan<const float> RooVectorDataStore::getFloatBatch(const RooAbsArg& real, std::size_t first, std::size_t len) const
+{
+  RealVector* column = findRealColumn(real) ;
+  if (!column || !column->_float || first+len>column->_vecF.size()) {
+    return RooSpan<const float>() ;
+  }
+  return RooSpan<const float>(&column->_vecF.front()+first,len) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the column storing the values of the real-valued object 'arg', or
+/// null if there is none.
+
+RooVectorDataStore::RealVector* RooVectorDataStore::findRealColumn(const RooAbsArg& arg) const
+{
+  for (vector<RealVector*>::const_iterator iter = _realStoreList.begin() ; iter!=_realStoreList.end() ; ++iter) {
+    if ((*iter)->bufArg()->namePtr()==arg.namePtr()) {
+      return *iter ;
+    }
+  }
+  for (vector<RealFullVector*>::const_iterator iter = _realfStoreList.begin() ; iter!=_realfStoreList.end() ; ++iter) {
+    if ((*iter)->bufArg()->namePtr()==arg.namePtr()) {
+      return *iter ;
+    }
+  }
+  return 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the column storing the states of the category 'arg', or null if
+/// there is none.
+
+RooVectorDataStore::CatVector* RooVectorDataStore::findCatColumn(const RooAbsArg& arg) const
+{
+  for (vector<CatVector*>::const_iterator iter = _catStoreList.begin() ; iter!=_catStoreList.end() ; ++iter) {
+    if ((*iter)->bufArg()->namePtr()==arg.namePtr()) {
+      return *iter ;
+    }
+  }
+  return 0 ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void RooVectorDataStore::dump()
@@ -1480,9 +1965,9 @@ void RooVectorDataStore::dump()
   for (; iter!=_realStoreList.end() ; ++iter) {
     cout << "RealVector " << *iter << " _nativeReal = " << (*iter)->_nativeReal << " = " << (*iter)->_nativeReal->GetName() << " bufptr = " << (*iter)->_buf  << endl ;
     cout << " values : " ;
-    Int_t imax = (*iter)->_vec.size()>10 ? 10 : (*iter)->_vec.size() ;
+    Int_t imax = (*iter)->size()>10 ? 10 : (*iter)->size() ;
     for (Int_t i=0 ; i<imax ; i++) {
-      cout << (*iter)->_vec[i] << " " ;
+      cout << ((*iter)->_float ? (*iter)->_vecF[i] : (*iter)->_vec[i]) << " " ;
     }
     cout << endl ;
   }    
@@ -1492,9 +1977,9 @@ void RooVectorDataStore::dump()
 	 << " bufptr = " << (*iter2)->_buf  << " errbufptr = " << (*iter2)->_bufE << endl ;
 
     cout << " values : " ;
-    Int_t imax = (*iter2)->_vec.size()>10 ? 10 : (*iter2)->_vec.size() ;
+    Int_t imax = (*iter2)->size()>10 ? 10 : (*iter2)->size() ;
     for (Int_t i=0 ; i<imax ; i++) {
-      cout << (*iter2)->_vec[i] << " " ;
+      cout << ((*iter2)->_float ? (*iter2)->_vecF[i] : (*iter2)->_vec[i]) << " " ;
     }
     cout << endl ;
     if ((*iter2)->_vecE) {
@@ -1552,6 +2037,7 @@ void RooVectorDataStore::RealVector::Streamer(TBuffer &R__b)
    if (R__b.IsReading()) {
       R__b.ReadClassBuffer(RooVectorDataStore::RealVector::Class(),this);
       _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
+      _vecF0 = _vecF.size()>0 ? &_vecF.front() : 0 ;
    } else {
       R__b.WriteClassBuffer(RooVectorDataStore::RealVector::Class(),this);
    }
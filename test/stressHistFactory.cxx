@@ -97,6 +97,7 @@ Int_t stressHistFactory(const char* refFile, Bool_t writeRef, Int_t verbose, Boo
 
    list<RooUnitTest*> testList;
    testList.push_back(new PdfComparison(fref, writeRef, verbose));
+   testList.push_back(new FastNLLComparison(fref, writeRef, verbose));
 
    TString suiteType = TString::Format(" Starting S.T.R.E.S.S. %s",
                                        allTests ? "full suite" : (oneTest ? TString::Format("test %d", testNumber).Data() : "basic suite")
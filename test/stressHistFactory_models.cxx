@@ -1,5 +1,7 @@
 // ROOT headers
 #include "TString.h"
+#include "TH1F.h"
+#include "TList.h"
 
 // RooFit headers
 #include "RooWorkspace.h"
@@ -7,6 +9,7 @@
 // HistFactory headers
 #include "RooStats/HistFactory/Measurement.h"
 #include "RooStats/HistFactory/MakeModelAndMeasurementsFast.h"
+#include "RooStats/HistFactory/HistoToWorkspaceFactoryFast.h"
 
 using namespace RooFit;
 using namespace RooStats;
@@ -84,3 +87,112 @@ void buildAPI_XML_TestModel(TString prefix)
 
   meas.PrintXML();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a histogram with 5 bins, owned by the list hists
+
+TH1* makeFastNLLHisto(TList& hists, const char* name, const Double_t* contents, Double_t relError=0)
+{
+  TH1F* h = new TH1F(name,name,5,0,5);
+  h->SetDirectory(0);
+  for(Int_t i = 0; i < 5; ++i) {
+    h->SetBinContent(i+1,contents[i]);
+    h->SetBinError(i+1,relError*contents[i]);
+  }
+  hists.Add(h);
+  return h;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build a model in memory with all the terms flattened by HistFactoryFastNLL:
+/// HistoSys for each interpolation code (set later on alpha_syst0...alpha_syst5),
+/// statistical uncertainties and ShapeSys with Gaussian and Poisson constraints
+/// and a ShapeFactor
+
+RooWorkspace* buildFastNLL_TestModel()
+{
+  TList hists;
+  hists.SetOwner();
+
+  HistFactory::Measurement meas("FastNLL","FastNLL_TestModel");
+  meas.SetPOI("mu");
+  meas.SetLumi(1.0);
+  meas.SetLumiRelErr(0.1);
+  meas.AddConstantParam("Lumi");
+
+  const Double_t sig[5] = {2,5,10,5,2};
+  const Double_t bkg[5] = {20,18,15,12,10};
+  const Double_t bkg2[5] = {30,25,20,25,30};
+  const Double_t flat[5] = {5,5,5,5,5};
+  const Double_t shapeErr[5] = {0.05,0.1,0.15,0.1,0.05};
+  const Double_t data1[5] = {23,25,27,18,11};
+  const Double_t data2[5] = {36,29,27,31,33};
+
+  // channel with Gaussian constraints of the statistical uncertainties
+  HistFactory::Channel chanGauss("chanGauss");
+  chanGauss.SetData(makeFastNLLHisto(hists,"data1",data1));
+  chanGauss.SetStatErrorConfig(0.01,HistFactory::Constraint::Gaussian);
+
+  HistFactory::Sample signal("signal");
+  signal.SetHisto(makeFastNLLHisto(hists,"signal",sig));
+  signal.AddNormFactor("mu",1,0,10);
+  for(Int_t k = 0; k < 6; ++k) {
+    // asymmetric variations, which differ for each interpolation code
+    Double_t low[5], high[5];
+    for(Int_t i = 0; i < 5; ++i) {
+      high[i] = sig[i]*(1 + 0.1*(k+1)*(i+1)/5.);
+      low[i] = sig[i]*(1 - 0.07*(k+1)*(5-i)/5.);
+    }
+    HistFactory::HistoSys syst(Form("syst%d",k));
+    syst.SetHistoLow(makeFastNLLHisto(hists,Form("signal_syst%d_low",k),low));
+    syst.SetHistoHigh(makeFastNLLHisto(hists,Form("signal_syst%d_high",k),high));
+    signal.AddHistoSys(syst);
+  }
+  chanGauss.AddSample(signal);
+
+  HistFactory::Sample background("background");
+  background.SetHisto(makeFastNLLHisto(hists,"background",bkg,0.1));
+  background.ActivateStatError();
+  background.AddOverallSys("bkg_unc",0.9,1.1);
+  HistFactory::ShapeSys shapeGauss;
+  shapeGauss.SetName("shapeGauss");
+  shapeGauss.SetConstraintType(HistFactory::Constraint::Gaussian);
+  shapeGauss.SetErrorHist(makeFastNLLHisto(hists,"shapeGauss",shapeErr));
+  background.AddShapeSys(shapeGauss);
+  chanGauss.AddSample(background);
+
+  // channel with Poisson constraints of the statistical uncertainties
+  HistFactory::Channel chanPois("chanPois");
+  chanPois.SetData(makeFastNLLHisto(hists,"data2",data2));
+  chanPois.SetStatErrorConfig(0.01,HistFactory::Constraint::Poisson);
+
+  HistFactory::Sample background2("background2");
+  background2.SetHisto(makeFastNLLHisto(hists,"background2",bkg2,0.1));
+  background2.ActivateStatError();
+  HistFactory::HistoSys syst0("syst0");
+  Double_t low[5], high[5];
+  for(Int_t i = 0; i < 5; ++i) {
+    high[i] = 1.05*bkg2[i];
+    low[i] = 0.97*bkg2[i];
+  }
+  syst0.SetHistoLow(makeFastNLLHisto(hists,"background2_syst0_low",low));
+  syst0.SetHistoHigh(makeFastNLLHisto(hists,"background2_syst0_high",high));
+  background2.AddHistoSys(syst0);
+  HistFactory::ShapeSys shapePois;
+  shapePois.SetName("shapePois");
+  shapePois.SetConstraintType(HistFactory::Constraint::Poisson);
+  shapePois.SetErrorHist(makeFastNLLHisto(hists,"shapePois",shapeErr));
+  background2.AddShapeSys(shapePois);
+  chanPois.AddSample(background2);
+
+  HistFactory::Sample freeShape("freeShape");
+  freeShape.SetHisto(makeFastNLLHisto(hists,"freeShape",flat));
+  freeShape.SetNormalizeByTheory(kFALSE);
+  freeShape.AddShapeFactor("sf");
+  chanPois.AddSample(freeShape);
+
+  meas.AddChannel(chanGauss);
+  meas.AddChannel(chanPois);
+
+  return HistFactory::HistoToWorkspaceFactoryFast::MakeCombinedModel(meas);
+}
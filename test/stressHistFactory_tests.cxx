@@ -17,10 +17,14 @@
 #include "RooLinkedListIter.h"
 #include "RooAbsPdf.h"
 #include "RooDataSet.h"
+#include "RooRealVar.h"
+#include "RooSimultaneous.h"
 
 // RooStats header(s)
 #include "RooStats/ModelConfig.h"
 #include "RooStats/RooStatsUtils.h"
+#include "RooStats/HistFactory/HistFactoryFastNLL.h"
+#include "RooStats/HistFactory/PiecewiseInterpolation.h"
 
 #include "stressHistFactory_models.cxx"
 
@@ -479,3 +483,103 @@ private:
     return kTRUE;
   }
 };
+
+
+class FastNLLComparison : public RooUnitTest {
+public:
+  FastNLLComparison(
+    TFile* refFile,
+    Bool_t writeRef,
+    Int_t verbose
+    ) :
+    RooUnitTest("HistFactoryFastNLL vs. RooNLLVar", refFile, writeRef, verbose)
+  {
+  }
+
+  Bool_t testCode()
+  {
+    RooWorkspace* pWS = buildFastNLL_TestModel();
+    RooSimultaneous* pSimPdf = (RooSimultaneous*)pWS->pdf("simPdf");
+    RooAbsData* pData = pWS->data("obsData");
+    ModelConfig* pMC = (ModelConfig*)pWS->obj("ModelConfig");
+    if(!pSimPdf || !pData || !pMC) {
+       Error("testCode","Error retrieving the model from the workspace");
+       delete pWS;
+       return kFALSE;
+    }
+    const RooArgSet* pGlobs = pMC->GetGlobalObservables();
+
+    // use interpolation code k for the HistoSys alpha_systk
+    RooArgSet* pComponents = pSimPdf->getComponents();
+    RooFIter itComp = pComponents->fwdIterator();
+    RooAbsArg* pComp;
+    while((pComp = itComp.next())) {
+      PiecewiseInterpolation* pInterp = dynamic_cast<PiecewiseInterpolation*>(pComp);
+      if(!pInterp) continue;
+      for(Int_t i = 0; i < pInterp->paramList().getSize(); ++i) {
+        RooAbsReal* pAlpha = (RooAbsReal*)pInterp->paramList().at(i);
+        Int_t code;
+        if(sscanf(pAlpha->GetName(),"alpha_syst%d",&code) == 1)
+          pInterp->setInterpCode(*pAlpha,code);
+      }
+    }
+    delete pComponents;
+
+    RooAbsReal* pNLL = pSimPdf->createNLL(*pData,GlobalObservables(*pGlobs));
+    HistFactory::HistFactoryFastNLL fastNLL("fastNLL","fastNLL",*pSimPdf,*pData,pGlobs);
+
+    Bool_t bResult = kTRUE;
+
+    // all the terms of a standard model are flattened
+    if(fastNLL.numGenericTerms() != 0)
+    {
+      Warning("testCode","%d terms of the model are evaluated bin by bin",fastNLL.numGenericTerms());
+      bResult = kFALSE;
+    }
+
+    RooArgSet* pParams = pSimPdf->getParameters(*pData);
+    pParams->remove(*pGlobs,kTRUE,kTRUE);
+
+    // the likelihoods differ by a constant at the nominal point and at points with the
+    // interpolation parameters on both sides of 0 and beyond +/-1
+    const Int_t iPoints = 5;
+    const Double_t alphas[iPoints] = {0,-1.6,-0.5,0.4,1.7};
+    Double_t diff0 = 0;
+    for(Int_t p = 0; p < iPoints; ++p)
+    {
+      RooFIter itPar = pParams->fwdIterator();
+      RooAbsArg* pArg;
+      Int_t k = 0;
+      while((pArg = itPar.next())) {
+        RooRealVar* pPar = dynamic_cast<RooRealVar*>(pArg);
+        if(!pPar || pPar->isConstant() || p == 0) continue;
+        TString name(pPar->GetName());
+        if(name.BeginsWith("alpha_"))
+          pPar->setVal(alphas[p] + 0.05*k);
+        else if(name.BeginsWith("gamma_"))
+          pPar->setVal(1 + 0.03*alphas[p] + 0.005*k);
+        else
+          pPar->setVal(1 + 0.3*alphas[p]);
+        ++k;
+      }
+
+      const Double_t nll = pNLL->getVal();
+      const Double_t fast = fastNLL.getVal();
+      if(_verb > 0)
+        Info("testCode","point %d: NLL %.10f fast NLL %.10f difference %.10f",p,nll,fast,nll-fast);
+      if(p == 0)
+        diff0 = nll - fast;
+      else if(!TMath::AreEqualAbs(nll - fast,diff0,1e-8*TMath::Max(1.,TMath::Abs(nll))))
+      {
+        Warning("testCode","likelihoods differ by %.10f at point %d instead of %.10f",nll-fast,p,diff0);
+        bResult = kFALSE;
+      }
+    }
+
+    delete pParams;
+    delete pNLL;
+    delete pWS;
+
+    return bResult;
+  }
+};
@@ -6444,3 +6444,504 @@ public:
   }
 } ;
 
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// Batch evaluation of p.d.f.s
+//
+// The values returned by getValBatch() for the events of a dataset are
+// the ones of getVal() event by event, and the likelihood evaluated in
+// batch mode is the scalar one
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooVectorDataStore.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooPolynomial.h"
+#include "RooAddPdf.h"
+#include "RooProdPdf.h"
+#include "TMath.h"
+
+using namespace RooFit ;
+
+
+class TestBasic901 : public RooUnitTest
+{
+public:
+  TestBasic901(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Batch evaluation of p.d.f.s",refFile,writeRef,verbose) {} ;
+
+  // Batch evaluations need a dataset stored in a RooVectorDataStore
+  Bool_t isTestAvailable() { return RooAbsData::getDefaultStorageType()==RooAbsData::Vector ; }
+
+  // Compare two values with a relative tolerance
+  Bool_t isClose(Double_t a, Double_t b, Double_t tol=1e-9) {
+    return TMath::Abs(a-b) <= tol*TMath::Max(1.,TMath::Max(TMath::Abs(a),TMath::Abs(b))) ;
+  }
+
+  // Compare getValBatch() of a clone of pdf bound to data with getVal() for each event
+  Bool_t compareBatch(const RooAbsPdf& pdf, RooDataSet& data) {
+
+    RooAbsPdf* clone = (RooAbsPdf*) pdf.cloneTree() ;
+    clone->attachDataSet(data) ;
+    RooArgSet* obs = clone->getObservables(data) ;
+    RooVectorDataStore* store = (RooVectorDataStore*) data.store() ;
+    const Int_t n = data.numEntries() ;
+
+    // Evaluate the events in two batches of different sizes
+    std::vector<double> batchVals ;
+    store->attachBatchData() ;
+    for (Int_t begin=0 ; begin<n ; begin+=700) {
+      const Int_t size = TMath::Min(700,n-begin) ;
+      RooSpan<const double> vals = clone->getValBatch(begin,size,obs) ;
+      for (Int_t i=0 ; i<size ; i++) {
+        batchVals.push_back(vals.size()==1 ? vals[0] : vals[i]) ;
+      }
+    }
+    store->attachBatchData(kFALSE) ;
+
+    Bool_t ok = kTRUE ;
+    for (Int_t i=0 ; i<n ; i++) {
+      data.get(i) ;
+      const Double_t val = clone->getVal(obs) ;
+      if (!isClose(val,batchVals[i])) {
+        if (_verb>0) cout << "TestBasic901: " << pdf.GetName() << " event " << i << " getVal()=" << val << " getValBatch()=" << batchVals[i] << endl ;
+        ok = kFALSE ;
+        break ;
+      }
+    }
+
+    delete obs ;
+    delete clone ;
+    return ok ;
+  }
+
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l
+  // -----------------------
+
+  RooRealVar x("x","x",-10,10) ;
+  RooRealVar y("y","y",0,5) ;
+
+  RooRealVar m("m","m",1,-10,10) ;
+  RooRealVar s("s","s",2,0.1,10) ;
+  RooGaussian g("g","g",x,m,s) ;
+
+  RooRealVar c("c","c",-0.2,-2.,0.) ;
+  RooExponential e("e","e",x,c) ;
+
+  RooRealVar a0("a0","a0",0.1,-1,1) ;
+  RooRealVar a1("a1","a1",0.01,-0.1,0.1) ;
+  RooPolynomial p("p","p",x,RooArgList(a0,a1)) ;
+
+  RooRealVar f1("f1","f1",0.5,0.,1.) ;
+  RooRealVar f2("f2","f2",0.3,0.,1.) ;
+  RooAddPdf sum("sum","sum",RooArgList(g,e,p),RooArgList(f1,f2)) ;
+
+  RooRealVar cy("cy","cy",-0.5,-2.,0.) ;
+  RooExponential ey("ey","ey",y,cy) ;
+  RooProdPdf prod("prod","prod",RooArgList(sum,ey)) ;
+
+  RooDataSet* data = prod.generate(RooArgSet(x,y),2000) ;
+
+
+  // C o m p a r e   b a t c h   a n d   s c a l a r   v a l u e s
+  // ---------------------------------------------------------------
+
+  const RooAbsPdf* pdfs[] = { &g, &e, &p, &sum, &ey, &prod } ;
+  for (const RooAbsPdf* pdf : pdfs) {
+    if (!compareBatch(*pdf,*data)) {
+      delete data ;
+      return kFALSE ;
+    }
+  }
+
+
+  // C o m p a r e   b a t c h   a n d   s c a l a r   l i k e l i h o o d s
+  // -------------------------------------------------------------------------
+
+  RooAbsReal* nll = prod.createNLL(*data) ;
+  RooAbsReal* nllBatch = prod.createNLL(*data,BatchMode()) ;
+  Bool_t ok = isClose(nll->getVal(),nllBatch->getVal(),1e-12) ;
+
+  // and after a change of the parameters
+  m.setVal(-0.5) ;
+  c.setVal(-0.4) ;
+  f1.setVal(0.4) ;
+  ok &= isClose(nll->getVal(),nllBatch->getVal(),1e-12) ;
+  if (!ok && _verb>0) cout << "TestBasic901: NLL=" << nll->getVal() << " batch NLL=" << nllBatch->getVal() << endl ;
+
+  delete nllBatch ;
+  delete nll ;
+  delete data ;
+
+  return ok ;
+  }
+} ;
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// Multi-threaded likelihood calculation
+//
+// A simultaneous fit whose likelihood is calculated on several threads,
+// with the events of each component split between them or with the
+// components distributed among them, gives the single-threaded result
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooCategory.h"
+#include "RooGaussian.h"
+#include "RooChebychev.h"
+#include "RooAddPdf.h"
+#include "RooSimultaneous.h"
+#include "RooFitResult.h"
+#include "TMath.h"
+#include "TROOT.h"
+
+using namespace RooFit ;
+
+
+class TestBasic902 : public RooUnitTest
+{
+public:
+  TestBasic902(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Multi-threaded likelihood calculation",refFile,writeRef,verbose) {} ;
+
+  // The likelihood is calculated on the threads of the implicit multi-threading pool
+  Bool_t isTestAvailable() {
+#ifdef R__USE_IMT
+    return kTRUE ;
+#else
+    return kFALSE ;
+#endif
+  }
+
+  // Fit from the initial values of the parameters and compare with the reference fit
+  Bool_t compareFit(RooSimultaneous& simPdf, RooDataSet& data, RooArgSet& params, const RooArgSet& init,
+                    const RooFitResult& ref, const RooCmdArg& numThreads) {
+    params = init ;
+    RooFitResult* r = simPdf.fitTo(data,Save(),numThreads) ;
+    Bool_t ok = r->status()==0 && r->isIdentical(ref,1e-6,1e-5,_verb>0) &&
+                TMath::Abs(r->minNll()-ref.minNll()) < 1e-8*TMath::Abs(ref.minNll()) ;
+    delete r ;
+    return ok ;
+  }
+
+  Bool_t testCode() {
+
+  // C r e a t e   s i m u l t a n e o u s   m o d e l
+  // ---------------------------------------------------
+
+  RooRealVar x("x","x",-8,8) ;
+
+  RooRealVar mean("mean","mean",0,-8,8) ;
+  RooRealVar sigma("sigma","sigma",0.3,0.1,10) ;
+  RooGaussian gx("gx","gx",x,mean,sigma) ;
+  RooRealVar a0("a0","a0",-0.1,-1,1) ;
+  RooRealVar a1("a1","a1",0.004,-1,1) ;
+  RooChebychev px("px","px",x,RooArgSet(a0,a1)) ;
+  RooRealVar f("f","f",0.2,0.,1.) ;
+  RooAddPdf model("model","model",RooArgList(gx,px),f) ;
+
+  RooRealVar mean_ctl("mean_ctl","mean_ctl",-3,-8,8) ;
+  RooRealVar sigma_ctl("sigma_ctl","sigma_ctl",0.5,0.1,10) ;
+  RooGaussian gx_ctl("gx_ctl","gx_ctl",x,mean_ctl,sigma_ctl) ;
+  RooRealVar a0_ctl("a0_ctl","a0_ctl",-0.1,-1,1) ;
+  RooRealVar a1_ctl("a1_ctl","a1_ctl",0.5,-0.1,1) ;
+  RooChebychev px_ctl("px_ctl","px_ctl",x,RooArgSet(a0_ctl,a1_ctl)) ;
+  RooRealVar f_ctl("f_ctl","f_ctl",0.5,0.,1.) ;
+  RooAddPdf model_ctl("model_ctl","model_ctl",RooArgList(gx_ctl,px_ctl),f_ctl) ;
+
+  RooDataSet* data = model.generate(RooArgSet(x),2000) ;
+  RooDataSet* data_ctl = model_ctl.generate(RooArgSet(x),4000) ;
+
+  RooCategory sample("sample","sample") ;
+  sample.defineType("physics") ;
+  sample.defineType("control") ;
+  RooDataSet combData("combData","combined data",x,Index(sample),Import("physics",*data),Import("control",*data_ctl)) ;
+
+  RooSimultaneous simPdf("simPdf","simultaneous pdf",sample) ;
+  simPdf.addPdf(model,"physics") ;
+  simPdf.addPdf(model_ctl,"control") ;
+
+  RooArgSet* params = simPdf.getParameters(combData) ;
+  RooArgSet* init = (RooArgSet*) params->snapshot() ;
+
+
+  // C o m p a r e   l i k e l i h o o d s   a n d   f i t s
+  // ---------------------------------------------------------
+
+  // Enable IMT for this test only, leaving it as it is if it is already enabled
+  const Bool_t wasMTEnabled = ROOT::IsImplicitMTEnabled() ;
+  if (!wasMTEnabled) ROOT::EnableImplicitMT(4) ;
+
+  RooAbsReal* nll = simPdf.createNLL(combData) ;
+  RooAbsReal* nllEvents = simPdf.createNLL(combData,NumThreads(4,RooFit::BulkPartition)) ;
+  RooAbsReal* nllComponents = simPdf.createNLL(combData,NumThreads(2,RooFit::SimComponents)) ;
+  Bool_t ok = TMath::Abs(nll->getVal()-nllEvents->getVal()) < 1e-10*TMath::Abs(nll->getVal()) &&
+              TMath::Abs(nll->getVal()-nllComponents->getVal()) < 1e-10*TMath::Abs(nll->getVal()) ;
+  if (!ok && _verb>0) cout << "TestBasic902: NLL=" << nll->getVal() << " events split: " << nllEvents->getVal()
+                           << " components split: " << nllComponents->getVal() << endl ;
+  delete nllComponents ;
+  delete nllEvents ;
+  delete nll ;
+
+  RooFitResult* ref = simPdf.fitTo(combData,Save()) ;
+  ok &= ref->status()==0 ;
+  ok &= compareFit(simPdf,combData,*params,*init,*ref,NumThreads(4,RooFit::BulkPartition)) ;
+  ok &= compareFit(simPdf,combData,*params,*init,*ref,NumThreads(2,RooFit::SimComponents)) ;
+
+  if (!wasMTEnabled) ROOT::DisableImplicitMT() ;
+
+  delete ref ;
+  delete init ;
+  delete params ;
+  delete data_ctl ;
+  delete data ;
+
+  return ok ;
+  }
+} ;
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// Column-wise data import and single precision columns
+//
+// Trees, chains and columns in memory read directly into the columns of a
+// RooVectorDataStore give the dataset imported through a RooTreeDataStore. Columns stored in
+// single precision survive writing to a file and are returned by the
+// batch accessors of the store
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooCategory.h"
+#include "RooDataSet.h"
+#include "RooFormulaVar.h"
+#include "RooVectorDataStore.h"
+#include "TTree.h"
+#include "TChain.h"
+#include "TFile.h"
+#include "TSystem.h"
+
+using namespace RooFit ;
+
+
+class TestBasic903 : public RooUnitTest
+{
+public:
+  TestBasic903(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Column-wise data import and single precision columns",refFile,writeRef,verbose) {} ;
+
+  // The columns are those of a RooVectorDataStore
+  Bool_t isTestAvailable() { return RooAbsData::getDefaultStorageType()==RooAbsData::Vector ; }
+
+  // Events stored in the trees
+  std::vector<Double_t> _x ;
+  std::vector<Float_t> _y, _w ;
+  std::vector<Int_t> _c ;
+
+  // Fill a tree with the events [begin,end), in the branches of a dataset written by
+  // RooTreeDataStore: the category is stored as an index branch c_idx and a label branch c_lbl
+  void fillTree(TTree& tree, Int_t begin, Int_t end) {
+    Double_t x ;
+    Float_t y, w ;
+    Int_t idx ;
+    char lbl[2] = "A" ;
+    tree.Branch("x",&x,"x/D") ;
+    tree.Branch("y",&y,"y/F") ;
+    tree.Branch("w",&w,"w/F") ;
+    tree.Branch("c_idx",&idx,"c_idx/I") ;
+    tree.Branch("c_lbl",lbl,"c_lbl/C") ;
+    for (Int_t i=begin ; i<end ; i++) {
+      x = _x[i] ;
+      y = _y[i] ;
+      w = _w[i] ;
+      idx = _c[i] ;
+      lbl[0] = char('A'+idx) ;
+      tree.Fill() ;
+    }
+  }
+
+  // Compare the events of two datasets with observables x, y and c
+  Bool_t compareData(const char* label, const RooDataSet& ref, const RooDataSet& data) {
+    if (ref.numEntries()!=data.numEntries() || ref.isWeighted()!=data.isWeighted()) {
+      if (_verb>0) cout << "TestBasic903: " << label << " has " << data.numEntries() << " events, expected " << ref.numEntries() << endl ;
+      return kFALSE ;
+    }
+    for (Int_t i=0 ; i<ref.numEntries() ; i++) {
+      const RooArgSet* r = ref.get(i) ;
+      const Double_t rx = r->getRealValue("x"), ry = r->getRealValue("y"), rw = ref.weight() ;
+      const Int_t rc = r->getCatIndex("c") ;
+      const RooArgSet* d = data.get(i) ;
+      if (rx!=d->getRealValue("x") || ry!=d->getRealValue("y") || rc!=d->getCatIndex("c") || rw!=data.weight()) {
+        if (_verb>0) cout << "TestBasic903: " << label << " event " << i << " differs" << endl ;
+        return kFALSE ;
+      }
+    }
+    return kTRUE ;
+  }
+
+  Bool_t testCode() {
+
+  RooRealVar x("x","x",-10,10) ;
+  RooRealVar y("y","y",0,10) ;
+  RooRealVar w("w","w",0,10) ;
+  RooCategory c("c","c") ;
+  c.defineType("A",0) ;
+  c.defineType("B",1) ;
+  c.defineType("C",2) ;
+  x.setRange("central",-5,5) ;
+  RooArgSet vars(x,y,w,c) ;
+
+  Bool_t ok(kTRUE) ;
+
+
+  // I m p o r t   t r e e s   a n d   c h a i n s
+  // -----------------------------------------------
+
+  // A tree in memory and the same events in a chain of two files
+  for (Int_t i=0 ; i<5000 ; i++) {
+    _x.push_back(gRandom->Uniform()*24 - 12) ;
+    _y.push_back(gRandom->Exp(3)) ;
+    _w.push_back(0.5 + gRandom->Uniform()*1.5) ;
+    _c.push_back(gRandom->Integer(3)) ;
+  }
+  TTree tree("t","t") ;
+  tree.SetDirectory(0) ;
+  fillTree(tree,0,5000) ;
+  const char* fileNames[2] = { "stressRooFit_903_1.root", "stressRooFit_903_2.root" } ;
+  for (Int_t k=0 ; k<2 ; k++) {
+    TFile f(fileNames[k],"RECREATE") ;
+    TTree part("t","t") ;
+    fillTree(part,2500*k,2500*(k+1)) ;
+    part.Write() ;
+  }
+  TChain chain("t") ;
+  chain.Add(fileNames[0]) ;
+  chain.Add(fileNames[1]) ;
+
+  // Reference datasets imported through a RooTreeDataStore
+  RooAbsData::setDefaultStorageType(RooAbsData::Tree) ;
+  RooDataSet refAll("refAll","refAll",vars,Import(tree),WeightVar(w)) ;
+  RooDataSet refCut("refCut","refCut",vars,Import(tree),Cut("y<5"),CutRange("central"),WeightVar(w)) ;
+  RooAbsData::setDefaultStorageType(RooAbsData::Vector) ;
+
+  // The trees are read into the columns of the store, without falling back to RooTreeDataStore
+  RooFormulaVar select("select","y<5",vars) ;
+  RooVectorDataStore store("store","store",vars,"w") ;
+  if (!store.loadValues(&chain,&select,"central") || store.numEntries()!=refCut.numEntries()) {
+    if (_verb>0) cout << "TestBasic903: chain not read into the columns, " << store.numEntries() << " events loaded" << endl ;
+    ok = kFALSE ;
+  }
+
+  // The same events given as columns in memory, the category as its index, in another order than the observables
+  std::vector<Double_t> xCol(_x), yCol(_y.begin(),_y.end()), wCol(_w.begin(),_w.end()), cCol(_c.begin(),_c.end()) ;
+  std::vector<RooSpan<const double> > columns ;
+  columns.push_back(RooSpan<const double>(cCol.data(),cCol.size())) ;
+  columns.push_back(RooSpan<const double>(wCol.data(),wCol.size())) ;
+  columns.push_back(RooSpan<const double>(yCol.data(),yCol.size())) ;
+  columns.push_back(RooSpan<const double>(xCol.data(),xCol.size())) ;
+  RooVectorDataStore colStore("colStore","colStore",vars,"w") ;
+  if (!colStore.loadColumns(RooArgList(c,w,y,x),columns,&select,"central") || colStore.numEntries()!=refCut.numEntries()) {
+    if (_verb>0) cout << "TestBasic903: columns not loaded, " << colStore.numEntries() << " events loaded" << endl ;
+    ok = kFALSE ;
+  } else {
+    for (Int_t i=0 ; i<refCut.numEntries() ; i++) {
+      const RooArgSet* r = refCut.get(i) ;
+      const RooArgSet* d = colStore.get(i) ;
+      if (r->getRealValue("x")!=d->getRealValue("x") || r->getRealValue("y")!=d->getRealValue("y") ||
+          r->getCatIndex("c")!=d->getCatIndex("c") || refCut.weight()!=colStore.weight()) {
+        if (_verb>0) cout << "TestBasic903: event " << i << " loaded from the columns differs" << endl ;
+        ok = kFALSE ;
+        break ;
+      }
+    }
+  }
+
+  RooDataSet treeAll("treeAll","treeAll",vars,Import(tree),WeightVar(w)) ;
+  RooDataSet treeCut("treeCut","treeCut",vars,Import(tree),Cut("y<5"),CutRange("central"),WeightVar(w)) ;
+  RooDataSet chainAll("chainAll","chainAll",vars,Import(chain),WeightVar(w)) ;
+  RooDataSet chainCut("chainCut","chainCut",vars,Import(chain),Cut("y<5"),CutRange("central"),WeightVar(w)) ;
+  ok &= compareData("tree",refAll,treeAll) ;
+  ok &= compareData("tree with cuts",refCut,treeCut) ;
+  ok &= compareData("chain",refAll,chainAll) ;
+  ok &= compareData("chain with cuts",refCut,chainCut) ;
+
+
+  // S i n g l e   p r e c i s i o n   c o l u m n s
+  // -------------------------------------------------
+
+  // Store y and the weights in single precision
+  RooDataSet fdata("fdata","fdata",vars,Import(tree),WeightVar(w),StoreAsFloat(RooArgSet(y,w))) ;
+  ok &= compareData("float columns",refAll,fdata) ;
+
+  const Int_t n = fdata.numEntries() ;
+  RooVectorDataStore* fstore = (RooVectorDataStore*) fdata.store() ;
+  RooSpan<const double> xBatch = fstore->getBatch(x,0,n) ;
+  RooSpan<const float> yBatch = fstore->getFloatBatch(y,0,n) ;
+  RooSpan<const double> wBatch = fstore->getWeightBatch(0,n) ;
+  if (xBatch.size()!=std::size_t(n) || yBatch.size()!=std::size_t(n) || wBatch.size()!=std::size_t(n) ||
+      fstore->getBatch(y,0,n).size()!=0 || fstore->getFloatBatch(x,0,n).size()!=0) {
+    if (_verb>0) cout << "TestBasic903: wrong batch sizes" << endl ;
+    ok = kFALSE ;
+  } else {
+    for (Int_t i=0 ; i<n ; i++) {
+      const RooArgSet* row = fdata.get(i) ;
+      if (xBatch[i]!=row->getRealValue("x") || yBatch[i]!=row->getRealValue("y") || wBatch[i]!=fdata.weight() ||
+          Float_t(refAll.get(i)->getRealValue("y"))!=yBatch[i] || Float_t(refAll.weight())!=wBatch[i]) {
+        if (_verb>0) cout << "TestBasic903: batch values of event " << i << " differ" << endl ;
+        ok = kFALSE ;
+        break ;
+      }
+    }
+  }
+
+  // The float columns are read back from a file
+  const char* floatFileName = "stressRooFit_903_float.root" ;
+  {
+    TFile f(floatFileName,"RECREATE") ;
+    fdata.Write() ;
+  }
+  TFile* f = TFile::Open(floatFileName) ;
+  RooDataSet* fread = f ? (RooDataSet*) f->Get("fdata") : 0 ;
+  if (!fread) {
+    if (_verb>0) cout << "TestBasic903: cannot read the dataset with float columns" << endl ;
+    ok = kFALSE ;
+  } else {
+    ok &= compareData("float columns read from file",fdata,*fread) ;
+    RooVectorDataStore* rstore = (RooVectorDataStore*) fread->store() ;
+    RooSpan<const float> yRead = rstore->getFloatBatch(y,0,n) ;
+    if (yRead.size()!=std::size_t(n) || !std::equal(yRead.begin(),yRead.end(),yBatch.begin())) {
+      if (_verb>0) cout << "TestBasic903: float column read from file differs" << endl ;
+      ok = kFALSE ;
+    }
+  }
+  delete fread ;
+  delete f ;
+
+  gSystem->Unlink(fileNames[0]) ;
+  gSystem->Unlink(fileNames[1]) ;
+  gSystem->Unlink(floatFileName) ;
+
+  return ok ;
+  }
+} ;
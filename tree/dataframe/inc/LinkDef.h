@@ -30,6 +30,7 @@
 #pragma link C++ class ROOT::RDF::TH3DModel-;
 #pragma link C++ class ROOT::RDF::TProfile1DModel-;
 #pragma link C++ class ROOT::RDF::TProfile2DModel-;
+#pragma link C++ class ROOT::RDF::RHistoBundle-;
 #pragma link C++ class ROOT::Internal::RDF::RIgnoreErrorLevelRAII-;
 #pragma link C++ class ROOT::Internal::RDF::FillHelper-;
 #pragma link C++ class ROOT::RDF::RTrivialDS-;
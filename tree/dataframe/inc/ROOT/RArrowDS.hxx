@@ -7,6 +7,9 @@
 #include <memory>
 
 namespace arrow {
+class RecordBatch;
+class RecordBatchReader;
+class Schema;
 class Table;
 }
 
@@ -22,7 +25,14 @@ namespace RDF {
 
 class RArrowDS final : public RDataSource {
 private:
-   std::shared_ptr<arrow::Table> fTable;
+   std::shared_ptr<arrow::Table> fTable; ///< The table to read from, if any
+   std::shared_ptr<arrow::Schema> fSchema;
+   /// The stream of record batches to read from, if any. Only one batch at a time is kept in memory.
+   std::shared_ptr<arrow::RecordBatchReader> fBatchReader;
+   std::shared_ptr<arrow::RecordBatch> fCurrentBatch;
+   std::string fFileName;           ///< Arrow IPC stream file to read from, if any. Reopened for every event loop.
+   bool fBatchReaderUsed = false;   ///< Whether some batches have already been read from fBatchReader
+   ULong64_t fNProcessedEntries = 0ULL; ///< Number of entries in the batches read so far
    std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
    std::vector<std::string> fColumnNames;
    size_t fNSlots = 0U;
@@ -30,9 +40,13 @@ private:
    std::vector<std::pair<size_t, size_t>> fGetterIndex; // (columnId, visitorId)
    std::vector<std::unique_ptr<ROOT::Internal::RDF::TValueGetter>> fValueGetters; // Visitors to be used to track and get entries. One per column.
    std::vector<void *> GetColumnReadersImpl(std::string_view name, const std::type_info &type) override;
+   void SetupColumns();
+   void SplitInEqualRanges(ULong64_t firstEntry, ULong64_t nRecords);
 
 public:
    RArrowDS(std::shared_ptr<arrow::Table> table, std::vector<std::string> const &columns);
+   RArrowDS(std::shared_ptr<arrow::RecordBatchReader> batchReader, std::vector<std::string> const &columns);
+   RArrowDS(std::string_view fileName, std::vector<std::string> const &columns);
    ~RArrowDS();
    const std::vector<std::string> &GetColumnNames() const override;
    std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() override;
@@ -49,6 +63,17 @@ public:
 /// \param[in] table an apache::arrow table to use as a source.
 RDataFrame MakeArrowDataFrame(std::shared_ptr<arrow::Table> table, std::vector<std::string> const &columns);
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a Apache Arrow RDataFrame reading a stream of record batches.
+/// \param[in] batchReader an apache::arrow record batch reader to use as a source.
+RDataFrame MakeArrowDataFrame(std::shared_ptr<arrow::RecordBatchReader> batchReader,
+                              std::vector<std::string> const &columns);
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a Apache Arrow RDataFrame reading a file in the Arrow IPC stream format.
+/// \param[in] fileName the path of the file, which is memory-mapped.
+RDataFrame MakeArrowIPCDataFrame(std::string_view fileName, std::vector<std::string> const &columns);
+
 } // namespace RDF
 
 } // namespace ROOT
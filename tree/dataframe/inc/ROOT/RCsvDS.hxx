@@ -15,7 +15,7 @@
 #include "ROOT/RDataSource.hxx"
 
 #include <deque>
-#include <list>
+#include <fstream>
 #include <map>
 #include <vector>
 
@@ -32,6 +32,13 @@ private:
    using ColType_t = char;
    static const std::map<ColType_t, std::string> fgColTypeMap;
 
+   /// A selection on the values of a numerical or boolean column, see SetColumnRanges
+   struct RValueRange {
+      std::size_t fColumnIdx;
+      double fMin;
+      double fMax;
+   };
+
    unsigned int fNSlots = 0U;
    std::ifstream fStream;
    const char fDelimiter;
@@ -40,26 +47,30 @@ private:
    ULong64_t fProcessedLines = 0ULL; // marks the progress of the consumption of the csv lines
    std::vector<std::string> fHeaders;
    std::map<std::string, ColType_t> fColTypes;
-   std::list<ColType_t> fColTypesList;
+   std::vector<ColType_t> fColTypesList;          // fColTypesList[column]
    std::vector<std::vector<void *>> fColAddresses; // fColAddresses[column][slot]
-   std::vector<Record_t> fRecords;                         // fRecords[entry][column]
-   std::vector<std::vector<double>> fDoubleEvtValues;      // one per column per slot
-   std::vector<std::vector<Long64_t>> fLong64EvtValues;    // one per column per slot
-   std::vector<std::vector<std::string>> fStringEvtValues; // one per column per slot
+   std::vector<std::string> fLines;                // lines of the chunk which is currently being processed
+   // Typed columnar storage of the current chunk of lines. Only the vector corresponding to the type of a column is
+   // filled, e.g. fDoubleColumns[column][entry] holds the values of a double column.
+   std::vector<std::vector<double>> fDoubleColumns;
+   std::vector<std::vector<Long64_t>> fLong64Columns;
+   std::vector<std::vector<std::string>> fStringColumns;
    // This must be a deque to avoid the specialisation vector<bool>. This would not
    // work given that the pointer to the boolean in that case cannot be taken
-   std::vector<std::deque<bool>> fBoolEvtValues; // one per column per slot
+   std::vector<std::deque<bool>> fBoolColumns;
+   std::vector<RValueRange> fValueRanges; // entries outside of these ranges are rejected by SetEntry
 
    static TRegexp intRegex, doubleRegex1, doubleRegex2, trueRegex, falseRegex;
 
    void FillHeaders(const std::string &);
-   void FillRecord(const std::string &, Record_t &);
+   void FillRecord(const std::string &, ULong64_t);
    void GenerateHeaders(size_t);
    std::vector<void *> GetColumnReadersImpl(std::string_view, const std::type_info &);
    void InferColTypes(std::vector<std::string> &);
    void InferType(const std::string &, unsigned int);
-   std::vector<std::string> ParseColumns(const std::string &);
-   size_t ParseValue(const std::string &, std::vector<std::string> &, size_t);
+   std::vector<std::string> ParseColumns(const std::string &) const;
+   size_t ParseValue(const std::string &, std::vector<std::string> &, size_t) const;
+   void ParseLines();
    ColType_t GetType(std::string_view colName) const;
 
 public:
@@ -72,6 +83,7 @@ public:
    bool HasColumn(std::string_view colName) const;
    bool SetEntry(unsigned int slot, ULong64_t entry);
    void SetNSlots(unsigned int nSlots);
+   void SetColumnRanges(const std::vector<RColumnRange> &ranges);
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -80,6 +92,7 @@ public:
 /// \param[in] readHeaders `true` if the CSV file contains headers as first row, `false` otherwise
 ///                        (default `true`).
 /// \param[in] delimiter Delimiter character (default ',').
+/// \param[in] linesChunkSize Number of lines read and parsed at a time, -1 to read the whole file at once (default -1).
 RDataFrame MakeCsvDataFrame(std::string_view fileName, bool readHeaders = true, char delimiter = ',', Long64_t linesChunkSize = -1LL);
 
 } // ns RDF
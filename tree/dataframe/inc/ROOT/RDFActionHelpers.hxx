@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -21,16 +22,20 @@
 
 #include "Compression.h"
 #include "ROOT/RIntegerSequence.hxx"
+#include "ROOT/RJaggedArray.hxx"
 #include "ROOT/RStringView.hxx"
 #include "ROOT/RVec.hxx"
 #include "ROOT/TBufferMerger.hxx" // for SnapshotHelper
 #include "ROOT/RCutFlowReport.hxx"
+#include "ROOT/RDFHistoModels.hxx"
 #include "ROOT/RDFUtils.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
 #include "ROOT/TThreadedObject.hxx"
 #include "ROOT/TypeTraits.hxx"
 #include "RtypesCore.h"
+#include "TAxis.h"
 #include "TBranch.h"
+#include "TChain.h" // for SnapshotHelperMTClusters
 #include "TClassEdit.h"
 #include "TDirectory.h"
 #include "TFile.h" // for SnapshotHelper
@@ -38,6 +43,7 @@
 #include "TLeaf.h"
 #include "TObjArray.h"
 #include "TObject.h"
+#include "TSystem.h" // for SnapshotHelperMTClusters
 #include "TTree.h"
 #include "TTreeReader.h" // for SnapshotHelper
 
@@ -311,11 +317,152 @@ public:
    HIST &PartialUpdate(unsigned int slot) { return *fTo->GetAtSlotRaw(slot); }
 };
 
-// In case of the take helper we have 4 cases:
+/// The binning of an axis of a histogram filled by HistoBundleHelper, with a FindBin that does not go through TAxis
+class RBundleAxis {
+   int fNBins;
+   double fMin;
+   double fMax;
+   std::vector<double> fEdges; ///< Empty for uniform binnings
+
+public:
+   RBundleAxis(const TAxis &axis)
+      : fNBins(axis.GetNbins()), fMin(axis.GetXmin()), fMax(axis.GetXmax())
+   {
+      if (axis.GetXbins()->GetSize() > 0)
+         fEdges.assign(axis.GetXbins()->GetArray(), axis.GetXbins()->GetArray() + fNBins + 1);
+   }
+   int GetNBins() const { return fNBins; }
+   /// Same convention as TAxis::FindFixBin: 0 is the underflow, fNBins + 1 the overflow
+   int FindBin(double x) const
+   {
+      if (x < fMin)
+         return 0;
+      if (!(x < fMax))
+         return fNBins + 1;
+      if (!fEdges.empty())
+         return std::upper_bound(fEdges.begin(), fEdges.end(), x) - fEdges.begin();
+      // the expression of TAxis, so that values on the bin edges are rounded to the same bin
+      return 1 + int(fNBins * (x - fMin) / (fMax - fMin));
+   }
+};
+
+/// Fills all the histograms of a RHistoBundle. The values of the columns are converted once per entry, and each
+/// slot fills plain arrays of bin contents, laid out one histogram after the other, which are added to the results
+/// at the end of the event loop.
+template <typename... ColumnTypes>
+class HistoBundleHelper {
+   // the statistics of TH1::GetStats and TH2::GetStats, followed by the number of entries
+   enum EStat { kSumw, kSumw2, kSumwx, kSumwx2, kSumwy, kSumwy2, kSumwxy, kEntries, kNStats };
+   struct RHisto {
+      RBundleAxis fXAxis;
+      RBundleAxis fYAxis;
+      bool fIs2D;
+      int fXColumn;
+      int fYColumn;
+      int fWColumn;
+      std::size_t fOffset; ///< Position of the bins of this histogram in the per-slot arrays
+   };
+
+   std::vector<std::shared_ptr<::TH1>> fResults;
+   std::vector<RHisto> fHistos;
+   std::vector<std::vector<double>> fSumw;  // one per slot
+   std::vector<std::vector<double>> fSumw2; // one per slot, only filled for weighted histograms
+   std::vector<std::vector<double>> fStats; // one per slot, kNStats per histogram
+
+public:
+   using ColumnTypes_t = TypeList<ColumnTypes...>;
+   HistoBundleHelper(const std::vector<std::shared_ptr<::TH1>> &results,
+                     const std::vector<RHistoBundle::RHistoSpec> &specs, const unsigned int nSlots)
+      : fResults(results), fStats(nSlots, std::vector<double>(kNStats * specs.size(), 0.))
+   {
+      std::size_t nCells = 0;
+      for (const auto &spec : specs) {
+         const auto is2D = spec.fModel->GetDimension() == 2;
+         fHistos.push_back({RBundleAxis(*spec.fModel->GetXaxis()), RBundleAxis(*spec.fModel->GetYaxis()), is2D,
+                            spec.fXColumn, spec.fYColumn, spec.fWColumn, nCells});
+         nCells += spec.fModel->GetNcells();
+      }
+      fSumw.assign(nSlots, std::vector<double>(nCells, 0.));
+      fSumw2.assign(nSlots, std::vector<double>(nCells, 0.));
+   }
+   HistoBundleHelper(HistoBundleHelper &&) = default;
+   HistoBundleHelper(const HistoBundleHelper &) = delete;
+   void InitSlot(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, const ColumnTypes &... values)
+   {
+      const double v[] = {static_cast<double>(values)...};
+      auto sumw = fSumw[slot].data();
+      auto sumw2 = fSumw2[slot].data();
+      auto stats = fStats[slot].data();
+      for (const auto &h : fHistos) {
+         const auto x = v[h.fXColumn];
+         const auto w = h.fWColumn < 0 ? 1. : v[h.fWColumn];
+         const auto binx = h.fXAxis.FindBin(x);
+         auto bin = binx;
+         auto isInRange = binx > 0 && binx <= h.fXAxis.GetNBins();
+         double y = 0.;
+         if (h.fIs2D) {
+            y = v[h.fYColumn];
+            const auto biny = h.fYAxis.FindBin(y);
+            bin += (h.fXAxis.GetNBins() + 2) * biny;
+            isInRange = isInRange && biny > 0 && biny <= h.fYAxis.GetNBins();
+         }
+         sumw[h.fOffset + bin] += w;
+         if (h.fWColumn >= 0)
+            sumw2[h.fOffset + bin] += w * w;
+         stats[kEntries] += 1.;
+         // like TH1::Fill, the statistics only account for the entries in the range of the axes
+         if (isInRange) {
+            stats[kSumw] += w;
+            stats[kSumw2] += w * w;
+            stats[kSumwx] += w * x;
+            stats[kSumwx2] += w * x * x;
+            stats[kSumwy] += w * y;
+            stats[kSumwy2] += w * y * y;
+            stats[kSumwxy] += w * x * y;
+         }
+         stats += kNStats;
+      }
+   }
+
+   void Initialize() { /* noop */}
+
+   void Finalize()
+   {
+      const auto nSlots = fSumw.size();
+      for (auto i = 0u; i < fHistos.size(); ++i) {
+         const auto &h = fHistos[i];
+         auto &res = *fResults[i];
+         const auto isWeighted = h.fWColumn >= 0;
+         if (isWeighted && res.GetSumw2N() == 0)
+            res.Sumw2();
+         auto contents = dynamic_cast<TArrayD &>(res).GetArray();
+         auto errors = res.GetSumw2N() > 0 ? res.GetSumw2()->GetArray() : nullptr;
+         for (auto slot = 0u; slot < nSlots; ++slot) {
+            const auto &slotSumw2 = isWeighted ? fSumw2[slot] : fSumw[slot]; // unit weights: sumw2 == sumw
+            for (auto bin = 0; bin < res.GetNcells(); ++bin) {
+               contents[bin] += fSumw[slot][h.fOffset + bin];
+               if (errors)
+                  errors[bin] += slotSumw2[h.fOffset + bin];
+            }
+         }
+         double stats[kNStats] = {};
+         for (auto slot = 0u; slot < nSlots; ++slot)
+            for (auto s = 0; s < kNStats; ++s)
+               stats[s] += fStats[slot][i * kNStats + s];
+         res.PutStats(stats);
+         res.SetEntries(stats[kEntries]);
+      }
+   }
+};
+
+// In case of the take helper we have 5 cases:
 // 1. The column is not an RVec, the collection is not a vector
 // 2. The column is not an RVec, the collection is a vector
 // 3. The column is an RVec, the collection is not a vector
 // 4. The column is an RVec, the collection is a vector
+// 5. The column is an RVec, the collection is a RJaggedArray
 
 // Case 1.: The column is not an RVec, the collection is not a vector
 // No optimisations, no transformations: just copies.
@@ -473,6 +620,40 @@ public:
    }
 };
 
+// Case 5.: The column is a RVec, the collection is a RJaggedArray
+// Optimisations, the values of all entries are stored in a single array
+template <typename RealT_t>
+class TakeHelper<RVec<RealT_t>, RVec<RealT_t>, ROOT::VecOps::RJaggedArray<RealT_t>> {
+   using Coll_t = ROOT::VecOps::RJaggedArray<RealT_t>;
+   std::vector<std::shared_ptr<Coll_t>> fColls;
+
+public:
+   using ColumnTypes_t = TypeList<RVec<RealT_t>>;
+   TakeHelper(const std::shared_ptr<Coll_t> &resultColl, const unsigned int nSlots)
+   {
+      fColls.emplace_back(resultColl);
+      for (unsigned int i = 1; i < nSlots; ++i)
+         fColls.emplace_back(std::make_shared<Coll_t>());
+   }
+   TakeHelper(TakeHelper &&) = default;
+   TakeHelper(const TakeHelper &) = delete;
+
+   void InitSlot(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, RVec<RealT_t> &av) { fColls[slot]->push_back(av); }
+
+   void Initialize() { /* noop */}
+
+   void Finalize()
+   {
+      auto rColl = fColls[0];
+      for (unsigned int i = 1; i < fColls.size(); ++i)
+         rColl->Append(*fColls[i]);
+   }
+
+   Coll_t &PartialUpdate(unsigned int slot) { return *fColls[slot]; }
+};
+
 template <typename ResultType>
 class MinHelper {
    const std::shared_ptr<ResultType> fResultMin;
@@ -857,6 +1038,212 @@ public:
    }
 };
 
+/// Helper object for a multi-thread Snapshot action which writes the entries of each task in a file owned by its
+/// slot, then copies the resulting clusters into the output tree without unzipping them
+template <typename... BranchTypes>
+class SnapshotHelperMTClusters {
+   using InputPosition_t = std::pair<std::size_t, Long64_t>; // index of an input file and entry number in that file
+
+   /// The clusters of a task, written in a slot file and waiting to be copied into the output tree
+   struct RTaskClusters {
+      InputPosition_t fFirstEntry;
+      unsigned int fSlot;
+      std::string fTreeName;
+   };
+
+   const unsigned int fNSlots;
+   const std::string fFileName;           // name of the output file name
+   const std::string fDirName;            // name of TFile subdirectory in which output must be written (possibly empty)
+   const std::string fTreeName;           // name of output tree
+   const RSnapshotOptions fOptions;       // struct holding options to pass down to TFile and TTree in this action
+   const ColumnNames_t fInputBranchNames; // This contains the resolved aliases
+   const ColumnNames_t fOutputBranchNames;
+   std::vector<std::string> fInputFileNames; // in the order of the input chain, to sort the tasks
+   std::unique_ptr<TFile> fOutputFile;
+   TTree *fOutputTree = nullptr; // owned by fOutputFile, created from the first task tree which is copied
+   std::vector<std::unique_ptr<TFile>> fSlotFiles;
+   std::vector<TTree *> fTaskTrees;  // owned by the slot files
+   std::vector<unsigned int> fNTasks; // number of tasks run by each slot, to name the task trees
+   std::vector<int> fIsFirstEvent;    // vector<bool> is evil
+   std::vector<InputPosition_t> fFirstEntries;
+   std::vector<TTree *> fInputTrees; // Current input trees. Set at initialization time (`InitSlot`)
+   std::vector<RTaskClusters> fPendingTasks; // tasks which wait for the end of the event loop to be copied
+   std::unique_ptr<std::mutex> fOutputMutex; // must use a ptr because std::mutex is not movable
+
+   std::string GetSlotFileName(unsigned int slot) const { return fFileName + ".slot" + std::to_string(slot); }
+
+   InputPosition_t GetInputPosition(TTree &inputTree) const
+   {
+      std::size_t fileIdx = 0;
+      auto chain = dynamic_cast<TChain *>(&inputTree);
+      if (chain && chain->GetTreeNumber() >= 0) {
+         const std::string fileName = chain->GetListOfFiles()->At(chain->GetTreeNumber())->GetTitle();
+         fileIdx = std::distance(fInputFileNames.begin(),
+                                 std::find(fInputFileNames.begin(), fInputFileNames.end(), fileName));
+      }
+      return {fileIdx, inputTree.GetTree()->GetReadEntry()};
+   }
+
+   // must be called with fOutputMutex locked, or outside of the event loop
+   void CopyClusters(TTree &taskTree)
+   {
+      if (!fOutputTree) {
+         auto outputDir = fOutputFile->GetDirectory(fDirName.c_str());
+         ::TDirectory::TContext c(outputDir);
+         fOutputTree = taskTree.CloneTree(0);
+         taskTree.GetListOfClones()->Remove(fOutputTree);
+         fOutputTree->ResetBranchAddresses();
+         fOutputTree->ResetBit(kMustCleanup);
+         fOutputTree->SetName(fTreeName.c_str());
+         fOutputTree->SetDirectory(outputDir);
+      }
+      // the baskets are copied as they are, the compression happened in the slot which filled the task tree
+      fOutputTree->CopyEntries(&taskTree, -1, "fast");
+   }
+
+public:
+   using ColumnTypes_t = TypeList<BranchTypes...>;
+   SnapshotHelperMTClusters(const unsigned int nSlots, std::string_view filename, std::string_view dirname,
+                            std::string_view treename, const ColumnNames_t &vbnames, const ColumnNames_t &bnames,
+                            const RSnapshotOptions &options, TTree *inputTree)
+      : fNSlots(nSlots), fFileName(filename), fDirName(dirname), fTreeName(treename), fOptions(options),
+        fInputBranchNames(vbnames), fOutputBranchNames(ReplaceDotWithUnderscore(bnames)), fSlotFiles(fNSlots),
+        fTaskTrees(fNSlots, nullptr), fNTasks(fNSlots, 0u), fIsFirstEvent(fNSlots, 1), fFirstEntries(fNSlots),
+        fInputTrees(fNSlots), fOutputMutex(new std::mutex())
+   {
+      if (auto chain = dynamic_cast<TChain *>(inputTree)) {
+         for (auto file : *chain->GetListOfFiles())
+            fInputFileNames.emplace_back(file->GetTitle());
+      }
+   }
+   SnapshotHelperMTClusters(const SnapshotHelperMTClusters &) = delete;
+   SnapshotHelperMTClusters(SnapshotHelperMTClusters &&) = default;
+
+   void InitSlot(TTreeReader *r, unsigned int slot)
+   {
+      ::TDirectory::TContext c; // do not let tasks change the thread-local gDirectory
+      if (!fSlotFiles[slot]) {
+         // the baskets of the slot files are compressed like the ones of the output, so that they can be copied as-is
+         fSlotFiles[slot].reset(TFile::Open(GetSlotFileName(slot).c_str(), "RECREATE", /*ftitle=*/"",
+                                            fOutputFile->GetCompressionSettings()));
+         if (!fSlotFiles[slot])
+            throw std::runtime_error("Snapshot: could not create the file " + GetSlotFileName(slot));
+      }
+      const auto taskTreeName = fTreeName + "_" + std::to_string(fNTasks[slot]++);
+      fTaskTrees[slot] =
+         new TTree(taskTreeName.c_str(), fTreeName.c_str(), fOptions.fSplitLevel, /*dir=*/fSlotFiles[slot].get());
+      fTaskTrees[slot]->ResetBit(kMustCleanup); // do not mingle with the thread-unsafe gListOfCleanups
+      if (fOptions.fAutoFlush)
+         fTaskTrees[slot]->SetAutoFlush(fOptions.fAutoFlush);
+      fInputTrees[slot] = r ? r->GetTree() : nullptr;
+      if (fInputTrees[slot]) {
+         // AddClone guarantees that if the input file changes the branches of the task tree are updated with the new
+         // addresses of the branch values
+         fInputTrees[slot]->AddClone(fTaskTrees[slot]);
+      }
+      fFirstEntries[slot] = InputPosition_t{0, 0};
+      fIsFirstEvent[slot] = 1;
+   }
+
+   void Exec(unsigned int slot, BranchTypes &... values)
+   {
+      if (fIsFirstEvent[slot]) {
+         using ind_t = std::index_sequence_for<BranchTypes...>;
+         SetBranches(slot, values..., ind_t());
+         if (fInputTrees[slot])
+            fFirstEntries[slot] = GetInputPosition(*fInputTrees[slot]);
+         fIsFirstEvent[slot] = 0;
+      }
+      fTaskTrees[slot]->Fill();
+   }
+
+   template <std::size_t... S>
+   void SetBranches(unsigned int slot, BranchTypes &... values, std::index_sequence<S...> /*dummy*/)
+   {
+      // hack to call TTree::Branch on all variadic template arguments
+      int expander[] = {(SetBranchesHelper(fInputTrees[slot], *fTaskTrees[slot], fInputBranchNames[S],
+                                           fOutputBranchNames[S], &values),
+                         0)...,
+                        0};
+      (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
+      (void)slot;     // avoid unused variable warnings in gcc6.2
+   }
+
+   void FinalizeTask(unsigned int slot)
+   {
+      auto taskTree = fTaskTrees[slot];
+      if (!taskTree)
+         return;
+      fTaskTrees[slot] = nullptr;
+      if (fInputTrees[slot])
+         fInputTrees[slot]->GetListOfClones()->Remove(taskTree);
+      if (taskTree->GetEntries() == 0) {
+         delete taskTree;
+         return;
+      }
+
+      {
+         ::TDirectory::TContext c(fSlotFiles[slot].get());
+         taskTree->Write(); // the last baskets of the task are compressed here, concurrently with the other slots
+      }
+      std::lock_guard<std::mutex> lock(*fOutputMutex);
+      if (fOptions.fPreserveEntryOrder)
+         fPendingTasks.push_back({fFirstEntries[slot], slot, taskTree->GetName()});
+      else
+         CopyClusters(*taskTree);
+      delete taskTree;
+   }
+
+   void Initialize()
+   {
+      const auto cs = ROOT::CompressionSettings(fOptions.fCompressionAlgorithm, fOptions.fCompressionLevel);
+      fOutputFile.reset(TFile::Open(fFileName.c_str(), fOptions.fMode.c_str(), /*ftitle=*/"", cs));
+      if (!fOutputFile)
+         throw std::runtime_error("Snapshot: could not create the file " + fFileName);
+      if (!fDirName.empty())
+         fOutputFile->mkdir(fDirName.c_str());
+   }
+
+   void Finalize()
+   {
+      if (!fOutputFile) {
+         Warning("Snapshot", "A lazy Snapshot action was booked but never triggered.");
+         return;
+      }
+
+      // sequential event loops (e.g. of a RDataFrame built before ROOT::EnableImplicitMT) run no tasks and never
+      // call FinalizeTask: their task tree is written here
+      for (auto slot = 0u; slot < fNSlots; ++slot)
+         FinalizeTask(slot);
+
+      // the tasks ran over disjoint ranges of entries, their first entries are enough to sort them
+      std::stable_sort(fPendingTasks.begin(), fPendingTasks.end(),
+                       [](const RTaskClusters &a, const RTaskClusters &b) { return a.fFirstEntry < b.fFirstEntry; });
+      for (const auto &task : fPendingTasks) {
+         std::unique_ptr<TTree> taskTree(static_cast<TTree *>(fSlotFiles[task.fSlot]->Get(task.fTreeName.c_str())));
+         CopyClusters(*taskTree);
+      }
+      fPendingTasks.clear();
+
+      auto outputDir = fOutputFile->GetDirectory(fDirName.c_str());
+      if (!fOutputTree) // no entry passed the selections, an empty tree is written nonetheless
+         fOutputTree = new TTree(fTreeName.c_str(), fTreeName.c_str(), fOptions.fSplitLevel, /*dir=*/outputDir);
+      {
+         ::TDirectory::TContext ctxt(outputDir);
+         fOutputTree->Write();
+      }
+      fOutputTree = nullptr;
+      fOutputFile.reset();
+
+      for (auto slot = 0u; slot < fNSlots; ++slot) {
+         if (fSlotFiles[slot]) {
+            fSlotFiles[slot].reset();
+            gSystem->Unlink(GetSlotFileName(slot).c_str());
+         }
+      }
+   }
+};
+
 template <typename Acc, typename Merge, typename R, typename T, typename U,
           bool MustCopyAssign = std::is_same<R, U>::value>
 class AggregateHelper {
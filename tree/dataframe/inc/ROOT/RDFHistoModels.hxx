@@ -11,9 +11,13 @@
 #ifndef ROOT_RDFHISTOMODELS
 #define ROOT_RDFHISTOMODELS
 
+#include <ROOT/RStringView.hxx>
 #include <TString.h>
 #include <memory>
+#include <string>
+#include <vector>
 
+class TH1;
 class TH1D;
 class TH2D;
 class TH3D;
@@ -153,6 +157,31 @@ struct TProfile2DModel {
    std::shared_ptr<::TProfile2D> GetProfile() const;
 };
 
+class RHistoBundle {
+public:
+   /// A histogram of the bundle. The column indices refer to GetColumnNames(), -1 meaning no column.
+   struct RHistoSpec {
+      std::shared_ptr<::TH1> fModel; ///< A TH1D or a TH2D, with fixed axis limits
+      int fXColumn;
+      int fYColumn;
+      int fWColumn;
+   };
+
+private:
+   std::vector<std::string> fColumnNames;
+   std::vector<RHistoSpec> fHistos;
+
+   int AddColumn(std::string_view name);
+
+public:
+   std::size_t Histo1D(const TH1DModel &model, std::string_view vName, std::string_view wName = "");
+   std::size_t Histo2D(const TH2DModel &model, std::string_view v1Name, std::string_view v2Name,
+                       std::string_view wName = "");
+   /// The distinct columns read by the histograms of the bundle, in order of first use
+   const std::vector<std::string> &GetColumnNames() const { return fColumnNames; }
+   const std::vector<RHistoSpec> &GetHistos() const { return fHistos; }
+};
+
 } // ns RDF
 
 } // ns ROOT
@@ -35,6 +35,7 @@
 #include "ROOT/RDFUtils.hxx"
 #include "ROOT/RDataSource.hxx"
 #include "ROOT/RLazyDSImpl.hxx"
+#include "ROOT/RProfileReport.hxx"
 #include "ROOT/RResultPtr.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
 #include "ROOT/TypeTraits.hxx"
@@ -721,6 +722,8 @@ public:
    /// \param[in] column The name of the column to collect the values of.
    ///
    /// The collection type to be specified for C-style array columns is `RVec<T>`.
+   /// The values of a column of type `RVec<T>` can be collected in a `ROOT::VecOps::RJaggedArray<T>`, which stores
+   /// them in a single array together with the offsets of the entries.
    /// This action is *lazy*: upon invocation of this method the calculation is
    /// booked but not executed. See RResultPtr documentation.
    template <typename T, typename COLL = std::vector<T>>
@@ -1123,6 +1126,96 @@ public:
       return Profile2D<V1, V2, V3, W>(model, "", "", "", "");
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Fill and return all the histograms of a bundle in a single action (*lazy action*)
+   /// \tparam ColumnTypes The types of the columns of the bundle, in the order of RHistoBundle::GetColumnNames().
+   /// \param[in] bundle The histograms to fill and the columns that fill them.
+   ///
+   /// Booking hundreds of Histo1D and Histo2D on the same node costs one action call and one set of virtual column
+   /// reads per histogram and entry, as well as one copy of each histogram per slot. A bundle is filled by a single
+   /// action instead: each column it needs is read once per entry, and each slot fills compact arrays of bin contents
+   /// which are added to the results at the end of the event loop.
+   /// The columns must be convertible to double: collections are not supported.
+   ///
+   /// The returned vector holds the histograms in the order in which they were added to the bundle.
+   /// This action is *lazy*: upon invocation of this method the calculation is
+   /// booked but not executed. See RResultPtr documentation.
+   template <typename... ColumnTypes>
+   std::vector<RResultPtr<::TH1>> HistoBundle(const RHistoBundle &bundle)
+   {
+      const auto &columns = bundle.GetColumnNames();
+      RDFInternal::CheckTypesAndPars(sizeof...(ColumnTypes), columns.size());
+      auto lm = GetLoopManager();
+      const auto validCols = GetValidatedColumnNames(columns.size(), columns);
+      if (fDataSource)
+         RDFInternal::DefineDataSourceColumns(validCols, *lm, *fDataSource, std::index_sequence_for<ColumnTypes...>(),
+                                              TTraits::TypeList<ColumnTypes...>());
+
+      std::vector<std::shared_ptr<::TH1>> results;
+      for (const auto &spec : bundle.GetHistos()) {
+         std::shared_ptr<::TH1> h(static_cast<::TH1 *>(spec.fModel->Clone()));
+         h->SetDirectory(nullptr);
+         results.emplace_back(std::move(h));
+      }
+      using Helper_t = RDFInternal::HistoBundleHelper<ColumnTypes...>;
+      using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
+      auto action =
+         std::make_shared<Action_t>(Helper_t(results, bundle.GetHistos(), lm->GetNSlots()), validCols, *fProxiedPtr);
+      lm->Book(action);
+      std::vector<RResultPtr<::TH1>> resultPtrs;
+      for (const auto &h : results)
+         resultPtrs.emplace_back(MakeResultPtr(h, lm, action.get()));
+      return resultPtrs;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Fill and return all the histograms of a bundle in a single action (*lazy action*)
+   /// \param[in] bundle The histograms to fill and the columns that fill them.
+   ///
+   /// The types of the columns are automatically inferred and do not need to be specified.
+   /// See the description of the first HistoBundle overload for more details.
+   std::vector<RResultPtr<::TH1>> HistoBundle(const RHistoBundle &bundle)
+   {
+      auto df = GetLoopManager();
+      const auto &columns = bundle.GetColumnNames();
+      std::vector<RResultPtr<::TH1>> resultPtrs;
+      if (columns.empty())
+         return resultPtrs;
+
+      auto tree = df->GetTree();
+      const auto nsID = df->GetID();
+      std::stringstream bundleCall;
+      auto upcastNode = RDFInternal::UpcastNode(fProxiedPtr);
+      RInterface<TTraits::TakeFirstParameter_t<decltype(upcastNode)>> upcastInterface(fProxiedPtr, fImplWeakPtr,
+                                                                                      fValidCustomColumns, fBranchNames,
+                                                                                      fDataSource);
+      // build a string equivalent to
+      // "*(vector<RResultPtr<TH1>>*)(&resultPtrs) = (RInterface<nodetype*>*)(this)->HistoBundle<Ts...>(bundle)"
+      bundleCall << "*reinterpret_cast<std::vector<ROOT::RDF::RResultPtr<TH1>>*>(" << std::hex << std::showbase
+                 << (size_t)&resultPtrs << ") = reinterpret_cast<ROOT::RDF::RInterface<"
+                 << upcastInterface.GetNodeTypeName() << ">*>(" << std::hex << std::showbase
+                 << (size_t)&upcastInterface << ")->HistoBundle<";
+
+      const auto &customCols = df->GetCustomColumnNames();
+      const auto dontConvertVector = false;
+      const auto validCols = GetValidatedColumnNames(columns.size(), columns);
+      for (auto &c : validCols) {
+         const auto isCustom = std::find(customCols.begin(), customCols.end(), c) != customCols.end();
+         bundleCall << RDFInternal::ColumnName2ColumnTypeName(c, nsID, tree, fDataSource, isCustom, dontConvertVector)
+                    << ", ";
+      };
+      bundleCall.seekp(-2, bundleCall.cur); // remove the last ",
+      bundleCall << ">(*reinterpret_cast<ROOT::RDF::RHistoBundle*>(" << std::hex << std::showbase << (size_t)&bundle
+                 << "));";
+      TInterpreter::EErrorCode errorCode;
+      gInterpreter->Calc(bundleCall.str().c_str(), &errorCode);
+      if (TInterpreter::EErrorCode::kNoError != errorCode) {
+         std::string msg = "Cannot jit HistoBundle call. Interpreter error code is " + std::to_string(errorCode) + ".";
+         throw std::runtime_error(msg);
+      }
+      return resultPtrs;
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Return an object of type T on which `T::Fill` will be called once per event (*lazy action*)
    ///
@@ -1288,6 +1381,26 @@ public:
       return MakeResultPtr(rep, lm, action.get());
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Profile the next event loop
+   ///
+   /// The next event loop of the computation graph this node belongs to records the time spent in each of its
+   /// nodes, in the reads of each column of the dataset together with the bytes they loaded, by each slot in its
+   /// tasks, and in jitting. The whole graph is profiled, whichever node this method is called on. The report can
+   /// be printed, or saved in the format of chrome://tracing with RProfileReport::SaveChromeTrace.
+   ///
+   /// Profiling has a cost: it measures time around every evaluation of every node.
+   ///
+   /// The profile is *lazy*: like an action, upon invocation of this method the profiling is requested but the
+   /// event loop is not run. Callbacks cannot be registered on the returned RResultPtr.
+   RResultPtr<RProfileReport> Profile()
+   {
+      auto lm = GetLoopManager();
+      auto report = std::make_shared<RProfileReport>();
+      lm->AddProfileReport(report);
+      return MakeResultPtr(report, lm, /*actionPtr=*/nullptr);
+   }
+
    /////////////////////////////////////////////////////////////////////////////
    /// \brief Returns the names of the available columns
    ///
@@ -1664,6 +1777,13 @@ private:
          using Action_t = RDFInternal::RAction<Helper_t, Proxied, TTraits::TypeList<ColumnTypes...>>;
          actionPtr.reset(new Action_t(Helper_t(filename, dirname, treename, validCols, columnList, options), validCols,
                                       *fProxiedPtr));
+      } else if (options.fSlotClusters) {
+         // multi-thread snapshot, each slot compresses its own clusters
+         using Helper_t = RDFInternal::SnapshotHelperMTClusters<ColumnTypes...>;
+         using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
+         actionPtr.reset(new Action_t(Helper_t(lm->GetNSlots(), filename, dirname, treename, validCols, columnList,
+                                               options, lm->GetTree()),
+                                      validCols, *fProxiedPtr));
       } else {
          // multi-thread snapshot
          using Helper_t = RDFInternal::SnapshotHelperMT<ColumnTypes...>;
@@ -215,6 +215,9 @@ void CheckCustomColumn(std::string_view definedCol, TTree *treePtr, const Column
 
 using TmpBranchBasePtr_t = std::shared_ptr<RCustomColumnBase>;
 
+std::vector<ROOT::RDF::RColumnRange> FindColumnRanges(std::string_view expression, const ColumnNames_t &dsColumns,
+                                                      const std::map<std::string, std::string> &aliasMap);
+
 void BookFilterJit(RJittedFilter *jittedFilter, void *prevNode, std::string_view prevNodeTypeName,
                    std::string_view name, std::string_view expression,
                    const std::map<std::string, std::string> &aliasMap, const ColumnNames_t &branches,
@@ -260,9 +263,22 @@ template <typename T>
 void DefineDSColumnHelper(std::string_view name, RLoopManager &lm, RDataSource &ds)
 {
    auto readers = ds.GetColumnReaders<T>(name);
-   auto getValue = [readers](unsigned int slot) { return *readers[slot]; };
-   using NewCol_t = RCustomColumn<decltype(getValue), TCCHelperTypes::TSlot>;
-   lm.Book(std::make_shared<NewCol_t>(name, std::move(getValue), ColumnNames_t{}, &lm, /*isDSColumn=*/true));
+   if (ds.SetColumnLazy(name)) {
+      // the data source loads the value only when it is requested: RCustomColumn does so at most once per entry
+      const auto &dsColumns = ds.GetColumnNames();
+      const std::size_t colIdx = std::distance(dsColumns.begin(), std::find(dsColumns.begin(), dsColumns.end(), name));
+      auto dsPtr = &ds;
+      auto getValue = [readers, dsPtr, colIdx](unsigned int slot) {
+         dsPtr->LoadColumnValue(slot, colIdx);
+         return *readers[slot];
+      };
+      using NewCol_t = RCustomColumn<decltype(getValue), TCCHelperTypes::TSlot>;
+      lm.Book(std::make_shared<NewCol_t>(name, std::move(getValue), ColumnNames_t{}, &lm, /*isDSColumn=*/true));
+   } else {
+      auto getValue = [readers](unsigned int slot) { return *readers[slot]; };
+      using NewCol_t = RCustomColumn<decltype(getValue), TCCHelperTypes::TSlot>;
+      lm.Book(std::make_shared<NewCol_t>(name, std::move(getValue), ColumnNames_t{}, &lm, /*isDSColumn=*/true));
+   }
    lm.AddCustomColumnName(name);
    lm.AddDataSourceColumn(name);
 }
@@ -0,0 +1,100 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_JAGGEDARRAY
+#define ROOT_RDF_JAGGEDARRAY
+
+#include "ROOT/RJaggedArray.hxx"
+#include "ROOT/RStringView.hxx"
+#include "RtypesCore.h"
+#include "TBuffer.h"
+
+#include <typeinfo>
+
+class TBasket;
+class TBranch;
+class TTree;
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Walks a range of entries of a branch holding a collection of fundamental values in the buffers of its baskets,
+/// without streaming the entries into objects. The branches supported are the ones whose entries are the values
+/// one after the other, stored with the byte order of the file:
+/// - leaf lists with one array leaf, e.g. `x[n]/F`
+/// - the data members of the objects of a split TClonesArray or STL collection, e.g. `tracks.fPx`
+/// - std::vector of a fundamental type, in which case the values of each entry follow a version and a size
+class RJaggedBranchEntries {
+   TBranch *fBranch = nullptr;
+   bool fHasHeader = false;
+   Int_t fValueSize = 0;
+   Long64_t fEntry = 0;    ///< The entry that the next call to Next moves to, in the tree of the branch
+   Long64_t fEndEntry = 0;
+   TBasket *fBasket = nullptr;
+   Long64_t fBasketFirstEntry = 0;
+   Long64_t fBasketEndEntry = 0;
+   Int_t fEntryBegin = 0; ///< The position of the current entry in the buffer of fBasket
+   Int_t fEntryEnd = 0;
+
+   void LoadBasket();
+
+public:
+   /// Throws if the branch does not exist or does not hold values of the given type in a supported layout. If the
+   /// tree is a TChain, begin and end are entries of the chain, and must belong to one of its trees.
+   RJaggedBranchEntries(TTree &tree, std::string_view branchName, const std::type_info &valueType, Long64_t begin,
+                        Long64_t end);
+   Long64_t GetNEntries() const { return fEndEntry - fEntry; }
+   /// Go to the next entry of the range, returning false past its end
+   bool Next();
+   /// The number of values of the current entry: the buffer is then positioned at the first one
+   UInt_t ReadNValues();
+   TBuffer &GetBuffer();
+};
+
+} // namespace RDF
+} // namespace Internal
+
+namespace RDF {
+
+////////////////////////////////////////////////////////////////////////////
+/// \brief Read the values of a collection branch for a range of entries into a RJaggedArray
+/// \tparam T The type of the values, e.g. `float` for a `vector<float>` branch
+/// \param[in] tree The tree or chain to read from
+/// \param[in] branchName The branch holding the collections
+/// \param[in] begin The first entry of the range
+/// \param[in] end One past the last entry of the range; -1 means the end of the tree containing `begin`
+///
+/// The values are copied from the basket buffers of the branch into the content of the RJaggedArray, and the
+/// offsets are computed from the sizes of the entries in the baskets, without creating one collection per entry.
+/// This is meant to read a whole cluster at a time, as delimited by TTree::GetClusterIterator. The supported
+/// branches are listed in ROOT::Internal::RDF::RJaggedBranchEntries; an exception is thrown for the others, and if
+/// the type of the values is not T.
+template <typename T>
+ROOT::VecOps::RJaggedArray<T> ReadJaggedArray(TTree &tree, std::string_view branchName, Long64_t begin = 0,
+                                              Long64_t end = -1)
+{
+   ROOT::Internal::RDF::RJaggedBranchEntries entries(tree, branchName, typeid(T), begin, end);
+   ROOT::VecOps::RVec<T> content;
+   typename ROOT::VecOps::RJaggedArray<T>::Offsets_t offsets;
+   offsets.reserve(entries.GetNEntries() + 1);
+   offsets.emplace_back(0u);
+   while (entries.Next()) {
+      const auto nValues = entries.ReadNValues();
+      const auto size = content.size();
+      content.resize(size + nValues);
+      entries.GetBuffer().ReadFastArray(content.data() + size, nValues);
+      offsets.emplace_back(content.size());
+   }
+   return ROOT::VecOps::RJaggedArray<T>(std::move(content), std::move(offsets));
+}
+
+} // namespace RDF
+} // namespace ROOT
+
+#endif
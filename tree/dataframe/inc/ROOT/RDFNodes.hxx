@@ -19,6 +19,7 @@
 #include "ROOT/RCutFlowReport.hxx"
 #include "ROOT/RDataSource.hxx"
 #include "ROOT/RDFNodesUtils.hxx"
+#include "ROOT/RDFProfiler.hxx"
 #include "ROOT/RDFUtils.hxx"
 #include "ROOT/RVec.hxx"
 #include "ROOT/TSpinMutex.hxx"
@@ -153,6 +154,13 @@ class RLoopManager {
    std::map<std::string, std::string> fAliasColumnNameMap; ///< ColumnNameAlias-columnName pairs
    std::vector<TCallback> fCallbacks;                      ///< Registered callbacks
    std::vector<TOneTimeCallback> fCallbacksOnce; ///< Registered callbacks to invoke just once before running the loop
+   /// Filters hanging from this object that are equivalent to selections on data-source columns
+   std::vector<std::pair<RFilterBase *, std::vector<ROOT::RDF::RColumnRange>>> fDSColumnRanges;
+   ColumnNames_t fEagerColumns; ///< Columns read for every entry, i.e. not only downstream of a filter or a range
+   bool fHasLazyColumns{false}; ///< Whether some columns are only read downstream of a filter or a range
+   /// Reports to fill at the end of the next event loop. If there are any, that event loop is profiled.
+   std::vector<std::shared_ptr<ROOT::RDF::RProfileReport>> fProfileReports;
+   std::unique_ptr<RDFInternal::RLoopProfiler> fProfiler; ///< Only set during a profiled event loop
    /// A unique ID that identifies the computation graph that starts with this RLoopManager.
    /// Used, for example, to jit objects in a namespace reserved for this computation graph
    const unsigned int fID = GetNextID();
@@ -170,6 +178,10 @@ class RLoopManager {
    void CleanUpTask(unsigned int slot);
    void JitActions();
    void EvalChildrenCounts();
+   void PushDownColumnRanges();
+   void EvalEagerColumns();
+   void SetupTreeCache(TTree &tree, int &treeNumber);
+   void SetupProfiler();
    unsigned int GetNextID() const;
 
 public:
@@ -209,7 +221,14 @@ public:
    void AddCustomColumnName(std::string_view name) { fCustomColumnNames.emplace_back(name); }
    const std::map<std::string, std::string> &GetAliasMap() const { return fAliasColumnNameMap; }
    void RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f);
+   void AddDataSourceColumnRanges(RFilterBase *filter, std::vector<ROOT::RDF::RColumnRange> &&ranges);
    unsigned int GetID() const { return fID; }
+   /// Profile the next event loop, and fill `report` at its end
+   void AddProfileReport(const std::shared_ptr<ROOT::RDF::RProfileReport> &report)
+   {
+      fProfileReports.emplace_back(report);
+   }
+   RDFInternal::RLoopProfiler *GetProfiler() const { return fProfiler.get(); }
 };
 } // end ns RDF
 } // end ns Detail
@@ -260,6 +279,8 @@ class TColumnValue {
 
    /// Owning ptrs to a TTreeReaderValue or TTreeReaderArray. Only used for Tree columns.
    std::vector<std::unique_ptr<TreeReader_t>> fTreeReaders;
+   /// The profiling state of each element of fTreeReaders, inactive unless the event loop is profiled
+   std::vector<RColumnReadProfile> fReadProfiles;
    /// Non-owning ptrs to the value of a custom column.
    std::vector<T *> fCustomValuePtrs;
    /// Non-owning ptrs to the value of a data-source column.
@@ -282,10 +303,11 @@ public:
 
    void SetTmpColumn(unsigned int slot, RCustomColumnBase *tmpColumn);
 
-   void MakeProxy(TTreeReader *r, const std::string &bn)
+   void MakeProxy(TTreeReader *r, const std::string &bn, unsigned int slot, RLoopProfiler *profiler)
    {
       fColumnKind = EColumnKind::kTree;
       fTreeReaders.emplace_back(new TreeReader_t(*r, bn.c_str()));
+      fReadProfiles.emplace_back(profiler, slot, r, bn);
    }
 
    /// This overload is used to return scalar quantities (i.e. types that are not read into a RVec)
@@ -300,7 +322,10 @@ public:
    void Reset()
    {
       switch (fColumnKind) {
-      case EColumnKind::kTree: fTreeReaders.pop_back(); break;
+      case EColumnKind::kTree:
+         fTreeReaders.pop_back();
+         fReadProfiles.pop_back();
+         break;
       case EColumnKind::kCustomColumn:
          fCustomColumns.pop_back();
          fCustomValuePtrs.pop_back();
@@ -341,6 +366,8 @@ protected:
                                /// graph. It is only guaranteed to contain a valid address during an
                                /// event loop.
    const unsigned int fNSlots; ///< Number of thread slots used by this node.
+   RLoopProfiler *fProfiler = nullptr; ///< Only set during a profiled event loop
+   unsigned int fProfileId = 0;
 
 public:
    RActionBase(RLoopManager *implPtr, const unsigned int nSlots);
@@ -353,9 +380,21 @@ public:
    virtual void InitSlot(TTreeReader *r, unsigned int slot) = 0;
    virtual void TriggerChildrenCount() = 0;
    virtual void ClearValueReaders(unsigned int slot) = 0;
+   /// This method is invoked at the end of each task of a multi-thread event loop, while its input is still loaded
+   virtual void FinalizeTask(unsigned int slot) = 0;
    /// This method is invoked to update a partial result during the event loop, right before passing the result to a
    /// user-defined callback registered via RResultPtr::RegisterCallback
    virtual void *PartialUpdate(unsigned int slot) = 0;
+   virtual const ColumnNames_t &GetColumnNames() const = 0;
+   /// Whether this action runs on all entries, i.e. no filter or range is upstream of it
+   virtual bool HangsFromLoopManager() const = 0;
+   /// The name of the action in profile reports
+   virtual std::string GetProfileName() const = 0;
+   void SetProfiler(RLoopProfiler *profiler, unsigned int id)
+   {
+      fProfiler = profiler;
+      fProfileId = id;
+   }
 };
 
 template <typename Helper, typename PrevDataFrame, typename ColumnTypes_t = typename Helper::ColumnTypes_t>
@@ -383,15 +422,17 @@ public:
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
       InitRDFValues(slot, fValues[slot], r, fBranches, fLoopManager->GetCustomColumnNames(),
-                    fLoopManager->GetBookedColumns(), TypeInd_t());
+                    fLoopManager->GetBookedColumns(), fLoopManager->GetProfiler(), TypeInd_t());
       fHelper.InitSlot(r, slot);
    }
 
    void Run(unsigned int slot, Long64_t entry) final
    {
       // check if entry passes all filters
-      if (fPrevData.CheckFilters(slot, entry))
+      if (fPrevData.CheckFilters(slot, entry)) {
+         RProfileScope profileScope(fProfiler, slot, RLoopProfiler::EScopeKind::kNode, fProfileId);
          Exec(slot, entry, TypeInd_t());
+      }
    }
 
    template <std::size_t... S>
@@ -405,6 +446,17 @@ public:
 
    virtual void ClearValueReaders(unsigned int slot) final { ResetRDFValueTuple(fValues[slot], TypeInd_t()); }
 
+   void FinalizeTask(unsigned int slot) final { FinalizeTaskImpl(slot); }
+
+   const ColumnNames_t &GetColumnNames() const final { return fBranches; }
+
+   bool HangsFromLoopManager() const final { return std::is_same<PrevDataFrame, RLoopManager>::value; }
+
+   std::string GetProfileName() const final
+   {
+      return GetProfileNodeName(typeid(Helper), fBranches);
+   }
+
    /// This method is invoked to update a partial result during the event loop, right before passing the result to a
    /// user-defined callback registered via RResultPtr::RegisterCallback
    /// TODO the PartialUpdateImpl trick can go away once all action helpers will implement PartialUpdate
@@ -420,6 +472,15 @@ private:
    }
    // this one is always available but has lower precedence thanks to `...`
    void *PartialUpdateImpl(...) { throw std::runtime_error("This action does not support callbacks yet!"); }
+
+   // this overload is SFINAE'd out if Helper does not implement `FinalizeTask`
+   template <typename H = Helper>
+   auto FinalizeTaskImpl(unsigned int slot) -> decltype(std::declval<H>().FinalizeTask(slot), void())
+   {
+      fHelper.FinalizeTask(slot);
+   }
+   // most helpers have nothing to do at the end of a task
+   void FinalizeTaskImpl(...) {}
 };
 
 } // end NS RDF
@@ -438,6 +499,8 @@ protected:
    const unsigned int fNSlots;      ///< number of thread slots used by this node, inherited from parent node.
    const bool fIsDataSourceColumn; ///< does the custom column refer to a data-source column? (or a user-define column?)
    std::vector<Long64_t> fLastCheckedEntry;
+   RDFInternal::RLoopProfiler *fProfiler = nullptr; ///< Only set during a profiled event loop
+   unsigned int fProfileId = 0; ///< Id of the node, or of the column for data-source columns
 
 public:
    RCustomColumnBase(RLoopManager *df, std::string_view name, const unsigned int nSlots, const bool isDSColumn);
@@ -450,8 +513,15 @@ public:
    std::string GetName() const;
    virtual void Update(unsigned int slot, Long64_t entry) = 0;
    virtual void ClearValueReaders(unsigned int slot) = 0;
+   /// The columns that the expression of this custom column reads
+   virtual const ColumnNames_t &GetColumnNames() const = 0;
    bool IsDataSourceColumn() const { return fIsDataSourceColumn; }
    void InitNode();
+   void SetProfiler(RDFInternal::RLoopProfiler *profiler, unsigned int id)
+   {
+      fProfiler = profiler;
+      fProfileId = id;
+   }
 };
 
 // clang-format off
@@ -501,7 +571,7 @@ public:
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
       RDFInternal::InitRDFValues(slot, fValues[slot], r, fBranches, fLoopManager->GetCustomColumnNames(),
-                                 fLoopManager->GetBookedColumns(), TypeInd_t());
+                                 fLoopManager->GetBookedColumns(), fLoopManager->GetProfiler(), TypeInd_t());
    }
 
    void *GetValuePtr(unsigned int slot) final { return static_cast<void *>(&fLastResults[slot]); }
@@ -510,6 +580,10 @@ public:
    {
       if (entry != fLastCheckedEntry[slot]) {
          // evaluate this filter, cache the result
+         using EScopeKind = RDFInternal::RLoopProfiler::EScopeKind;
+         RDFInternal::RProfileScope profileScope(fProfiler, slot,
+                                                 fIsDataSourceColumn ? EScopeKind::kColumn : EScopeKind::kNode,
+                                                 fProfileId);
          UpdateHelper(slot, entry, TypeInd_t(), ColumnTypes_t(), (UPDATE_HELPER_TYPE *)nullptr);
          fLastCheckedEntry[slot] = entry;
       }
@@ -551,6 +625,8 @@ public:
    }
 
    void ClearValueReaders(unsigned int slot) final { RDFInternal::ResetRDFValueTuple(fValues[slot], TypeInd_t()); }
+
+   const ColumnNames_t &GetColumnNames() const final { return fBranches; }
 };
 
 class RFilterBase {
@@ -565,6 +641,8 @@ protected:
    unsigned int fNChildren{0};      ///< Number of nodes of the functional graph hanging from this object
    unsigned int fNStopsReceived{0}; ///< Number of times that a children node signaled to stop processing entries.
    const unsigned int fNSlots;      ///< Number of thread slots used by this node, inherited from parent node.
+   RDFInternal::RLoopProfiler *fProfiler = nullptr; ///< Only set during a profiled event loop
+   unsigned int fProfileId = 0;
 
 public:
    RFilterBase(RLoopManager *df, std::string_view name, const unsigned int nSlots);
@@ -586,6 +664,7 @@ public:
       fNStopsReceived = 0;
    }
    virtual void TriggerChildrenCount() = 0;
+   virtual bool HasChildren() const { return fNChildren > 0; }
    virtual void ResetReportCount()
    {
       assert(!fName.empty()); // this method is to only be called on named filters
@@ -595,6 +674,16 @@ public:
    }
    virtual void ClearValueReaders(unsigned int slot) = 0;
    virtual void InitNode();
+   virtual const ColumnNames_t &GetColumnNames() const = 0;
+   /// Whether this filter is evaluated for all entries, i.e. no other filter or range is upstream of it
+   virtual bool HangsFromLoopManager() const = 0;
+   /// The name of the filter in profile reports
+   std::string GetProfileName() const;
+   virtual void SetProfiler(RDFInternal::RLoopProfiler *profiler, unsigned int id)
+   {
+      fProfiler = profiler;
+      fProfileId = id;
+   }
 };
 
 /// A wrapper around a concrete RFilter, which forwards all calls to it
@@ -619,9 +708,13 @@ public:
    void StopProcessing() override final;
    void ResetChildrenCount() override final;
    void TriggerChildrenCount() override final;
+   bool HasChildren() const override final;
    void ResetReportCount() override final;
    void ClearValueReaders(unsigned int slot) override final;
    void InitNode() override final;
+   const ColumnNames_t &GetColumnNames() const override final;
+   bool HangsFromLoopManager() const override final;
+   void SetProfiler(RDFInternal::RLoopProfiler *profiler, unsigned int id) override final;
 };
 
 template <typename FilterF, typename PrevDataFrame>
@@ -652,6 +745,8 @@ public:
             fLastResult[slot] = false;
          } else {
             // evaluate this filter, cache the result
+            RDFInternal::RProfileScope profileScope(fProfiler, slot, RDFInternal::RLoopProfiler::EScopeKind::kNode,
+                                                    fProfileId);
             auto passed = CheckFilterHelper(slot, entry, TypeInd_t());
             passed ? ++fAccepted[slot] : ++fRejected[slot];
             fLastResult[slot] = passed;
@@ -673,7 +768,7 @@ public:
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
       RDFInternal::InitRDFValues(slot, fValues[slot], r, fBranches, fLoopManager->GetCustomColumnNames(),
-                                 fLoopManager->GetBookedColumns(), TypeInd_t());
+                                 fLoopManager->GetBookedColumns(), fLoopManager->GetProfiler(), TypeInd_t());
    }
 
    // recursive chain of `Report`s
@@ -710,6 +805,10 @@ public:
    {
       RDFInternal::ResetRDFValueTuple(fValues[slot], TypeInd_t());
    }
+
+   const ColumnNames_t &GetColumnNames() const final { return fBranches; }
+
+   bool HangsFromLoopManager() const final { return std::is_same<PrevDataFrame, RLoopManager>::value; }
 };
 
 class RRangeBase {
@@ -846,6 +945,7 @@ template <typename U, typename std::enable_if<!TColumnValue<U>::fgMustUseRVec, i
 T &TColumnValue<T, B>::Get(Long64_t entry)
 {
    if (fColumnKind == EColumnKind::kTree) {
+      RColumnReadScope profileScope(fReadProfiles.back());
       return *(fTreeReaders.back()->Get());
    } else {
       fCustomColumns.back()->Update(fSlot, entry);
@@ -859,6 +959,7 @@ template <typename U, typename std::enable_if<TColumnValue<U>::fgMustUseRVec, in
 T &TColumnValue<T, B>::Get(Long64_t entry)
 {
    if (fColumnKind == EColumnKind::kTree) {
+      RColumnReadScope profileScope(fReadProfiles.back());
       auto &readerArray = *fTreeReaders.back();
       // We only use TTreeReaderArrays to read columns that users flagged as type `RVec`, so we need to check
       // that the branch stores the array as contiguous memory that we can actually wrap in an `RVec`.
@@ -11,6 +11,7 @@
 #ifndef ROOT_RDFNODES_UTILS
 #define ROOT_RDFNODES_UTILS
 
+#include "ROOT/RDFProfiler.hxx"
 #include "ROOT/RIntegerSequence.hxx"
 #include "ROOT/RVec.hxx"
 #include "ROOT/RDFUtils.hxx" // ColumnNames_t
@@ -45,7 +46,7 @@ template <typename RDFValueTuple, std::size_t... S>
 void InitRDFValues(unsigned int slot, RDFValueTuple &valueTuple, TTreeReader *r, const ColumnNames_t &bn,
                    const ColumnNames_t &tmpbn,
                    const std::map<std::string, std::shared_ptr<RCustomColumnBase>> &customCols,
-                   std::index_sequence<S...>)
+                   RLoopProfiler *profiler, std::index_sequence<S...>)
 {
    // isTmpBranch has length bn.size(). Elements are true if the corresponding
    // branch is a temporary branch created with Define, false if they are
@@ -58,12 +59,13 @@ void InitRDFValues(unsigned int slot, RDFValueTuple &valueTuple, TTreeReader *r,
    // The statement defines a variable with type std::initializer_list<int>, containing all zeroes, and SetTmpColumn or
    // SetProxy are conditionally executed as the braced init list is expanded. The final ... expands S.
    int expander[] = {(isTmpColumn[S] ? std::get<S>(valueTuple).SetTmpColumn(slot, customCols.at(bn.at(S)).get())
-                                     : std::get<S>(valueTuple).MakeProxy(r, bn.at(S)),
+                                     : std::get<S>(valueTuple).MakeProxy(r, bn.at(S), slot, profiler),
                       0)...,
                      0};
    (void)expander; // avoid "unused variable" warnings for expander on gcc4.9
    (void)slot;     // avoid _bogus_ "unused variable" warnings for slot on gcc 4.9
    (void)r;        // avoid "unused variable" warnings for r on gcc5.2
+   (void)profiler;
 }
 
 } // namespace RDF
@@ -0,0 +1,169 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDFPROFILER
+#define ROOT_RDFPROFILER
+
+#include "ROOT/RProfileReport.hxx"
+#include "ROOT/RStringView.hxx"
+#include "RtypesCore.h"
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+class TBranch;
+class TTree;
+class TTreeReader;
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/**
+\class ROOT::Internal::RDF::RLoopProfiler
+\ingroup dataframe
+\brief Records where the time of an event loop goes, for RInterface::Profile
+
+The RLoopManager creates one for the event loops in which a profile is requested, and hands it to the nodes.
+Nodes and column readers wrap their work in RProfileScopes: the scopes of a slot form a stack, so that the time of
+a scope can be accounted to its node or column excluding the time of the scopes nested in it, e.g. the reading of
+the columns a Define needs.
+
+Nodes and columns must be registered before the event loop starts. The other methods taking a slot are called
+during the event loop, concurrently for different slots.
+**/
+class RLoopProfiler {
+public:
+   using Clock_t = std::chrono::steady_clock;
+   enum class EScopeKind { kNode, kColumn };
+
+private:
+   struct RScope {
+      Clock_t::time_point fStart;
+      Clock_t::duration fNested; ///< Time spent in the scopes opened within this one
+   };
+   /// Everything that one slot records, so that slots never share data during the event loop
+   struct RSlotRecord {
+      std::vector<RScope> fScopes;
+      std::vector<Clock_t::duration> fNodeTimes;
+      std::vector<ULong64_t> fNodeCalls;
+      std::vector<Clock_t::duration> fColumnTimes;
+      std::vector<ULong64_t> fColumnReads;
+      std::vector<ULong64_t> fColumnBytes;
+      std::vector<std::pair<Clock_t::time_point, Clock_t::time_point>> fTasks;
+      bool fIsInTask = false;
+   };
+
+   std::vector<std::string> fNodeNames;
+   std::vector<std::string> fColumnNames;
+   std::map<std::string, unsigned int> fColumnIds;
+   std::vector<RSlotRecord> fSlots;
+   Clock_t::duration fJitTime{0};
+   Clock_t::time_point fLoopStart;
+   Clock_t::time_point fLoopEnd;
+
+public:
+   RLoopProfiler(unsigned int nSlots) : fSlots(nSlots) {}
+
+   unsigned int AddNode(const std::string &name);
+   unsigned int AddColumn(const std::string &name);
+   /// Return the id of a registered column, or -1
+   int FindColumn(const std::string &name) const;
+
+   void AddJitTime(Clock_t::duration t) { fJitTime += t; }
+   void StartLoop() { fLoopStart = Clock_t::now(); }
+   void EndLoop();
+   void StartTask(unsigned int slot);
+   void EndTask(unsigned int slot);
+
+   void EnterScope(unsigned int slot) { fSlots[slot].fScopes.push_back({Clock_t::now(), Clock_t::duration(0)}); }
+   void ExitScope(unsigned int slot, EScopeKind kind, unsigned int id);
+   void AddColumnBytes(unsigned int slot, unsigned int columnId, ULong64_t bytes);
+
+   ROOT::RDF::RProfileReport MakeReport() const;
+};
+
+/// Opens a profiling scope for its lifetime, if a profiler is set
+class RProfileScope {
+   RLoopProfiler *const fProfiler;
+   const unsigned int fSlot;
+   const RLoopProfiler::EScopeKind fKind;
+   const unsigned int fId;
+
+public:
+   RProfileScope(RLoopProfiler *profiler, unsigned int slot, RLoopProfiler::EScopeKind kind, unsigned int id)
+      : fProfiler(profiler), fSlot(slot), fKind(kind), fId(id)
+   {
+      if (fProfiler)
+         fProfiler->EnterScope(fSlot);
+   }
+   RProfileScope(const RProfileScope &) = delete;
+   RProfileScope &operator=(const RProfileScope &) = delete;
+   ~RProfileScope()
+   {
+      if (fProfiler)
+         fProfiler->ExitScope(fSlot, fKind, fId);
+   }
+};
+
+/// The profiling state of the reads of a TTree column through one TTreeReader
+class RColumnReadProfile {
+   RLoopProfiler *fProfiler = nullptr; ///< Null if the event loop is not profiled
+   unsigned int fSlot = 0;
+   unsigned int fColumnId = 0;
+   TTreeReader *fReader = nullptr;
+   std::string fBranchName;
+   TTree *fTree = nullptr; ///< The tree in which fBranch was looked up, to notice when a chain moves to another file
+   TBranch *fBranch = nullptr;
+   Int_t fLastBasket = -1;
+
+public:
+   RColumnReadProfile(RLoopProfiler *profiler, unsigned int slot, TTreeReader *r, const std::string &branchName);
+   RLoopProfiler *GetProfiler() const { return fProfiler; }
+   unsigned int GetSlot() const { return fSlot; }
+   unsigned int GetColumnId() const { return fColumnId; }
+   /// Account the basket holding the current entry to the column, unless it was already
+   void CountBasketBytes();
+};
+
+/// Times a read of a TTree column and counts the bytes it loaded, if the event loop is profiled
+class RColumnReadScope {
+   RColumnReadProfile &fProfile;
+
+public:
+   RColumnReadScope(RColumnReadProfile &profile) : fProfile(profile)
+   {
+      if (fProfile.GetProfiler())
+         fProfile.GetProfiler()->EnterScope(fProfile.GetSlot());
+   }
+   RColumnReadScope(const RColumnReadScope &) = delete;
+   RColumnReadScope &operator=(const RColumnReadScope &) = delete;
+   ~RColumnReadScope()
+   {
+      if (fProfile.GetProfiler()) {
+         fProfile.GetProfiler()->ExitScope(fProfile.GetSlot(), RLoopProfiler::EScopeKind::kColumn,
+                                           fProfile.GetColumnId());
+         fProfile.CountBasketBytes();
+      }
+   }
+};
+
+/// The name of a node in profile reports: its kind and the columns it reads, e.g. "Fill(x, w)"
+std::string GetProfileNodeName(std::string_view kind, const std::vector<std::string> &columns);
+/// The name of an action in profile reports, its kind being taken from the type of its helper, e.g. "Fill" for
+/// ROOT::Internal::RDF::FillHelper
+std::string GetProfileNodeName(const std::type_info &helperType, const std::vector<std::string> &columns);
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -14,6 +14,7 @@
 #include "ROOT/RStringView.hxx"
 #include "RtypesCore.h" // ULong64_t
 #include <algorithm>    // std::transform
+#include <string>
 #include <vector>
 #include <typeinfo>
 
@@ -60,6 +61,14 @@ public:
 
 namespace RDF {
 
+/// A selection of the entries of a dataset: only entries for which the value of column fColumnName is in the
+/// interval [fMin, fMax] pass it. See RDataSource::SetColumnRanges.
+struct RColumnRange {
+   std::string fColumnName;
+   double fMin;
+   double fMax;
+};
+
 // clang-format off
 /**
 \class ROOT::RDF::RDataSource
@@ -87,6 +96,15 @@ Method 1 is called once per RDataSource object, typically when it is associated
 Method 2 can be called several times, potentially with the same arguments, also in-between event-loops, but not during an event-loop.
 Methods 3,8 are called once per event-loop, right before starting and right after finishing.
 Methods 5,6,7 can be called concurrently from multiple threads, multiple times per event-loop.
+
+Two optional parts of the API let data sources avoid reading data that RDataFrame does not need:
+- SetColumnRanges is called before each Initialise with the simple selections (e.g. `Filter("x > 0")`) that
+  RDataFrame applies to all entries before any other operation. Data sources can use them to skip whole blocks of
+  entries or to reject entries in SetEntry, but they are not required to: RDataFrame applies the selections anyway.
+- After retrieving the readers of a column, RDataFrame asks with SetColumnLazy to take charge of updating them. If the
+  data source accepts, SetEntry leaves them alone and RDataFrame calls LoadColumnValue when it needs the value of the
+  column for the current entry: at most once per entry, and only if the entry passed all the filters upstream of the
+  nodes that use the column.
 */
 class RDataSource {
    // clang-format on
@@ -140,6 +158,8 @@ public:
    /// \brief Return ranges of entries to distribute to tasks.
    /// They are required to be contiguous intervals with no entries skipped. Supposing a dataset with nEntries, the
    /// intervals must start at 0 and end at nEntries, e.g. [0-5],[5-10] for 10 entries.
+   /// The only exception are entries which are known to fail the selections passed via SetColumnRanges: they can be
+   /// left out.
    // clang-format on
    virtual std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() = 0;
 
@@ -153,6 +173,29 @@ public:
    // clang-format on
    virtual bool SetEntry(unsigned int slot, ULong64_t entry) = 0;
 
+   // clang-format off
+   /// \brief Inform RDataSource of the selections that the next event-loop applies to all entries.
+   /// \param[in] ranges Only the entries for which the value of each column is within the corresponding range are
+   /// processed by RDataFrame. The bounds are included. Empty if RDataFrame could not hand down any selection.
+   /// Called right before Initialise, it replaces the ranges passed for the previous event-loop.
+   // clang-format on
+   virtual void SetColumnRanges(const std::vector<RColumnRange> & /*ranges*/) {}
+
+   // clang-format off
+   /// \brief Ask RDataSource to update the "cursors" of a column only upon a call to LoadColumnValue, not in SetEntry.
+   /// \param[in] columnName The name of the column
+   /// Called after GetColumnReaders for the same column. Returns false if the request is not supported, in which case
+   /// SetEntry keeps updating the cursors and LoadColumnValue is never called for this column.
+   // clang-format on
+   virtual bool SetColumnLazy(std::string_view /*columnName*/) { return false; }
+
+   // clang-format off
+   /// \brief Make the "cursor" of a lazy column (see SetColumnLazy) point to its value at the entry last passed to SetEntry.
+   /// \param[in] slot The data processing slot that needs to be considered
+   /// \param[in] columnIdx The index of the column in the collection returned by GetColumnNames
+   // clang-format on
+   virtual void LoadColumnValue(unsigned int /*slot*/, std::size_t /*columnIdx*/) {}
+
    // clang-format off
    /// \brief Convenience method called before starting an event-loop.
    /// This method might be called multiple times over the lifetime of a RDataSource, since
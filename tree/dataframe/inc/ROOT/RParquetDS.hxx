@@ -0,0 +1,108 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RPARQUETDS
+#define ROOT_RPARQUETDS
+
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDataSource.hxx"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace arrow {
+class Schema;
+class Table;
+}
+
+namespace parquet {
+class FileMetaData;
+namespace arrow {
+class FileReader;
+}
+}
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+class TParquetValueGetter;
+} // namespace RDF
+} // namespace Internal
+
+namespace RDF {
+
+class RParquetDS final : public RDataSource {
+private:
+   /// A row group of the file which is processed, and the entries it corresponds to
+   struct RRowGroupRange {
+      int fRowGroup;
+      ULong64_t fStart;
+      ULong64_t fEnd;
+   };
+
+   /// A selection of the values of a column, used to skip row groups
+   struct RRowGroupFilter {
+      int fColumnIdx;
+      double fMin;
+      double fMax;
+   };
+
+   std::string fFileName;
+   unsigned int fNSlots = 0U;
+   std::shared_ptr<parquet::FileMetaData> fMetaData;
+   std::shared_ptr<arrow::Schema> fSchema;
+   std::vector<std::string> fColumnNames;
+   std::vector<int> fColumnIndices;         ///< Index in the file schema of each of the columns in fColumnNames
+   std::vector<bool> fIsColumnRequested;    ///< Whether a reader has been requested for each column, i.e. it needs decoding
+   std::vector<RRowGroupFilter> fRowGroupFilters;
+   std::vector<RRowGroupFilter> fColumnRangeFilters; ///< The selections handed down by RDataFrame
+   std::vector<RRowGroupRange> fRowGroupRanges; ///< The row groups to process, after the filters are applied
+   bool fEntryRangesRequested = false;
+
+   /// One reader per slot, so that row groups can be decoded concurrently
+   std::vector<std::unique_ptr<parquet::arrow::FileReader>> fSlotReaders;
+   std::vector<std::shared_ptr<arrow::Table>> fSlotTables; ///< The row group each slot is processing
+   std::vector<ULong64_t> fSlotFirstEntry;                 ///< The first entry of the row group of each slot
+   /// Value getters, fValueGetters[slot][column]
+   std::vector<std::vector<std::unique_ptr<ROOT::Internal::RDF::TParquetValueGetter>>> fValueGetters;
+
+   std::vector<void *> GetColumnReadersImpl(std::string_view name, const std::type_info &type) override;
+   int GetColumnIdx(std::string_view colName) const;
+   void SelectRowGroups();
+
+public:
+   RParquetDS(std::string_view fileName, const std::vector<std::string> &columns = {});
+   ~RParquetDS();
+   const std::vector<std::string> &GetColumnNames() const override;
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() override;
+   std::string GetTypeName(std::string_view colName) const override;
+   bool HasColumn(std::string_view colName) const override;
+   bool SetEntry(unsigned int slot, ULong64_t entry) override;
+   void InitSlot(unsigned int slot, ULong64_t firstEntry) override;
+   void FinaliseSlot(unsigned int slot) override;
+   void SetNSlots(unsigned int nSlots) override;
+   void Initialise() override;
+   void SetColumnRanges(const std::vector<RColumnRange> &ranges) override;
+
+   void AddRowGroupFilter(std::string_view colName, double min, double max);
+   ULong64_t GetNRowGroups() const;
+   ULong64_t GetNSelectedRowGroups() const { return fRowGroupRanges.size(); }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a RDataFrame reading a Apache Parquet file.
+/// \param[in] fileName the path of the Parquet file.
+/// \param[in] columns the names of the columns to read. If empty, all columns of the file are used.
+RDataFrame MakeParquetDataFrame(std::string_view fileName, const std::vector<std::string> &columns = {});
+
+} // namespace RDF
+
+} // namespace ROOT
+
+#endif
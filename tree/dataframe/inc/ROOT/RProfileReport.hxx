@@ -0,0 +1,85 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RPROFILEREPORT
+#define ROOT_RPROFILEREPORT
+
+#include "ROOT/RStringView.hxx"
+#include "RtypesCore.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+
+namespace Internal {
+namespace RDF {
+class RLoopProfiler;
+} // End NS RDF
+} // End NS Internal
+
+namespace RDF {
+
+/// Where the time of a RDataFrame event loop went, as recorded when it is requested with RInterface::Profile.
+/// All times are in seconds. The times of the nodes are exclusive: the time spent evaluating the other nodes and
+/// reading the columns that a node needs is not accounted to it.
+class RProfileReport {
+   friend class ROOT::Internal::RDF::RLoopProfiler;
+
+public:
+   /// A Filter, Define or action of the computation graph
+   struct RNodeTime {
+      std::string fName;
+      double fTime;
+      ULong64_t fNCalls;
+   };
+   /// A column of the input dataset. Bytes are the compressed sizes of the baskets loaded, and are only available for
+   /// TTree branches.
+   struct RColumnTime {
+      std::string fName;
+      double fTime;
+      ULong64_t fNReads;
+      ULong64_t fBytes;
+   };
+   /// A task run by a slot, with start and end relative to the start of the event loop
+   struct RTaskTime {
+      unsigned int fSlot;
+      double fStart;
+      double fEnd;
+   };
+   struct RSlotTime {
+      double fBusyTime;
+      double fIdleTime; ///< Time of the event loop during which the slot was not running any task
+   };
+
+private:
+   std::vector<RNodeTime> fNodes;
+   std::vector<RColumnTime> fColumns;
+   std::vector<RTaskTime> fTasks;
+   std::vector<RSlotTime> fSlots;
+   double fJitTime = 0.;
+   double fLoopTime = 0.;
+
+public:
+   const std::vector<RNodeTime> &GetNodes() const { return fNodes; }
+   const std::vector<RColumnTime> &GetColumns() const { return fColumns; }
+   const std::vector<RTaskTime> &GetTasks() const { return fTasks; }
+   const std::vector<RSlotTime> &GetSlots() const { return fSlots; }
+   /// Time spent compiling the jitted parts of the computation graph before the event loop
+   double GetJitTime() const { return fJitTime; }
+   double GetLoopTime() const { return fLoopTime; }
+   void Print() const;
+   void WriteChromeTrace(std::ostream &os) const;
+   void SaveChromeTrace(std::string_view fileName) const;
+};
+
+} // End NS RDF
+} // End NS ROOT
+
+#endif
@@ -16,6 +16,9 @@
 #include <TChain.h>
 
 #include <memory>
+#include <vector>
+
+class TBranch;
 
 namespace ROOT {
 
@@ -32,6 +35,11 @@ private:
    std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
    std::vector<std::vector<void *>> fBranchAddresses; // first container-> slot, second -> column;
    std::vector<std::unique_ptr<TChain>> fChains;
+   std::vector<bool> fIsColumnRequested; // only the branches of requested columns are read
+   std::vector<bool> fIsColumnLazy;      // these branches are read by LoadColumnValue rather than by SetEntry
+   std::vector<std::vector<TBranch *>> fBranches; // fBranches[slot][column], branches of the current tree of the slot
+   std::vector<Int_t> fTreeNumbers;               // the number of the tree of the chain each slot is reading
+   std::vector<Long64_t> fLocalEntries;           // the current entry of each slot, in the current tree
 
    std::vector<void *> GetColumnReadersImpl(std::string_view, const std::type_info &);
 
@@ -47,6 +55,8 @@ public:
    bool SetEntry(unsigned int slot, ULong64_t entry);
    void SetNSlots(unsigned int nSlots);
    void Initialise();
+   bool SetColumnLazy(std::string_view colName);
+   void LoadColumnValue(unsigned int slot, std::size_t columnIdx);
 };
 
 RDataFrame MakeRootDataFrame(std::string_view treeName, std::string_view fileNameGlob);
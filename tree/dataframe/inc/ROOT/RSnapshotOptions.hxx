@@ -35,6 +35,12 @@ struct RSnapshotOptions {
    int fAutoFlush = 0;                        //< AutoFlush value for output tree
    int fSplitLevel = 99;                      //< Split level of output tree
    bool fLazy = false;                        //< Delay the snapshot of the dataset
+   /// In multi-thread event loops, let each slot write and compress the clusters of its tasks in a file of its own,
+   /// and copy them into the output tree without unzipping them, instead of merging in-memory files with TBufferMerger
+   bool fSlotClusters = false;
+   /// With fSlotClusters, write the clusters in the order of the input entries rather than as soon as a task ends.
+   /// Only honoured when the input is a TTree or TChain.
+   bool fPreserveEntryOrder = false;
 };
 } // ns RDF
 } // ns ROOT
@@ -17,8 +17,16 @@ The RArrowDS implements a proxy RDataSource to be able to use Apache Arrow
 tables with RDataFrame.
 
 A RDataFrame that adapts an arrow::Table class can be constructed using the factory method
-ROOT::RDF::MakeArrowDataFrame, which accepts one parameter:
+ROOT::RDF::MakeArrowDataFrame, which accepts two parameters:
 1. An arrow::Table smart pointer.
+2. The names of the columns to use. If empty, all the columns of the table are used.
+
+Datasets that do not fit in memory can be processed as a stream of record batches, passing an
+arrow::RecordBatchReader to ROOT::RDF::MakeArrowDataFrame, or the path of a file in the Arrow IPC
+stream format to ROOT::RDF::MakeArrowIPCDataFrame. Only one record batch at a time is kept in memory,
+and the ranges of entries of each batch are processed before the next batch is read. Files are
+memory-mapped, so that numerical columns are read in place without copies. A record batch reader can
+only be consumed by a single event loop, whereas files are read again from the start at each event loop.
 
 The types of the columns are derived from the types in the associated
 arrow::Schema.
@@ -32,6 +40,7 @@ arrow::Schema.
 #include <ROOT/RMakeUnique.hxx>
 
 #include <algorithm>
+#include <limits>
 #include <sstream>
 #include <string>
 
@@ -39,6 +48,9 @@ arrow::Schema.
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
 #endif
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/record_batch.h>
 #include <arrow/table.h>
 #if defined(__GNUC__)
 #pragma GCC diagnostic pop
@@ -133,19 +145,34 @@ private:
    arrow::ArrayVector fChunks;
 
 public:
-   TValueGetter(size_t slots, arrow::ArrayVector chunks)
-      : fValuesPtrPerSlot(slots, nullptr), fLastEntryPerSlot(slots, 0), fLastChunkPerSlot(slots, 0), fChunks{chunks}
+   TValueGetter(size_t slots, arrow::ArrayVector chunks, ULong64_t firstEntry = 0ULL)
+      : fValuesPtrPerSlot(slots, nullptr), fLastEntryPerSlot(slots, 0), fLastChunkPerSlot(slots, 0)
+   {
+      SetChunks(std::move(chunks), firstEntry);
+      for (size_t si = 0, se = fValuesPtrPerSlot.size(); si != se; ++si) {
+         fArrayVisitorPerSlot.push_back(ArrayPtrVisitor{fValuesPtrPerSlot.data() + si});
+      }
+   }
+
+   /// Replace the arrays the values are read from, e.g. when moving to a new record batch.
+   /// The pointers returned by SlotPtrs stay valid.
+   /// \param[in] chunks the arrays containing the values
+   /// \param[in] firstEntry the entry number corresponding to the first element of the first array
+   void SetChunks(arrow::ArrayVector chunks, ULong64_t firstEntry)
    {
+      fChunks = std::move(chunks);
+      fChunkIndex.clear();
+      fFirstEntryPerChunk.clear();
       fChunkIndex.reserve(fChunks.size());
-      size_t next = 0;
-      for (auto &chunk : chunks) {
+      ULong64_t next = firstEntry;
+      for (auto &chunk : fChunks) {
          fFirstEntryPerChunk.push_back(next);
          next += chunk->length();
          fChunkIndex.push_back(next);
       }
-      for (size_t si = 0, se = fValuesPtrPerSlot.size(); si != se; ++si) {
-         fArrayVisitorPerSlot.push_back(ArrayPtrVisitor{fValuesPtrPerSlot.data() + si});
-      }
+      // Invalidate the cached lookups, they refer to the previous chunks
+      std::fill(fLastEntryPerSlot.begin(), fLastEntryPerSlot.end(), std::numeric_limits<ULong64_t>::max());
+      std::fill(fLastChunkPerSlot.begin(), fLastChunkPerSlot.end(), 0ULL);
    }
 
    /// This returns the ptr to the ptr to actual data.
@@ -190,6 +217,7 @@ public:
          msg += std::to_string(slot) + " looking at entry " + std::to_string(entry);
          throw std::runtime_error(msg);
       }
+      fLastEntryPerSlot[slot] = entry;
    }
 
    /// Set the current entry to be retrieved
@@ -203,6 +231,28 @@ public:
    }
 };
 
+/// Open a file in the Arrow IPC stream format. The file is memory-mapped, so that the buffers of the record
+/// batches point directly to the content of the file.
+std::shared_ptr<arrow::RecordBatchReader> OpenIPCStream(const std::string &fileName)
+{
+   std::shared_ptr<arrow::io::MemoryMappedFile> file;
+   auto status = arrow::io::MemoryMappedFile::Open(fileName, arrow::io::FileMode::READ, &file);
+   if (!status.ok()) {
+      std::string msg = "Cannot open file ";
+      msg += fileName + ": " + status.ToString();
+      throw std::runtime_error(msg);
+   }
+
+   std::shared_ptr<arrow::RecordBatchReader> reader;
+   status = arrow::ipc::RecordBatchStreamReader::Open(file, &reader);
+   if (!status.ok()) {
+      std::string msg = "Cannot read the Arrow stream in file ";
+      msg += fileName + ": " + status.ToString();
+      throw std::runtime_error(msg);
+   }
+   return reader;
+}
+
 } // namespace RDF
 } // namespace Internal
 
@@ -285,29 +335,66 @@ public:
 /// \param[in] columns the name of the columns to use
 /// In case columns is empty, we use all the columns found in the table
 RArrowDS::RArrowDS(std::shared_ptr<arrow::Table> inTable, std::vector<std::string> const &inColumns)
-   : fTable{inTable}, fColumnNames{inColumns}
+   : fTable{inTable}, fSchema{inTable->schema()}, fColumnNames{inColumns}
+{
+   SetupColumns();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor to create an Arrow RDataSource for RDataFrame which reads a stream of record batches.
+/// \param[in] batchReader the arrow RecordBatchReader providing the record batches.
+/// \param[in] columns the name of the columns to use
+/// In case columns is empty, we use all the columns found in the schema of the batches.
+/// The batches are read one at a time while the event loop proceeds, therefore they can
+/// be consumed by a single event loop.
+RArrowDS::RArrowDS(std::shared_ptr<arrow::RecordBatchReader> batchReader, std::vector<std::string> const &inColumns)
+   : fSchema{batchReader->schema()}, fBatchReader{batchReader}, fColumnNames{inColumns}
+{
+   SetupColumns();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor to create an Arrow RDataSource for RDataFrame which reads a file in the Arrow IPC stream format.
+/// \param[in] fileName the path of the file.
+/// \param[in] columns the name of the columns to use
+/// In case columns is empty, we use all the columns found in the schema of the file.
+/// The file is memory-mapped and its record batches are read one at a time while the event loop proceeds.
+RArrowDS::RArrowDS(std::string_view fileName, std::vector<std::string> const &inColumns)
+   : fBatchReader{ROOT::Internal::RDF::OpenIPCStream(std::string(fileName))}, fFileName{fileName},
+     fColumnNames{inColumns}
+{
+   fSchema = fBatchReader->schema();
+   SetupColumns();
+}
+
+/// Check the requested columns and build the index of the value getters.
+void RArrowDS::SetupColumns()
 {
    auto &columnNames = fColumnNames;
+   auto &schema = fSchema;
    auto &table = fTable;
    auto &index = fGetterIndex;
    // We want to allow people to specify which columns they
    // need so that we can think of upfront IO optimizations.
-   auto filterWantedColumns = [&columnNames, &table]()
+   auto filterWantedColumns = [&columnNames, &schema]()
    {
       if (columnNames.empty()) {
-         for (auto &field : table->schema()->fields()) {
+         for (auto &field : schema->fields()) {
             columnNames.push_back(field->name());
          }
       }
    };
 
-   auto getRecordsFirstColumn = [&columnNames, &table]()
+   auto getRecordsFirstColumn = [&columnNames, &schema, &table]() -> int64_t
    {
       if (columnNames.empty()) {
          throw std::runtime_error("At least one column required");
       }
+      // the number of entries of a stream of record batches is not known in advance
+      if (!table)
+         return -1;
       const auto name = columnNames.front();
-      const auto columnIdx = table->schema()->GetFieldIndex(name);
+      const auto columnIdx = schema->GetFieldIndex(name);
       return table->column(columnIdx)->length();
    };
 
@@ -322,12 +409,12 @@ RArrowDS::RArrowDS(std::shared_ptr<arrow::Table> inTable, std::vector<std::strin
    };
 
    /// For the moment we support only a few native types.
-   auto verifyColumnType = [](std::shared_ptr<arrow::Column> column) {
+   auto verifyColumnType = [](std::shared_ptr<arrow::Field> field) {
       auto verifyType = std::make_unique<VerifyValidColumnType>();
-      auto result = column->type()->Accept(verifyType.get());
+      auto result = field->type()->Accept(verifyType.get());
       if (result.ok() == false) {
          std::string msg = "Column ";
-         msg += column->name() + " contains an unsupported type.";
+         msg += field->name() + " contains an unsupported type.";
          throw std::runtime_error(msg);
       }
    };
@@ -348,12 +435,17 @@ RArrowDS::RArrowDS(std::shared_ptr<arrow::Table> inTable, std::vector<std::strin
    resetGetterIndex();
    auto nRecords = getRecordsFirstColumn();
    for (auto &columnName : fColumnNames) {
-      auto columnIdx = fTable->schema()->GetFieldIndex(columnName);
+      auto columnIdx = fSchema->GetFieldIndex(columnName);
+      if (columnIdx < 0) {
+         std::string msg = "The dataset does not have column ";
+         msg += columnName;
+         throw std::runtime_error(msg);
+      }
       addColumnToGetterIndex(columnIdx);
 
-      auto column = fTable->column(columnIdx);
-      verifyColumnSize(column, nRecords);
-      verifyColumnType(column);
+      verifyColumnType(fSchema->field(columnIdx));
+      if (fTable)
+         verifyColumnSize(fTable->column(columnIdx), nRecords);
    }
 }
 
@@ -370,13 +462,34 @@ const std::vector<std::string> &RArrowDS::GetColumnNames() const
 
 std::vector<std::pair<ULong64_t, ULong64_t>> RArrowDS::GetEntryRanges()
 {
+   if (fBatchReader) {
+      // Move to the next non-empty record batch, if any
+      fBatchReaderUsed = true;
+      std::shared_ptr<arrow::RecordBatch> batch;
+      do {
+         auto status = fBatchReader->ReadNext(&batch);
+         if (!status.ok())
+            throw std::runtime_error("Could not read the next record batch: " + status.ToString());
+      } while (batch && batch->num_rows() == 0);
+      // The previous batch is released here, all tasks processing it have finished
+      fCurrentBatch = batch;
+      if (!fCurrentBatch)
+         return {};
+
+      const ULong64_t nRecords = fCurrentBatch->num_rows();
+      for (auto &link : fGetterIndex)
+         fValueGetters[link.second]->SetChunks({fCurrentBatch->column(link.first)}, fNProcessedEntries);
+      SplitInEqualRanges(fNProcessedEntries, nRecords);
+      fNProcessedEntries += nRecords;
+   }
+
    auto entryRanges(std::move(fEntryRanges)); // empty fEntryRanges
    return entryRanges;
 }
 
 std::string RArrowDS::GetTypeName(std::string_view colName) const
 {
-   auto field = fTable->schema()->GetFieldByName(std::string(colName));
+   auto field = fSchema->GetFieldByName(std::string(colName));
    if (!field) {
       std::string msg = "The dataset does not have column ";
       msg += colName;
@@ -394,7 +507,7 @@ std::string RArrowDS::GetTypeName(std::string_view colName) const
 
 bool RArrowDS::HasColumn(std::string_view colName) const
 {
-   auto field = fTable->schema()->GetFieldByName(std::string(colName));
+   auto field = fSchema->GetFieldByName(std::string(colName));
    if (!field) {
       return false;
    }
@@ -404,7 +517,6 @@ bool RArrowDS::HasColumn(std::string_view colName) const
 bool RArrowDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
    for (auto link : fGetterIndex) {
-      auto column = fTable->column(link.first);
       auto &getter = fValueGetters[link.second];
       getter->SetEntry(slot, entry);
    }
@@ -414,7 +526,6 @@ bool RArrowDS::SetEntry(unsigned int slot, ULong64_t entry)
 void RArrowDS::InitSlot(unsigned int slot, ULong64_t entry)
 {
    for (auto link : fGetterIndex) {
-      auto column = fTable->column(link.first);
       auto &getter = fValueGetters[link.second];
       getter->UncachedSlotLookup(slot, entry);
    }
@@ -426,43 +537,37 @@ void RArrowDS::SetNSlots(unsigned int nSlots)
 
    // We dump all the previous getters structures and we rebuild it.
    auto nColumns = fGetterIndex.size();
-   auto &outNSlots = fNSlots;
-   auto &ranges = fEntryRanges;
-   auto &table = fTable;
-   auto &columnNames = fColumnNames;
+   fNSlots = nSlots;
 
    fValueGetters.clear();
    for (size_t ci = 0; ci != nColumns; ++ci) {
-      auto chunkedArray = fTable->column(fGetterIndex[ci].first)->data();
-      fValueGetters.emplace_back(std::make_unique<ROOT::Internal::RDF::TValueGetter>(nSlots, chunkedArray->chunks()));
+      // When reading record batches, the arrays are set when the batches are read
+      auto chunks = fTable ? fTable->column(fGetterIndex[ci].first)->data()->chunks() : arrow::ArrayVector{};
+      fValueGetters.emplace_back(std::make_unique<ROOT::Internal::RDF::TValueGetter>(nSlots, chunks));
    }
 
-   // We use the same logic as the ROOTDS.
-   auto splitInEqualRanges = [&outNSlots, &ranges](int nRecords, unsigned int newNSlots)
-   {
-      ranges.clear();
-      outNSlots = newNSlots;
-      const auto chunkSize = nRecords / outNSlots;
-      const auto remainder = 1U == outNSlots ? 0 : nRecords % outNSlots;
-      auto start = 0UL;
-      auto end = 0UL;
-      for (auto i : ROOT::TSeqU(outNSlots)) {
-         start = end;
-         end += chunkSize;
-         ranges.emplace_back(start, end);
-         (void)i;
-      }
-      ranges.back().second += remainder;
-   };
-
-   auto getNRecords = [&table, &columnNames]()->int
-   {
-      auto index = table->schema()->GetFieldIndex(columnNames.front());
-      return table->column(index)->length();
-   };
+   if (fTable) {
+      auto index = fSchema->GetFieldIndex(fColumnNames.front());
+      SplitInEqualRanges(0ULL, fTable->column(index)->length());
+   }
+}
 
-   auto nRecords = getNRecords();
-   splitInEqualRanges(nRecords, nSlots);
+/// Split nRecords entries starting at firstEntry in a range per slot.
+/// We use the same logic as the ROOTDS.
+void RArrowDS::SplitInEqualRanges(ULong64_t firstEntry, ULong64_t nRecords)
+{
+   fEntryRanges.clear();
+   const auto chunkSize = nRecords / fNSlots;
+   const auto remainder = 1U == fNSlots ? 0 : nRecords % fNSlots;
+   auto start = firstEntry;
+   auto end = firstEntry;
+   for (auto i : ROOT::TSeqU(fNSlots)) {
+      start = end;
+      end += chunkSize;
+      fEntryRanges.emplace_back(start, end);
+      (void)i;
+   }
+   fEntryRanges.back().second += remainder;
 }
 
 /// This needs to return a pointer to the pointer each value getter
@@ -489,6 +594,18 @@ std::vector<void *> RArrowDS::GetColumnReadersImpl(std::string_view colName, con
 
 void RArrowDS::Initialise()
 {
+   if (!fBatchReader)
+      return;
+
+   // A new event loop starts: the record batches need to be read from the beginning
+   if (fBatchReaderUsed) {
+      if (fFileName.empty())
+         throw std::runtime_error("The record batches of this RArrowDS have already been read by a previous event loop");
+      fBatchReader = ROOT::Internal::RDF::OpenIPCStream(fFileName);
+      fBatchReaderUsed = false;
+   }
+   fCurrentBatch.reset();
+   fNProcessedEntries = 0ULL;
 }
 
 /// Creates a RDataFrame using an arrow::Table as input.
@@ -501,6 +618,27 @@ RDataFrame MakeArrowDataFrame(std::shared_ptr<arrow::Table> table, std::vector<s
    return tdf;
 }
 
+/// Creates a RDataFrame using a stream of arrow::RecordBatch as input.
+/// \param[in] batchReader the arrow RecordBatchReader providing the batches.
+/// \param[in] columnNames the name of the columns to use
+/// In case columnNames is empty, we use all the columns found in the schema of the batches
+RDataFrame MakeArrowDataFrame(std::shared_ptr<arrow::RecordBatchReader> batchReader,
+                              std::vector<std::string> const &columnNames)
+{
+   ROOT::RDataFrame tdf(std::make_unique<RArrowDS>(batchReader, columnNames));
+   return tdf;
+}
+
+/// Creates a RDataFrame reading a file in the Arrow IPC stream format.
+/// \param[in] fileName the path of the file, which is memory-mapped.
+/// \param[in] columnNames the name of the columns to use
+/// In case columnNames is empty, we use all the columns found in the schema of the file
+RDataFrame MakeArrowIPCDataFrame(std::string_view fileName, std::vector<std::string> const &columnNames)
+{
+   ROOT::RDataFrame tdf(std::make_unique<RArrowDS>(fileName, columnNames));
+   return tdf;
+}
+
 } // namespace RDF
 
 } // namespace ROOT
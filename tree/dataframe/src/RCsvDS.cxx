@@ -65,9 +65,17 @@ double-quote characters must be represented by a pair of double-quote characters
     2000,Mercury,Cougar
 ~~~
 
-The current implementation of RCsvDS reads the entire CSV file content into memory before
-RDataFrame starts processing it. Therefore, before creating a CSV RDataFrame, it is
-important to check both how much memory is available and the size of the CSV file.
+By default, RCsvDS reads the entire CSV file content into memory before RDataFrame starts
+processing it. Therefore, before creating a CSV RDataFrame, it is important to check both how
+much memory is available and the size of the CSV file. Large files can be processed in bounded
+memory by passing a positive number of lines to the `linesChunkSize` parameter of the
+constructor (or of ROOT::RDF::MakeCsvDataFrame): the file is then read, parsed and processed
+that many lines at a time.
+
+The values of each chunk of lines are stored column-wise, each column with its own type. If
+implicit multi-threading is enabled, the lines of a chunk are split in blocks which are parsed
+in parallel. Entries which fail simple selections on numerical columns, e.g. `Filter("x > 0")`
+applied first thing to the RDataFrame, are rejected by RCsvDS before any other node sees them.
 */
 // clang-format on
 
@@ -75,10 +83,12 @@ important to check both how much memory is available and the size of the CSV fil
 #include <ROOT/TSeq.hxx>
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/RMakeUnique.hxx>
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
 
 #include <algorithm>
 #include <iostream>
-#include <sstream>
 #include <string>
 
 namespace ROOT {
@@ -103,34 +113,28 @@ void RCsvDS::FillHeaders(const std::string &line)
    }
 }
 
-void RCsvDS::FillRecord(const std::string &line, Record_t &record)
+void RCsvDS::FillRecord(const std::string &line, ULong64_t recordPos)
 {
-   std::istringstream lineStream(line);
    auto i = 0U;
 
    auto columns = ParseColumns(line);
 
    for (auto &col : columns) {
-      auto colType = fColTypes[fHeaders[i]];
-
-      switch (colType) {
+      switch (fColTypesList[i]) {
       case 'd': {
-         record.emplace_back(new double(std::stod(col)));
+         fDoubleColumns[i][recordPos] = std::stod(col);
          break;
       }
       case 'l': {
-         record.emplace_back(new Long64_t(std::stoll(col)));
+         fLong64Columns[i][recordPos] = std::stoll(col);
          break;
       }
       case 'b': {
-         auto b = new bool();
-         record.emplace_back(b);
-         std::istringstream is(col);
-         is >> std::boolalpha >> *b;
+         fBoolColumns[i][recordPos] = col == "true";
          break;
       }
       case 's': {
-         record.emplace_back(new std::string(col));
+         fStringColumns[i][recordPos] = std::move(col);
          break;
       }
       }
@@ -161,18 +165,9 @@ std::vector<void *> RCsvDS::GetColumnReadersImpl(std::string_view colName, const
    const auto &colNames = GetColumnNames();
    const auto index = std::distance(colNames.begin(), std::find(colNames.begin(), colNames.end(), colName));
    std::vector<void *> ret(fNSlots);
+   // The addresses are made to point directly to the values stored in the columns by SetEntry
    for (auto slot : ROOT::TSeqU(fNSlots)) {
-      auto &val = fColAddresses[index][slot];
-      if (ti == typeid(double)) {
-         val = &fDoubleEvtValues[index][slot];
-      } else if (ti == typeid(Long64_t)) {
-         val = &fLong64EvtValues[index][slot];
-      } else if (ti == typeid(std::string)) {
-         val = &fStringEvtValues[index][slot];
-      } else {
-         val = &fBoolEvtValues[index][slot];
-      }
-      ret[slot] = &val;
+      ret[slot] = &fColAddresses[index][slot];
    }
    return ret;
 }
@@ -206,7 +201,7 @@ void RCsvDS::InferType(const std::string &col, unsigned int idxCol)
    fColTypesList.push_back(type);
 }
 
-std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
+std::vector<std::string> RCsvDS::ParseColumns(const std::string &line) const
 {
    std::vector<std::string> columns;
 
@@ -217,9 +212,9 @@ std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
    return columns;
 }
 
-size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i)
+size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i) const
 {
-   std::stringstream val;
+   std::string val;
    bool quoted = false;
 
    for (; i < line.size(); ++i) {
@@ -230,18 +225,53 @@ size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &col
          if (line[i + 1] != '"') {
             quoted = !quoted;
          } else {
-            val << line[++i];
+            val += line[++i];
          }
       } else {
-         val << line[i];
+         val += line[i];
       }
    }
 
-   columns.emplace_back(val.str());
+   columns.emplace_back(std::move(val));
 
    return i;
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Parse the lines of the current chunk and store their values in the typed columns.
+/// If implicit multi-threading is enabled, blocks of lines are parsed in parallel.
+void RCsvDS::ParseLines()
+{
+   const auto nRecords = fLines.size();
+   const auto nColumns = fColTypesList.size();
+   for (auto i : ROOT::TSeqU(nColumns)) {
+      switch (fColTypesList[i]) {
+      case 'd': fDoubleColumns[i].resize(nRecords); break;
+      case 'l': fLong64Columns[i].resize(nRecords); break;
+      case 'b': fBoolColumns[i].resize(nRecords); break;
+      case 's': fStringColumns[i].resize(nRecords); break;
+      }
+   }
+
+   // Every block of lines fills a different set of entries of the columns, which are already allocated
+   auto parseBlock = [this, nRecords](ULong64_t begin, ULong64_t end) {
+      for (auto recordPos = begin; recordPos < end && recordPos < nRecords; ++recordPos)
+         FillRecord(fLines[recordPos], recordPos);
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && fNSlots > 1U && nRecords > fNSlots) {
+      const ULong64_t blockSize = (nRecords + fNSlots - 1) / fNSlots;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](unsigned int block) { parseBlock(block * blockSize, (block + 1) * blockSize); },
+                   ROOT::TSeqU(fNSlots));
+      return;
+   }
+#endif
+
+   parseBlock(0ULL, nRecords);
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Constructor to create a CSV RDataSource for RDataFrame.
 /// \param[in] fileName Path of the CSV file.
@@ -277,39 +307,28 @@ RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long
       // Infer types of columns with first record
       InferColTypes(columns);
 
-      // Fill with the content of the first line
-      fRecords.emplace_back();
-      FillRecord(line, fRecords.back());
+      // Keep the first line, it will be parsed together with the first chunk
+      fLines.emplace_back(std::move(line));
    }
+
+   const auto nColumns = fHeaders.size();
+   fDoubleColumns.resize(nColumns);
+   fLong64Columns.resize(nColumns);
+   fStringColumns.resize(nColumns);
+   fBoolColumns.resize(nColumns);
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Release the memory used to store the lines and values of the current chunk.
 void RCsvDS::FreeRecords()
 {
-   for (auto &record : fRecords) {
-      for (size_t i = 0; i < record.size(); ++i) {
-         void *p = record[i];
-         const auto colType = fColTypes[fHeaders[i]];
-         switch (colType) {
-         case 'd': {
-            delete static_cast<double *>(p);
-            break;
-         }
-         case 'l': {
-            delete static_cast<Long64_t *>(p);
-            break;
-         }
-         case 'b': {
-            delete static_cast<bool *>(p);
-            break;
-         }
-         case 's': {
-            delete static_cast<std::string *>(p);
-            break;
-         }
-         }
-      }
+   fLines.clear();
+   for (auto i : ROOT::TSeqU(fColTypesList.size())) {
+      std::vector<double>().swap(fDoubleColumns[i]);
+      std::vector<Long64_t>().swap(fLong64Columns[i]);
+      std::vector<std::string>().swap(fStringColumns[i]);
+      std::deque<bool>().swap(fBoolColumns[i]);
    }
-   fRecords.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -340,12 +359,12 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
    }
    std::string line;
    while ((-1LL == fLinesChunkSize || 0 != linesToRead--) && std::getline(fStream, line)) {
-      fRecords.emplace_back();
-      FillRecord(line, fRecords.back());
+      fLines.emplace_back(std::move(line));
    }
+   ParseLines();
 
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   const auto nRecords = fRecords.size();
+   const auto nRecords = fLines.size();
    if (0 == nRecords)
       return entryRanges;
 
@@ -393,24 +412,39 @@ bool RCsvDS::SetEntry(unsigned int slot, ULong64_t entry)
    // Here we need to normalise the entry to the number of lines we already processed.
    const auto offset = (fEntryRangesRequested - 1) * fLinesChunkSize;
    const auto recordPos = entry - offset;
+
+   // Entries which fail the selections of RDataFrame are rejected before updating any reader
+   for (const auto &range : fValueRanges) {
+      const auto col = range.fColumnIdx;
+      double value = 0.;
+      switch (fColTypesList[col]) {
+      case 'd': value = fDoubleColumns[col][recordPos]; break;
+      case 'l': value = fLong64Columns[col][recordPos]; break;
+      case 'b': value = fBoolColumns[col][recordPos]; break;
+      }
+      if (value < range.fMin || value > range.fMax)
+         return false;
+   }
+
    int colIndex = 0;
    for (auto &colType : fColTypesList) {
-      auto dataPtr = fRecords[recordPos][colIndex];
+      // Point the readers directly to the stored values, no copy is needed
+      auto &dataPtr = fColAddresses[colIndex][slot];
       switch (colType) {
       case 'd': {
-         fDoubleEvtValues[colIndex][slot] = *static_cast<double *>(dataPtr);
+         dataPtr = &fDoubleColumns[colIndex][recordPos];
          break;
       }
       case 'l': {
-         fLong64EvtValues[colIndex][slot] = *static_cast<Long64_t *>(dataPtr);
+         dataPtr = &fLong64Columns[colIndex][recordPos];
          break;
       }
       case 'b': {
-         fBoolEvtValues[colIndex][slot] = *static_cast<bool *>(dataPtr);
+         dataPtr = &fBoolColumns[colIndex][recordPos];
          break;
       }
       case 's': {
-         fStringEvtValues[colIndex][slot] = *static_cast<std::string *>(dataPtr);
+         dataPtr = &fStringColumns[colIndex][recordPos];
          break;
       }
       }
@@ -428,12 +462,21 @@ void RCsvDS::SetNSlots(unsigned int nSlots)
    const auto nColumns = fHeaders.size();
    // Initialise the entire set of addresses
    fColAddresses.resize(nColumns, std::vector<void *>(fNSlots, nullptr));
+}
 
-   // Initialize the per event data holders
-   fDoubleEvtValues.resize(nColumns, std::vector<double>(fNSlots));
-   fLong64EvtValues.resize(nColumns, std::vector<Long64_t>(fNSlots));
-   fStringEvtValues.resize(nColumns, std::vector<std::string>(fNSlots));
-   fBoolEvtValues.resize(nColumns, std::deque<bool>(fNSlots));
+/// Entries for which the values of numerical and boolean columns are outside of the ranges are rejected by SetEntry.
+/// Ranges on string columns are ignored.
+void RCsvDS::SetColumnRanges(const std::vector<RColumnRange> &ranges)
+{
+   fValueRanges.clear();
+   for (const auto &range : ranges) {
+      const auto it = std::find(fHeaders.begin(), fHeaders.end(), range.fColumnName);
+      if (it == fHeaders.end())
+         continue;
+      const std::size_t col = std::distance(fHeaders.begin(), it);
+      if (fColTypesList[col] != 's')
+         fValueRanges.push_back({col, range.fMin, range.fMax});
+   }
 }
 
 RDataFrame MakeCsvDataFrame(std::string_view fileName, bool readHeaders, char delimiter, Long64_t linesChunkSize)
@@ -13,6 +13,8 @@
 #include <TProfile.h>
 #include <TProfile2D.h>
 #include <stddef.h>
+#include <algorithm>
+#include <stdexcept>
 #include <vector>
 
 #include "TAxis.h"
@@ -40,6 +42,13 @@
 * \class ROOT::RDF::TProfile2DModel
 * \ingroup dataframe
 * \brief A struct which stores the parameters of a TProfile2D
+*
+* \class ROOT::RDF::RHistoBundle
+* \ingroup dataframe
+* \brief A set of TH1D and TH2D to be filled by a single action, see RInterface::HistoBundle
+*
+* Histograms are added with Histo1D and Histo2D, which return the position of the histogram in the bundle, i.e. in
+* the vector of results of RInterface::HistoBundle. A column used by several histograms is read once per entry.
 */
 
 template <typename T>
@@ -314,6 +323,40 @@ TProfile2DModel::~TProfile2DModel()
 {
 }
 
+int RHistoBundle::AddColumn(std::string_view name)
+{
+   if (name.empty())
+      return -1;
+   const auto it = std::find(fColumnNames.begin(), fColumnNames.end(), name);
+   if (it != fColumnNames.end())
+      return it - fColumnNames.begin();
+   fColumnNames.emplace_back(name);
+   return fColumnNames.size() - 1;
+}
+
+std::size_t RHistoBundle::Histo1D(const TH1DModel &model, std::string_view vName, std::string_view wName)
+{
+   if (vName.empty())
+      throw std::runtime_error("The histograms of a RHistoBundle need explicit column names.");
+   auto h = model.GetHistogram();
+   if (!(h->GetXaxis()->GetXmin() < h->GetXaxis()->GetXmax()))
+      throw std::runtime_error("The histograms of a RHistoBundle need axis limits.");
+   fHistos.push_back({h, AddColumn(vName), -1, AddColumn(wName)});
+   return fHistos.size() - 1;
+}
+
+std::size_t
+RHistoBundle::Histo2D(const TH2DModel &model, std::string_view v1Name, std::string_view v2Name, std::string_view wName)
+{
+   if (v1Name.empty() || v2Name.empty())
+      throw std::runtime_error("The histograms of a RHistoBundle need explicit column names.");
+   auto h = model.GetHistogram();
+   if (!(h->GetXaxis()->GetXmin() < h->GetXaxis()->GetXmax() && h->GetYaxis()->GetXmin() < h->GetYaxis()->GetXmax()))
+      throw std::runtime_error("The histograms of a RHistoBundle need axis limits.");
+   fHistos.push_back({h, AddColumn(v1Name), AddColumn(v2Name), AddColumn(wName)});
+   return fHistos.size() - 1;
+}
+
 } // ns RDF
 
 } // ns ROOT
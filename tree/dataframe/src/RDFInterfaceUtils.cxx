@@ -20,7 +20,11 @@
 #include <TTree.h>
 #include <TBranchElement.h>
 
+#include <algorithm>
+#include <cctype>
+#include <cmath>
 #include <iosfwd>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <typeinfo>
@@ -499,6 +503,83 @@ std::string PrettyPrintAddr(void *addr)
    return s.str();
 }
 
+/// Return the selections on data-source columns equivalent to a filter expression such as "x > 0 && y <= 10".
+/// Only conjunctions of comparisons between a data-source column and a number are understood: for any other
+/// expression an empty vector is returned. Strict inequalities are widened to include the bound.
+std::vector<ROOT::RDF::RColumnRange> FindColumnRanges(std::string_view expression, const ColumnNames_t &dsColumns,
+                                                      const std::map<std::string, std::string> &aliasMap)
+{
+   auto trim = [](const std::string &s) {
+      const auto first = s.find_first_not_of(" \t\n");
+      if (first == std::string::npos)
+         return std::string();
+      return s.substr(first, s.find_last_not_of(" \t\n") - first + 1);
+   };
+   auto isIdentifier = [](const std::string &s) {
+      if (s.empty() || std::isdigit(static_cast<unsigned char>(s[0])))
+         return false;
+      return std::all_of(s.begin(), s.end(), [](unsigned char c) { return std::isalnum(c) || c == '_'; });
+   };
+   auto toNumber = [](const std::string &s, double &value) {
+      if (s.empty())
+         return false;
+      try {
+         std::size_t nParsed = 0;
+         value = std::stod(s, &nParsed);
+         return nParsed == s.size() && !std::isnan(value);
+      } catch (const std::logic_error &) {
+         return false;
+      }
+   };
+
+   const auto lowest = std::numeric_limits<double>::lowest();
+   const auto highest = std::numeric_limits<double>::max();
+   std::vector<ROOT::RDF::RColumnRange> ranges;
+   const std::string expr(expression);
+   std::size_t termStart = 0;
+   while (termStart <= expr.size()) {
+      auto termEnd = expr.find("&&", termStart);
+      if (termEnd == std::string::npos)
+         termEnd = expr.size();
+      const auto term = expr.substr(termStart, termEnd - termStart);
+      termStart = termEnd + 2;
+
+      // split the term in "lhs op rhs"
+      const auto opPos = term.find_first_of("<>=");
+      if (opPos == std::string::npos)
+         return {};
+      const bool orEqual = opPos + 1 < term.size() && term[opPos + 1] == '=';
+      const auto op = term[opPos];
+      if (op == '=' && !orEqual)
+         return {};
+      auto lhs = trim(term.substr(0, opPos));
+      auto rhs = trim(term.substr(opPos + (orEqual ? 2 : 1)));
+
+      // one side is the column, the other one is the number
+      double value = 0.;
+      bool columnOnLeft = true;
+      if (!(isIdentifier(lhs) && toNumber(rhs, value))) {
+         if (!(isIdentifier(rhs) && toNumber(lhs, value)))
+            return {};
+         columnOnLeft = false;
+         std::swap(lhs, rhs);
+      }
+
+      const auto aliasIt = aliasMap.find(lhs);
+      const auto &colName = aliasIt == aliasMap.end() ? lhs : aliasIt->second;
+      if (std::find(dsColumns.begin(), dsColumns.end(), colName) == dsColumns.end())
+         return {};
+
+      if (op == '=')
+         ranges.push_back({colName, value, value});
+      else if ((op == '<') == columnOnLeft) // column < value or value > column
+         ranges.push_back({colName, lowest, value});
+      else
+         ranges.push_back({colName, value, highest});
+   }
+   return ranges;
+}
+
 // Jit a string filter expression and jit-and-call this->Filter with the appropriate arguments
 // Return pointer to the new functional chain node returned by the call, cast to Long_t
 void BookFilterJit(RJittedFilter *jittedFilter, void *prevNode, std::string_view prevNodeTypeName,
@@ -542,7 +623,16 @@ void BookFilterJit(RJittedFilter *jittedFilter, void *prevNode, std::string_view
                     << "reinterpret_cast<ROOT::Detail::RDF::RJittedFilter*>(" << jittedFilterAddr << "), "
                     << "reinterpret_cast<" << prevNodeTypeName << "*>(" << prevNodeAddr << "));";
 
-   jittedFilter->GetLoopManagerUnchecked()->ToJit(filterInvocation.str());
+   auto lm = jittedFilter->GetLoopManagerUnchecked();
+   lm->ToJit(filterInvocation.str());
+
+   // Unnamed filters on data-source columns that hang directly from the RLoopManager are candidates for being
+   // applied by the data source itself. RLoopManager decides before each event-loop whether they can be.
+   if (ds && name.empty() && prevNode == lm) {
+      auto ranges = FindColumnRanges(expression, dsColumns, aliasMap);
+      if (!ranges.empty())
+         lm->AddDataSourceColumnRanges(jittedFilter, std::move(ranges));
+   }
 }
 
 // Jit a Define call
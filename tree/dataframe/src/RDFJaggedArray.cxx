@@ -0,0 +1,149 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDFJaggedArray.hxx"
+#include "TBasket.h"
+#include "TBranch.h"
+#include "TBranchElement.h"
+#include "TClass.h"
+#include "TDataType.h"
+#include "TLeaf.h"
+#include "TMath.h"
+#include "TTree.h"
+#include "TVirtualCollectionProxy.h"
+#include "TVirtualStreamerInfo.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+namespace {
+/// Whether the entries of the branch are arrays of values of the given type, possibly preceded by a header as the
+/// ones of a std::vector
+bool HoldsValuesOf(TBranch &branch, EDataType type, bool &hasHeader)
+{
+   hasHeader = false;
+   if (branch.IsA() == TBranch::Class()) {
+      if (branch.GetNleaves() != 1)
+         return false;
+      auto leaf = static_cast<TLeaf *>(branch.GetListOfLeaves()->UncheckedAt(0));
+      return std::string(leaf->GetTypeName()) == TDataType::GetTypeName(type);
+   }
+
+   if (branch.IsA() != TBranchElement::Class())
+      return false;
+   auto &element = static_cast<TBranchElement &>(branch);
+   if (element.GetType() == 31 || element.GetType() == 41) {
+      // a member of the objects of a split collection: the values of all objects are streamed one after the other.
+      // Float16_t and Double32_t are not, as their values are packed.
+      const auto streamerType = element.GetStreamerType();
+      return streamerType > 0 && streamerType < TVirtualStreamerInfo::kOffsetL &&
+             streamerType != TVirtualStreamerInfo::kFloat16 && streamerType != TVirtualStreamerInfo::kDouble32 &&
+             streamerType == type;
+   }
+   if (element.GetType() == 0 && element.GetID() < 0) {
+      auto cl = TClass::GetClass(element.GetClassName());
+      auto proxy = cl ? cl->GetCollectionProxy() : nullptr;
+      hasHeader = true;
+      return proxy && proxy->GetCollectionType() == ROOT::kSTLvector && !proxy->GetValueClass() &&
+             proxy->GetType() == type;
+   }
+   return false;
+}
+} // anonymous namespace
+
+RJaggedBranchEntries::RJaggedBranchEntries(TTree &tree, std::string_view branchName, const std::type_info &valueType,
+                                           Long64_t begin, Long64_t end)
+{
+   const std::string name(branchName);
+   const auto localBegin = tree.LoadTree(begin);
+   if (localBegin < 0)
+      throw std::runtime_error("Cannot read entry " + std::to_string(begin) + " of tree " + tree.GetName() + ".");
+   auto localTree = tree.GetTree();
+   fEntry = localBegin;
+   fEndEntry = end < 0 ? localTree->GetEntries() : localBegin + (end - begin);
+   if (fEndEntry < fEntry || fEndEntry > localTree->GetEntries())
+      throw std::runtime_error("The entries to read of branch " + name + " must belong to a single tree.");
+
+   fBranch = localTree->GetBranch(name.c_str());
+   if (!fBranch)
+      fBranch = localTree->FindBranch(name.c_str());
+   if (!fBranch)
+      throw std::runtime_error("Unknown branch " + name + ".");
+
+   const auto type = TDataType::GetType(valueType);
+   if (type == kOther_t || type == kCharStar || !HoldsValuesOf(*fBranch, type, fHasHeader))
+      throw std::runtime_error("Branch " + name + " does not hold arrays of " + TDataType::GetTypeName(type) +
+                               " which can be read from its baskets.");
+   fValueSize = TDataType::GetDataType(type)->Size();
+}
+
+void RJaggedBranchEntries::LoadBasket()
+{
+   const auto basketNumber = TMath::BinarySearch(fBranch->GetWriteBasket() + 1, fBranch->GetBasketEntry(), fEntry);
+   // do not keep in memory the baskets already read, as TBranch::GetEntry does
+   fBranch->DropBaskets();
+   fBasket = basketNumber < 0 ? nullptr : fBranch->GetBasket(basketNumber);
+   if (!fBasket || !fBasket->GetBufferRef())
+      throw std::runtime_error(std::string("Cannot read the basket of entry ") + std::to_string(fEntry) +
+                               " of branch " + fBranch->GetName() + ".");
+   if (!fBasket->GetBufferRef()->IsReading())
+      fBasket->SetReadMode();
+   fBasketFirstEntry = fBranch->GetBasketEntry()[basketNumber];
+   fBasketEndEntry = basketNumber == fBranch->GetWriteBasket() ? fBranch->GetEntryNumber()
+                                                                 : fBranch->GetBasketEntry()[basketNumber + 1];
+}
+
+bool RJaggedBranchEntries::Next()
+{
+   if (fEntry >= fEndEntry)
+      return false;
+   if (!fBasket || fEntry < fBasketFirstEntry || fEntry >= fBasketEndEntry)
+      LoadBasket();
+
+   const Int_t entryInBasket = fEntry - fBasketFirstEntry;
+   auto entryOffsets = fBasket->GetEntryOffset();
+   if (entryOffsets) {
+      fEntryBegin = entryOffsets[entryInBasket];
+      fEntryEnd = entryInBasket + 1 < fBasket->GetNevBuf() ? entryOffsets[entryInBasket + 1] : fBasket->GetLast();
+   } else {
+      fEntryBegin = fBasket->GetKeylen() + entryInBasket * fBasket->GetNevBufSize();
+      fEntryEnd = fEntryBegin + fBasket->GetNevBufSize();
+   }
+   ++fEntry;
+   return true;
+}
+
+UInt_t RJaggedBranchEntries::ReadNValues()
+{
+   auto &buffer = GetBuffer();
+   buffer.SetBufferOffset(fEntryBegin);
+   if (!fHasHeader)
+      return (fEntryEnd - fEntryBegin) / fValueSize;
+
+   UInt_t start = 0, byteCount = 0;
+   buffer.ReadVersion(&start, &byteCount);
+   Int_t nValues = 0;
+   buffer >> nValues;
+   if (nValues < 0 || buffer.Length() + nValues * fValueSize > fEntryEnd)
+      throw std::runtime_error(std::string("Corrupted entry ") + std::to_string(fEntry - 1) + " in branch " +
+                               fBranch->GetName() + ".");
+   return nValues;
+}
+
+TBuffer &RJaggedBranchEntries::GetBuffer()
+{
+   return *fBasket->GetBufferRef();
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
@@ -15,6 +15,7 @@
 #include "ROOT/RDataSource.hxx"
 #include "ROOT/TTreeProcessorMT.hxx"
 #include "ROOT/RStringView.hxx"
+#include "TFile.h"
 #include "TTree.h"
 #ifdef R__USE_IMT
 #include "ROOT/TThreadExecutor.hxx"
@@ -26,6 +27,7 @@
 #include <memory>
 #include <mutex>
 #include <numeric>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -104,6 +106,11 @@ void RFilterBase::FillReport(ROOT::RDF::RCutFlowReport &rep) const
    rep.AddCut({fName, accepted, all});
 }
 
+std::string RFilterBase::GetProfileName() const
+{
+   return fName.empty() ? RDFInternal::GetProfileNodeName("Filter", GetColumnNames()) : fName;
+}
+
 void RFilterBase::InitNode()
 {
    fLastCheckedEntry = std::vector<Long64_t>(fNSlots, -1);
@@ -170,6 +177,12 @@ void RJittedFilter::TriggerChildrenCount()
    fConcreteFilter->TriggerChildrenCount();
 }
 
+bool RJittedFilter::HasChildren() const
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->HasChildren();
+}
+
 void RJittedFilter::ResetReportCount()
 {
    R__ASSERT(fConcreteFilter != nullptr);
@@ -188,6 +201,24 @@ void RJittedFilter::InitNode()
    fConcreteFilter->InitNode();
 }
 
+const ColumnNames_t &RJittedFilter::GetColumnNames() const
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->GetColumnNames();
+}
+
+bool RJittedFilter::HangsFromLoopManager() const
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->HangsFromLoopManager();
+}
+
+void RJittedFilter::SetProfiler(RDFInternal::RLoopProfiler *profiler, unsigned int id)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   fConcreteFilter->SetProfiler(profiler, id);
+}
+
 void TSlotStack::ReturnSlot(unsigned int slotNumber)
 {
    auto &index = GetIndex();
@@ -298,8 +329,11 @@ void RLoopManager::RunTreeProcessorMT()
    tp->Process([this, &slotStack](TTreeReader &r) -> void {
       auto slot = slotStack.GetSlot();
       InitNodeSlots(&r, slot);
-      // recursive call to check filters and conditionally execute actions
+      // the cache is set up once the first entry of each tree is loaded, before any branch is read
+      int treeNumber = -1;
       while (r.Next()) {
+         SetupTreeCache(*r.GetTree(), treeNumber);
+         // recursive call to check filters and conditionally execute actions
          RunAndCheckFilters(slot, r.GetCurrentEntry());
       }
       CleanUpTask(slot);
@@ -316,10 +350,16 @@ void RLoopManager::RunTreeReader()
       return;
    InitNodeSlots(&r, 0);
 
+   // the cache is set up once the first entry of each tree is loaded, before any branch is read
+   int treeNumber = -1;
+   auto hasEntry = r.Next();
+
    // recursive call to check filters and conditionally execute actions
    // in the non-MT case processing can be stopped early by ranges, hence the check on fNStopsReceived
-   while (r.Next() && fNStopsReceived < fNChildren) {
+   while (hasEntry && fNStopsReceived < fNChildren) {
+      SetupTreeCache(*r.GetTree(), treeNumber);
       RunAndCheckFilters(0, r.GetCurrentEntry());
+      hasEntry = r.Next();
    }
    fTree->GetEntry(0);
 }
@@ -409,6 +449,44 @@ void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
       ptr->InitSlot(r, slot);
    for (auto &callback : fCallbacksOnce)
       callback(slot);
+   if (fProfiler)
+      fProfiler->StartTask(slot);
+}
+
+/// Hand the profiler to the nodes and register them and the columns they read, if the event loop is profiled.
+/// Otherwise make sure that no node refers to the profiler of a previous event loop.
+void RLoopManager::SetupProfiler()
+{
+   auto p = fProfiler.get();
+   std::set<std::string> usedColumns;
+   for (auto &filter : fBookedFilters)
+      usedColumns.insert(filter->GetColumnNames().begin(), filter->GetColumnNames().end());
+   for (auto &nameAndColumn : fBookedCustomColumns)
+      usedColumns.insert(nameAndColumn.second->GetColumnNames().begin(), nameAndColumn.second->GetColumnNames().end());
+   for (auto &action : fBookedActions)
+      usedColumns.insert(action->GetColumnNames().begin(), action->GetColumnNames().end());
+
+   for (auto &filter : fBookedFilters)
+      filter->SetProfiler(p, p ? p->AddNode(filter->GetProfileName()) : 0u);
+   // custom columns that are never used, e.g. the implicit ones, are left out of the report
+   for (auto &nameAndColumn : fBookedCustomColumns) {
+      auto &column = nameAndColumn.second;
+      if (!p || usedColumns.count(nameAndColumn.first) == 0)
+         column->SetProfiler(nullptr, 0u);
+      else if (column->IsDataSourceColumn())
+         column->SetProfiler(p, p->AddColumn(column->GetName()));
+      else
+         column->SetProfiler(p, p->AddNode("Define " + column->GetName()));
+   }
+   for (auto &action : fBookedActions)
+      action->SetProfiler(p, p ? p->AddNode(action->GetProfileName()) : 0u);
+
+   if (!p)
+      return;
+   // the columns which are not custom columns are read from the input tree
+   for (auto &column : usedColumns)
+      if (fBookedCustomColumns.find(column) == fBookedCustomColumns.end())
+         p->AddColumn(column);
 }
 
 /// Initialize all nodes of the functional graph before running the event loop.
@@ -418,6 +496,9 @@ void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
 void RLoopManager::InitNodes()
 {
    EvalChildrenCounts();
+   if (fTree)
+      EvalEagerColumns();
+   SetupProfiler();
    for (auto &filter : fBookedFilters)
       filter->InitNode();
    for (auto &customColumn : fBookedCustomColumns)
@@ -457,8 +538,12 @@ void RLoopManager::CleanUpNodes()
 /// Perform clean-up operations. To be called at the end of each task execution.
 void RLoopManager::CleanUpTask(unsigned int slot)
 {
-   for (auto &ptr : fBookedActions)
+   if (fProfiler)
+      fProfiler->EndTask(slot);
+   for (auto &ptr : fBookedActions) {
+      ptr->FinalizeTask(slot);
       ptr->ClearValueReaders(slot);
+   }
    for (auto &ptr : fBookedFilters)
       ptr->ClearValueReaders(slot);
    for (auto &pair : fBookedCustomColumns)
@@ -469,7 +554,10 @@ void RLoopManager::CleanUpTask(unsigned int slot)
 void RLoopManager::JitActions()
 {
    auto error = TInterpreter::EErrorCode::kNoError;
+   const auto start = RDFInternal::RLoopProfiler::Clock_t::now();
    gInterpreter->Calc(fToJit.c_str(), &error);
+   if (fProfiler)
+      fProfiler->AddJitTime(RDFInternal::RLoopProfiler::Clock_t::now() - start);
    if (TInterpreter::EErrorCode::kNoError != error) {
       std::string exceptionText =
          "An error occurred while jitting. The lines above might indicate the cause of the crash\n";
@@ -492,6 +580,85 @@ void RLoopManager::EvalChildrenCounts()
       namedFilterPtr->TriggerChildrenCount();
 }
 
+/// Find the columns that are read for every entry: the ones used by the nodes that hang directly from this object,
+/// including the inputs of the custom columns among them (recursively). All other columns are only read for the
+/// entries that pass a filter or a range. Must be called after EvalChildrenCounts.
+void RLoopManager::EvalEagerColumns()
+{
+   std::set<std::string> eagerColumns, allColumns;
+   auto addColumns = [this](const ColumnNames_t &columns, std::set<std::string> &columnSet) {
+      std::vector<std::string> toVisit(columns.begin(), columns.end());
+      while (!toVisit.empty()) {
+         const auto column = toVisit.back();
+         toVisit.pop_back();
+         if (!columnSet.insert(column).second)
+            continue;
+         const auto customColumnIt = fBookedCustomColumns.find(column);
+         if (customColumnIt != fBookedCustomColumns.end()) {
+            const auto &inputs = customColumnIt->second->GetColumnNames();
+            toVisit.insert(toVisit.end(), inputs.begin(), inputs.end());
+         }
+      }
+   };
+
+   for (const auto &actionPtr : fBookedActions) {
+      addColumns(actionPtr->GetColumnNames(), allColumns);
+      if (actionPtr->HangsFromLoopManager())
+         addColumns(actionPtr->GetColumnNames(), eagerColumns);
+   }
+   for (const auto &filterPtr : fBookedFilters) {
+      // filters which are not part of this event loop are skipped
+      if (!filterPtr->HasName() && !filterPtr->HasChildren())
+         continue;
+      addColumns(filterPtr->GetColumnNames(), allColumns);
+      if (filterPtr->HangsFromLoopManager())
+         addColumns(filterPtr->GetColumnNames(), eagerColumns);
+   }
+
+   fEagerColumns.assign(eagerColumns.begin(), eagerColumns.end());
+   fHasLazyColumns = eagerColumns.size() != allColumns.size();
+}
+
+/// Restrict the read cache of the tree to the branches that are read for every entry, so that baskets of the other
+/// branches are only loaded and decompressed when an entry that passed the filters upstream actually needs them.
+/// This is done by adding the eager branches to the TTreeCache and stopping its learning phase: otherwise the cache
+/// would prefetch, for every cluster, all the branches read during its learning phase.
+/// Nothing is done if no column is read lazily or if the tree has no read cache.
+/// This is called for every entry, with the number of the tree of the previous entry: the cache is only set up again
+/// when a chain moves to another tree, since the file of that tree can come with a new cache in its learning phase.
+void RLoopManager::SetupTreeCache(TTree &tree, int &treeNumber)
+{
+   if (tree.GetTreeNumber() == treeNumber)
+      return;
+   treeNumber = tree.GetTreeNumber();
+   auto file = tree.GetCurrentFile();
+   if (!fHasLazyColumns || !file || !file->GetCacheRead(tree.GetTree()))
+      return;
+   for (const auto &column : fEagerColumns) {
+      if (tree.GetBranch(column.c_str()))
+         tree.AddBranchToCache(column.c_str(), /*subbranches=*/true);
+   }
+   tree.StopCacheLearningPhase();
+}
+
+/// Hand down to the data source the selections of the filter that all entries go through, if there is one.
+/// This is only possible if the filter is unnamed and it is the only active node hanging from this object: then no
+/// other node, cut-flow report or callback can observe the entries that it rejects.
+/// Must be called after EvalChildrenCounts.
+void RLoopManager::PushDownColumnRanges()
+{
+   std::vector<ROOT::RDF::RColumnRange> ranges;
+   if (fNChildren == 1 && fCallbacks.empty()) {
+      for (const auto &filterAndRanges : fDSColumnRanges) {
+         if (filterAndRanges.first->HasChildren()) {
+            ranges = filterAndRanges.second;
+            break;
+         }
+      }
+   }
+   fDataSource->SetColumnRanges(ranges);
+}
+
 unsigned int RLoopManager::GetNextID() const
 {
    static unsigned int id = 0;
@@ -503,10 +670,18 @@ unsigned int RLoopManager::GetNextID() const
 /// Also perform a few setup and clean-up operations (jit actions if necessary, clear booked actions after the loop...).
 void RLoopManager::Run()
 {
+   if (!fProfileReports.empty())
+      fProfiler.reset(new RDFInternal::RLoopProfiler(fNSlots));
+
    if (!fToJit.empty())
       JitActions();
 
    InitNodes();
+   if (fDataSource)
+      PushDownColumnRanges();
+
+   if (fProfiler)
+      fProfiler->StartLoop();
 
    switch (fLoopType) {
    case ELoopType::kNoFilesMT: RunEmptySourceMT(); break;
@@ -517,6 +692,15 @@ void RLoopManager::Run()
    case ELoopType::kDataSource: RunDataSource(); break;
    }
 
+   // the reports must be filled before CleanUpNodes marks the results as ready
+   if (fProfiler) {
+      fProfiler->EndLoop();
+      for (auto &report : fProfileReports)
+         *report = fProfiler->MakeReport();
+      fProfileReports.clear();
+      fProfiler.reset();
+   }
+
    CleanUpNodes();
 }
 
@@ -592,6 +776,12 @@ void RLoopManager::RegisterCallback(ULong64_t everyNEvents, std::function<void(u
       fCallbacks.emplace_back(everyNEvents, std::move(f), fNSlots);
 }
 
+/// Register the selections on data-source columns that are equivalent to a filter hanging from this object.
+void RLoopManager::AddDataSourceColumnRanges(RFilterBase *filter, std::vector<ROOT::RDF::RColumnRange> &&ranges)
+{
+   fDSColumnRanges.emplace_back(filter, std::move(ranges));
+}
+
 RRangeBase::RRangeBase(RLoopManager *implPtr, unsigned int start, unsigned int stop, unsigned int stride,
                        const unsigned int nSlots)
    : fLoopManager(implPtr), fStart(start), fStop(stop), fStride(stride), fNSlots(nSlots)
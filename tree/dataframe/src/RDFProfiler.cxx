@@ -0,0 +1,214 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDFProfiler.hxx"
+#include "TBranch.h"
+#include "TClassEdit.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+namespace {
+double ToSeconds(RLoopProfiler::Clock_t::duration t)
+{
+   return std::chrono::duration_cast<std::chrono::duration<double>>(t).count();
+}
+
+template <typename T>
+T &GrowAndGet(std::vector<T> &v, unsigned int idx)
+{
+   if (idx >= v.size())
+      v.resize(idx + 1);
+   return v[idx];
+}
+} // anonymous namespace
+
+unsigned int RLoopProfiler::AddNode(const std::string &name)
+{
+   fNodeNames.emplace_back(name);
+   return fNodeNames.size() - 1;
+}
+
+unsigned int RLoopProfiler::AddColumn(const std::string &name)
+{
+   const auto it = fColumnIds.find(name);
+   if (it != fColumnIds.end())
+      return it->second;
+   fColumnNames.emplace_back(name);
+   return fColumnIds[name] = fColumnNames.size() - 1;
+}
+
+int RLoopProfiler::FindColumn(const std::string &name) const
+{
+   const auto it = fColumnIds.find(name);
+   return it == fColumnIds.end() ? -1 : int(it->second);
+}
+
+void RLoopProfiler::EndLoop()
+{
+   // sequential event loops do not signal the end of their only task
+   for (auto slot = 0u; slot < fSlots.size(); ++slot)
+      if (fSlots[slot].fIsInTask)
+         EndTask(slot);
+   fLoopEnd = Clock_t::now();
+}
+
+void RLoopProfiler::StartTask(unsigned int slot)
+{
+   auto &record = fSlots[slot];
+   // an interleaved task, executed by the same thread while the other one waits, is part of the outer task
+   if (record.fIsInTask)
+      return;
+   record.fTasks.emplace_back(Clock_t::now(), Clock_t::time_point());
+   record.fIsInTask = true;
+}
+
+void RLoopProfiler::EndTask(unsigned int slot)
+{
+   auto &record = fSlots[slot];
+   if (!record.fIsInTask)
+      return;
+   record.fTasks.back().second = Clock_t::now();
+   record.fIsInTask = false;
+}
+
+void RLoopProfiler::ExitScope(unsigned int slot, EScopeKind kind, unsigned int id)
+{
+   auto &record = fSlots[slot];
+   const auto scope = record.fScopes.back();
+   record.fScopes.pop_back();
+   const auto total = Clock_t::now() - scope.fStart;
+   if (!record.fScopes.empty())
+      record.fScopes.back().fNested += total;
+
+   if (kind == EScopeKind::kNode) {
+      GrowAndGet(record.fNodeTimes, id) += total - scope.fNested;
+      ++GrowAndGet(record.fNodeCalls, id);
+   } else {
+      GrowAndGet(record.fColumnTimes, id) += total - scope.fNested;
+      ++GrowAndGet(record.fColumnReads, id);
+   }
+}
+
+void RLoopProfiler::AddColumnBytes(unsigned int slot, unsigned int columnId, ULong64_t bytes)
+{
+   GrowAndGet(fSlots[slot].fColumnBytes, columnId) += bytes;
+}
+
+ROOT::RDF::RProfileReport RLoopProfiler::MakeReport() const
+{
+   ROOT::RDF::RProfileReport report;
+   report.fJitTime = ToSeconds(fJitTime);
+   report.fLoopTime = ToSeconds(fLoopEnd - fLoopStart);
+
+   for (auto id = 0u; id < fNodeNames.size(); ++id) {
+      Clock_t::duration time(0);
+      ULong64_t nCalls = 0;
+      for (const auto &record : fSlots) {
+         if (id < record.fNodeTimes.size()) {
+            time += record.fNodeTimes[id];
+            nCalls += record.fNodeCalls[id];
+         }
+      }
+      report.fNodes.push_back({fNodeNames[id], ToSeconds(time), nCalls});
+   }
+
+   for (auto id = 0u; id < fColumnNames.size(); ++id) {
+      Clock_t::duration time(0);
+      ULong64_t nReads = 0;
+      ULong64_t bytes = 0;
+      for (const auto &record : fSlots) {
+         if (id < record.fColumnTimes.size()) {
+            time += record.fColumnTimes[id];
+            nReads += record.fColumnReads[id];
+         }
+         if (id < record.fColumnBytes.size())
+            bytes += record.fColumnBytes[id];
+      }
+      report.fColumns.push_back({fColumnNames[id], ToSeconds(time), nReads, bytes});
+   }
+
+   for (auto slot = 0u; slot < fSlots.size(); ++slot) {
+      Clock_t::duration busyTime(0);
+      for (const auto &task : fSlots[slot].fTasks) {
+         busyTime += task.second - task.first;
+         report.fTasks.push_back({slot, ToSeconds(task.first - fLoopStart), ToSeconds(task.second - fLoopStart)});
+      }
+      report.fSlots.push_back({ToSeconds(busyTime), std::max(0., report.fLoopTime - ToSeconds(busyTime))});
+   }
+   std::sort(report.fTasks.begin(), report.fTasks.end(),
+             [](const ROOT::RDF::RProfileReport::RTaskTime &a, const ROOT::RDF::RProfileReport::RTaskTime &b) {
+                return a.fStart < b.fStart;
+             });
+
+   return report;
+}
+
+RColumnReadProfile::RColumnReadProfile(RLoopProfiler *profiler, unsigned int slot, TTreeReader *r,
+                                       const std::string &branchName)
+   : fSlot(slot), fReader(r), fBranchName(branchName)
+{
+   const auto id = profiler ? profiler->FindColumn(branchName) : -1;
+   if (id >= 0) {
+      fProfiler = profiler;
+      fColumnId = id;
+   }
+}
+
+void RColumnReadProfile::CountBasketBytes()
+{
+   auto tree = fReader->GetTree() ? fReader->GetTree()->GetTree() : nullptr;
+   if (tree != fTree) {
+      fTree = tree;
+      fBranch = tree ? tree->GetBranch(fBranchName.c_str()) : nullptr;
+      fLastBasket = -1;
+   }
+   if (!fBranch)
+      return;
+   const auto basket = fBranch->GetReadBasket();
+   if (basket == fLastBasket || basket < 0)
+      return;
+   fLastBasket = basket;
+   fProfiler->AddColumnBytes(fSlot, fColumnId, fBranch->GetBasketBytes()[basket]);
+}
+
+std::string GetProfileNodeName(std::string_view kind, const std::vector<std::string> &columns)
+{
+   std::string name(kind);
+   name += "(";
+   for (auto i = 0u; i < columns.size(); ++i)
+      name += (i == 0 ? "" : ", ") + columns[i];
+   return name + ")";
+}
+
+std::string GetProfileNodeName(const std::type_info &helperType, const std::vector<std::string> &columns)
+{
+   int err = 0;
+   char *demangled = TClassEdit::DemangleTypeIdName(helperType, err);
+   std::string kind = demangled ? demangled : helperType.name();
+   free(demangled);
+   // drop the template arguments, then the namespaces and the Helper suffix
+   kind = kind.substr(0, kind.find('<'));
+   const auto lastColon = kind.rfind(':');
+   if (lastColon != std::string::npos)
+      kind = kind.substr(lastColon + 1);
+   const std::string suffix = "Helper";
+   if (kind.size() > suffix.size() && kind.compare(kind.size() - suffix.size(), suffix.size(), suffix) == 0)
+      kind.resize(kind.size() - suffix.size());
+   return GetProfileNodeName(kind, columns);
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
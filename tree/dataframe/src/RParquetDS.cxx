@@ -0,0 +1,530 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// clang-format off
+/** \class ROOT::RDF::RParquetDS
+    \ingroup dataframe
+    \brief RDataFrame data source class for reading Apache Parquet files.
+
+The RParquetDS class implements a Parquet file reader for RDataFrame, based on the
+Apache Arrow bindings of the Parquet C++ library.
+
+A RDataFrame that reads from a Parquet file can be constructed using the factory method
+ROOT::RDF::MakeParquetDataFrame, which accepts two parameters:
+1. Path to the Parquet file.
+2. The names of the columns to make available (optional). If empty, all columns are used.
+
+Only top-level columns of the following types are supported: 32 and 64 bit signed and unsigned
+integers, float, double, boolean and string. Their types are mapped respectively to `int`, `unsigned int`,
+`Long64_t`, `ULong64_t`, `float`, `double`, `bool` and `std::string`.
+
+Each row group of the file corresponds to one range of entries. Different slots decode different
+row groups concurrently, each with its own file reader, and only the columns that are actually read by
+the RDataFrame computation graph are decoded. Numerical values are read in place from the decoded
+Arrow arrays.
+
+Row groups can be skipped using the minimum and maximum values stored in the file for each column:
+~~~{.cpp}
+auto ds = std::make_unique<ROOT::RDF::RParquetDS>("data.parquet");
+ds->AddRowGroupFilter("pt", 20., std::numeric_limits<double>::max()); // only row groups which might contain pt >= 20
+ROOT::RDataFrame df(std::move(ds));
+auto h = df.Filter("pt >= 20").Histo1D("pt"); // the selection must still be applied to the single entries
+~~~
+Entries keep the numbers they have in the file when row groups are skipped: the entry numbers, e.g. the values
+of `rdfentry_`, of the selected row groups are not contiguous.
+*/
+// clang-format on
+
+#include <ROOT/RDFUtils.hxx>
+#include <ROOT/RParquetDS.hxx>
+#include <ROOT/RMakeUnique.hxx>
+#include <ROOT/TSeq.hxx>
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#endif
+#include <arrow/io/file.h>
+#include <arrow/table.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/arrow/schema.h>
+#include <parquet/metadata.h>
+#include <parquet/statistics.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Per-slot, per-column helper that points to the values of a column of the row group being processed.
+class TParquetValueGetter : public ::arrow::ArrayVisitor {
+private:
+   /// The pointer RDataFrame reads the value from.
+   void *fValuePtr = nullptr;
+   bool fCachedBool{false}; // Booleans need to be unpacked, so we use a cached entry.
+   std::string fCachedString;
+   /// The index of the current value in the current chunk.
+   int64_t fIndex = 0;
+   /// The decoded arrays of the column in the current row group.
+   ::arrow::ArrayVector fChunks;
+   std::size_t fCurrentChunk = 0;
+   /// The entry in the row group corresponding to the first value of the current chunk.
+   ULong64_t fCurrentChunkFirstEntry = 0;
+
+public:
+   void **GetValuePtrAddress() { return &fValuePtr; }
+
+   void SetChunks(::arrow::ArrayVector chunks)
+   {
+      fChunks = std::move(chunks);
+      fCurrentChunk = 0;
+      fCurrentChunkFirstEntry = 0;
+   }
+
+   /// Point to the value of the given entry of the row group.
+   void SetEntry(ULong64_t entry)
+   {
+      // Entries are typically requested in increasing order, so we only go back to the first chunk if needed
+      if (entry < fCurrentChunkFirstEntry) {
+         fCurrentChunk = 0;
+         fCurrentChunkFirstEntry = 0;
+      }
+      while (entry >= fCurrentChunkFirstEntry + fChunks[fCurrentChunk]->length()) {
+         fCurrentChunkFirstEntry += fChunks[fCurrentChunk]->length();
+         ++fCurrentChunk;
+         assert(fCurrentChunk < fChunks.size());
+      }
+      fIndex = entry - fCurrentChunkFirstEntry;
+
+      auto status = fChunks[fCurrentChunk]->Accept(this);
+      if (!status.ok()) {
+         std::string msg = "Could not get pointer to entry ";
+         msg += std::to_string(entry) + " of a row group: " + status.ToString();
+         throw std::runtime_error(msg);
+      }
+   }
+
+   ::arrow::Status Visit(::arrow::Int32Array const &array) final
+   {
+      fValuePtr = (void *)(array.raw_values() + fIndex);
+      return ::arrow::Status::OK();
+   }
+
+   ::arrow::Status Visit(::arrow::UInt32Array const &array) final
+   {
+      fValuePtr = (void *)(array.raw_values() + fIndex);
+      return ::arrow::Status::OK();
+   }
+
+   ::arrow::Status Visit(::arrow::Int64Array const &array) final
+   {
+      fValuePtr = (void *)(array.raw_values() + fIndex);
+      return ::arrow::Status::OK();
+   }
+
+   ::arrow::Status Visit(::arrow::UInt64Array const &array) final
+   {
+      fValuePtr = (void *)(array.raw_values() + fIndex);
+      return ::arrow::Status::OK();
+   }
+
+   ::arrow::Status Visit(::arrow::FloatArray const &array) final
+   {
+      fValuePtr = (void *)(array.raw_values() + fIndex);
+      return ::arrow::Status::OK();
+   }
+
+   ::arrow::Status Visit(::arrow::DoubleArray const &array) final
+   {
+      fValuePtr = (void *)(array.raw_values() + fIndex);
+      return ::arrow::Status::OK();
+   }
+
+   ::arrow::Status Visit(::arrow::BooleanArray const &array) final
+   {
+      fCachedBool = array.Value(fIndex);
+      fValuePtr = reinterpret_cast<void *>(&fCachedBool);
+      return ::arrow::Status::OK();
+   }
+
+   ::arrow::Status Visit(::arrow::StringArray const &array) final
+   {
+      fCachedString = array.GetString(fIndex);
+      fValuePtr = reinterpret_cast<void *>(&fCachedString);
+      return ::arrow::Status::OK();
+   }
+
+   using ::arrow::ArrayVisitor::Visit;
+};
+
+/// Helper to get the name of the type of a column, which also checks that the type is supported.
+class TParquetTypeNameGetter : public ::arrow::TypeVisitor {
+private:
+   std::string fTypeName;
+
+   ::arrow::Status SetName(const char *name)
+   {
+      fTypeName = name;
+      return ::arrow::Status::OK();
+   }
+
+public:
+   ::arrow::Status Visit(const ::arrow::Int32Type &) override { return SetName("int"); }
+   ::arrow::Status Visit(const ::arrow::UInt32Type &) override { return SetName("unsigned int"); }
+   ::arrow::Status Visit(const ::arrow::Int64Type &) override { return SetName("Long64_t"); }
+   ::arrow::Status Visit(const ::arrow::UInt64Type &) override { return SetName("ULong64_t"); }
+   ::arrow::Status Visit(const ::arrow::FloatType &) override { return SetName("float"); }
+   ::arrow::Status Visit(const ::arrow::DoubleType &) override { return SetName("double"); }
+   ::arrow::Status Visit(const ::arrow::BooleanType &) override { return SetName("bool"); }
+   ::arrow::Status Visit(const ::arrow::StringType &) override { return SetName("std::string"); }
+   const std::string &GetTypeName() const { return fTypeName; }
+
+   using ::arrow::TypeVisitor::Visit;
+};
+
+/// Open a Parquet file and return a reader which decodes it into Arrow arrays.
+std::unique_ptr<parquet::arrow::FileReader> OpenParquetFile(const std::string &fileName)
+{
+   std::shared_ptr<::arrow::io::ReadableFile> file;
+   auto status = ::arrow::io::ReadableFile::Open(fileName, &file);
+   if (!status.ok()) {
+      std::string msg = "Cannot open file ";
+      msg += fileName + ": " + status.ToString();
+      throw std::runtime_error(msg);
+   }
+
+   std::unique_ptr<parquet::arrow::FileReader> reader;
+   status = parquet::arrow::OpenFile(file, ::arrow::default_memory_pool(), &reader);
+   if (!status.ok()) {
+      std::string msg = "Cannot read Parquet file ";
+      msg += fileName + ": " + status.ToString();
+      throw std::runtime_error(msg);
+   }
+   return reader;
+}
+
+/// Return false if the statistics of a column chunk guarantee that none of its values is in [min, max].
+/// Integer columns with unsigned logical type and non-numerical columns are never excluded.
+bool MayContainValuesInRange(const parquet::ColumnChunkMetaData &chunkMetaData, double min, double max)
+{
+   if (!chunkMetaData.is_stats_set())
+      return true;
+   const auto stats = chunkMetaData.statistics();
+   if (!stats || !stats->HasMinMax())
+      return true;
+   if (stats->descr()->logical_type() != parquet::LogicalType::NONE &&
+       stats->descr()->logical_type() != parquet::LogicalType::INT_32 &&
+       stats->descr()->logical_type() != parquet::LogicalType::INT_64)
+      return true;
+
+   double statMin = 0., statMax = 0.;
+   switch (stats->physical_type()) {
+   case parquet::Type::INT32: {
+      const auto typedStats = std::static_pointer_cast<parquet::Int32Statistics>(stats);
+      statMin = typedStats->min();
+      statMax = typedStats->max();
+      break;
+   }
+   case parquet::Type::INT64: {
+      const auto typedStats = std::static_pointer_cast<parquet::Int64Statistics>(stats);
+      statMin = typedStats->min();
+      statMax = typedStats->max();
+      break;
+   }
+   case parquet::Type::FLOAT: {
+      const auto typedStats = std::static_pointer_cast<parquet::FloatStatistics>(stats);
+      statMin = typedStats->min();
+      statMax = typedStats->max();
+      break;
+   }
+   case parquet::Type::DOUBLE: {
+      const auto typedStats = std::static_pointer_cast<parquet::DoubleStatistics>(stats);
+      statMin = typedStats->min();
+      statMax = typedStats->max();
+      break;
+   }
+   default: return true;
+   }
+
+   return statMax >= min && statMin <= max;
+}
+
+} // namespace RDF
+} // namespace Internal
+
+namespace RDF {
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor to create a Parquet RDataSource for RDataFrame.
+/// \param[in] fileName Path of the Parquet file.
+/// \param[in] columns The names of the columns to use. If empty, all the columns of the file are used.
+RParquetDS::RParquetDS(std::string_view fileName, const std::vector<std::string> &columns)
+   : fFileName(fileName), fColumnNames(columns)
+{
+   auto reader = ROOT::Internal::RDF::OpenParquetFile(fFileName);
+   fMetaData = reader->parquet_reader()->metadata();
+   auto status = parquet::arrow::FromParquetSchema(fMetaData->schema(), &fSchema);
+   if (!status.ok()) {
+      std::string msg = "Cannot convert the schema of Parquet file ";
+      msg += fFileName + ": " + status.ToString();
+      throw std::runtime_error(msg);
+   }
+
+   if (fColumnNames.empty()) {
+      for (auto &field : fSchema->fields())
+         fColumnNames.push_back(field->name());
+   }
+
+   for (const auto &colName : fColumnNames) {
+      const auto fieldIdx = fSchema->GetFieldIndex(colName);
+      const auto columnIdx = fMetaData->schema()->ColumnIndex(colName);
+      if (fieldIdx < 0 || columnIdx < 0) {
+         std::string msg = "The dataset does not have column ";
+         msg += colName;
+         throw std::runtime_error(msg);
+      }
+      ROOT::Internal::RDF::TParquetTypeNameGetter typeGetter;
+      if (!fSchema->field(fieldIdx)->type()->Accept(&typeGetter).ok()) {
+         std::string msg = "Column ";
+         msg += colName + " contains an unsupported type.";
+         throw std::runtime_error(msg);
+      }
+      fColumnIndices.push_back(columnIdx);
+   }
+   fIsColumnRequested.resize(fColumnNames.size(), false);
+
+   SelectRowGroups();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+RParquetDS::~RParquetDS()
+{
+}
+
+/// Return the index of the column in fColumnNames, or throw if the column is not available.
+int RParquetDS::GetColumnIdx(std::string_view colName) const
+{
+   const auto it = std::find(fColumnNames.begin(), fColumnNames.end(), colName);
+   if (it == fColumnNames.end()) {
+      std::string msg = "The dataset does not have column ";
+      msg += colName;
+      throw std::runtime_error(msg);
+   }
+   return std::distance(fColumnNames.begin(), it);
+}
+
+/// Build the list of row groups to process, taking into account the row group filters and the column ranges.
+/// Entries are numbered as if all row groups were processed, so that skipping row groups does not renumber them.
+void RParquetDS::SelectRowGroups()
+{
+   fRowGroupRanges.clear();
+   ULong64_t nEntries = 0ULL;
+   for (auto rg : ROOT::TSeqI(fMetaData->num_row_groups())) {
+      const auto rgMetaData = fMetaData->RowGroup(rg);
+      const ULong64_t nRows = rgMetaData->num_rows();
+      const auto firstEntry = nEntries;
+      nEntries += nRows;
+      if (nRows == 0)
+         continue;
+
+      auto mayPass = [&](const RRowGroupFilter &f) {
+         const auto chunkMetaData = rgMetaData->ColumnChunk(fColumnIndices[f.fColumnIdx]);
+         return ROOT::Internal::RDF::MayContainValuesInRange(*chunkMetaData, f.fMin, f.fMax);
+      };
+      if (!std::all_of(fRowGroupFilters.begin(), fRowGroupFilters.end(), mayPass) ||
+          !std::all_of(fColumnRangeFilters.begin(), fColumnRangeFilters.end(), mayPass))
+         continue;
+
+      fRowGroupRanges.push_back({rg, firstEntry, nEntries});
+   }
+}
+
+const std::vector<std::string> &RParquetDS::GetColumnNames() const
+{
+   return fColumnNames;
+}
+
+std::vector<std::pair<ULong64_t, ULong64_t>> RParquetDS::GetEntryRanges()
+{
+   std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
+   if (fEntryRangesRequested)
+      return entryRanges;
+
+   // One range per row group: each row group is decoded by the slot that processes it
+   for (const auto &range : fRowGroupRanges)
+      entryRanges.emplace_back(range.fStart, range.fEnd);
+   fEntryRangesRequested = true;
+   return entryRanges;
+}
+
+std::string RParquetDS::GetTypeName(std::string_view colName) const
+{
+   const auto fieldIdx = fSchema->GetFieldIndex(fColumnNames[GetColumnIdx(colName)]);
+   ROOT::Internal::RDF::TParquetTypeNameGetter typeGetter;
+   fSchema->field(fieldIdx)->type()->Accept(&typeGetter);
+   return typeGetter.GetTypeName();
+}
+
+bool RParquetDS::HasColumn(std::string_view colName) const
+{
+   return fColumnNames.end() != std::find(fColumnNames.begin(), fColumnNames.end(), colName);
+}
+
+bool RParquetDS::SetEntry(unsigned int slot, ULong64_t entry)
+{
+   const auto rgEntry = entry - fSlotFirstEntry[slot];
+   for (auto col : ROOT::TSeqU(fColumnNames.size())) {
+      if (fIsColumnRequested[col])
+         fValueGetters[slot][col]->SetEntry(rgEntry);
+   }
+   return true;
+}
+
+void RParquetDS::InitSlot(unsigned int slot, ULong64_t firstEntry)
+{
+   const auto range = std::lower_bound(fRowGroupRanges.begin(), fRowGroupRanges.end(), firstEntry,
+                                       [](const RRowGroupRange &r, ULong64_t e) { return r.fStart < e; });
+   if (range == fRowGroupRanges.end() || range->fStart != firstEntry) {
+      std::string msg = "No row group starts at entry ";
+      msg += std::to_string(firstEntry);
+      throw std::runtime_error(msg);
+   }
+   fSlotFirstEntry[slot] = firstEntry;
+
+   // Decode only the columns which are read
+   std::vector<int> indices;
+   for (auto col : ROOT::TSeqU(fColumnNames.size())) {
+      if (fIsColumnRequested[col])
+         indices.push_back(fColumnIndices[col]);
+   }
+   if (indices.empty())
+      return;
+
+   auto &table = fSlotTables[slot];
+   auto status = fSlotReaders[slot]->ReadRowGroup(range->fRowGroup, indices, &table);
+   if (!status.ok()) {
+      std::string msg = "Cannot read row group ";
+      msg += std::to_string(range->fRowGroup) + " of file " + fFileName + ": " + status.ToString();
+      throw std::runtime_error(msg);
+   }
+
+   // The columns of the table are in the same order as the indices
+   auto tableColumn = 0;
+   for (auto col : ROOT::TSeqU(fColumnNames.size())) {
+      if (fIsColumnRequested[col])
+         fValueGetters[slot][col]->SetChunks(table->column(tableColumn++)->data()->chunks());
+   }
+}
+
+void RParquetDS::FinaliseSlot(unsigned int slot)
+{
+   // Release the memory of the decoded row group
+   for (auto &getter : fValueGetters[slot])
+      getter->SetChunks({});
+   fSlotTables[slot].reset();
+}
+
+void RParquetDS::SetNSlots(unsigned int nSlots)
+{
+   assert(0U == fNSlots && "Setting the number of slots even if the number of slots is different from zero.");
+
+   fNSlots = nSlots;
+   fSlotTables.resize(fNSlots);
+   fSlotFirstEntry.resize(fNSlots, 0ULL);
+   for (auto slot : ROOT::TSeqU(fNSlots)) {
+      fSlotReaders.emplace_back(ROOT::Internal::RDF::OpenParquetFile(fFileName));
+      fValueGetters.emplace_back();
+      for (auto col : ROOT::TSeqU(fColumnNames.size())) {
+         fValueGetters.back().emplace_back(std::make_unique<ROOT::Internal::RDF::TParquetValueGetter>());
+         (void)col;
+      }
+      (void)slot;
+   }
+}
+
+std::vector<void *> RParquetDS::GetColumnReadersImpl(std::string_view colName, const std::type_info &id)
+{
+   const auto colTypeName = GetTypeName(colName);
+   const auto &colTypeId = ROOT::Internal::RDF::TypeName2TypeID(colTypeName);
+   if (id != colTypeId) {
+      std::string err = "The type of column \"";
+      err += colName;
+      err += "\" is ";
+      err += colTypeName;
+      err += " but a different one has been selected.";
+      throw std::runtime_error(err);
+   }
+
+   const auto col = GetColumnIdx(colName);
+   fIsColumnRequested[col] = true;
+   std::vector<void *> ret(fNSlots);
+   for (auto slot : ROOT::TSeqU(fNSlots)) {
+      ret[slot] = fValueGetters[slot][col]->GetValuePtrAddress();
+   }
+   return ret;
+}
+
+void RParquetDS::Initialise()
+{
+   fEntryRangesRequested = false;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Skip the row groups in which no value of a column can be in the interval [min, max].
+/// \param[in] colName The name of the column.
+/// \param[in] min The minimum value of the interval.
+/// \param[in] max The maximum value of the interval.
+///
+/// The decision is taken using the minimum and maximum values of the column in each row group, as stored in the
+/// file. Row groups without statistics for the column are never skipped. This is a coarse selection: the
+/// corresponding selection of single entries must still be applied, e.g. with RInterface::Filter.
+/// Must be called before the event loop starts. Multiple filters are combined with a logical AND.
+void RParquetDS::AddRowGroupFilter(std::string_view colName, double min, double max)
+{
+   fRowGroupFilters.push_back({GetColumnIdx(colName), min, max});
+   SelectRowGroups();
+}
+
+/// The row groups which cannot contain entries passing the selections are not processed.
+void RParquetDS::SetColumnRanges(const std::vector<RColumnRange> &ranges)
+{
+   fColumnRangeFilters.clear();
+   for (const auto &range : ranges) {
+      if (HasColumn(range.fColumnName))
+         fColumnRangeFilters.push_back({GetColumnIdx(range.fColumnName), range.fMin, range.fMax});
+   }
+   SelectRowGroups();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Return the total number of row groups in the file.
+ULong64_t RParquetDS::GetNRowGroups() const
+{
+   return fMetaData->num_row_groups();
+}
+
+/// Creates a RDataFrame reading an Apache Parquet file.
+/// \param[in] fileName the path of the Parquet file.
+/// \param[in] columns the name of the columns to use
+/// In case columns is empty, we use all the columns found in the file
+RDataFrame MakeParquetDataFrame(std::string_view fileName, const std::vector<std::string> &columns)
+{
+   ROOT::RDataFrame tdf(std::make_unique<RParquetDS>(fileName, columns));
+   return tdf;
+}
+
+} // namespace RDF
+
+} // namespace ROOT
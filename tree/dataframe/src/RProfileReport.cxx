@@ -0,0 +1,103 @@
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RProfileReport.hxx"
+#include "TString.h"
+
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+
+namespace ROOT {
+
+namespace RDF {
+
+namespace {
+std::string EscapeJSON(const std::string &s)
+{
+   std::string escaped;
+   for (auto c : s) {
+      if (c == '"' || c == '\\')
+         escaped += '\\';
+      if (c == '\n')
+         escaped += "\\n";
+      else
+         escaped += c;
+   }
+   return escaped;
+}
+
+Long64_t ToMicroseconds(double seconds)
+{
+   return seconds * 1e6;
+}
+
+void WriteCompleteEvent(std::ostream &os, const std::string &name, unsigned int tid, double start, double end)
+{
+   os << "{\"name\": \"" << EscapeJSON(name) << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << tid
+      << ", \"ts\": " << ToMicroseconds(start) << ", \"dur\": " << ToMicroseconds(end) - ToMicroseconds(start) << "}";
+}
+} // anonymous namespace
+
+void RProfileReport::Print() const
+{
+   Printf("Event loop: %.3f s, jitting: %.3f s", fLoopTime, fJitTime);
+   Printf("%-40s %12s %14s", "Node", "time [s]", "calls");
+   for (const auto &node : fNodes)
+      Printf("%-40s %12.3f %14llu", node.fName.c_str(), node.fTime, node.fNCalls);
+   Printf("%-40s %12s %14s %14s", "Column", "time [s]", "reads", "bytes");
+   for (const auto &column : fColumns)
+      Printf("%-40s %12.3f %14llu %14llu", column.fName.c_str(), column.fTime, column.fNReads, column.fBytes);
+   Printf("%-40s %12s %14s", "Slot", "busy [s]", "idle [s]");
+   for (auto slot = 0u; slot < fSlots.size(); ++slot)
+      Printf("%-40u %12.3f %14.3f", slot, fSlots[slot].fBusyTime, fSlots[slot].fIdleTime);
+}
+
+/// Write the report in the Trace Event Format read by chrome://tracing: one row of events per slot, with an event
+/// per task. The times of the nodes and of the columns are stored as arguments of the event of the whole loop.
+void RProfileReport::WriteChromeTrace(std::ostream &os) const
+{
+   os << "{\"traceEvents\": [\n";
+   for (auto slot = 0u; slot < fSlots.size(); ++slot)
+      os << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << slot + 1
+         << ", \"args\": {\"name\": \"slot " << slot << "\"}},\n";
+   for (const auto &task : fTasks) {
+      WriteCompleteEvent(os, "task", task.fSlot + 1, task.fStart, task.fEnd);
+      os << ",\n";
+   }
+   // jitting happens right before the event loop, which starts at time 0 of the trace
+   WriteCompleteEvent(os, "jitting", 0, -fJitTime, 0.);
+   os << ",\n";
+   os << "{\"name\": \"event loop\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0, \"ts\": 0, \"dur\": "
+      << ToMicroseconds(fLoopTime) << ", \"args\": {";
+   // nodes can have the same name, e.g. two unnamed filters on the same column: their position keeps them apart
+   auto isFirst = true;
+   for (auto i = 0u; i < fNodes.size(); ++i) {
+      os << (isFirst ? "" : ", ") << "\"" << i << " " << EscapeJSON(fNodes[i].fName) << " [s]\": " << fNodes[i].fTime;
+      isFirst = false;
+   }
+   for (const auto &column : fColumns) {
+      os << (isFirst ? "" : ", ") << "\"column " << EscapeJSON(column.fName) << " [s]\": " << column.fTime
+         << ", \"column " << EscapeJSON(column.fName) << " [bytes]\": " << column.fBytes;
+      isFirst = false;
+   }
+   os << "}}\n]}\n";
+}
+
+void RProfileReport::SaveChromeTrace(std::string_view fileName) const
+{
+   const std::string fileNameStr(fileName);
+   std::ofstream os(fileNameStr);
+   if (!os)
+      throw std::runtime_error("Cannot open \"" + fileNameStr + "\" for writing.");
+   WriteChromeTrace(os);
+}
+
+} // End NS RDF
+
+} // End NS ROOT
@@ -1,6 +1,7 @@
 #include <ROOT/RDFUtils.hxx>
 #include <ROOT/RRootDS.hxx>
 #include <ROOT/TSeq.hxx>
+#include <TBranch.h>
 #include <TClass.h>
 #include <TROOT.h>         // For the gROOTMutex
 #include <TVirtualMutex.h> // For the R__LOCKGUARD
@@ -28,6 +29,7 @@ std::vector<void *> RRootDS::GetColumnReadersImpl(std::string_view name, const s
 
    const auto index =
       std::distance(fListOfBranches.begin(), std::find(fListOfBranches.begin(), fListOfBranches.end(), name));
+   fIsColumnRequested[index] = true;
    std::vector<void *> ret(fNSlots);
    for (auto slot : ROOT::TSeqU(fNSlots)) {
       ret[slot] = (void *)&fBranchAddresses[index][slot];
@@ -106,6 +108,7 @@ void RRootDS::InitSlot(unsigned int slot, ULong64_t firstEntry)
       }
    }
    fChains[slot].reset(chain);
+   fTreeNumbers[slot] = -1; // the branches are retrieved by the first SetEntry
 }
 
 void RRootDS::FinaliseSlot(unsigned int slot)
@@ -119,12 +122,41 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RRootDS::GetEntryRanges()
    return entryRanges;
 }
 
+/// Only the branches of the columns whose readers have been requested are read, and lazy ones are skipped.
 bool RRootDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
-   fChains[slot]->GetEntry(entry);
+   auto chain = fChains[slot].get();
+   fLocalEntries[slot] = chain->LoadTree(entry);
+   auto &branches = fBranches[slot];
+   if (chain->GetTreeNumber() != fTreeNumbers[slot]) {
+      // A new tree of the chain has been loaded, together with its branches
+      fTreeNumbers[slot] = chain->GetTreeNumber();
+      for (auto i : ROOT::TSeqU(fListOfBranches.size()))
+         branches[i] = fIsColumnRequested[i] ? chain->GetTree()->GetBranch(fListOfBranches[i].c_str()) : nullptr;
+   }
+   for (auto i : ROOT::TSeqU(fListOfBranches.size())) {
+      if (branches[i] && !fIsColumnLazy[i])
+         branches[i]->GetEntry(fLocalEntries[slot]);
+   }
+   return true;
+}
+
+/// The branch of the column will only be read when its value is needed, see LoadColumnValue.
+bool RRootDS::SetColumnLazy(std::string_view colName)
+{
+   const auto it = std::find(fListOfBranches.begin(), fListOfBranches.end(), colName);
+   if (it == fListOfBranches.end())
+      return false;
+   fIsColumnLazy[std::distance(fListOfBranches.begin(), it)] = true;
    return true;
 }
 
+void RRootDS::LoadColumnValue(unsigned int slot, std::size_t columnIdx)
+{
+   if (auto branch = fBranches[slot][columnIdx])
+      branch->GetEntry(fLocalEntries[slot]);
+}
+
 void RRootDS::SetNSlots(unsigned int nSlots)
 {
    assert(0U == fNSlots && "Setting the number of slots even if the number of slots is different from zero.");
@@ -136,6 +168,11 @@ void RRootDS::SetNSlots(unsigned int nSlots)
    fBranchAddresses.resize(nColumns, std::vector<void *>(fNSlots, nullptr));
 
    fChains.resize(fNSlots);
+   fIsColumnRequested.resize(nColumns, false);
+   fIsColumnLazy.resize(nColumns, false);
+   fBranches.resize(fNSlots, std::vector<TBranch *>(nColumns, nullptr));
+   fTreeNumbers.resize(fNSlots, -1);
+   fLocalEntries.resize(fNSlots, 0LL);
 }
 
 void RRootDS::Initialise()
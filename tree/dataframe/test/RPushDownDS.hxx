@@ -0,0 +1,69 @@
+#ifndef ROOT_RPUSHDOWNDS
+#define ROOT_RPUSHDOWNDS
+
+#include "ROOT/RDataSource.hxx"
+
+#include <string>
+#include <vector>
+
+/// A RDataSource with columns "x" = entry and "y" = 2 * entry, which records the selections it receives and reads its
+/// columns lazily, counting the values that are loaded
+class RPushDownDS : public ROOT::RDF::RDataSource {
+   unsigned int fNSlots = 0u;
+   const ULong64_t fNEntries = 10ull;
+   const std::vector<std::string> fColumnNames = {"x", "y"};
+   std::vector<ULong64_t> fEntries;
+   std::vector<std::vector<int>> fValues;     // fValues[column][slot]
+   std::vector<std::vector<int *>> fValuePtrs; // fValuePtrs[column][slot]
+   bool fEntryRangesRequested = false;
+
+public:
+   std::vector<ROOT::RDF::RColumnRange> fColumnRanges;
+   std::vector<unsigned int> fNLoadedValues = {0u, 0u}; // per column, only meaningful with one slot
+
+   void SetNSlots(unsigned int nSlots)
+   {
+      fNSlots = nSlots;
+      fEntries.resize(nSlots);
+      fValues.resize(2, std::vector<int>(nSlots));
+      fValuePtrs.resize(2, std::vector<int *>(nSlots));
+      for (auto col : {0, 1})
+         for (auto slot = 0u; slot < nSlots; ++slot)
+            fValuePtrs[col][slot] = &fValues[col][slot];
+   }
+   const std::vector<std::string> &GetColumnNames() const { return fColumnNames; }
+   bool HasColumn(std::string_view name) const { return name == "x" || name == "y"; }
+   std::string GetTypeName(std::string_view) const { return "int"; }
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges()
+   {
+      if (fEntryRangesRequested)
+         return {};
+      fEntryRangesRequested = true;
+      return {{0ull, fNEntries}};
+   }
+   bool SetEntry(unsigned int slot, ULong64_t entry)
+   {
+      fEntries[slot] = entry;
+      return true;
+   }
+   void Initialise() { fEntryRangesRequested = false; }
+   void SetColumnRanges(const std::vector<ROOT::RDF::RColumnRange> &ranges) { fColumnRanges = ranges; }
+   bool SetColumnLazy(std::string_view) { return true; }
+   void LoadColumnValue(unsigned int slot, std::size_t columnIdx)
+   {
+      fValues[columnIdx][slot] = (columnIdx + 1) * fEntries[slot];
+      ++fNLoadedValues[columnIdx];
+   }
+
+protected:
+   std::vector<void *> GetColumnReadersImpl(std::string_view name, const std::type_info &)
+   {
+      const auto col = name == "x" ? 0 : 1;
+      std::vector<void *> ret;
+      for (auto slot = 0u; slot < fNSlots; ++slot)
+         ret.emplace_back(&fValuePtrs[col][slot]);
+      return ret;
+   }
+};
+
+#endif
@@ -171,3 +171,78 @@ TEST(RDataFrameHistoModels, Histo3D)
    CheckBins(hm0w->GetYaxis(), ref1);
    CheckBins(hm0w->GetZaxis(), ref0);
 }
+
+TEST(RDataFrameHistoModels, HistoBundle)
+{
+   ROOT::RDataFrame tdf(20);
+   auto d = tdf.Define("x", [](ULong64_t e) { return e * 0.7 - 2.; }, {"tdfentry_"})
+               .Define("y", [](ULong64_t e) { return int(e % 7); }, {"tdfentry_"})
+               .Define("w", [](ULong64_t e) { return 1.f + e % 3; }, {"tdfentry_"});
+   std::vector<double> edges{0, 1, 2, 4, 8};
+
+   RHistoBundle bundle;
+   const auto i1 = bundle.Histo1D({"h1", "h1", 10, 0, 10}, "x");
+   const auto i1w = bundle.Histo1D({"h1w", "h1w", 10, 0, 10}, "x", "w");
+   const auto i1e = bundle.Histo1D({"h1e", "h1e", (int)edges.size() - 1, edges.data()}, "y", "w");
+   const auto i2 = bundle.Histo2D({"h2", "h2", 5, 0, 10, (int)edges.size() - 1, edges.data()}, "x", "y");
+   const auto i2w = bundle.Histo2D({"h2w", "h2w", 5, 0, 10, 7, 0, 7}, "x", "y", "w");
+   EXPECT_EQ(bundle.GetColumnNames(), std::vector<std::string>({"x", "w", "y"}));
+
+   auto typed = d.HistoBundle<double, float, int>(bundle);
+   auto jitted = d.HistoBundle(bundle);
+   ASSERT_EQ(typed.size(), 5u);
+   ASSERT_EQ(jitted.size(), 5u);
+
+   auto r1 = d.Histo1D<double>({"r1", "r1", 10, 0, 10}, "x");
+   auto r1w = d.Histo1D<double, float>({"r1w", "r1w", 10, 0, 10}, "x", "w");
+   auto r1e = d.Histo1D<int, float>({"r1e", "r1e", (int)edges.size() - 1, edges.data()}, "y", "w");
+   auto r2 = d.Histo2D<double, int>({"r2", "r2", 5, 0, 10, (int)edges.size() - 1, edges.data()}, "x", "y");
+   auto r2w = d.Histo2D<double, int, float>({"r2w", "r2w", 5, 0, 10, 7, 0, 7}, "x", "y", "w");
+   std::vector<::TH1 *> refs(5);
+   refs[i1] = r1.GetPtr();
+   refs[i1w] = r1w.GetPtr();
+   refs[i1e] = r1e.GetPtr();
+   refs[i2] = r2.GetPtr();
+   refs[i2w] = r2w.GetPtr();
+
+   for (auto i = 0u; i < refs.size(); ++i) {
+      for (auto results : {&typed, &jitted}) {
+         const auto &h = *(*results)[i];
+         const auto &ref = *refs[i];
+         EXPECT_STREQ(h.GetName(), bundle.GetHistos()[i].fModel->GetName());
+         ASSERT_EQ(h.GetNcells(), ref.GetNcells());
+         for (auto bin = 0; bin < ref.GetNcells(); ++bin) {
+            EXPECT_DOUBLE_EQ(h.GetBinContent(bin), ref.GetBinContent(bin));
+            EXPECT_DOUBLE_EQ(h.GetBinError(bin), ref.GetBinError(bin));
+         }
+         EXPECT_DOUBLE_EQ(h.GetEntries(), ref.GetEntries());
+         EXPECT_DOUBLE_EQ(h.GetMean(), ref.GetMean());
+         EXPECT_DOUBLE_EQ(h.GetStdDev(), ref.GetStdDev());
+         EXPECT_DOUBLE_EQ(h.GetMean(2), ref.GetMean(2));
+      }
+   }
+}
+
+TEST(RDataFrameHistoModels, HistoBundleBinEdges)
+{
+   // values on the bin edges of a range whose edges are not exactly representable
+   const double xmin = 0.1, xmax = 0.7;
+   std::vector<double> values;
+   for (auto n : ROOT::TSeqI(1, 61))
+      for (auto i : ROOT::TSeqI(n + 1))
+         values.emplace_back(xmin + (xmax - xmin) * i / n);
+
+   ROOT::RDataFrame tdf(values.size());
+   auto d = tdf.Define("x", [&values](ULong64_t e) { return values[e]; }, {"tdfentry_"});
+   RHistoBundle bundle;
+   bundle.Histo1D({"h", "h", 3, xmin, xmax}, "x");
+   auto histos = d.HistoBundle<double>(bundle);
+   ASSERT_EQ(histos.size(), 1u);
+
+   TH1D ref("ref", "ref", 3, xmin, xmax);
+   for (auto x : values)
+      ref.Fill(x);
+   const auto &h = *histos[0];
+   for (auto bin = 0; bin < ref.GetNcells(); ++bin)
+      EXPECT_EQ(h.GetBinContent(bin), ref.GetBinContent(bin)) << "bin " << bin;
+}
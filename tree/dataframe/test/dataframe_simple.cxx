@@ -6,14 +6,17 @@
 #include <TGraph.h>
 #include <TInterpreter.h>
 #include <TRandom.h>
+#include <TChain.h>
 #include <TROOT.h>
 #include <TSystem.h>
 #include <TTree.h>
+#include <TTreeCache.h>
 
 #include <algorithm> // std::sort
 #include <chrono>
 #include <thread>
 #include <set>
+#include <sstream>
 
 using namespace ROOT;
 using namespace ROOT::RDF;
@@ -513,6 +516,109 @@ TEST_P(RDFSimpleTests, BookCustomAction)
    EXPECT_EQ(*maxSlot, nWorkers-1);
 }
 
+TEST_P(RDFSimpleTests, LazyColumnsAfterFilter)
+{
+   auto fileName = "dataframe_simple_lazycolumns.root";
+   auto treeName = "lazycolumns";
+   FillTree(fileName, treeName, 20);
+   TFile f(fileName);
+   auto t = static_cast<TTree *>(f.Get(treeName));
+   t->SetCacheSize(10000000);
+   RDataFrame d(*t);
+   auto sumArray = [](const RVec<int> &b4) { return Sum(b4); };
+   auto s = d.Filter([](double b1) { return b1 > 17.; }, {"b1"}).Define("s", sumArray, {"b4"}).Sum<int>("s");
+   EXPECT_EQ(84, *s);
+
+   // only the branch needed for all entries is cached, b4 is only read for the entries that pass the filter
+   // (in MT runs the tasks read their own copies of the tree)
+   if (!GetParam()) {
+      auto cache = dynamic_cast<TTreeCache *>(f.GetCacheRead(t));
+      ASSERT_NE(nullptr, cache);
+      EXPECT_FALSE(cache->IsLearning());
+      EXPECT_NE(nullptr, cache->GetCachedBranches()->FindObject("b1"));
+      EXPECT_EQ(nullptr, cache->GetCachedBranches()->FindObject("b4"));
+   }
+   f.Close();
+   gSystem->Unlink(fileName);
+}
+
+TEST_P(RDFSimpleTests, LazyColumnsAfterFilterChain)
+{
+   const char *fileNames[2] = {"dataframe_simple_lazycolumns_1.root", "dataframe_simple_lazycolumns_2.root"};
+   auto treeName = "lazycolumns";
+   TChain chain(treeName);
+   for (auto fileName : fileNames) {
+      FillTree(fileName, treeName, 20);
+      chain.Add(fileName);
+   }
+   chain.SetCacheSize(10000000);
+
+   RDataFrame d(chain);
+   auto sumArray = [](const RVec<int> &b4) { return Sum(b4); };
+   auto filtered = d.Filter([](double b1) { return b1 > 17.; }, {"b1"}).Define("s", sumArray, {"b4"});
+   auto s = filtered.Sum<int>("s");
+
+   // the cache of each file of the chain is checked for the entries that pass the filter
+   // (in MT runs the tasks read their own copies of the chain)
+   std::vector<int> checkedTrees;
+   if (!GetParam()) {
+      auto checkCache = [&chain, &checkedTrees](int) {
+         auto cache = dynamic_cast<TTreeCache *>(chain.GetCurrentFile()->GetCacheRead(chain.GetTree()));
+         ASSERT_NE(nullptr, cache);
+         EXPECT_FALSE(cache->IsLearning());
+         EXPECT_NE(nullptr, cache->GetCachedBranches()->FindObject("b1"));
+         EXPECT_EQ(nullptr, cache->GetCachedBranches()->FindObject("b4"));
+         checkedTrees.emplace_back(chain.GetTreeNumber());
+      };
+      filtered.Foreach(checkCache, {"s"});
+      EXPECT_EQ(std::vector<int>({0, 0, 1, 1}), checkedTrees);
+   }
+   EXPECT_EQ(168, *s);
+
+   for (auto fileName : fileNames)
+      gSystem->Unlink(fileName);
+}
+
+TEST_P(RDFSimpleTests, Profile)
+{
+   auto fileName = "dataframe_simple_profile.root";
+   auto treeName = "profile";
+   FillTree(fileName, treeName, 20);
+   RDataFrame d(treeName, fileName);
+   auto sumArray = [](const RVec<int> &b4) { return Sum(b4); };
+   auto s = d.Filter([](double b1) { return b1 > 17.; }, {"b1"}).Define("s", sumArray, {"b4"}).Sum<int>("s");
+   auto profile = d.Profile();
+   EXPECT_EQ(84, *s);
+
+   const auto &nodes = profile->GetNodes();
+   ASSERT_EQ(3u, nodes.size());
+   EXPECT_EQ("Filter(b1)", nodes[0].fName);
+   EXPECT_EQ(20ull, nodes[0].fNCalls);
+   EXPECT_EQ("Define s", nodes[1].fName);
+   EXPECT_EQ(2ull, nodes[1].fNCalls);
+   EXPECT_EQ("Sum(s)", nodes[2].fName);
+   EXPECT_EQ(2ull, nodes[2].fNCalls);
+
+   const auto &columns = profile->GetColumns();
+   ASSERT_EQ(2u, columns.size());
+   for (const auto &column : columns) {
+      EXPECT_EQ(column.fName == "b1" ? 20ull : 2ull, column.fNReads);
+      EXPECT_GT(column.fBytes, 0ull);
+   }
+
+   EXPECT_EQ(NSLOTS, profile->GetSlots().size());
+   EXPECT_FALSE(profile->GetTasks().empty());
+   std::stringstream trace;
+   profile->WriteChromeTrace(trace);
+   EXPECT_EQ(0u, trace.str().find("{\"traceEvents\": ["));
+
+   // the next event loop is not profiled
+   auto s2 = d.Sum<double>("b1");
+   *s2;
+   EXPECT_EQ(3u, profile->GetNodes().size());
+   gSystem->Unlink(fileName);
+}
+
 // run single-thread tests
 INSTANTIATE_TEST_CASE_P(Seq, RDFSimpleTests, ::testing::Values(false));
 
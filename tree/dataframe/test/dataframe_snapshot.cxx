@@ -5,6 +5,7 @@
 #include "TSystem.h"
 #include "TTree.h"
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <limits>
 #include <memory>
 using namespace ROOT;         // RDataFrame
@@ -527,6 +528,90 @@ TEST(RDFSnapshotMore, ManyTasksPerThread)
    ROOT::DisableImplicitMT();
 }
 
+TEST(RDFSnapshotMore, SlotClustersMT)
+{
+   const auto nSlots = 4u;
+
+   // several input files, so that several tasks run per worker thread. x is the global entry number.
+   const std::string inputFilePrefix = "snapshot_slotclusters_";
+   const auto nInputFiles = 4 * nSlots;
+   const auto nEntriesPerFile = 10u;
+   std::vector<std::string> inputFiles;
+   for (auto i = 0u; i < nInputFiles; ++i) {
+      inputFiles.emplace_back(inputFilePrefix + std::to_string(i) + ".root");
+      ROOT::RDataFrame d(nEntriesPerFile);
+      d.Define("x", [i](ULong64_t e) { return int(i * nEntriesPerFile + e); }, {"tdfentry_"})
+         .Snapshot<int>("t", inputFiles.back(), {"x"});
+   }
+
+   ROOT::EnableImplicitMT(nSlots);
+
+   ROOT::RDF::RSnapshotOptions opts;
+   opts.fSlotClusters = true;
+   const auto outputFile = "snapshot_slotclusters_out.root";
+   const auto nOutputEntries = nInputFiles * nEntriesPerFile / 2;
+   for (auto preserveOrder : {false, true}) {
+      opts.fPreserveEntryOrder = preserveOrder;
+      ROOT::RDataFrame tdf("t", inputFiles);
+      tdf.Filter([](int x) { return x % 2 == 0; }, {"x"}).Snapshot<int>("t", outputFile, {"x"}, opts);
+
+      // the slot files are removed
+      for (auto slot = 0u; slot < nSlots; ++slot)
+         EXPECT_TRUE(gSystem->AccessPathName((std::string(outputFile) + ".slot" + std::to_string(slot)).c_str()));
+
+      TFile f(outputFile);
+      auto t = static_cast<TTree *>(f.Get("t"));
+      ASSERT_TRUE(t != nullptr);
+      ASSERT_EQ(t->GetEntries(), nOutputEntries);
+      int x = -1;
+      t->SetBranchAddress("x", &x);
+      std::vector<int> values;
+      for (auto e = 0u; e < nOutputEntries; ++e) {
+         t->GetEntry(e);
+         values.emplace_back(x);
+      }
+      if (!preserveOrder)
+         std::sort(values.begin(), values.end());
+      for (auto e = 0u; e < nOutputEntries; ++e)
+         EXPECT_EQ(values[e], int(2 * e));
+   }
+
+   for (const auto &fileName : inputFiles)
+      gSystem->Unlink(fileName.c_str());
+   gSystem->Unlink(outputFile);
+
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFSnapshotMore, SlotClustersSequentialLoopMT)
+{
+   // the RDataFrame is built before IMT is enabled, so its event loop is sequential and runs no tasks
+   const auto inputFile = "snapshot_slotclusters_seq_in.root";
+   const auto nEntries = 100u;
+   ROOT::RDataFrame(nEntries).Define("x", [](ULong64_t e) { return int(e); }, {"tdfentry_"}).Snapshot<int>(
+      "t", inputFile, {"x"});
+
+   ROOT::RDataFrame tdf("t", inputFile);
+   ROOT::EnableImplicitMT(4);
+
+   ROOT::RDF::RSnapshotOptions opts;
+   opts.fSlotClusters = true;
+   const auto outputFile = "snapshot_slotclusters_seq_out.root";
+   tdf.Snapshot<int>("t", outputFile, {"x"}, opts);
+
+   {
+      TFile f(outputFile);
+      auto t = static_cast<TTree *>(f.Get("t"));
+      ASSERT_TRUE(t != nullptr);
+      EXPECT_EQ(t->GetEntries(), nEntries);
+   }
+
+   gSystem->Unlink(inputFile);
+   gSystem->Unlink(outputFile);
+
+   ROOT::DisableImplicitMT();
+}
+
 void checkSnapshotArrayFileMT(RResultPtr<RInterface<RLoopManager>> &df, unsigned int kNEvents)
 {
    // fixedSizeArr and varSizeArr are RResultPtr<vector<vector<T>>>
@@ -1,7 +1,10 @@
 #include <ROOT/RDataFrame.hxx>
+#include <ROOT/RDFJaggedArray.hxx>
 #include <ROOT/RVec.hxx>
 #include <TBranchElement.h>
+#include <TClonesArray.h>
 #include <TFile.h>
+#include <TParameter.h>
 #include <TTree.h>
 #include <TSystem.h> // Unlink
 #include <gtest/gtest.h>
@@ -61,3 +64,115 @@ TEST(RDFAndVecOps, SnapshotRVec)
 
    gSystem->Unlink(fname);
 }
+
+TEST(RDFAndVecOps, ReadJaggedArray)
+{
+   const auto fname = "rdfandvecops_jagged.root";
+   const auto treename = "t";
+   const auto nEntries = 1000;
+   {
+      TFile f(fname, "RECREATE");
+      TTree t(treename, treename);
+      int n = 0;
+      float x[10];
+      std::vector<float> v;
+      t.Branch("n", &n, "n/I");
+      t.Branch("x", x, "x[n]/F", 512); // small baskets, so that entries are read from many of them
+      t.Branch("v", &v, 512);
+      for (auto i = 0; i < nEntries; ++i) {
+         n = i % 10;
+         v.clear();
+         for (auto j = 0; j < n; ++j) {
+            x[j] = i + 0.5f * j;
+            v.emplace_back(x[j]);
+         }
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TFile f(fname);
+   auto t = static_cast<TTree *>(f.Get(treename));
+   for (auto branchName : {"x", "v"}) {
+      const auto all = ROOT::RDF::ReadJaggedArray<float>(*t, branchName);
+      ASSERT_EQ(all.size(), std::size_t(nEntries));
+      EXPECT_EQ(all.GetContent().size(), 4500u);
+      for (auto i : {0, 1, 9, 517, 999}) {
+         ASSERT_EQ(all.GetSize(i), std::size_t(i % 10));
+         for (auto j = 0; j < i % 10; ++j)
+            EXPECT_FLOAT_EQ(all[i][j], i + 0.5f * j);
+      }
+
+      const auto some = ROOT::RDF::ReadJaggedArray<float>(*t, branchName, 517, 530);
+      ASSERT_EQ(some.size(), 13u);
+      for (auto i = 0u; i < some.size(); ++i)
+         EXPECT_EQ(some.GetSize(i), all.GetSize(517 + i));
+      EXPECT_FLOAT_EQ(Sum(some)[0], 7 * 517 + 0.5f * 21);
+   }
+   EXPECT_THROW(ROOT::RDF::ReadJaggedArray<double>(*t, "x"), std::runtime_error);
+   EXPECT_THROW(ROOT::RDF::ReadJaggedArray<float>(*t, "y"), std::runtime_error);
+   EXPECT_THROW(ROOT::RDF::ReadJaggedArray<float>(*t, "x", 10, nEntries + 1), std::runtime_error);
+
+   // RDataFrame collects a RVec column in a RJaggedArray
+   RDataFrame d(treename, fname);
+   auto taken = d.Filter("n > 5").Take<RVec<float>, RJaggedArray<float>>("v");
+   EXPECT_EQ(taken->size(), 400u);
+   EXPECT_TRUE(All(Sizes(*taken) > 5u));
+
+   gSystem->Unlink(fname);
+}
+
+TEST(RDFAndVecOps, ReadJaggedArraySplitCollections)
+{
+   const auto fname = "rdfandvecops_jagged_split.root";
+   const auto treename = "t";
+   const auto nEntries = 1000;
+   {
+      TFile f(fname, "RECREATE");
+      TTree t(treename, treename);
+      TClonesArray params("TParameter<float>");
+      std::vector<std::pair<int, int>> pairs;
+      t.Branch("params", &params, 512, 99);
+      t.Branch("pairs", &pairs, 512, 99);
+      for (auto i = 0; i < nEntries; ++i) {
+         params.Clear();
+         pairs.clear();
+         for (auto j = 0; j < i % 10; ++j) {
+            new (params[j]) TParameter<float>("p", i + 0.5f * j);
+            pairs.emplace_back(j, i * 10 + j);
+         }
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TFile f(fname);
+   auto t = static_cast<TTree *>(f.Get(treename));
+   // the data members of the objects of a split TClonesArray and of a split STL collection
+   auto paramsVal = dynamic_cast<TBranchElement *>(t->GetBranch("params.fVal"));
+   auto pairsSecond = dynamic_cast<TBranchElement *>(t->GetBranch("pairs.second"));
+   ASSERT_NE(nullptr, paramsVal);
+   ASSERT_NE(nullptr, pairsSecond);
+   EXPECT_EQ(31, paramsVal->GetType());
+   EXPECT_EQ(41, pairsSecond->GetType());
+
+   const auto vals = ROOT::RDF::ReadJaggedArray<float>(*t, "params.fVal");
+   const auto seconds = ROOT::RDF::ReadJaggedArray<int>(*t, "pairs.second", 517, 530);
+   ASSERT_EQ(vals.size(), std::size_t(nEntries));
+   ASSERT_EQ(seconds.size(), 13u);
+   EXPECT_EQ(vals.GetContent().size(), 4500u);
+   for (auto i : {0, 1, 9, 517, 999}) {
+      ASSERT_EQ(vals.GetSize(i), std::size_t(i % 10));
+      for (auto j = 0; j < i % 10; ++j)
+         EXPECT_FLOAT_EQ(vals[i][j], i + 0.5f * j);
+   }
+   for (auto i = 0u; i < seconds.size(); ++i) {
+      const auto entry = 517 + i;
+      ASSERT_EQ(seconds.GetSize(i), std::size_t(entry % 10));
+      for (auto j = 0u; j < entry % 10; ++j)
+         EXPECT_EQ(seconds[i][j], int(entry * 10 + j));
+   }
+   EXPECT_THROW(ROOT::RDF::ReadJaggedArray<double>(*t, "params.fVal"), std::runtime_error);
+
+   gSystem->Unlink(fname);
+}
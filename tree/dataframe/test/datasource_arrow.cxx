@@ -7,6 +7,8 @@
 #pragma GCC diagnostic ignored "-Wshadow"
 #endif
 #include <arrow/builder.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
 #include <arrow/memory_pool.h>
 #include <arrow/record_batch.h>
 #include <arrow/table.h>
@@ -15,6 +17,8 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <TSystem.h>
+
 #include <gtest/gtest.h>
 
 #include <iostream>
@@ -54,6 +58,27 @@ std::shared_ptr<Table> createTestTable()
    return table_;
 }
 
+/// Write the test table as an Arrow IPC stream with nBatches identical record batches
+void writeTestStream(const std::string &fileName, int nBatches)
+{
+   auto table = createTestTable();
+   std::vector<std::shared_ptr<Array>> arrays;
+   for (auto i : ROOT::TSeqI(table->num_columns()))
+      arrays.emplace_back(table->column(i)->data()->chunk(0));
+   auto batch = RecordBatch::Make(table->schema(), table->num_rows(), arrays);
+
+   std::shared_ptr<io::FileOutputStream> file;
+   ASSERT_TRUE(io::FileOutputStream::Open(fileName, &file).ok());
+   std::shared_ptr<RecordBatchWriter> writer;
+   ASSERT_TRUE(ipc::RecordBatchStreamWriter::Open(file.get(), table->schema(), &writer).ok());
+   for (auto i : ROOT::TSeqI(nBatches)) {
+      ASSERT_TRUE(writer->WriteRecordBatch(*batch).ok());
+      (void)i;
+   }
+   ASSERT_TRUE(writer->Close().ok());
+   ASSERT_TRUE(file->Close().ok());
+}
+
 TEST(RArrowDS, ColTypeNames)
 {
    RArrowDS tds(createTestTable(), {"Name", "Age", "Height", "Married"});
@@ -140,6 +165,45 @@ TEST(RArrowDS, ColumnReadersString)
    }
 }
 
+TEST(RArrowDS, RecordBatchStream)
+{
+   const auto fileName = "RArrowDS_test_stream.arrow";
+   writeTestStream(fileName, 2);
+
+   RArrowDS tds(fileName, {});
+   const auto nSlots = 2U;
+   tds.SetNSlots(nSlots);
+   EXPECT_STREQ("Long64_t", tds.GetTypeName("Age").c_str());
+   auto vals = tds.GetColumnReaders<Long64_t>("Age");
+   std::vector<Long64_t> ages = {64, 50, 40, 30, 2, 0};
+
+   // run two event loops to check that the file is read again from the start
+   for (auto loop : ROOT::TSeqI(2)) {
+      tds.Initialise();
+      auto nEntries = 0U;
+      auto ranges = tds.GetEntryRanges();
+      while (!ranges.empty()) {
+         ASSERT_EQ(nSlots, ranges.size());
+         auto slot = 0U;
+         for (auto &&range : ranges) {
+            tds.InitSlot(slot, range.first);
+            for (auto i : ROOT::TSeqU(range.first, range.second)) {
+               tds.SetEntry(slot, i);
+               EXPECT_EQ(ages[i % ages.size()], **vals[slot]);
+               ++nEntries;
+            }
+            slot++;
+         }
+         ranges = tds.GetEntryRanges();
+      }
+      tds.Finalise();
+      EXPECT_EQ(12U, nEntries);
+      (void)loop;
+   }
+
+   gSystem->Unlink(fileName);
+}
+
 #ifndef NDEBUG
 
 TEST(RArrowDS, SetNSlotsTwice)
@@ -225,6 +289,23 @@ TEST(RArrowDS, FromARDFWithJittingMT)
    EXPECT_EQ(40, *min);
 }
 
+TEST(RArrowDS, FromARDFRecordBatchStreamMT)
+{
+   const auto fileName = "RArrowDS_test_streammt.arrow";
+   writeTestStream(fileName, 3);
+
+   auto tdf = MakeArrowIPCDataFrame(fileName, {"Age", "Height"});
+   auto max = tdf.Max<double>("Height");
+   auto c = tdf.Count();
+   EXPECT_EQ(18U, *c);
+   EXPECT_DOUBLE_EQ(200.5, *max);
+
+   auto sum = tdf.Sum<Long64_t>("Age");
+   EXPECT_EQ(3 * 186, *sum);
+
+   gSystem->Unlink(fileName);
+}
+
 #endif // R__USE_IMT
 
 #endif // R__B64
@@ -1,9 +1,12 @@
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/TSeq.hxx>
+#include <TSystem.h>
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 
 using namespace ROOT::RDF;
@@ -279,6 +282,38 @@ TEST(RCsvDS, ProgressiveReadingRDFMT)
    EXPECT_EQ(6U, *c2);
 }
 
+TEST(RCsvDS, ParallelParsingMT)
+{
+   ROOT::EnableImplicitMT(4);
+
+   const auto fileName = "RCsvDS_test_parallel.csv";
+   {
+      std::ofstream f(fileName);
+      // one decimal for all values of x, so that the column is inferred as double from its first value
+      f << std::fixed << std::setprecision(1);
+      f << "i,x,b,s\n";
+      for (auto i : ROOT::TSeqI(1000))
+         f << i << ',' << i * .5 << ',' << (i % 2 ? "true" : "false") << ",\"s" << i << "\"\n";
+   }
+
+   for (auto chunkSize : {-1LL, 300LL}) {
+      auto tdf = ROOT::RDF::MakeCsvDataFrame(fileName, true, ',', chunkSize);
+      auto sumI = tdf.Sum<Long64_t>("i");
+      auto sumX = tdf.Sum<double>("x");
+      auto nTrue = tdf.Filter([](bool b) { return b; }, {"b"}).Count();
+      auto nS = tdf.Filter([](const std::string &s, Long64_t i) { return s == "s" + std::to_string(i); }, {"s", "i"})
+                   .Count();
+
+      EXPECT_EQ(499500LL, *sumI);
+      EXPECT_DOUBLE_EQ(249750., *sumX);
+      EXPECT_EQ(500U, *nTrue);
+      EXPECT_EQ(1000U, *nS);
+   }
+
+   gSystem->Unlink(fileName);
+   ROOT::DisableImplicitMT();
+}
+
 #endif // R__USE_IMT
 
 #endif // R__B64
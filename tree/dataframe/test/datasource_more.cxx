@@ -2,10 +2,13 @@
 #include <ROOT/RMakeUnique.hxx>
 
 #include "RNonCopiableColumnDS.hxx"
+#include "RPushDownDS.hxx"
 #include "RStreamingDS.hxx"
 
 #include "gtest/gtest.h"
 
+#include <limits>
+
 using namespace ROOT::RDF;
 
 TEST(RNonCopiableColumnDS, UseNonCopiableColumnType)
@@ -46,3 +49,48 @@ TEST(RStreamingDS, MultipleEntryRangesMT)
    ROOT::DisableImplicitMT();
 }
 #endif
+
+TEST(RPushDownDS, ColumnRanges)
+{
+   auto ds = std::make_unique<RPushDownDS>();
+   auto dsPtr = ds.get();
+   ROOT::RDataFrame tdf(std::move(ds));
+   auto filtered = tdf.Filter("x > 5 && 8 >= x");
+   auto c = filtered.Count();
+   EXPECT_EQ(3ull, *c);
+   ASSERT_EQ(2u, dsPtr->fColumnRanges.size());
+   EXPECT_EQ("x", dsPtr->fColumnRanges[0].fColumnName);
+   EXPECT_DOUBLE_EQ(5., dsPtr->fColumnRanges[0].fMin);
+   EXPECT_DOUBLE_EQ(std::numeric_limits<double>::max(), dsPtr->fColumnRanges[0].fMax);
+   EXPECT_DOUBLE_EQ(std::numeric_limits<double>::lowest(), dsPtr->fColumnRanges[1].fMin);
+   EXPECT_DOUBLE_EQ(8., dsPtr->fColumnRanges[1].fMax);
+
+   // another branch of the computation graph needs all entries
+   auto c2 = filtered.Count();
+   auto all = tdf.Count();
+   EXPECT_EQ(3ull, *c2);
+   EXPECT_EQ(10ull, *all);
+   EXPECT_TRUE(dsPtr->fColumnRanges.empty());
+
+   // named filters must see all entries for their report
+   auto c3 = tdf.Filter("x > 5", "xcut").Count();
+   EXPECT_EQ(4ull, *c3);
+   EXPECT_TRUE(dsPtr->fColumnRanges.empty());
+
+   // not a simple selection
+   auto c4 = tdf.Filter("x > 5 || y < 2").Count();
+   EXPECT_EQ(5ull, *c4);
+   EXPECT_TRUE(dsPtr->fColumnRanges.empty());
+}
+
+TEST(RPushDownDS, LazyColumns)
+{
+   auto ds = std::make_unique<RPushDownDS>();
+   auto dsPtr = ds.get();
+   ROOT::RDataFrame tdf(std::move(ds));
+   auto sum = tdf.Filter([](int x) { return x > 5; }, {"x"}).Sum<int>("y");
+   EXPECT_EQ(60, *sum);
+   EXPECT_EQ(10u, dsPtr->fNLoadedValues[0]);
+   // "y" is only read for the entries which pass the filter
+   EXPECT_EQ(4u, dsPtr->fNLoadedValues[1]);
+}
@@ -0,0 +1,186 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RParquetDS.hxx>
+#include <ROOT/TSeq.hxx>
+#include <TSystem.h>
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#endif
+#include <arrow/builder.h>
+#include <arrow/io/file.h>
+#include <arrow/memory_pool.h>
+#include <arrow/table.h>
+#include <arrow/test-util.h>
+#include <parquet/arrow/writer.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+using namespace ROOT;
+using namespace ROOT::RDF;
+using namespace arrow;
+
+const auto fileName = "RParquetDS_test.parquet";
+
+/// Write a file with 3 row groups of 4 entries each, with x = 0..11
+void writeTestFile()
+{
+   auto schema_ = schema({field("x", arrow::int64()), field("y", arrow::float64()), field("s", arrow::utf8())});
+
+   std::vector<int64_t> xs;
+   std::vector<double> ys;
+   std::vector<std::string> ss;
+   for (auto i : ROOT::TSeqI(12)) {
+      xs.push_back(i);
+      ys.push_back(i * 0.5);
+      ss.push_back("s" + std::to_string(i));
+   }
+
+   std::shared_ptr<Array> arrays_[3];
+   arrow::ArrayFromVector<Int64Type, int64_t>(xs, &arrays_[0]);
+   arrow::ArrayFromVector<DoubleType, double>(ys, &arrays_[1]);
+   arrow::ArrayFromVector<StringType, std::string>(ss, &arrays_[2]);
+
+   std::vector<std::shared_ptr<Column>> columns_ = {std::make_shared<Column>(schema_->field(0), arrays_[0]),
+                                                    std::make_shared<Column>(schema_->field(1), arrays_[1]),
+                                                    std::make_shared<Column>(schema_->field(2), arrays_[2])};
+   auto table = Table::Make(schema_, columns_);
+
+   std::shared_ptr<io::FileOutputStream> file;
+   ASSERT_TRUE(io::FileOutputStream::Open(fileName, &file).ok());
+   ASSERT_TRUE(parquet::arrow::WriteTable(*table, default_memory_pool(), file, 4).ok());
+   ASSERT_TRUE(file->Close().ok());
+}
+
+class RParquetDSTest : public ::testing::Test {
+protected:
+   static void SetUpTestCase() { writeTestFile(); }
+   static void TearDownTestCase() { gSystem->Unlink(fileName); }
+};
+
+TEST_F(RParquetDSTest, ColTypeNames)
+{
+   RParquetDS tds(fileName);
+   tds.SetNSlots(1);
+
+   auto colNames = tds.GetColumnNames();
+   ASSERT_EQ(3U, colNames.size());
+   EXPECT_TRUE(tds.HasColumn("x"));
+   EXPECT_FALSE(tds.HasColumn("z"));
+
+   EXPECT_STREQ("Long64_t", tds.GetTypeName("x").c_str());
+   EXPECT_STREQ("double", tds.GetTypeName("y").c_str());
+   EXPECT_STREQ("std::string", tds.GetTypeName("s").c_str());
+}
+
+TEST_F(RParquetDSTest, Projection)
+{
+   RParquetDS tds(fileName, {"y"});
+   ASSERT_EQ(1U, tds.GetColumnNames().size());
+   EXPECT_FALSE(tds.HasColumn("x"));
+}
+
+TEST_F(RParquetDSTest, EntryRangesAndReaders)
+{
+   RParquetDS tds(fileName);
+   EXPECT_EQ(3U, tds.GetNRowGroups());
+   const auto nSlots = 2U;
+   tds.SetNSlots(nSlots);
+   auto xs = tds.GetColumnReaders<Long64_t>("x");
+   auto ss = tds.GetColumnReaders<std::string>("s");
+   tds.Initialise();
+   auto ranges = tds.GetEntryRanges();
+   ASSERT_EQ(3U, ranges.size()); // one per row group
+
+   auto slot = 0U;
+   for (auto &&range : ranges) {
+      EXPECT_EQ(4U, range.second - range.first);
+      tds.InitSlot(slot, range.first);
+      for (auto i : ROOT::TSeqU(range.first, range.second)) {
+         tds.SetEntry(slot, i);
+         EXPECT_EQ(Long64_t(i), **xs[slot]);
+         EXPECT_EQ("s" + std::to_string(i), **ss[slot]);
+      }
+      tds.FinaliseSlot(slot);
+      slot = (slot + 1) % nSlots;
+   }
+   EXPECT_TRUE(tds.GetEntryRanges().empty());
+}
+
+TEST_F(RParquetDSTest, RowGroupFilter)
+{
+   auto tds = std::make_unique<RParquetDS>(fileName);
+   tds->AddRowGroupFilter("x", 5., std::numeric_limits<double>::max());
+   EXPECT_EQ(2U, tds->GetNSelectedRowGroups());
+   tds->AddRowGroupFilter("y", -1., 3.);
+   EXPECT_EQ(1U, tds->GetNSelectedRowGroups());
+
+   ROOT::RDataFrame rdf(std::move(tds));
+   auto c = rdf.Count();
+   auto min = rdf.Min<Long64_t>("x");
+   EXPECT_EQ(4U, *c);
+   EXPECT_EQ(4, *min);
+}
+
+#ifdef R__B64
+
+TEST_F(RParquetDSTest, FromARDF)
+{
+   auto rdf = MakeParquetDataFrame(fileName);
+   auto max = rdf.Max<double>("y");
+   auto sum = rdf.Sum<Long64_t>("x");
+   auto c = rdf.Count();
+
+   EXPECT_EQ(12U, *c);
+   EXPECT_DOUBLE_EQ(5.5, *max);
+   EXPECT_EQ(66, *sum);
+}
+
+TEST_F(RParquetDSTest, FromARDFWithJitting)
+{
+   auto rdf = MakeParquetDataFrame(fileName);
+   auto max = rdf.Filter("x < 7").Max("y");
+   EXPECT_DOUBLE_EQ(3., *max);
+}
+
+TEST_F(RParquetDSTest, PushedDownFilterKeepsEntryNumbers)
+{
+   auto tds = std::make_unique<RParquetDS>(fileName);
+   auto tdsPtr = tds.get();
+   ROOT::RDataFrame rdf(std::move(tds));
+   // the filter is handed down to the data source, which skips the first row group (x = 0..3)
+   auto filtered = rdf.Filter("x > 5");
+   auto entries = filtered.Take<ULong64_t>("rdfentry_");
+   auto xs = filtered.Take<Long64_t>("x");
+
+   const std::vector<ULong64_t> expected = {6, 7, 8, 9, 10, 11};
+   EXPECT_EQ(expected, *entries);
+   ASSERT_EQ(expected.size(), xs->size());
+   for (auto i : ROOT::TSeqU(xs->size()))
+      EXPECT_EQ(Long64_t((*entries)[i]), (*xs)[i]);
+   EXPECT_EQ(2U, tdsPtr->GetNSelectedRowGroups());
+}
+
+#ifdef R__USE_IMT
+
+TEST_F(RParquetDSTest, FromARDFMT)
+{
+   ROOT::EnableImplicitMT(3);
+   auto rdf = MakeParquetDataFrame(fileName);
+   auto max = rdf.Max<double>("y");
+   auto sum = rdf.Sum<Long64_t>("x");
+   auto c = rdf.Count();
+
+   EXPECT_EQ(12U, *c);
+   EXPECT_DOUBLE_EQ(5.5, *max);
+   EXPECT_EQ(66, *sum);
+}
+
+#endif // R__USE_IMT
+
+#endif // R__B64
@@ -25,6 +25,7 @@
 
 #include <string.h>
 #include <functional>
+#include <mutex>
 #include <vector>
 
 
@@ -67,6 +68,7 @@ namespace ROOT {
       // EntryClusters and number of entries per file
       using ClustersAndEntries = std::pair<std::vector<std::vector<EntryCluster>>, std::vector<Long64_t>>;
       ClustersAndEntries MakeClusters(const std::string &treename, const std::vector<std::string> &filenames);
+      std::vector<EntryCluster> SplitClusters(const std::vector<EntryCluster> &clusters, unsigned int nTasks);
 
       class TTreeView {
       private:
@@ -183,6 +185,16 @@ namespace ROOT {
    } // End of namespace Internal
 
    class TTreeProcessorMT {
+   public:
+      /// Timing information about one of the tasks run by TTreeProcessorMT::Process
+      struct TaskTiming {
+         std::size_t fFileIdx;   ///< Index of the file that was processed, in the list of input files
+         Long64_t fStart;        ///< First entry of the task range (global if friends or an entry list are used)
+         Long64_t fEnd;          ///< One-past-the-last entry of the task range
+         double fBeginTime;      ///< Seconds elapsed between the start of Process and the start of the task
+         double fEndTime;        ///< Seconds elapsed between the start of Process and the end of the task
+      };
+
    private:
       const std::vector<std::string> fFileNames; ///< Names of the files
       const std::string fTreeName;               ///< Name of the tree
@@ -192,6 +204,11 @@ namespace ROOT {
 
       ROOT::TThreadedObject<ROOT::Internal::TTreeView> treeView; ///<! Thread-local TreeViews
 
+      std::vector<TaskTiming> fTaskTimings; ///<! Timings of the tasks run by the last call to Process
+      std::mutex fTaskTimingsMutex;         ///<! Protects fTaskTimings while tasks are running
+
+      static unsigned int fgTasksPerWorkerHint; ///< Target number of tasks per worker thread per file
+
       Internal::FriendInfo GetFriendInfo(TTree &tree);
       std::string FindTreeName();
 
@@ -202,6 +219,11 @@ namespace ROOT {
       TTreeProcessorMT(TTree &tree);
 
       void Process(std::function<void(TTreeReader &)> func);
+
+      const std::vector<TaskTiming> &GetTaskTimings() const { return fTaskTimings; }
+
+      static void SetTasksPerWorkerHint(unsigned int m);
+      static unsigned int GetTasksPerWorkerHint();
    };
 
 } // End of namespace ROOT
@@ -22,12 +22,24 @@ The implementation of ROOT::TTreeProcessorMT parallelizes the processing of the
 each corresponding to a cluster in the TTree. This is possible thanks to the use
 of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTree
 objects.
+
+Clusters with very different sizes, or very uneven processing costs, can leave most worker
+threads idle while the last few clusters are being processed. To mitigate this,
+TTreeProcessorMT::SetTasksPerWorkerHint can be used to require that the entries of each
+file are spread over a minimum number of tasks per worker thread: clusters that are larger
+than the resulting task size are split in sub-ranges that idle workers can steal. Note that
+the baskets of a split cluster might be read and decompressed by more than one task.
+The timing of each task run by the last call to Process is available via
+TTreeProcessorMT::GetTaskTimings.
 */
 
 #include "TROOT.h"
 #include "ROOT/TTreeProcessorMT.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 
+#include <algorithm>
+#include <chrono>
+
 using namespace ROOT;
 
 namespace ROOT {
@@ -66,6 +78,43 @@ MakeClusters(const std::string &treeName, const std::vector<std::string> &fileNa
    return std::make_pair(std::move(clustersPerFile), std::move(entriesPerFile));
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Split the clusters that are larger than the size required to obtain nTasks equally sized tasks.
+/// Clusters are split in sub-ranges of (as much as possible) equal size. Smaller clusters are left untouched.
+/// If nTasks is 0, the clusters are returned unchanged.
+std::vector<EntryCluster> SplitClusters(const std::vector<EntryCluster> &clusters, unsigned int nTasks)
+{
+   if (nTasks == 0u || clusters.empty())
+      return clusters;
+
+   Long64_t nEntries = 0ll;
+   for (const auto &c : clusters)
+      nEntries += c.end - c.start;
+   const Long64_t maxTaskSize = std::max(1ll, (nEntries + nTasks - 1) / nTasks);
+
+   std::vector<EntryCluster> ranges;
+   ranges.reserve(std::max<std::size_t>(clusters.size(), nTasks));
+   for (const auto &c : clusters) {
+      const Long64_t clusterSize = c.end - c.start;
+      if (clusterSize <= maxTaskSize) {
+         ranges.emplace_back(c);
+         continue;
+      }
+      // Spread the entries of the cluster over nParts ranges whose sizes differ by at most one
+      const Long64_t nParts = (clusterSize + maxTaskSize - 1) / maxTaskSize;
+      const Long64_t partSize = clusterSize / nParts;
+      const Long64_t remainder = clusterSize % nParts;
+      Long64_t start = c.start;
+      for (Long64_t i = 0ll; i < nParts; ++i) {
+         const Long64_t end = start + partSize + (i < remainder ? 1ll : 0ll);
+         ranges.emplace_back(EntryCluster{start, end});
+         start = end;
+      }
+   }
+
+   return ranges;
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Return a vector containing the number of entries of each file of each friend TChain
 std::vector<std::vector<Long64_t>> GetFriendEntries(const std::vector<std::pair<std::string, std::string>> &friendNames,
@@ -91,6 +140,8 @@ std::vector<std::vector<Long64_t>> GetFriendEntries(const std::vector<std::pair<
 }
 }
 
+unsigned int TTreeProcessorMT::fgTasksPerWorkerHint = 0u;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get and store the names, aliases and file names of the friends of the tree.
 /// \param[in] tree The main tree whose friends to 
@@ -245,6 +296,9 @@ TTreeProcessorMT::TTreeProcessorMT(TTree &tree) : TTreeProcessorMT(tree, TEntryL
 /// be processed in parallel. This means that the code of the user function
 /// should be thread safe.
 ///
+/// The start and end times of each task are recorded and can be retrieved
+/// with GetTaskTimings after this method returns.
+///
 /// \param[in] func User-defined function that processes a subrange of entries
 void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
 {
@@ -266,6 +320,15 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
       hasFriends ? Internal::GetFriendEntries(friendNames, friendFileNames) : std::vector<std::vector<Long64_t>>{};
 
    TThreadExecutor pool;
+   const auto nTasksPerFile = fgTasksPerWorkerHint * Internal::TPoolManager::GetPoolSize();
+
+   fTaskTimings.clear();
+   using clock_t = std::chrono::steady_clock;
+   const auto processStart = clock_t::now();
+   auto secondsSinceStart = [processStart]() {
+      return std::chrono::duration<double>(clock_t::now() - processStart).count();
+   };
+
    // Parent task, spawns tasks that process each of the entry clusters for each input file
    using Internal::EntryCluster;
    auto processFile = [&](std::size_t fileIdx) {
@@ -286,7 +349,12 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
       const auto &theseEntries =
          shouldUseGlobalEntries ? entries : std::vector<Long64_t>({theseClustersAndEntries.second[0]});
 
+      // Split the largest clusters in sub-ranges, if requested, so that idle workers can steal part of their work
+      const auto theseRanges = Internal::SplitClusters(thisFileClusters, nTasksPerFile);
+
       auto processCluster = [&](const Internal::EntryCluster &c) {
+         const auto beginTime = secondsSinceStart();
+
          // This task will operate with the tree that contains start
          treeView->PushTaskFirstEntry(c.start);
 
@@ -298,9 +366,13 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
 
          // In case of task interleaving, we need to load here the tree of the parent task
          treeView->PopTaskFirstEntry();
+
+         const auto endTime = secondsSinceStart();
+         std::lock_guard<std::mutex> lock(fTaskTimingsMutex);
+         fTaskTimings.emplace_back(TaskTiming{fileIdx, c.start, c.end, beginTime, endTime});
       };
 
-      pool.Foreach(processCluster, thisFileClusters);
+      pool.Foreach(processCluster, theseRanges);
    };
 
    std::vector<std::size_t> fileIdxs(fFileNames.size());
@@ -311,3 +383,25 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
 
    pool.Foreach(processFile, fileIdxs);
 }
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Sets the target number of tasks per worker thread that TTreeProcessorMT creates for each file.
+/// \param[in] m The target number of tasks per worker thread per file. 0 (the default) means one task per cluster.
+///
+/// The entries of each file are split so that no task processes more than
+/// nEntriesInFile / (m * nWorkerThreads) entries: clusters that are larger than that are split in
+/// several sub-ranges, which are then distributed among the worker threads by the task scheduler.
+/// Smaller clusters are never merged. Values larger than one trade some redundant basket reading
+/// for a better load balancing at the end of the processing.
+void TTreeProcessorMT::SetTasksPerWorkerHint(unsigned int m)
+{
+   fgTasksPerWorkerHint = m;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// \brief Returns the target number of tasks per worker thread that TTreeProcessorMT creates for each file.
+/// \return The target number of tasks per worker thread per file. 0 means one task per cluster.
+unsigned int TTreeProcessorMT::GetTasksPerWorkerHint()
+{
+   return fgTasksPerWorkerHint;
+}
@@ -71,3 +71,71 @@ TEST(TreeProcessorMT, ManyFiles)
 
    DeleteFiles(filenames);
 }
+
+TEST(TreeProcessorMT, SplitClusters)
+{
+   using ROOT::Internal::EntryCluster;
+   const std::vector<EntryCluster> clusters{{0, 10}, {10, 100}, {100, 103}};
+
+   // no splitting requested
+   const auto sameClusters = ROOT::Internal::SplitClusters(clusters, 0u);
+   ASSERT_EQ(sameClusters.size(), clusters.size());
+
+   // 103 entries in 4 tasks: clusters larger than 26 entries are split
+   const auto ranges = ROOT::Internal::SplitClusters(clusters, 4u);
+   ASSERT_EQ(ranges.size(), 6u);
+   Long64_t expectedStart = 0ll;
+   for (const auto &r : ranges) {
+      EXPECT_EQ(r.start, expectedStart);
+      EXPECT_LE(r.end - r.start, 26ll);
+      expectedStart = r.end;
+   }
+   EXPECT_EQ(expectedStart, 103ll);
+}
+
+TEST(TreeProcessorMT, TasksPerWorkerHint)
+{
+   const auto nFiles = 4u;
+   const std::string treename = "t";
+   std::vector<std::string> filenames;
+   for (auto i = 0u; i < nFiles; ++i)
+      filenames.emplace_back("treeprocmt_hint_" + std::to_string(i) + ".root");
+
+   WriteFiles(treename, filenames);
+
+   std::atomic_int sum(0);
+   std::atomic_int count(0);
+   auto sumValues = [&sum, &count](TTreeReader &r) {
+      TTreeReaderValue<int> v(r, "v");
+      while (r.Next()) {
+         sum += *v;
+         ++count;
+      }
+   };
+
+   std::vector<std::string_view> fnames;
+   for (const auto &f : filenames)
+      fnames.emplace_back(f);
+
+   const auto oldHint = ROOT::TTreeProcessorMT::GetTasksPerWorkerHint();
+   ROOT::TTreeProcessorMT::SetTasksPerWorkerHint(4u);
+   ROOT::TTreeProcessorMT proc(fnames, treename);
+   proc.Process(sumValues);
+   ROOT::TTreeProcessorMT::SetTasksPerWorkerHint(oldHint);
+
+   EXPECT_EQ(count.load(), int(nFiles * 10)); // 10 entries per file
+   EXPECT_EQ(sum.load(), 820);                 // sum 1..nFiles*10
+
+   // each file has a single cluster, which is split in more than one task
+   const auto &timings = proc.GetTaskTimings();
+   EXPECT_GT(timings.size(), nFiles);
+   Long64_t nProcessed = 0ll;
+   for (const auto &t : timings) {
+      EXPECT_LT(t.fFileIdx, nFiles);
+      EXPECT_LE(t.fBeginTime, t.fEndTime);
+      nProcessed += t.fEnd - t.fStart;
+   }
+   EXPECT_EQ(nProcessed, Long64_t(nFiles * 10));
+
+   DeleteFiles(filenames);
+}